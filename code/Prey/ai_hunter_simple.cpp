@@ -1381,6 +1381,18 @@ void hhHunterSimple::Event_CallBackup( float delay ) {
 	}
 }
 
+/*
+=====================
+hhHunterSimple::CanSeeList
+	CanSee updates AI_ENEMY_SHOOTABLE from every trace it does, so the hunter keeps single traces
+=====================
+*/
+void hhHunterSimple::CanSeeList( idEntity * const *ents, const int numEnts, bool useFov, bool *canSee ) {
+	for ( int i = 0; i < numEnts; i++ ) {
+		canSee[i] = CanSee( ents[i], useFov );
+	}
+}
+
 bool hhHunterSimple::CanSee( idEntity *ent, bool useFov ) {
 	trace_t		tr;
 	idVec3		eye;
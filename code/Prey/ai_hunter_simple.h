@@ -58,6 +58,7 @@ public:
 	void Event_TriggerDelay( idEntity *ent, float delay );
 	void Event_CallBackup( float delay );
 	virtual bool CanSee( idEntity *ent, bool useFov );
+	virtual void CanSeeList( idEntity * const *ents, const int numEnts, bool useFov, bool *canSee );
 	void Event_GetAdvanceNode();
 	void Event_GetRetreatNode();
 	void Event_OnProjectileLand(hhProjectile *proj);
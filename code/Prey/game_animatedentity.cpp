@@ -73,6 +73,20 @@ hhAnimatedEntity::~hhAnimatedEntity() {
 	Event_Silent();
 }
 
+/*
+==============
+hhAnimatedEntity::DefaultThinkBudget
+
+Placed animated props are scenery, the many subclasses keep thinking every frame unless they ask otherwise
+==============
+*/
+thinkBudget_t hhAnimatedEntity::DefaultThinkBudget( void ) const {
+	if ( GetType() == &hhAnimatedEntity::Type ) {
+		return THINKBUDGET_LOW;
+	}
+	return idAnimatedEntity::DefaultThinkBudget();
+}
+
 /*
 ==============
 hhAnimatedEntity::FillDebugVars
@@ -24,6 +24,7 @@ public:
 	virtual						~hhAnimatedEntity();
 
 	void						Think();
+	virtual thinkBudget_t		DefaultThinkBudget( void ) const;
 
 	virtual hhAnimator *		GetAnimator( void );
 	virtual const hhAnimator *	GetAnimator( void ) const;
@@ -14,6 +14,7 @@ public:
 	void		Restore( idRestoreGame *savefile );
 	void		Trigger( idEntity *activator );
 	void		Damage( idEntity *inflictor, idEntity *attacker, const idVec3 &dir, const char *damageDefName, const float damageScale, const int location );
+	virtual thinkBudget_t	DefaultThinkBudget( void ) const { return THINKBUDGET_LOW; }
 
 protected:
 	void		Event_Trigger( idEntity *activator );
@@ -6,6 +6,7 @@
 CLASS_DECLARATION( idEntityFx, hhEntityFx )
 	EVENT( EV_Activate,	   	hhEntityFx::Event_Trigger )
 	EVENT( EV_Fx_KillFx,	hhEntityFx::Event_ClearFx )
+	EVENT( EV_Remove,		hhEntityFx::Event_Remove )
 END_CLASS
 
 /*
@@ -21,6 +22,9 @@ hhEntityFx::hhEntityFx() {
 // HUMANHEAD bg
 	restartActive = false;
 // HUMANHEAD END
+
+	returnToPool = false;
+	poolClient = false;
 }
 
 /*
@@ -41,6 +45,8 @@ void hhEntityFx::Save(idSaveGame *savefile) const {
 // HUMANHEAD bg
 	savefile->WriteBool( restartActive );
 // HUMANHEAD END
+	savefile->WriteBool( returnToPool );
+	savefile->WriteBool( poolClient );
 }
 
 void hhEntityFx::Restore( idRestoreGame *savefile ) {
@@ -50,6 +56,16 @@ void hhEntityFx::Restore( idRestoreGame *savefile ) {
 // HUMANHEAD bg
 	savefile->ReadBool( restartActive );
 // HUMANHEAD END
+	if ( savefile->GetBuildNumber() < ENTITY_POOL_BUILD_NUMBER ) {
+		returnToPool = false;
+		poolClient = false;
+	} else {
+		savefile->ReadBool( returnToPool );
+		savefile->ReadBool( poolClient );
+	}
+	if ( inEntityPool ) {
+		gameLocal.entityPool.RestoreEntity( this, spawnArgs.GetString( "fx" ), true, poolClient );
+	}
 }
 
 void hhEntityFx::WriteToSnapshot( idBitMsgDelta &msg ) const {
@@ -635,3 +651,60 @@ void hhEntityFx::Event_ClearFx( void ) {
 		}
 	}
 }
+
+/*
+================
+hhEntityFx::EnterPool
+
+Puts the fx to sleep instead of deleting it
+================
+*/
+void hhEntityFx::EnterPool() {
+	idEvent::CancelEvents( this );
+
+	Stop();
+	BecomeInactive( TH_ALL );
+	Unbind();
+	StopSound( SND_CHANNEL_ANY, false );
+	// our Hide only cleans up the actions
+	idEntity::Hide();
+
+	restartActive = false;
+}
+
+/*
+================
+hhEntityFx::LeavePool
+
+Sets the fx up the way idEntity::SpawnFxLocal and Spawn would for a new one
+================
+*/
+void hhEntityFx::LeavePool( const idVec3 &origin, const idMat3 &axis, const hhFxInfo &info ) {
+	spawnArgs.SetVector( "origin", origin );
+	spawnArgs.SetMatrix( "rotation", axis );
+	spawnArgs.SetBool( "onlyVisibleInSpirit", info.OnlyVisibleInSpirit() );
+	spawnArgs.SetBool( "onlyInvisibleInSpirit", info.OnlyInvisibleInSpirit() );
+	renderEntity.onlyVisibleInSpirit = info.OnlyVisibleInSpirit();
+	renderEntity.onlyInvisibleInSpirit = info.OnlyInvisibleInSpirit();
+
+	SetOrigin( origin );
+	SetAxis( axis );
+
+	fl.networkSync = !poolClient;
+	nextTriggerTime = 0;
+
+	SetFxInfo( info );
+	ProcessEvent( &EV_Activate, this );
+}
+
+/*
+================
+hhEntityFx::Event_Remove
+================
+*/
+void hhEntityFx::Event_Remove( void ) {
+	if ( returnToPool && gameLocal.entityPool.ReturnFx( this, poolClient ) ) {
+		return;
+	}
+	idEntityFx::Event_Remove();
+}
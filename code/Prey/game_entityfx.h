@@ -34,6 +34,11 @@ public:
 	void				SetParticleShaderParm( int parmnum, float value );
 	// HUMANHEAD END
 
+	// entity pool, see hhEntityPool
+	void				AllowPooling( bool client ) { returnToPool = true; poolClient = client; }
+	void				EnterPool();
+	void				LeavePool( const idVec3 &origin, const idMat3 &axis, const hhFxInfo &info );
+
 protected:
 	virtual void		CleanUpSingleAction( const idFXSingleAction& fxaction, idFXLocalAction& laction );
 	virtual void		DormantBegin();
@@ -42,6 +47,7 @@ protected:
 protected:
 	void				Event_Trigger( idEntity *activator );
 	void				Event_ClearFx( void );
+	void				Event_Remove( void );
 
 protected:
 	// HUMANHEAD nla
@@ -57,6 +63,9 @@ protected:
 	// HUMANHEAD bg
 	bool					restartActive;
 	// HUMANHEAD END
+
+	bool					returnToPool;	// one shot fx, goes back to the entity pool when removed
+	bool					poolClient;
 };
 
 #endif
\ No newline at end of file
@@ -729,6 +729,83 @@ bool hhMonsterAI::CanSee( idEntity *ent, bool useFov ) {
 	return false;
 }
 
+/*
+=====================
+hhMonsterAI::CanSeeList
+	Same tests as CanSee, with all the sight traces in one batch
+=====================
+*/
+void hhMonsterAI::CanSeeList( idEntity * const *ents, const int numEnts, bool useFov, bool *canSee ) {
+	cmBatchTrace_t	*traces;
+	trace_t			*results;
+	idEntity		**traceEnts;
+	int				*traceIndex;
+	idEntity		*ent;
+	idVec3			eye;
+	idVec3			toPos;
+	int				i, numTraces;
+
+	if ( numEnts <= 0 ) {
+		return;
+	}
+
+	traces = (cmBatchTrace_t *) _alloca16( numEnts * sizeof( traces[0] ) );
+	results = (trace_t *) _alloca16( numEnts * sizeof( results[0] ) );
+	traceEnts = (idEntity **) _alloca16( numEnts * sizeof( traceEnts[0] ) );
+	traceIndex = (int *) _alloca16( numEnts * sizeof( traceIndex[0] ) );
+
+	eye = GetEyePosition();
+
+	numTraces = 0;
+	for ( i = 0; i < numEnts; i++ ) {
+		canSee[i] = false;
+		ent = ents[i];
+
+		if ( ent->IsHidden() ) {
+			continue;
+		}
+
+		if ( ent->IsType( idActor::Type ) ) {
+			idActor *act = static_cast<idActor*>(ent);
+
+			// If this actor is in a vehicle, look at the vehicle, not the actor
+			if(act->InVehicle()) {
+				ent = act->GetVehicleInterface()->GetVehicle();
+			}
+		}
+
+		if ( ent->IsType( idActor::Type ) ) {
+			toPos = ( ( idActor * )ent )->GetEyePosition();
+		} else {
+			toPos = ent->GetPhysics()->GetOrigin();
+		}
+
+		if ( useFov && !CheckFOV( toPos ) ) {
+			continue;
+		}
+
+		traces[numTraces].start = eye;
+		traces[numTraces].end = toPos;
+		traces[numTraces].bounds.Zero();
+		traces[numTraces].contentMask = MASK_SHOT_BOUNDINGBOX;
+		traceEnts[numTraces] = ent;
+		traceIndex[numTraces] = i;
+		numTraces++;
+	}
+
+	if ( InVehicle() ) {
+		gameLocal.clip.TranslationBatch( results, traces, numTraces, GetVehicleInterface()->GetVehicle() );
+	} else {
+		gameLocal.clip.TranslationBatch( results, traces, numTraces, this );
+	}
+
+	for ( i = 0; i < numTraces; i++ ) {
+		if ( results[i].fraction >= 1.0f || ( gameLocal.GetTraceEntity( results[i] ) == traceEnts[i] ) ) {
+			canSee[traceIndex[i]] = true;
+		}
+	}
+}
+
 idPlayer* hhMonsterAI::GetClosestPlayer(void) {
 	idEntity *closestEnt = NULL;
 	float closestDist = idMath::INFINITY;	
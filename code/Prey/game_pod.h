@@ -15,6 +15,7 @@ public:
 	virtual bool	GetPhysicsToVisualTransform( idVec3 &origin, idMat3 &axis );
 	virtual void	Think( void );
 	virtual void	ClientPredictionThink( void );
+	virtual thinkBudget_t	DefaultThinkBudget( void ) const { return THINKBUDGET_LOW; }
 
 	virtual bool	Collide( const trace_t &collision, const idVec3 &velocity );
 	virtual void	Event_HoverTo( const idVec3 &position );
@@ -760,6 +760,7 @@ void hhVehicle::Save(idSaveGame *savefile) const {
 void hhVehicle::Restore( idRestoreGame *savefile ) {
 	savefile->ReadStaticObject(physicsObj);
 	RestorePhysics(&physicsObj);
+	physicsObj.SetStepTime( spawnArgs.GetInt( "physicsStepTime", g_vehicleStepTime.GetString() ) );
 
 	savefile->ReadMat3(modelAxis);
 
@@ -1047,6 +1048,9 @@ void hhVehicle::InitPhysics() {
 		spawnArgs.GetFloat("friction_linear"),
 		spawnArgs.GetFloat("friction_angular"),
 		spawnArgs.GetFloat("friction_contact") );
+
+	// fast vehicles step more often than the game to keep docking and collisions accurate
+	physicsObj.SetStepTime( spawnArgs.GetInt( "physicsStepTime", g_vehicleStepTime.GetString() ) );
 }
 
 void hhVehicle::SetConsolePhysics() {
@@ -4,6 +4,8 @@
 
 #include "prey_local.h"
 
+extern idVec3 vec3_boxEpsilon;	// Clip.cpp
+
 const idEventDef EV_SetGravityVector("setgravity", "v");
 const idEventDef EV_SetGravityFactor("setgravityfactor", "f");
 const idEventDef EV_DeactivateZone("<deactivatezone>", NULL);
@@ -41,6 +43,12 @@ void hhZone::Spawn(void) {
 	bActive = true;
 	bEnabled = true;
 #endif
+
+	gameLocal.zoneRegistry.AddZone(this);
+}
+
+hhZone::~hhZone() {
+	gameLocal.zoneRegistry.RemoveZone(this);
 }
 
 void hhZone::Save(idSaveGame *savefile) const {
@@ -63,6 +71,8 @@ void hhZone::Restore( idRestoreGame *savefile ) {
 	}
 
 	savefile->ReadFloat(slop);
+
+	gameLocal.zoneRegistry.AddZone(this);
 }
 
 bool hhZone::ValidEntity(idEntity *ent) {
@@ -119,21 +129,107 @@ void hhZone::TriggerAction(idEntity *activator) {
 	BecomeActive(TH_THINK);
 }
 
+int hhZone::EntitiesTouchingZone(idEntity **touch, int maxCount) {
+	idBounds clipBounds;
+	clipBounds.FromTransformedBounds( GetPhysics()->GetBounds(), GetOrigin(), GetAxis() );
+
+	if (isSimpleBox) {
+		return gameLocal.clip.EntitiesTouchingBounds( clipBounds.Expand(slop), MASK_SHOT_BOUNDINGBOX | CONTENTS_PROJECTILE | CONTENTS_TRIGGER, touch, maxCount ); // CONTENTS_TRIGGER for walkthrough movables
+	}
+	return hhUtils::EntitiesTouchingClipmodel( GetPhysics()->GetClipModel(), touch, maxCount, MASK_SHOT_BOUNDINGBOX | CONTENTS_TRIGGER );
+}
+
+// Same test as EntitiesTouchingZone for a single entity
+bool hhZone::Touches(idEntity *ent) {
+	idPhysics		*phys = ent->GetPhysics();
+	idClipModel		*zoneModel = GetPhysics()->GetClipModel();
+	idClipModel		*cm;
+	idBounds		bounds;
+	int				contentMask;
+
+	if (!phys || !zoneModel) {
+		return false;
+	}
+
+	if (isSimpleBox) {
+		bounds.FromTransformedBounds( GetPhysics()->GetBounds(), GetOrigin(), GetAxis() );
+		bounds.ExpandSelf(slop);
+		contentMask = MASK_SHOT_BOUNDINGBOX | CONTENTS_PROJECTILE | CONTENTS_TRIGGER;
+	}
+	else {
+		if (!phys->GetClipModel() || !phys->GetClipModel()->IsTraceModel()) {
+			return false;
+		}
+		bounds = zoneModel->GetAbsBounds();
+		contentMask = MASK_SHOT_BOUNDINGBOX | CONTENTS_TRIGGER;
+	}
+	bounds[0] -= vec3_boxEpsilon;
+	bounds[1] += vec3_boxEpsilon;
+
+	for (int i = 0; i < phys->GetNumClipModels(); i++) {
+		cm = phys->GetClipModel(i);
+		if (!cm || cm == zoneModel || !cm->IsLinked() || !cm->IsEnabled() || !(cm->GetContents() & contentMask)) {
+			continue;
+		}
+		if (!cm->GetAbsBounds().IntersectsBounds(bounds)) {
+			continue;
+		}
+		return isSimpleBox || phys->ClipContents(zoneModel) != 0;
+	}
+	return false;
+}
+
+void hhZone::UpdateTouch(int entityNumber) {
+	idEntity *ent = gameLocal.entities[entityNumber];
+	int index = touchList.FindIndex(entityNumber);
+
+	if (ent && ent != this && Touches(ent)) {
+		if (index == -1) {
+			touchList.Append(entityNumber);
+		}
+	}
+	else if (index != -1) {
+		touchList.RemoveIndex(index);
+	}
+}
+
+void hhZone::BuildTouchList() {
+	idEntity		*touch[ MAX_GENTITIES ];
+	int				num;
+
+	num = EntitiesTouchingZone(touch, MAX_GENTITIES);
+	touchList.SetNum(0, false);
+	for (int i = 0; i < num; i++) {
+		if (touch[i] != this) {
+			touchList.Append(touch[i]->entityNumber);
+		}
+	}
+}
+
 void hhZone::ApplyToEncroachers() {
 	idEntity		*touch[ MAX_GENTITIES ];
 	idEntity		*previouslyInZone;
 	idEntity		*encroacher;
 	int				i, num;
 
-	idBounds clipBounds;
-	clipBounds.FromTransformedBounds( GetPhysics()->GetBounds(), GetOrigin(), GetAxis() );
-
 	// Find all encroachers
-	if (isSimpleBox) {
-		num = gameLocal.clip.EntitiesTouchingBounds( clipBounds.Expand(slop), MASK_SHOT_BOUNDINGBOX | CONTENTS_PROJECTILE | CONTENTS_TRIGGER, touch, MAX_GENTITIES ); // CONTENTS_TRIGGER for walkthrough movables
+	if (g_zoneRegistry.GetBool()) {
+		// only the entities that moved since the last update are tested again, the rest
+		// are checked for clip models that were disabled or changed contents in place
+		gameLocal.zoneRegistry.Update();
+		num = 0;
+		for (i = 0; i < touchList.Num(); ) {
+			encroacher = gameLocal.entities[touchList[i]];
+			if (!encroacher || !Touches(encroacher)) {
+				touchList.RemoveIndex(i);
+				continue;
+			}
+			touch[num++] = encroacher;
+			i++;
+		}
 	}
 	else {
-		num = hhUtils::EntitiesTouchingClipmodel( GetPhysics()->GetClipModel(), touch, MAX_GENTITIES, MASK_SHOT_BOUNDINGBOX | CONTENTS_TRIGGER );
+		num = EntitiesTouchingZone(touch, MAX_GENTITIES);
 	}
 
 	// for anything previously applied, but no longer encroaching, call EntityLeaving()
@@ -186,6 +282,14 @@ void hhZone::Think() {
 	}
 }
 
+// Zones with something in them keep applying their effect every frame
+thinkBudget_t hhZone::GetThinkBudget( void ) {
+	if ( zoneList.Num() ) {
+		return THINKBUDGET_FULL;
+	}
+	return hhTrigger::GetThinkBudget();
+}
+
 void hhZone::Event_TurnOff() {
 	BecomeInactive(TH_THINK);
 	bActive = false;
@@ -368,7 +472,13 @@ bool hhGravityZoneBase::TouchingOtherZones(idEntity *ent, bool traceCheck, idVec
 
 	idEntity		*touch[ MAX_GENTITIES ];
 	clipBounds.FromTransformedBounds( ent->GetPhysics()->GetBounds(), ent->GetOrigin(), ent->GetAxis() );
-	int num = gameLocal.clip.EntitiesTouchingBounds( clipBounds, GetPhysics()->GetContents(), touch, MAX_GENTITIES );
+	int num;
+	if (g_zoneRegistry.GetBool()) {
+		num = gameLocal.zoneRegistry.ZonesTouchingBounds( clipBounds, GetPhysics()->GetContents(), touch, MAX_GENTITIES );
+	}
+	else {
+		num = gameLocal.clip.EntitiesTouchingBounds( clipBounds, GetPhysics()->GetContents(), touch, MAX_GENTITIES );
+	}
 	for (int i = 0; i < num; i++) {
 		if (touch[i] && touch[i]->entityNumber != entityNumber && touch[i]->IsType(hhGravityZoneBase::Type)) {
 			//touching the object, isn't me, and seems to be another gravity zone
@@ -1180,3 +1290,96 @@ void hhRemovalVolume::EntityEncroaching(idEntity *ent) {
 
 void hhRemovalVolume::EntityLeaving(idEntity *ent) {
 }
+
+
+//-----------------------------------------------------------------------
+//
+// hhZoneRegistry
+//
+// Zones used to search the clip world for encroachers every tick.  The
+// registry is told when an entity links or unlinks a clip model, and only
+// those entities are tested against the zones again.
+//-----------------------------------------------------------------------
+
+void hhZoneRegistry::Clear( void ) {
+	zones.Clear();
+	memset( moved, 0, sizeof( moved ) );
+	numMoved = 0;
+}
+
+void hhZoneRegistry::AddZone( hhZone *zone ) {
+	if ( zones.FindIndex( zone ) == -1 ) {
+		zones.Append( zone );
+	}
+	// the touch list is built on the next update
+	EntityMoved( zone->entityNumber );
+}
+
+void hhZoneRegistry::RemoveZone( hhZone *zone ) {
+	zones.Remove( zone );
+}
+
+void hhZoneRegistry::Update( void ) {
+	int i, j, k, bits, entityNumber;
+
+	// the touch lists may be stale after g_zoneRegistry was switched off, so start over
+	if ( g_zoneRegistry.IsModified() ) {
+		g_zoneRegistry.ClearModified();
+		memset( moved, 0, sizeof( moved ) );
+		numMoved = 0;
+		for ( i = 0; i < zones.Num(); i++ ) {
+			zones[i]->BuildTouchList();
+		}
+		return;
+	}
+
+	if ( !numMoved ) {
+		return;
+	}
+	numMoved = 0;
+
+	for ( i = 0; i < (int)( sizeof( moved ) / sizeof( moved[0] ) ); i++ ) {
+		if ( !moved[i] ) {
+			continue;
+		}
+		bits = moved[i];
+		moved[i] = 0;
+
+		for ( j = 0; j < 32; j++ ) {
+			if ( !( bits & ( 1 << j ) ) ) {
+				continue;
+			}
+			entityNumber = ( i << 5 ) + j;
+			for ( k = 0; k < zones.Num(); k++ ) {
+				if ( zones[k]->entityNumber == entityNumber ) {
+					zones[k]->BuildTouchList();
+				} else {
+					zones[k]->UpdateTouch( entityNumber );
+				}
+			}
+		}
+	}
+}
+
+// Same result as idClip::EntitiesTouchingBounds for the zones, which is all hhGravityZoneBase::TouchingOtherZones looks for
+int hhZoneRegistry::ZonesTouchingBounds( const idBounds &bounds, int contentMask, idEntity **entityList, int maxCount ) const {
+	idClipModel *cm;
+	idBounds expanded;
+	int i, num;
+
+	expanded[0] = bounds[0] - vec3_boxEpsilon;
+	expanded[1] = bounds[1] + vec3_boxEpsilon;
+
+	num = 0;
+	for ( i = 0; i < zones.Num() && num < maxCount; i++ ) {
+		cm = zones[i]->GetPhysics()->GetClipModel();
+		if ( !cm || !cm->IsLinked() || !cm->IsEnabled() || !( cm->GetContents() & contentMask ) ) {
+			continue;
+		}
+		if ( cm->GetAbsBounds().IntersectsBounds( expanded ) ) {
+			entityList[num++] = zones[i];
+		}
+	}
+
+	return num;
+}
@@ -8,12 +8,16 @@ class hhZone : public hhTrigger {
 public:
 	ABSTRACT_PROTOTYPE( hhZone );
 
+	virtual			~hhZone();
+
 	void			Spawn( void );
 	void			Save( idSaveGame *savefile ) const;
 	void			Restore( idRestoreGame *savefile );
 
 	virtual void	Think( void );
 	virtual void	Present( void ) { } // HUMANHEAD mdl:  Not used by zones
+	virtual thinkBudget_t	GetThinkBudget( void );
+	virtual thinkBudget_t	DefaultThinkBudget( void ) const { return THINKBUDGET_NORMAL; }
 
 	// hhTrigger interface
 	void			TriggerAction(idEntity *activator);
@@ -28,7 +32,14 @@ public:
 	virtual bool	ValidEntity(idEntity *ent);
 	virtual void	Empty();
 
+	// hhZoneRegistry interface
+	bool			Touches(idEntity *ent);
+	void			UpdateTouch(int entityNumber);
+	void			BuildTouchList();
+
 protected:
+	int				EntitiesTouchingZone(idEntity **touch, int maxCount);
+
 	void			Event_TurnOff();
 	void			Event_Enable( void );
 	void			Event_Disable( void );
@@ -36,6 +47,7 @@ protected:
 
 protected:
 	idList<int>		zoneList;		// List of valid entities in zone last frame
+	idList<int>		touchList;		// Entities touching the zone, kept by the zone registry, not saved
 	float			slop;
 };
 
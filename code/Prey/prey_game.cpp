@@ -99,6 +99,8 @@ void hhGameLocal::MapShutdown( void ) {
 	sunCorona			= NULL;
 
 	talonTargets.Clear();
+	zoneRegistry.Clear();
+	entityPool.Clear();
 }
 
 //---------------------------------------------------
@@ -115,6 +117,8 @@ void hhGameLocal::InitFromNewMap( const char *mapName, idRenderWorld *renderWorl
 	//HUMANHEAD END
 
 	talonTargets.Clear(); // CJR:  Must be before idGameLocal::InitFromNewMap()
+	zoneRegistry.Clear();
+	entityPool.Clear();
 
 #if INGAME_DEBUGGER_ENABLED
 	debugger.Reset();
@@ -262,6 +266,15 @@ void hhGameLocal::RegisterTalonTarget( idEntity *ent ) {
 	talonTargets.Append(ent);
 }
 
+//=============================================================================
+//
+// hhGameLocal::RenewSpawnId
+//
+//=============================================================================
+void hhGameLocal::RenewSpawnId( idEntity *ent ) {
+	spawnIds[ ent->entityNumber ] = spawnCount++;
+}
+
 //=============================================================================
 //
 // hhGameLocal::SpawnClientObject
@@ -676,6 +689,7 @@ gameReturn_t hhGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 	// HUMANHEAD pdm
 	idTimer		timer_singledormant;
 	bool		dormant;
+	bool		thought;
 	const float thinkalpha = 0.98f;	// filter with historical timings
 	// HUMANHEAD END
 
@@ -762,13 +776,25 @@ gameReturn_t hhGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 		// sort the active entity list
 		SortActiveEntityList();
 
+		// set the physics level of detail of articulated figures and rigid bodies
+		UpdatePhysicsLOD();
+
+		// let entities out of view or far away think less often
+		UpdateThinkLOD();
+
+		// solve independent articulated figures in parallel
+		RunPhysicsIslands();
+
 		timer_think.Clear();
 		timer_think.Start();
 		PROFILE_START("Misc_Think", PROFMASK_NORMAL);	// HUMANHEAD pdm
 
 		// HUMANHEAD pdm: This loop reworked to support debugger and dormant timings
 		// let entities think
-		if ( g_timeentities.GetFloat() || g_debugger.GetInteger() || g_dormanttests.GetBool()) {
+		if ( g_timeentities.GetFloat() || g_debugger.GetInteger() || g_dormanttests.GetBool() || g_timeEntityClasses.GetBool() ) {
+			if ( g_timeEntityClasses.GetBool() ) {
+				thinkCostFrames++;
+			}
 			num = 0;
 			for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
 				if ( g_cinematic.GetBool() && inCinematic && !ent->cinematic ) {
@@ -784,9 +810,10 @@ gameReturn_t hhGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 				}
 
 				timer_singlethink.Clear();
+				thought = false;
 				if( !dormant ) {
 					timer_singlethink.Start();
-					ent->Think();
+					thought = ThinkEntity( ent );
 					timer_singlethink.Stop();
 				}
 
@@ -794,6 +821,9 @@ gameReturn_t hhGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 				if ( g_timeentities.GetFloat() && ms >= g_timeentities.GetFloat() ) {
 					gameLocal.Printf( "%d: entity '%s': %.1f ms\n", time, ent->name.c_str(), ms );
 				}
+				if ( g_timeEntityClasses.GetBool() && !dormant ) {
+					AddThinkCost( ent, thought, ms );
+				}
 				if (g_debugger.GetInteger() || g_dormanttests.GetBool()) {
 					ent->thinkMS = ent->thinkMS*thinkalpha + (1.0-thinkalpha)*ms;
 				}
@@ -819,7 +849,7 @@ gameReturn_t hhGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 					}
 					// HUMANHEAD JRM
 					if( !ent->CheckDormant() ) {
-						ent->Think();
+						ThinkEntity( ent );
 					}
 					num++;
 				}
@@ -828,7 +858,7 @@ gameReturn_t hhGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 				for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
 					// HUMANHEAD JRM
 					if( !ent->CheckDormant() ) {
-						ent->Think();
+						ThinkEntity( ent );
 					}
 					num++;
 				}
@@ -1436,3 +1466,267 @@ bool hhGameLocal::SetTip(idUserInterface* gui, const char *binding, const char *
 	return (keyMaterial.Length() > 0);
 }
 
+
+//=============================================================================
+//
+// hhEntityPool::Clear
+//
+//=============================================================================
+void hhEntityPool::Clear( void ) {
+	pools.Clear();
+	poolHash.Free();
+}
+
+//=============================================================================
+//
+// hhEntityPool::IsEnabled
+//
+//=============================================================================
+bool hhEntityPool::IsEnabled( void ) {
+	return g_entityPool.GetBool() && g_entityPoolSize.GetInteger() > 0 && !gameLocal.isMultiplayer;
+}
+
+//=============================================================================
+//
+// hhEntityPool::CanPoolProjectile
+//
+// Only projectiles spawned straight from their entityDef can be handed out
+// again, a modified copy of the def may have changed any key.
+//=============================================================================
+bool hhEntityPool::CanPoolProjectile( const idDict *args ) {
+	if ( !IsEnabled() || !args ) {
+		return false;
+	}
+	const idDeclEntityDef *def = gameLocal.FindEntityDef( args->GetString( "classname" ), false );
+	return def && &def->dict == args;
+}
+
+//=============================================================================
+//
+// hhEntityPool::CanPoolFx
+//
+// Only fx that start right away, remove themselves when done and aren't bound
+// to anything.
+//=============================================================================
+bool hhEntityPool::CanPoolFx( const hhFxInfo *fxInfo ) {
+	if ( !IsEnabled() || !fxInfo ) {
+		return false;
+	}
+	return fxInfo->StartIsSet() && fxInfo->RemoveWhenDone() && !fxInfo->EntityIsSet() && !fxInfo->Toggle() && !fxInfo->Triggered();
+}
+
+//=============================================================================
+//
+// hhEntityPool::TakeProjectile
+//
+//=============================================================================
+hhProjectile *hhEntityPool::TakeProjectile( const idDict *args, bool client ) {
+	if ( !CanPoolProjectile( args ) ) {
+		return NULL;
+	}
+	idEntity *ent = Take( FindPool( args->GetString( "classname" ), false, client ) );
+	if ( !ent ) {
+		return NULL;
+	}
+	assert( ent->IsType( hhProjectile::Type ) );
+	return static_cast<hhProjectile *>( ent );
+}
+
+//=============================================================================
+//
+// hhEntityPool::TakeFx
+//
+//=============================================================================
+hhEntityFx *hhEntityPool::TakeFx( const char *fxName, bool client ) {
+	if ( !IsEnabled() || !fxName || !fxName[0] ) {
+		return NULL;
+	}
+	idEntity *ent = Take( FindPool( fxName, true, client ) );
+	if ( !ent ) {
+		return NULL;
+	}
+	assert( ent->IsType( hhEntityFx::Type ) );
+	return static_cast<hhEntityFx *>( ent );
+}
+
+//=============================================================================
+//
+// hhEntityPool::ReturnProjectile
+//
+//=============================================================================
+bool hhEntityPool::ReturnProjectile( hhProjectile *projectile, bool client ) {
+	if ( !IsEnabled() || !projectile->IsPoolable() ) {
+		return false;
+	}
+	int poolNum = FindPool( projectile->spawnArgs.GetString( "classname" ), false, client );
+	if ( !HasRoom( poolNum ) ) {
+		return false;
+	}
+	projectile->EnterPool();
+	Park( poolNum, projectile );
+	return true;
+}
+
+//=============================================================================
+//
+// hhEntityPool::ReturnFx
+//
+//=============================================================================
+bool hhEntityPool::ReturnFx( hhEntityFx *fx, bool client ) {
+	if ( !IsEnabled() || fx->scriptHandle ) {
+		return false;
+	}
+	int poolNum = FindPool( fx->spawnArgs.GetString( "fx" ), true, client );
+	if ( !HasRoom( poolNum ) ) {
+		return false;
+	}
+	fx->EnterPool();
+	Park( poolNum, fx );
+	return true;
+}
+
+//=============================================================================
+//
+// hhEntityPool::RestoreEntity
+//
+//=============================================================================
+void hhEntityPool::RestoreEntity( idEntity *ent, const char *name, bool fx, bool client ) {
+	idEntityPtr<idEntity> ptr;
+
+	ptr = ent;
+	pools[ FindPool( name, fx, client ) ].entities.Append( ptr );
+}
+
+//=============================================================================
+//
+// hhEntityPool::FindPool
+//
+//=============================================================================
+int hhEntityPool::FindPool( const char *name, bool fx, bool client ) {
+	int i, hash;
+
+	hash = poolHash.GenerateKey( name, false );
+	for ( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) ) {
+		if ( pools[ i ].fx == fx && pools[ i ].client == client && !pools[ i ].name.Icmp( name ) ) {
+			return i;
+		}
+	}
+
+	entityPool_t &pool = pools.Alloc();
+	pool.name = name;
+	pool.fx = fx;
+	pool.client = client;
+	pool.entities.Clear();
+	pool.hits = 0;
+	pool.misses = 0;
+	pool.returned = 0;
+	pool.discarded = 0;
+
+	i = pools.Num() - 1;
+	poolHash.Add( hash, i );
+	return i;
+}
+
+//=============================================================================
+//
+// hhEntityPool::Take
+//
+//=============================================================================
+idEntity *hhEntityPool::Take( int poolNum ) {
+	entityPool_t &pool = pools[ poolNum ];
+	idEntity *ent;
+
+	while ( pool.entities.Num() ) {
+		ent = pool.entities[ pool.entities.Num() - 1 ].GetEntity();
+		pool.entities.RemoveIndex( pool.entities.Num() - 1 );
+		// parked entities can still be deleted by the map or a script
+		if ( !ent ) {
+			continue;
+		}
+		ent->inEntityPool = false;
+		// a script got hold of it while it was parked, so it has to go for real
+		if ( ent->scriptHandle ) {
+			ent->PostEventMS( &EV_Remove, 0 );
+			continue;
+		}
+		pool.hits++;
+		return ent;
+	}
+
+	pool.misses++;
+	return NULL;
+}
+
+//=============================================================================
+//
+// hhEntityPool::HasRoom
+//
+//=============================================================================
+bool hhEntityPool::HasRoom( int poolNum ) {
+	entityPool_t &pool = pools[ poolNum ];
+
+	if ( pool.entities.Num() >= g_entityPoolSize.GetInteger() ) {
+		pool.discarded++;
+		return false;
+	}
+	return true;
+}
+
+//=============================================================================
+//
+// hhEntityPool::Park
+//
+//=============================================================================
+void hhEntityPool::Park( int poolNum, idEntity *ent ) {
+	idEntityPtr<idEntity> ptr;
+
+	// pointers to the removed entity shouldn't see it come back
+	gameLocal.RenewSpawnId( ent );
+	ent->inEntityPool = true;
+
+	ptr = ent;
+	pools[ poolNum ].entities.Append( ptr );
+	pools[ poolNum ].returned++;
+}
+
+//=============================================================================
+//
+// hhEntityPool::ListPools
+//
+//=============================================================================
+void hhEntityPool::ListPools( void ) const {
+	int i, hits, misses;
+
+	if ( !pools.Num() ) {
+		gameLocal.Printf( "no entity pools%s\n", IsEnabled() ? "" : ", g_entityPool is off" );
+		return;
+	}
+
+	hits = 0;
+	misses = 0;
+	gameLocal.Printf( "%6s %8s %8s %8s %8s %6s  %s\n", "parked", "hits", "misses", "returned", "deleted", "hit %", "name" );
+	gameLocal.Printf( "----------------------------------------------------------------------\n" );
+	for ( i = 0; i < pools.Num(); i++ ) {
+		const entityPool_t &pool = pools[ i ];
+		gameLocal.Printf( "%6d %8d %8d %8d %8d %5.1f%%  %s%s%s\n", pool.entities.Num(), pool.hits, pool.misses, pool.returned, pool.discarded,
+			( pool.hits + pool.misses ) ? 100.0f * pool.hits / ( pool.hits + pool.misses ) : 0.0f,
+			pool.fx ? "fx " : "", pool.name.c_str(), pool.client ? " (client)" : "" );
+		hits += pool.hits;
+		misses += pool.misses;
+	}
+	gameLocal.Printf( "%d pools, %d spawns avoided, %d spawned\n", pools.Num(), hits, misses );
+}
+
+//=============================================================================
+//
+// hhEntityPool::ClearStats
+//
+//=============================================================================
+void hhEntityPool::ClearStats( void ) {
+	for ( int i = 0; i < pools.Num(); i++ ) {
+		pools[ i ].hits = 0;
+		pools[ i ].misses = 0;
+		pools[ i ].returned = 0;
+		pools[ i ].discarded = 0;
+	}
+}
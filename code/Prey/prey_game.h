@@ -5,6 +5,10 @@ class hhReactionHandler;
 class hhSunCorona; // CJR
 class hhHand;
 class hhAIInspector;
+class hhZone;
+class hhProjectile;
+class hhEntityFx;
+class hhFxInfo;
 
 #ifdef GAME_DLL
 extern idCVar com_forceGenericSIMD;
@@ -14,6 +18,98 @@ extern idCVar com_forceGenericSIMD;
 extern const int DECL_MAX_TYPES_NUM_BITS; 
 //HUMANHEAD END
 
+/*
+===============================================================================
+
+	hhZoneRegistry
+
+	Keeps the list of entities touching each zone up to date from the clip model
+	links, so zones don't have to search the clip world every frame.
+
+===============================================================================
+*/
+
+class hhZoneRegistry {
+public:
+	void					Clear( void );
+	void					AddZone( hhZone *zone );
+	void					RemoveZone( hhZone *zone );
+	bool					IsRegistered( const hhZone *zone ) const { return zones.FindIndex( const_cast<hhZone *>( zone ) ) >= 0; }
+
+							// called when a clip model of the entity is linked or unlinked
+	void					EntityMoved( int entityNumber );
+							// updates the touch lists of all zones for the entities that moved
+	void					Update( void );
+
+	int						ZonesTouchingBounds( const idBounds &bounds, int contentMask, idEntity **entityList, int maxCount ) const;
+
+private:
+	idList<hhZone *>		zones;
+	int						moved[ ( MAX_GENTITIES + MAX_CENTITIES + 31 ) >> 5 ];
+	int						numMoved;
+};
+
+ID_INLINE void hhZoneRegistry::EntityMoved( int entityNumber ) {
+	if ( zones.Num() && entityNumber >= 0 && entityNumber < MAX_GENTITIES + MAX_CENTITIES ) {
+		moved[ entityNumber >> 5 ] |= 1 << ( entityNumber & 31 );
+		numMoved++;
+	}
+}
+
+/*
+===============================================================================
+
+	hhEntityPool
+
+	Projectiles and one shot fx are parked here when they are removed and handed
+	out again the next time the same entityDef or fx is spawned, so rapid fire
+	weapons don't spawn and delete entities for every shot.  Single player only,
+	clients expect every networked entity to be spawned and removed.
+
+===============================================================================
+*/
+
+class hhEntityPool {
+public:
+	void					Clear( void );
+
+	static bool				IsEnabled( void );
+	static bool				CanPoolProjectile( const idDict *args );
+	static bool				CanPoolFx( const hhFxInfo *fxInfo );
+
+							// NULL when nothing is parked, the caller spawns a new entity then
+	hhProjectile *			TakeProjectile( const idDict *args, bool client );
+	hhEntityFx *			TakeFx( const char *fxName, bool client );
+							// false when the pool is full, the caller deletes the entity then
+	bool					ReturnProjectile( hhProjectile *projectile, bool client );
+	bool					ReturnFx( hhEntityFx *fx, bool client );
+							// puts an entity that was parked when the game was saved back in its pool
+	void					RestoreEntity( idEntity *ent, const char *name, bool fx, bool client );
+
+	void					ListPools( void ) const;
+	void					ClearStats( void );
+
+private:
+	typedef struct entityPool_s {
+		idStr				name;
+		bool				fx;
+		bool				client;
+		idList< idEntityPtr<idEntity> > entities;
+		int					hits;
+		int					misses;
+		int					returned;
+		int					discarded;
+	} entityPool_t;
+
+	idList<entityPool_t>	pools;
+	idHashIndex				poolHash;
+
+	int						FindPool( const char *name, bool fx, bool client );
+	idEntity *				Take( int poolNum );
+	bool					HasRoom( int poolNum );
+	void					Park( int poolNum, idEntity *ent );
+};
+
 class hhGameLocal : public idGameLocal {
 public:
 	virtual void			Init( void );
@@ -41,6 +137,8 @@ public:
 	void					SetSunCorona( hhSunCorona *ent ) { sunCorona = ent; } // CJR
 	hhSunCorona *			GetSunCorona( void ) { return sunCorona; } // CJR
 	idEntity *				FindEntityOfType(const idTypeInfo &type, idEntity *last);
+							// entity pointers to the entity no longer resolve, for entities that are recycled instead of deleted
+	void					RenewSpawnId( idEntity *ent );
 
 	// nla
 	idDict &				GetSpawnArgs()	{ return( spawnArgs ); };	
@@ -82,6 +180,9 @@ public:
 	idList<idEntity*>		talonTargets;
 	float					lastAIAlertRadius;
 
+	hhZoneRegistry			zoneRegistry;
+	hhEntityPool			entityPool;
+
 	idList< idEntityPtr< hhHand > > hands;
 
 	idEntityPtr<hhAIInspector>		inspector;
@@ -62,6 +62,8 @@ CLASS_DECLARATION( idProjectile, hhProjectile )
 
 	EVENT( EV_Collision_Remove,				hhProjectile::Event_Collision_Remove )
 
+	EVENT( EV_Remove,						hhProjectile::Event_Remove )
+
 	EVENT( EV_AllowCollision_Flesh,			hhProjectile::Event_AllowCollision_Collide )
 	EVENT( EV_AllowCollision_Metal,			hhProjectile::Event_AllowCollision_CollideNoProj )
 	EVENT( EV_AllowCollision_AltMetal,		hhProjectile::Event_AllowCollision_Collide )
@@ -95,6 +97,9 @@ void hhProjectile::Spawn() {
 
 	weaponNum = -1; // cjr - default the weapon index to -1, to denote non-player weapons
 
+	bPooled = false;
+	bPoolClient = false;
+
 	netSyncPhysics = spawnArgs.GetBool( "net_fullphysics" ); //HUMANHEAD rww
 	bNoCollideWithCrawlers = spawnArgs.GetBool( "noCollideWithCrawlers", "0" );
 	bProjCollide = spawnArgs.GetBool( "proj_collision", "0" );
@@ -908,12 +913,22 @@ hhProjectile* hhProjectile::SpawnProjectile( const idDict* args ) {//FIXME: Broa
 	assert( args );
 	assert(!gameLocal.isClient);
 
+	hhProjectile* projectile = gameLocal.entityPool.TakeProjectile( args, false );
+	if( projectile ) {
+		projectile->LeavePool();
+		return projectile;
+	}
+
 	idEntity* ent = NULL;
 
 	gameLocal.SpawnEntityDef( *args, &ent );
 	HH_ASSERT( ent && ent->IsType(hhProjectile::Type) );
 
-	return static_cast<hhProjectile*>(ent);
+	projectile = static_cast<hhProjectile*>(ent);
+	projectile->bPooled = hhEntityPool::CanPoolProjectile( args );
+	projectile->bPoolClient = false;
+
+	return projectile;
 }
 
 /*
@@ -926,15 +941,137 @@ HUMANHEAD: rww
 hhProjectile* hhProjectile::SpawnClientProjectile( const idDict* args ) {//FIXME: Broadcast
 	assert( args );
 
-	idEntity* ent = NULL;
+	hhProjectile* projectile = NULL;
+	if( !gameLocal.isClient ) {
+		projectile = gameLocal.entityPool.TakeProjectile( args, true );
+	}
+	if( projectile ) {
+		projectile->LeavePool();
+	} else {
+		idEntity* ent = NULL;
 
-	gameLocal.SpawnEntityDef( *args, &ent, true, gameLocal.isClient );
-	HH_ASSERT( ent && ent->IsType(hhProjectile::Type) );
+		gameLocal.SpawnEntityDef( *args, &ent, true, gameLocal.isClient );
+		HH_ASSERT( ent && ent->IsType(hhProjectile::Type) );
+
+		projectile = static_cast<hhProjectile*>(ent);
+		projectile->bPooled = !gameLocal.isClient && hhEntityPool::CanPoolProjectile( args );
+		projectile->bPoolClient = true;
+	}
+
+	projectile->fl.networkSync = false;
+	projectile->fl.clientEvents = true;
+
+	return projectile;
+}
+
+/*
+================
+hhProjectile::IsPoolable
+
+Subclasses keep state of their own, so a class only goes back to the pool when
+ResetsForPool says its LeavePool resets that state.  Projectiles a script may
+still hold are deleted, so the script sees them go away.
+================
+*/
+bool hhProjectile::IsPoolable() const {
+	if( !bPooled || scriptHandle || !ResetsForPool() ) {
+		return false;
+	}
+	return !spawnArgs.GetString( "def_driver" )[0] && spawnArgs.GetBool( "pooled", "1" );
+}
+
+/*
+================
+hhProjectile::EnterPool
+
+Puts the projectile to sleep instead of deleting it
+================
+*/
+void hhProjectile::EnterPool() {
+	idEvent::CancelEvents( this );
+
+	StopSound( SND_CHANNEL_ANY, false );
+	SAFE_REMOVE( fxFly );
+	RemoveBinds();
+	Unbind();
+	FreeLightDef();
+
+	fl.takedamage = false;
+	physicsObj.SetContents( 0 );
+	physicsObj.SetClipMask( 0 );
+	physicsObj.GetClipModel()->Unlink();
+	physicsObj.PutToRest();
 
-	ent->fl.networkSync = false;
-	ent->fl.clientEvents = true;
+	Hide();
+	BecomeInactive( TH_ALL );
 
-	return static_cast<hhProjectile*>(ent);
+	owner = NULL;
+	parentProjectile = NULL;
+	collidedPortal = NULL;
+}
+
+/*
+================
+hhProjectile::LeavePool
+
+Resets what the constructors and Spawn set up, Create and Launch take it from there
+================
+*/
+void hhProjectile::LeavePool() {
+	// keys set by whoever fired it last, like "weapontype", go away
+	const idDeclEntityDef *def = gameLocal.FindEntityDef( spawnArgs.GetString( "classname" ), false );
+	if( def ) {
+		spawnArgs = def->dict;
+		FixupLocalizedStrings();
+	}
+
+	owner = NULL;
+	thrust = 0.0f;
+	thrust_start = 0;
+	thrust_end = 0;
+	damagePower = 1.0f;
+	memset( &projectileFlags, 0, sizeof( projectileFlags ) );
+	lightOffset = vec3_zero;
+	lightStartTime = 0;
+	lightEndTime = 0;
+	lightColor = vec3_zero;
+	state = SPAWNED;
+
+	bDDACounted = false;
+	parentProjectile = NULL;
+	launchTimestamp = 0;
+	weaponNum = -1;
+	collidedPortal = NULL;
+	collideLocation = vec3_origin;
+	collideVelocity = vec3_origin;
+	bPlayFlyBySound = ( flyBySoundDistSq > 0 );
+
+	health = spawnArgs.GetInt( "health" );
+	fl.takedamage = false;
+
+	// Launch copies this clip model, disabled state included
+	physicsObj.GetClipModel()->Enable();
+
+	// shader parms and skin set by the last owner, like the droid's charge shot, go away
+	renderEntity_t spawnRenderEntity;
+	gameEdit->ParseSpawnArgsToRenderEntity( &spawnArgs, &spawnRenderEntity );
+	memcpy( renderEntity.shaderParms, spawnRenderEntity.shaderParms, sizeof( renderEntity.shaderParms ) );
+	SetSkin( spawnRenderEntity.customSkin );
+
+	Show();
+	BecomeActive( TH_TICKER );
+}
+
+/*
+================
+hhProjectile::Event_Remove
+================
+*/
+void hhProjectile::Event_Remove() {
+	if( bPooled && gameLocal.entityPool.ReturnProjectile(this, bPoolClient) ) {
+		return;
+	}
+	idProjectile::Event_Remove();
 }
 
 /*
@@ -1409,6 +1546,9 @@ void hhProjectile::Save( idSaveGame *savefile ) const {
 	collidedPortal.Save( savefile );
 	savefile->WriteVec3( collideLocation );
 	savefile->WriteVec3( collideVelocity );
+
+	savefile->WriteBool( bPooled );
+	savefile->WriteBool( bPoolClient );
 }
 
 //================
@@ -1431,6 +1571,17 @@ void hhProjectile::Restore( idRestoreGame *savefile ) {
 	collidedPortal.Restore( savefile );
 	savefile->ReadVec3( collideLocation );
 	savefile->ReadVec3( collideVelocity );
+
+	if( savefile->GetBuildNumber() < ENTITY_POOL_BUILD_NUMBER ) {
+		bPooled = false;
+		bPoolClient = false;
+	} else {
+		savefile->ReadBool( bPooled );
+		savefile->ReadBool( bPoolClient );
+	}
+	if( inEntityPool ) {
+		gameLocal.entityPool.RestoreEntity( this, spawnArgs.GetString("classname"), false, bPoolClient );
+	}
 }
 
 /*
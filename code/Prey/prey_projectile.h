@@ -89,6 +89,12 @@ class hhProjectile : public idProjectile {
 		static hhProjectile*	SpawnProjectile( const idDict* args );
 		static hhProjectile*	SpawnClientProjectile( const idDict* args );
 
+		// entity pool, see hhEntityPool
+		bool					IsPoolable() const;
+		void					EnterPool();
+		virtual void			LeavePool();
+		virtual bool			ResetsForPool() const { return GetType() == &hhProjectile::Type; }	// subclasses opt in once their LeavePool resets their own state
+
 		void					Save( idSaveGame *savefile ) const;
 		void					Restore( idRestoreGame *savefile );
 
@@ -150,6 +156,8 @@ class hhProjectile : public idProjectile {
 		void					Event_SpawnDriverLocal( const char* defName );
 		void					Event_SpawnFxFlyLocal( const char* defName );
 
+		void					Event_Remove();
+
 
 	protected:
 		idEntityPtr<hhAnimDriven> driver;
@@ -171,6 +179,9 @@ class hhProjectile : public idProjectile {
 		idEntityPtr<hhPortal>	collidedPortal;	// cjr:  This projectile struck a portal, so it should get portalled before thinking
 		idVec3					collideLocation; // cjr: This projectile struck a portal, so it should get portalled before thinking
 		idVec3					collideVelocity; // cjr: This projectile struck a portal, so it should get portalled before thinking
+
+		bool					bPooled;		// spawned straight from its entityDef, goes back to the entity pool when removed
+		bool					bPoolClient;	// spawned with SpawnClientProjectile
 };
 
 #endif
\ No newline at end of file
@@ -3,6 +3,10 @@
 
 class hhProjectileAutoCannonGrenade : public hhProjectile {
 	CLASS_PROTOTYPE( hhProjectileAutoCannonGrenade )
+
+	public:
+		// no state of its own, hhProjectile::LeavePool resets everything
+		virtual bool	ResetsForPool() const { return GetType() == &hhProjectileAutoCannonGrenade::Type; }
 };
 
 #endif
\ No newline at end of file
@@ -32,6 +32,19 @@ void hhProjectileRifleSniper::Spawn() {
 	maxPassThroughs = hhMath::hhMax<float>( 1.0f, spawnArgs.GetFloat("maxPassThroughs") );
 }
 
+/*
+=================
+hhProjectileRifleSniper::LeavePool
+=================
+*/
+void hhProjectileRifleSniper::LeavePool() {
+	hhProjectile::LeavePool();
+
+	numPassThroughs = 0.0f;
+	maxPassThroughs = hhMath::hhMax<float>( 1.0f, spawnArgs.GetFloat("maxPassThroughs") );
+	lastDamagedEntity = NULL;
+}
+
 /*
 =================
 hhProjectileRifleSniper::Event_AllowCollision_PassThru
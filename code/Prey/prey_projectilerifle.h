@@ -16,6 +16,9 @@ class hhProjectileRifleSniper : public hhProjectile {
 		void					Spawn();
 		virtual void			Think();
 
+		virtual void			LeavePool();
+		virtual bool			ResetsForPool() const { return GetType() == &hhProjectileRifleSniper::Type; }
+
 		void					Save( idSaveGame *savefile ) const;
 		void					Restore( idRestoreGame *savefile );
 
@@ -63,6 +63,21 @@ void hhProjectileTracking::Spawn() {
 	}
 }
 
+/*
+================
+hhProjectileTracking::LeavePool
+================
+*/
+void hhProjectileTracking::LeavePool() {
+	hhProjectile::LeavePool();
+
+	enemy = NULL;
+	angularVelocity.Zero();
+	velocity.Zero();
+	spinAngle = 0.0f;
+	turnFactor = spawnArgs.GetFloat("turnfactor");	// Event_TrackTarget accelerates it
+}
+
 /*
 ================
 hhProjectileTracking::IsEnemyValid
@@ -12,6 +12,8 @@ class hhProjectileTracking: public hhProjectile {
 	public:
 		hhProjectileTracking();
 		void			Spawn();
+		virtual void	LeavePool();
+		virtual bool	ResetsForPool() const { return GetType() == &hhProjectileTracking::Type; }
 		virtual void	Launch( const idVec3 &start, const idMat3 &axis, const idVec3 &pushVelocity, const float timeSinceFire = 0.0f, const float launchPower = 1.0f, const float dmgPower = 1.0f );
 		virtual void	Explode( const trace_t *collision, const idVec3& velocity, int removeDelay );
 
@@ -74,6 +74,7 @@ hhThread::PushEntity
 void hhThread::PushEntity( const idEntity *ent ) {
 	HH_ASSERT( ent );
 
+	const_cast<idEntity *>( ent )->scriptHandle = true;
 	PushParm( ent->entityNumber + 1 );
 }
 
@@ -201,6 +201,9 @@ void			Sys_LeaveCriticalSection( int index ) {}
 void			Sys_WaitForEvent( int index ) {}
 void			Sys_TriggerEvent( int index ) {}
 
+void			Sys_WaitForJobSignal( int index ) {}
+void			Sys_RaiseJobSignal( int index, int count ) {}
+
 /*
 ==============
 idSysLocal stub
@@ -237,6 +240,8 @@ sysEvent_t		idSysLocal::GenerateMouseMoveEvent( int deltax, int deltay ) { sysEv
 void			idSysLocal::OpenURL( const char *url, bool quit ) { }
 void			idSysLocal::StartProcess( const char *exeName, bool quit ) { }
 
+void			idSysLocal::RunJobs( sysJob_t job, void **jobData, int numJobs, int numThreads ) { for ( int i = 0; i < numJobs; i++ ) { job( jobData[i] ); } }
+
 void			idSysLocal::FPU_EnableExceptions( int exceptions ) { }
 
 idSysLocal		sysLocal;
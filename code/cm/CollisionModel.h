@@ -20,6 +20,17 @@
 	A translation with start == end or a rotation with angle == 0 performs
 	a position test and fills in the trace_t structure accordingly.
 
+	All per trace state lives in a trace context. The main thread always uses
+	CM_MAIN_TRACE_CONTEXT. Other threads allocate a context of their own from
+	the main thread and pass it to every trace they do. Two threads may never
+	use the same context at the same time. Loading and freeing maps, and
+	allocating contexts, must not overlap with traces.
+
+	Many short point or box traces through the same model can be done with a
+	single TranslationBatch call. The traces share the walk down the model's
+	node tree and only test the nodes they touch, the results are the same as
+	for separate translations.
+
 ===============================================================================
 */
 
@@ -55,10 +66,30 @@ typedef struct trace_s {
 
 typedef int cmHandle_t;
 
+// single trace in a batch of translations
+typedef struct {
+	idVec3					start;			// trace start
+	idVec3					end;			// trace end
+	idBounds				bounds;			// axial box relative to start and end, zero sized for a point trace
+	int						contentMask;	// contents to collide with
+} cmBatchTrace_t;
+
+// polygon of a model returned by GetModelPolygons
+typedef struct {
+	idPlane					plane;			// polygon plane
+	const idMaterial *		material;		// surface material
+	int						contents;		// contents behind polygon
+	int						firstPoint;		// first point of the winding in the point list
+	int						numPoints;		// number of points in the winding
+} cmPolygon_t;
+
 #define CM_CLIP_EPSILON		0.25f			// always stay this distance away from any model
 #define CM_BOX_EPSILON		1.0f			// should always be larger than clip epsilon
 #define CM_MAX_TRACE_DIST	4096.0f			// maximum distance a trace model may be traced, point traces are unlimited
 
+#define CM_MAX_TRACE_CONTEXTS	4			// maximum number of threads that can trace at the same time
+#define CM_MAIN_TRACE_CONTEXT	0			// trace context of the main thread
+
 //HUMANHEAD rww
 #if _HH_INLINED_PROC_CLIPMODELS
 #define PROC_CLIPMODEL_INDEX_START		1
@@ -88,7 +119,8 @@ public:
 	// Gets the clip handle for a model.
 	virtual cmHandle_t		LoadModel( const char *modelName, const bool precache ) = 0;
 	// Sets up a trace model for collision with other trace models.
-	virtual cmHandle_t		SetupTrmModel( const idTraceModel &trm, const idMaterial *material ) = 0;
+	// Each trace context has its own trace model slot.
+	virtual cmHandle_t		SetupTrmModel( const idTraceModel &trm, const idMaterial *material, int traceContext = CM_MAIN_TRACE_CONTEXT ) = 0;
 	// Creates a trace model from a collision model, returns true if succesfull.
 	virtual bool			TrmFromModel( const char *modelName, idTraceModel &trm ) = 0;
 
@@ -104,23 +136,39 @@ public:
 	virtual bool			GetModelEdge( cmHandle_t model, int edgeNum, idVec3 &start, idVec3 &end ) const = 0;
 	// Gets a polygon of a model.
 	virtual bool			GetModelPolygon( cmHandle_t model, int polygonNum, idFixedWinding &winding ) const = 0;
+	// Gets the polygons of a model touching the bounds in model space, returns -1 if they don't fit.
+	virtual int				GetModelPolygons( cmHandle_t model, const idBounds &bounds, int contentMask,
+								cmPolygon_t *polygons, const int maxPolygons, idVec3 *points, const int maxPoints ) = 0;
+
+	// Reserves a trace context for a worker thread, returns -1 if all contexts are in use.
+	virtual int				AllocTraceContext( void ) = 0;
+	// Releases a trace context reserved with AllocTraceContext.
+	virtual void			FreeTraceContext( int traceContext ) = 0;
 
 	// Translates a trace model and reports the first collision if any.
 	virtual void			Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+								int traceContext = CM_MAIN_TRACE_CONTEXT ) = 0;
+	// Translates a batch of points and axial boxes through a model, stores one result per trace.
+	virtual void			TranslationBatch( trace_t *results, const cmBatchTrace_t *traces, const int numTraces,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+								int traceContext = CM_MAIN_TRACE_CONTEXT ) = 0;
 	// Rotates a trace model and reports the first collision if any.
 	virtual void			Rotation( trace_t *results, const idVec3 &start, const idRotation &rotation,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+								int traceContext = CM_MAIN_TRACE_CONTEXT ) = 0;
 	// Returns the contents touched by the trace model or 0 if the trace model is in free space.
 	virtual int				Contents( const idVec3 &start,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+								int traceContext = CM_MAIN_TRACE_CONTEXT ) = 0;
 	// Stores all contact points of the trace model with the model, returns the number of contacts.
 	virtual int				Contacts( contactInfo_t *contacts, const int maxContacts, const idVec3 &start, const idVec6 &dir, const float depth,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+								int traceContext = CM_MAIN_TRACE_CONTEXT ) = 0;
 
 	// Tests collision detection.
 	virtual void			DebugOutput( const idVec3 &origin ) = 0;
@@ -131,6 +179,10 @@ public:
 	virtual void			ModelInfo( cmHandle_t model ) = 0;
 	// Lists all loaded models.
 	virtual void			ListModels( void ) = 0;
+	// Records the next translations done by the main thread to a file.
+	virtual void			RecordTraces( const char *fileName, int numTraces ) = 0;
+	// Replays a recorded trace file through the axial tree and the bounding volume hierarchy.
+	virtual void			BenchmarkTraces( const char *fileName, int numIterations ) = 0;
 	// Writes a collision model file for the given map entity.
 	virtual bool			WriteCollisionModelForMapEntity( const idMapEntity *mapEnt, const char *filename, const bool testTraceModel = true ) = 0;
 
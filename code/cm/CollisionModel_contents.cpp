@@ -32,10 +32,10 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush( cm_traceWork_t *tw, cm_b
 	float d, bestd;
 	idVec3 *p;
 
-	if ( b->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( b->checkcount[tw->context] == tw->checkCount ) {
 		return false;
 	}
-	b->checkcount = idCollisionModelManagerLocal::checkCount;
+	b->checkcount[tw->context] = tw->checkCount;
 
 	if ( !(b->contents & tw->contents) ) {
 		return false;
@@ -104,10 +104,10 @@ CM_SetTrmEdgeSidedness
 CM_SetTrmPolygonSidedness
 ================
 */
-#define CM_SetTrmPolygonSidedness( v, plane, bitNum ) {								\
+#define CM_SetTrmPolygonSidedness( v, point, plane, bitNum ) {						\
 	if ( !((v)->sideSet & (1<<bitNum)) ) {											\
 		float fl;																	\
-		fl = plane.Distance( (v)->p );												\
+		fl = plane.Distance( point );												\
 		/* cannot use float sign bit because it is undetermined when fl == 0.0f */	\
 		if ( fl < 0.0f ) {															\
 			(v)->side |= (1 << bitNum);												\
@@ -133,12 +133,13 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	cm_trmEdge_t *trmEdge;
 	cm_edge_t *edge;
 	cm_vertex_t *v, *v1, *v2;
+	cm_traceStamp_t *es, *vs, *vs1, *vs2;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( p->checkcount[tw->context] == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->checkcount[tw->context] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -170,14 +171,14 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 			edgeNum = p->edges[i];
 			edge = tw->model->edges + abs(edgeNum);
 			// if this edge is already tested
-			if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( edge->stamps[tw->context].checkcount == tw->checkCount ) {
 				continue;
 			}
 
 			for ( j = 0; j < 2; j++ ) {
 				v = &tw->model->vertices[edge->vertexNum[j]];
 				// if this vertex is already tested
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( v->stamps[tw->context].checkcount == tw->checkCount ) {
 					continue;
 				}
 
@@ -212,19 +213,20 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	for ( i = 0; i < p->numEdges; i++ ) {
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
+		es = &edge->stamps[tw->context];
 		// reset sidedness cache if this is the first time we encounter this edge
-		if ( edge->checkcount != idCollisionModelManagerLocal::checkCount ) {
-			edge->sideSet = 0;
+		if ( es->checkcount != tw->checkCount ) {
+			es->sideSet = 0;
 		}
 		// pluecker coordinate for edge
 		tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[edge->vertexNum[0]].p,
 													tw->model->vertices[edge->vertexNum[1]].p );
-		v = &tw->model->vertices[edge->vertexNum[INTSIGNBITSET(edgeNum)]];
+		vs = &tw->model->vertices[edge->vertexNum[INTSIGNBITSET(edgeNum)]].stamps[tw->context];
 		// reset sidedness cache if this is the first time we encounter this vertex
-		if ( v->checkcount != idCollisionModelManagerLocal::checkCount ) {
-			v->sideSet = 0;
+		if ( vs->checkcount != tw->checkCount ) {
+			vs->sideSet = 0;
 		}
-		v->checkcount = idCollisionModelManagerLocal::checkCount;
+		vs->checkcount = tw->checkCount;
 	}
 
 	// get side of polygon for each trm vertex
@@ -246,8 +248,9 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 			edgeNum = p->edges[j];
 			edge = tw->model->edges + abs(edgeNum);
 #if 1
-			CM_SetTrmEdgeSidedness( edge, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
-			if ( INTSIGNBITSET(edgeNum) ^ ((edge->side >> i) & 1) ^ flip ) {
+			es = &edge->stamps[tw->context];
+			CM_SetTrmEdgeSidedness( es, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
+			if ( INTSIGNBITSET(edgeNum) ^ ((es->side >> i) & 1) ^ flip ) {
 				break;
 			}
 #else
@@ -285,22 +288,25 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	for ( i = 0; i < p->numEdges; i++ ) {
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		es = &edge->stamps[tw->context];
+		if ( es->checkcount == tw->checkCount ) {
 			continue;
 		}
-		edge->checkcount = idCollisionModelManagerLocal::checkCount;
+		es->checkcount = tw->checkCount;
 
 		for ( j = 0; j < tw->numPolys; j++ ) {
 #if 1
 			v1 = tw->model->vertices + edge->vertexNum[0];
-			CM_SetTrmPolygonSidedness( v1, tw->polys[j].plane, j );
+			vs1 = &v1->stamps[tw->context];
+			CM_SetTrmPolygonSidedness( vs1, v1->p, tw->polys[j].plane, j );
 			v2 = tw->model->vertices + edge->vertexNum[1];
-			CM_SetTrmPolygonSidedness( v2, tw->polys[j].plane, j );
+			vs2 = &v2->stamps[tw->context];
+			CM_SetTrmPolygonSidedness( vs2, v2->p, tw->polys[j].plane, j );
 			// if the polygon edge does not cross the trm polygon plane
-			if ( !(((v1->side ^ v2->side) >> j) & 1) ) {
+			if ( !(((vs1->side ^ vs2->side) >> j) & 1) ) {
 				continue;
 			}
-			flip = (v1->side >> j) & 1;
+			flip = (vs1->side >> j) & 1;
 #else
 			float d1, d2;
 
@@ -323,8 +329,8 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 				trmEdge = tw->edges + abs(trmEdgeNum);
 #if 1
 				bitNum = abs(trmEdgeNum);
-				CM_SetTrmEdgeSidedness( edge, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
-				if ( INTSIGNBITSET(trmEdgeNum) ^ ((edge->side >> bitNum) & 1) ^ flip ) {
+				CM_SetTrmEdgeSidedness( es, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
+				if ( INTSIGNBITSET(trmEdgeNum) ^ ((es->side >> bitNum) & 1) ^ flip ) {
 					break;
 				}
 #else
@@ -450,7 +456,8 @@ idCollisionModelManagerLocal::ContentsTrm
 */
 int idCollisionModelManagerLocal::ContentsTrm( trace_t *results, const idVec3 &start,
 									const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-									cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+									cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+									int traceContext ) {
 	int i;
 	bool model_rotated, trm_rotated;
 	idMat3 invModelAxis, tmpAxis;
@@ -470,7 +477,8 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t *results, const idVec3 &s
 		return results->c.contents;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
+	tw.context = traceContext;
+	tw.checkCount = ++traceContexts[traceContext].checkCount;
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -598,10 +606,13 @@ idCollisionModelManagerLocal::Contents
 */
 int idCollisionModelManagerLocal::Contents( const idVec3 &start,
 									const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-									cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+									cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+									int traceContext ) {
 	trace_t results;
 
-	if ( model < 0 || model > idCollisionModelManagerLocal::maxModels || model > MAX_SUBMODELS ) {
+	assert( traceContext >= 0 && traceContext < CM_MAX_TRACE_CONTEXTS );
+
+	if ( model < 0 || model >= idCollisionModelManagerLocal::maxModels + CM_MAX_TRACE_CONTEXTS || model >= TRACE_MODEL_HANDLE + CM_MAX_TRACE_CONTEXTS ) {
 		common->Printf("idCollisionModelManagerLocal::Contents: invalid model handle\n");
 		return 0;
 	}
@@ -610,5 +621,5 @@ int idCollisionModelManagerLocal::Contents( const idVec3 &start,
 		return 0;
 	}
 
-	return ContentsTrm( &results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+	return ContentsTrm( &results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis, traceContext );
 }
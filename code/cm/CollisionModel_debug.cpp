@@ -103,6 +103,8 @@ idCVar cm_drawInternal(		"cm_drawInternal",		"1",		CVAR_GAME | CVAR_BOOL,	"draw
 idCVar cm_drawNormals(		"cm_drawNormals",		"0",		CVAR_GAME | CVAR_BOOL,	"draw polygon and edge normals" );
 idCVar cm_backFaceCull(		"cm_backFaceCull",		"0",		CVAR_GAME | CVAR_BOOL,	"cull back facing polygons" );
 idCVar cm_debugCollision(	"cm_debugCollision",	"0",		CVAR_GAME | CVAR_BOOL,	"debug the collision detection" );
+idCVar cm_useBVH(			"cm_useBVH",			"1",		CVAR_GAME | CVAR_BOOL,	"trace through the bounding volume hierarchy instead of the axial tree" );
+idCVar cm_batchTraces(		"cm_batchTraces",		"1",		CVAR_GAME | CVAR_BOOL,	"share the node tree walk between batched translations" );
 
 static idVec4 cm_color;
 
@@ -251,10 +253,10 @@ void idCollisionModelManagerLocal::DrawPolygon( cm_model_t *model, cm_polygon_t
 		for ( i = 0; i < p->numEdges; i++ ) {
 			edgeNum = p->edges[i];
 			edge = model->edges + abs(edgeNum);
-			if ( edge->checkcount == checkCount ) {
+			if ( edge->stamps[CM_MAIN_TRACE_CONTEXT].checkcount == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 				continue;
 			}
-			edge->checkcount = checkCount;
+			edge->stamps[CM_MAIN_TRACE_CONTEXT].checkcount = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 			DrawEdge( model, edgeNum, origin, axis );
 		}
 	}
@@ -289,7 +291,7 @@ void idCollisionModelManagerLocal::DrawNodePolygons( cm_model_t *model, cm_node_
 					continue;
 				}
 			}
-			if ( p->checkcount == checkCount ) {
+			if ( p->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 				continue;
 			}
 			if ( !( p->contents & cm_contentsFlagByIndex[cm_drawMask.GetInteger()] ) ) {
@@ -297,7 +299,7 @@ void idCollisionModelManagerLocal::DrawNodePolygons( cm_model_t *model, cm_node_
 			}
 
 			DrawPolygon( model, p, origin, axis, viewOrigin );
-			p->checkcount = checkCount;
+			p->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 		}
 		if ( node->planeType == -1 ) {
 			break;
@@ -335,7 +337,7 @@ void idCollisionModelManagerLocal::DrawModel( cmHandle_t handle, const idVec3 &m
 
 	model = models[ handle ];
 	viewPos = (viewOrigin - modelOrigin) * modelAxis.Transpose();
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	DrawNodePolygons( model, model->node, modelOrigin, modelAxis, viewPos, radius );
 }
 
@@ -496,3 +498,217 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 	Mem_Free( testend );
 	testend = NULL;
 }
+
+
+/*
+===============================================================================
+
+Trace recording and benchmarking
+
+===============================================================================
+*/
+
+#define CM_TRACEFILE_ID			( ( 'R' << 24 ) | ( 'T' << 16 ) | ( 'M' << 8 ) | 'C' )
+#define CM_TRACEFILE_VERSION	1
+
+/*
+================
+idCollisionModelManagerLocal::RecordTraces
+================
+*/
+void idCollisionModelManagerLocal::RecordTraces( const char *fileName, int numTraces ) {
+	if ( recordedTraces.Num() ) {
+		WriteRecordedTraces();
+	}
+	if ( numTraces <= 0 || !loaded ) {
+		return;
+	}
+	recordFileName = fileName;
+	recordFileName.DefaultFileExtension( ".cmtraces" );
+	maxRecordedTraces = numTraces;
+	recordedTraces.SetGranularity( 4096 );
+	common->Printf( "recording %d translations to %s\n", maxRecordedTraces, recordFileName.c_str() );
+}
+
+/*
+================
+idCollisionModelManagerLocal::RecordTrace
+================
+*/
+void idCollisionModelManagerLocal::RecordTrace( const idVec3 &start, const idVec3 &end, const idTraceModel *trm, const idMat3 &trmAxis,
+												int contentMask, cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+	cm_recordedTrace_t *t;
+
+	// trace model handles are setup on the fly and can't be replayed
+	if ( model >= numModels ) {
+		return;
+	}
+
+	t = &recordedTraces.Alloc();
+	t->start = start;
+	t->end = end;
+	if ( trm ) {
+		t->bounds = trm->bounds;
+	} else {
+		t->bounds.Clear();
+	}
+	t->trmAxis = trmAxis;
+	t->contentMask = contentMask;
+	t->model = model;
+	t->modelOrigin = modelOrigin;
+	t->modelAxis = modelAxis;
+
+	if ( recordedTraces.Num() >= maxRecordedTraces ) {
+		WriteRecordedTraces();
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteRecordedTraces
+================
+*/
+void idCollisionModelManagerLocal::WriteRecordedTraces( void ) {
+	int i;
+	idFile *fp;
+	const cm_recordedTrace_t *t;
+
+	maxRecordedTraces = 0;
+
+	fp = fileSystem->OpenFileWrite( recordFileName );
+	if ( !fp ) {
+		common->Warning( "idCollisionModelManagerLocal::WriteRecordedTraces: Error opening file %s\n", recordFileName.c_str() );
+		recordedTraces.Clear();
+		return;
+	}
+
+	fp->WriteInt( CM_TRACEFILE_ID );
+	fp->WriteInt( CM_TRACEFILE_VERSION );
+	fp->WriteString( mapName );
+	fp->WriteInt( recordedTraces.Num() );
+	for ( i = 0; i < recordedTraces.Num(); i++ ) {
+		t = &recordedTraces[i];
+		fp->WriteVec3( t->start );
+		fp->WriteVec3( t->end );
+		fp->WriteVec3( t->bounds[0] );
+		fp->WriteVec3( t->bounds[1] );
+		fp->WriteMat3( t->trmAxis );
+		fp->WriteInt( t->contentMask );
+		fp->WriteInt( t->model );
+		fp->WriteVec3( t->modelOrigin );
+		fp->WriteMat3( t->modelAxis );
+	}
+
+	fileSystem->CloseFile( fp );
+
+	common->Printf( "wrote %d translations to %s\n", recordedTraces.Num(), recordFileName.c_str() );
+	recordedTraces.Clear();
+}
+
+/*
+================
+idCollisionModelManagerLocal::BenchmarkTraces
+
+  Replays a recorded trace file once through the axial tree and once through
+  the bounding volume hierarchy. Trace models are replayed as boxes.
+================
+*/
+void idCollisionModelManagerLocal::BenchmarkTraces( const char *fileName, int numIterations ) {
+	int i, j, pass, id, version, numTraces, numDifferent, msec[2];
+	bool isPoint, useBVH;
+	idFile *fp;
+	idStr name, traceMapName;
+	idBounds trmBounds;
+	idTraceModel trm;
+	idTimer timer;
+	idList<cm_recordedTrace_t> traces;
+	idList<float> fractions;
+	cm_recordedTrace_t *t;
+	trace_t trace;
+
+	if ( !loaded ) {
+		common->Printf( "no collision map loaded\n" );
+		return;
+	}
+
+	name = fileName;
+	name.DefaultFileExtension( ".cmtraces" );
+	fp = fileSystem->OpenFileRead( name );
+	if ( !fp ) {
+		common->Printf( "couldn't open %s\n", name.c_str() );
+		return;
+	}
+
+	fp->ReadInt( id );
+	fp->ReadInt( version );
+	if ( id != CM_TRACEFILE_ID || version != CM_TRACEFILE_VERSION ) {
+		common->Printf( "%s is not a version %d trace file\n", name.c_str(), CM_TRACEFILE_VERSION );
+		fileSystem->CloseFile( fp );
+		return;
+	}
+	fp->ReadString( traceMapName );
+	if ( traceMapName.Icmp( mapName ) != 0 ) {
+		common->Warning( "%s was recorded on %s", name.c_str(), traceMapName.c_str() );
+	}
+	fp->ReadInt( numTraces );
+	traces.SetNum( numTraces > 0 ? numTraces : 0 );
+	for ( i = 0; i < traces.Num(); i++ ) {
+		t = &traces[i];
+		fp->ReadVec3( t->start );
+		fp->ReadVec3( t->end );
+		fp->ReadVec3( t->bounds[0] );
+		fp->ReadVec3( t->bounds[1] );
+		fp->ReadMat3( t->trmAxis );
+		fp->ReadInt( t->contentMask );
+		fp->ReadInt( t->model );
+		fp->ReadVec3( t->modelOrigin );
+		fp->ReadMat3( t->modelAxis );
+		// skip traces through models that are not loaded
+		if ( t->model < 0 || t->model >= numModels || !models[t->model] ) {
+			traces.RemoveIndex( i-- );
+		}
+	}
+	fileSystem->CloseFile( fp );
+
+	if ( numIterations < 1 ) {
+		numIterations = 1;
+	}
+
+	useBVH = cm_useBVH.GetBool();
+	fractions.SetNum( traces.Num() );
+	numDifferent = 0;
+
+	for ( pass = 0; pass < 2; pass++ ) {
+		cm_useBVH.SetBool( pass == 1 );
+		trmBounds.Zero();
+
+		timer.Clear();
+		timer.Start();
+		for ( i = 0; i < numIterations; i++ ) {
+			for ( j = 0; j < traces.Num(); j++ ) {
+				t = &traces[j];
+				isPoint = t->bounds.IsCleared();
+				if ( !isPoint && t->bounds != trmBounds ) {
+					trmBounds = t->bounds;
+					trm.SetupBox( trmBounds );
+				}
+				Translation( &trace, t->start, t->end, isPoint ? NULL : &trm, t->trmAxis, t->contentMask,
+								t->model, t->modelOrigin, t->modelAxis );
+				if ( i == 0 ) {
+					if ( pass == 0 ) {
+						fractions[j] = trace.fraction;
+					} else if ( idMath::Fabs( fractions[j] - trace.fraction ) > 1e-4f ) {
+						numDifferent++;
+					}
+				}
+			}
+		}
+		timer.Stop();
+		msec[pass] = timer.Milliseconds();
+	}
+
+	cm_useBVH.SetBool( useBVH );
+
+	common->Printf( "%d translations x %d: axial tree %d msec, bounding volume hierarchy %d msec, %d different results\n",
+						traces.Num(), numIterations, msec[0], msec[1], numDifferent );
+}
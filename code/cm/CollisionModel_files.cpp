@@ -55,10 +55,10 @@ int idCollisionModelManagerLocal::CountPolygonMemory( cm_node_t *node ) const {
 	memory = 0;
 	for ( pref = node->polygons; pref; pref = pref->next ) {
 		p = pref->p;
-		if ( p->checkcount == checkCount ) {
+		if ( p->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 			continue;
 		}
-		p->checkcount = checkCount;
+		p->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 
 		memory += sizeof( cm_polygon_t ) + ( p->numEdges - 1 ) * sizeof( p->edges[0] );
 	}
@@ -81,10 +81,10 @@ void idCollisionModelManagerLocal::WritePolygons( idFile *fp, cm_node_t *node )
 
 	for ( pref = node->polygons; pref; pref = pref->next ) {
 		p = pref->p;
-		if ( p->checkcount == checkCount ) {
+		if ( p->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 			continue;
 		}
-		p->checkcount = checkCount;
+		p->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 		fp->WriteFloatString( "\t%d (", p->numEdges );
 		for ( i = 0; i < p->numEdges; i++ ) {
 			fp->WriteFloatString( " %d", p->edges[i] );
@@ -113,10 +113,10 @@ int idCollisionModelManagerLocal::CountBrushMemory( cm_node_t *node ) const {
 	memory = 0;
 	for ( bref = node->brushes; bref; bref = bref->next ) {
 		b = bref->b;
-		if ( b->checkcount == checkCount ) {
+		if ( b->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 			continue;
 		}
-		b->checkcount = checkCount;
+		b->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 
 		memory += sizeof( cm_brush_t ) + ( b->numPlanes - 1 ) * sizeof( b->planes[0] );
 	}
@@ -139,10 +139,10 @@ void idCollisionModelManagerLocal::WriteBrushes( idFile *fp, cm_node_t *node ) {
 
 	for ( bref = node->brushes; bref; bref = bref->next ) {
 		b = bref->b;
-		if ( b->checkcount == checkCount ) {
+		if ( b->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 			continue;
 		}
-		b->checkcount = checkCount;
+		b->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 		fp->WriteFloatString( "\t%d {\n", b->numPlanes );
 		for ( i = 0; i < b->numPlanes; i++ ) {
 			fp->WriteFloatString( "\t\t( %f %f %f ) %f\n", b->planes[i].Normal()[0], b->planes[i].Normal()[1], b->planes[i].Normal()[2], b->planes[i].Dist() );
@@ -182,17 +182,17 @@ void idCollisionModelManagerLocal::WriteCollisionModel( idFile *fp, cm_model_t *
 	WriteNodes( fp, model->node );
 	fp->WriteFloatString( "\t}\n" );
 	// polygons
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	polygonMemory = CountPolygonMemory( model->node );
 	fp->WriteFloatString( "\tpolygons /* polygonMemory = */ %d {\n", polygonMemory );
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	WritePolygons( fp, model->node );
 	fp->WriteFloatString( "\t}\n" );
 	// brushes
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	brushMemory = CountBrushMemory( model->node );
 	fp->WriteFloatString( "\tbrushes /* brushMemory = */ %d {\n", brushMemory );
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	WriteBrushes( fp, model->node );
 	fp->WriteFloatString( "\t}\n" );
 	// closing brace
@@ -301,9 +301,7 @@ void idCollisionModelManagerLocal::ParseVertices( idLexer *src, cm_model_t *mode
 	model->vertices = (cm_vertex_t *) Mem_Alloc( model->maxVertices * sizeof( cm_vertex_t ) );
 	for ( i = 0; i < model->numVertices; i++ ) {
 		src->Parse1DMatrix( 3, model->vertices[i].p.ToFloatPtr() );
-		model->vertices[i].side = 0;
-		model->vertices[i].sideSet = 0;
-		model->vertices[i].checkcount = 0;
+		memset( model->vertices[i].stamps, 0, sizeof( model->vertices[i].stamps ) );
 	}
 	src->ExpectTokenString( "}" );
 }
@@ -325,12 +323,10 @@ void idCollisionModelManagerLocal::ParseEdges( idLexer *src, cm_model_t *model )
 		model->edges[i].vertexNum[0] = src->ParseInt();
 		model->edges[i].vertexNum[1] = src->ParseInt();
 		src->ExpectTokenString( ")" );
-		model->edges[i].side = 0;
-		model->edges[i].sideSet = 0;
 		model->edges[i].internal = src->ParseInt();
 		model->edges[i].numUsers = src->ParseInt();
 		model->edges[i].normal = vec3_origin;
-		model->edges[i].checkcount = 0;
+		memset( model->edges[i].stamps, 0, sizeof( model->edges[i].stamps ) );
 		model->numInternalEdges += model->edges[i].internal;
 	}
 	src->ExpectTokenString( "}" );
@@ -397,7 +393,7 @@ void idCollisionModelManagerLocal::ParsePolygons( idLexer *src, cm_model_t *mode
 		// get material
 		p->material = declManager->FindMaterial( token );
 		p->contents = p->material->GetContentFlags();
-		p->checkcount = 0;
+		memset( p->checkcount, 0, sizeof( p->checkcount ) );
 		// filter polygon into tree
 		R_FilterPolygonIntoTree( model, model->node, NULL, p );
 	}
@@ -441,7 +437,7 @@ void idCollisionModelManagerLocal::ParseBrushes( idLexer *src, cm_model_t *model
 		} else {
 			b->contents = ContentsFromString( token );
 		}
-		b->checkcount = 0;
+		memset( b->checkcount, 0, sizeof( b->checkcount ) );
 		b->primitiveNum = 0;
 		// filter brush into tree
 		R_FilterBrushIntoTree( model, model->node, NULL, b );
@@ -511,7 +507,7 @@ bool idCollisionModelManagerLocal::ParseCollisionModel( idLexer *src ) {
 		src->Error( "ParseCollisionModel: bad token \"%s\"", token.c_str() );
 	}
 	// calculate edge normals
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	CalculateEdgeNormals( model, model->node );
 	// get model bounds from brush and polygon bounds
 	CM_GetNodeBounds( &model->bounds, model->node );
@@ -539,6 +535,12 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, uns
 	idToken token;
 	idLexer *src;
 	unsigned int crc;
+	int firstModel;
+
+	// try the binary cache first
+	if ( LoadBinaryCollisionModelFile( name, mapFileCRC ) ) {
+		return true;
+	}
 
 	// load it
 	fileName = name;
@@ -576,6 +578,7 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, uns
 	}
 
 	// parse the file
+	firstModel = numModels;
 	while ( 1 ) {
 		if ( !src->ReadToken( &token ) ) {
 			break;
@@ -594,5 +597,601 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, uns
 
 	delete src;
 
+	// create the binary cache so the next load does not need to parse the text file
+	WriteBinaryCollisionModelsToFile( name, firstModel, numModels, crc );
+
+	return true;
+}
+
+
+/*
+===============================================================================
+
+Binary collision model cache
+
+	The .cmb file is a platform specific dump of the fully built collision
+	models. Every section is read straight into the memory block that will
+	hold it for the lifetime of the model. Pointers are stored as indices or
+	byte offsets and fixed up in place after reading, so no per element
+	allocation or parsing is required.
+
+	The cache is only used when the struct sizes, the map file CRC and the
+	time stamp of the text .cm file all match, otherwise it is rebuilt.
+
+===============================================================================
+*/
+
+#define CM_BINARYFILE_EXT		"cmb"
+#define CM_BINARYFILEID			( ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'C' << 8 ) | 'C' )
+#define CM_BINARYFILEVERSION	1
+
+idCVar cm_binaryModels( "cm_binaryModels", "1", CVAR_SYSTEM | CVAR_BOOL, "read and write binary .cmb collision model caches" );
+
+typedef struct cm_binaryHeader_s {
+	int						id;
+	int						version;
+	unsigned int			mapFileCRC;
+	ID_TIME_T				sourceTimeStamp;	// time stamp of the .cm file the cache was created from
+	int						numModels;
+	int						pointerSize;
+	int						vertexSize;
+	int						edgeSize;
+	int						nodeSize;
+	int						polygonRefSize;
+	int						brushRefSize;
+	int						polygonSize;
+	int						brushSize;
+} cm_binaryHeader_t;
+
+typedef struct cm_binaryModel_s {
+	idBounds				bounds;
+	int						contents;
+	int						isConvex;
+	int						numVertices;
+	int						numEdges;
+	int						numNodes;
+	int						numPolygonRefs;
+	int						numBrushRefs;
+	int						numPolygons;
+	int						polygonMemory;
+	int						numBrushes;
+	int						brushMemory;
+	int						numInternalEdges;
+	int						numSharpEdges;
+	int						numRemovedPolys;
+	int						numMergedPolys;
+	int						numMaterials;
+} cm_binaryModel_t;
+
+#define CM_INDEX_TO_PTR( type, index )		( (type *) (intptr_t) ( index ) )
+#define CM_PTR_TO_INDEX( ptr )				( (intptr_t) ( ptr ) )
+
+/*
+================
+CM_SetupBinaryHeader
+================
+*/
+static void CM_SetupBinaryHeader( cm_binaryHeader_t *header, unsigned int mapFileCRC, ID_TIME_T sourceTimeStamp, int numModels ) {
+	memset( header, 0, sizeof( *header ) );
+	header->id = CM_BINARYFILEID;
+	header->version = CM_BINARYFILEVERSION;
+	header->mapFileCRC = mapFileCRC;
+	header->sourceTimeStamp = sourceTimeStamp;
+	header->numModels = numModels;
+	header->pointerSize = sizeof( void * );
+	header->vertexSize = sizeof( cm_vertex_t );
+	header->edgeSize = sizeof( cm_edge_t );
+	header->nodeSize = sizeof( cm_node_t );
+	header->polygonRefSize = sizeof( cm_polygonRef_t );
+	header->brushRefSize = sizeof( cm_brushRef_t );
+	header->polygonSize = sizeof( cm_polygon_t );
+	header->brushSize = sizeof( cm_brush_t );
+}
+
+/*
+================
+CM_PointerHashKey
+================
+*/
+static ID_INLINE int CM_PointerHashKey( const void *ptr ) {
+	return (int) ( CM_PTR_TO_INDEX( ptr ) >> 4 );
+}
+
+/*
+================
+CM_BinaryMaterialNum
+================
+*/
+static int CM_BinaryMaterialNum( const idMaterial *material, idList<const idMaterial *> &materials, idHashIndex &materialHash ) {
+	int i, key;
+
+	if ( !material ) {
+		return -1;
+	}
+	key = CM_PointerHashKey( material );
+	for ( i = materialHash.First( key ); i != -1; i = materialHash.Next( i ) ) {
+		if ( materials[i] == material ) {
+			return i;
+		}
+	}
+	i = materials.Append( material );
+	materialHash.Add( key, i );
+	return i;
+}
+
+/*
+================
+idCollisionModelManagerLocal::GatherBinaryPolygons
+
+  Collects all unique polygons and brushes in the tree and assigns them a byte offset.
+================
+*/
+void idCollisionModelManagerLocal::GatherBinaryPolygons( cm_node_t *node, idList<cm_polygon_t *> &polygons, idList<cm_brush_t *> &brushes ) {
+	cm_polygonRef_t *pref;
+	cm_brushRef_t *bref;
+
+	while( 1 ) {
+		for ( pref = node->polygons; pref; pref = pref->next ) {
+			if ( !pref->p || pref->p->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
+				continue;
+			}
+			pref->p->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
+			polygons.Append( pref->p );
+		}
+		for ( bref = node->brushes; bref; bref = bref->next ) {
+			if ( !bref->b || bref->b->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
+				continue;
+			}
+			bref->b->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
+			brushes.Append( bref->b );
+		}
+		if ( node->planeType == -1 ) {
+			break;
+		}
+		GatherBinaryPolygons( node->children[1], polygons, brushes );
+		node = node->children[0];
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::GatherBinaryNodes
+
+  Stores the tree in pre-order with all pointers converted to indices.
+  Reference and node indices are stored plus one so zero can be used for NULL.
+================
+*/
+int idCollisionModelManagerLocal::GatherBinaryNodes( cm_node_t *node, int parentNum, cm_binaryGather_t &gather ) {
+	cm_polygonRef_t *pref;
+	cm_brushRef_t *bref;
+	cm_polygonRef_t binaryPref;
+	cm_brushRef_t binaryBref;
+	cm_node_t binaryNode;
+	int i, key, nodeNum;
+
+	binaryNode = *node;
+	binaryNode.parent = CM_INDEX_TO_PTR( cm_node_t, parentNum + 1 );
+	binaryNode.polygons = NULL;
+	binaryNode.brushes = NULL;
+	binaryNode.children[0] = binaryNode.children[1] = NULL;
+
+	for ( pref = node->polygons; pref; pref = pref->next ) {
+		binaryPref.p = NULL;
+		if ( pref->p ) {
+			key = CM_PointerHashKey( pref->p );
+			for ( i = gather.polygonHash.First( key ); i != -1; i = gather.polygonHash.Next( i ) ) {
+				if ( gather.polygons[i] == pref->p ) {
+					break;
+				}
+			}
+			assert( i != -1 );
+			binaryPref.p = CM_INDEX_TO_PTR( cm_polygon_t, gather.polygonOffsets[i] + 1 );
+		}
+		binaryPref.next = pref->next ? CM_INDEX_TO_PTR( cm_polygonRef_t, gather.polygonRefs.Num() + 2 ) : NULL;
+		if ( pref == node->polygons ) {
+			binaryNode.polygons = CM_INDEX_TO_PTR( cm_polygonRef_t, gather.polygonRefs.Num() + 1 );
+		}
+		gather.polygonRefs.Append( binaryPref );
+	}
+
+	for ( bref = node->brushes; bref; bref = bref->next ) {
+		binaryBref.b = NULL;
+		if ( bref->b ) {
+			key = CM_PointerHashKey( bref->b );
+			for ( i = gather.brushHash.First( key ); i != -1; i = gather.brushHash.Next( i ) ) {
+				if ( gather.brushes[i] == bref->b ) {
+					break;
+				}
+			}
+			assert( i != -1 );
+			binaryBref.b = CM_INDEX_TO_PTR( cm_brush_t, gather.brushOffsets[i] + 1 );
+		}
+		binaryBref.next = bref->next ? CM_INDEX_TO_PTR( cm_brushRef_t, gather.brushRefs.Num() + 2 ) : NULL;
+		if ( bref == node->brushes ) {
+			binaryNode.brushes = CM_INDEX_TO_PTR( cm_brushRef_t, gather.brushRefs.Num() + 1 );
+		}
+		gather.brushRefs.Append( binaryBref );
+	}
+
+	nodeNum = gather.nodes.Append( binaryNode );
+
+	if ( node->planeType != -1 ) {
+		gather.nodes[nodeNum].children[0] = CM_INDEX_TO_PTR( cm_node_t, GatherBinaryNodes( node->children[0], nodeNum, gather ) );
+		gather.nodes[nodeNum].children[1] = CM_INDEX_TO_PTR( cm_node_t, GatherBinaryNodes( node->children[1], nodeNum, gather ) );
+	}
+	return nodeNum;
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBinaryCollisionModel
+================
+*/
+void idCollisionModelManagerLocal::WriteBinaryCollisionModel( idFile *fp, cm_model_t *model ) {
+	int i, size, offset;
+	cm_binaryGather_t gather;
+	cm_binaryModel_t binaryModel;
+	idList<const idMaterial *> materials;
+	idHashIndex materialHash;
+	cm_vertex_t vertex;
+	cm_edge_t edge;
+	idList<byte> buffer;
+	cm_polygon_t *p;
+	cm_brush_t *b;
+
+	// collect unique polygons and brushes and assign their offsets in the polygon and brush blocks
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
+	GatherBinaryPolygons( model->node, gather.polygons, gather.brushes );
+
+	gather.polygonOffsets.SetNum( gather.polygons.Num() );
+	gather.polygonHash.Clear( 4096, gather.polygons.Num() );
+	for ( offset = 0, i = 0; i < gather.polygons.Num(); i++ ) {
+		gather.polygonOffsets[i] = offset;
+		gather.polygonHash.Add( CM_PointerHashKey( gather.polygons[i] ), i );
+		offset += sizeof( cm_polygon_t ) + ( gather.polygons[i]->numEdges - 1 ) * sizeof( gather.polygons[i]->edges[0] );
+	}
+	binaryModel.polygonMemory = offset;
+
+	gather.brushOffsets.SetNum( gather.brushes.Num() );
+	gather.brushHash.Clear( 1024, gather.brushes.Num() );
+	for ( offset = 0, i = 0; i < gather.brushes.Num(); i++ ) {
+		gather.brushOffsets[i] = offset;
+		gather.brushHash.Add( CM_PointerHashKey( gather.brushes[i] ), i );
+		offset += sizeof( cm_brush_t ) + ( gather.brushes[i]->numPlanes - 1 ) * sizeof( gather.brushes[i]->planes[0] );
+	}
+	binaryModel.brushMemory = offset;
+
+	// flatten the tree
+	gather.nodes.SetGranularity( 1024 );
+	gather.polygonRefs.SetGranularity( 1024 );
+	gather.brushRefs.SetGranularity( 1024 );
+	GatherBinaryNodes( model->node, -1, gather );
+
+	// collect materials
+	for ( i = 0; i < gather.polygons.Num(); i++ ) {
+		CM_BinaryMaterialNum( gather.polygons[i]->material, materials, materialHash );
+	}
+	for ( i = 0; i < gather.brushes.Num(); i++ ) {
+		CM_BinaryMaterialNum( gather.brushes[i]->material, materials, materialHash );
+	}
+
+	binaryModel.bounds = model->bounds;
+	binaryModel.contents = model->contents;
+	binaryModel.isConvex = model->isConvex;
+	binaryModel.numVertices = model->numVertices;
+	binaryModel.numEdges = model->numEdges;
+	binaryModel.numNodes = gather.nodes.Num();
+	binaryModel.numPolygonRefs = gather.polygonRefs.Num();
+	binaryModel.numBrushRefs = gather.brushRefs.Num();
+	binaryModel.numPolygons = gather.polygons.Num();
+	binaryModel.numBrushes = gather.brushes.Num();
+	binaryModel.numInternalEdges = model->numInternalEdges;
+	binaryModel.numSharpEdges = model->numSharpEdges;
+	binaryModel.numRemovedPolys = model->numRemovedPolys;
+	binaryModel.numMergedPolys = model->numMergedPolys;
+	binaryModel.numMaterials = materials.Num();
+
+	fp->WriteString( model->name );
+	fp->Write( &binaryModel, sizeof( binaryModel ) );
+
+	for ( i = 0; i < materials.Num(); i++ ) {
+		fp->WriteString( materials[i]->GetName() );
+	}
+
+	// vertices and edges without the per trace state
+	for ( i = 0; i < model->numVertices; i++ ) {
+		vertex = model->vertices[i];
+		memset( vertex.stamps, 0, sizeof( vertex.stamps ) );
+		fp->Write( &vertex, sizeof( vertex ) );
+	}
+	for ( i = 0; i < model->numEdges; i++ ) {
+		edge = model->edges[i];
+		memset( edge.stamps, 0, sizeof( edge.stamps ) );
+		fp->Write( &edge, sizeof( edge ) );
+	}
+
+	fp->Write( gather.nodes.Ptr(), gather.nodes.Num() * sizeof( cm_node_t ) );
+	fp->Write( gather.polygonRefs.Ptr(), gather.polygonRefs.Num() * sizeof( cm_polygonRef_t ) );
+	fp->Write( gather.brushRefs.Ptr(), gather.brushRefs.Num() * sizeof( cm_brushRef_t ) );
+
+	// polygons and brushes with the material pointer replaced by the material index
+	for ( i = 0; i < gather.polygons.Num(); i++ ) {
+		p = gather.polygons[i];
+		size = sizeof( cm_polygon_t ) + ( p->numEdges - 1 ) * sizeof( p->edges[0] );
+		buffer.SetNum( size, false );
+		memcpy( buffer.Ptr(), p, size );
+		memset( ( (cm_polygon_t *) buffer.Ptr() )->checkcount, 0, sizeof( p->checkcount ) );
+		( (cm_polygon_t *) buffer.Ptr() )->material = CM_INDEX_TO_PTR( const idMaterial, CM_BinaryMaterialNum( p->material, materials, materialHash ) );
+		fp->Write( buffer.Ptr(), size );
+	}
+	for ( i = 0; i < gather.brushes.Num(); i++ ) {
+		b = gather.brushes[i];
+		size = sizeof( cm_brush_t ) + ( b->numPlanes - 1 ) * sizeof( b->planes[0] );
+		buffer.SetNum( size, false );
+		memcpy( buffer.Ptr(), b, size );
+		memset( ( (cm_brush_t *) buffer.Ptr() )->checkcount, 0, sizeof( b->checkcount ) );
+		( (cm_brush_t *) buffer.Ptr() )->material = CM_INDEX_TO_PTR( const idMaterial, CM_BinaryMaterialNum( b->material, materials, materialHash ) );
+		fp->Write( buffer.Ptr(), size );
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile
+================
+*/
+void idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC ) {
+	int i;
+	idFile *fp;
+	idStr name, sourceName;
+	ID_TIME_T sourceTimeStamp;
+	cm_binaryHeader_t header;
+
+	if ( !cm_binaryModels.GetBool() ) {
+		return;
+	}
+
+	sourceName = filename;
+	sourceName.SetFileExtension( CM_FILE_EXT );
+	fileSystem->ReadFile( sourceName, NULL, &sourceTimeStamp );
+
+	name = filename;
+	name.SetFileExtension( CM_BINARYFILE_EXT );
+
+	fp = fileSystem->OpenFileWrite( name );
+	if ( !fp ) {
+		common->Warning( "idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile: Error opening file %s\n", name.c_str() );
+		return;
+	}
+
+	CM_SetupBinaryHeader( &header, mapFileCRC, sourceTimeStamp, lastModel - firstModel );
+	fp->Write( &header, sizeof( header ) );
+
+	for ( i = firstModel; i < lastModel; i++ ) {
+		WriteBinaryCollisionModel( fp, models[i] );
+	}
+
+	fileSystem->CloseFile( fp );
+}
+
+/*
+================
+idCollisionModelManagerLocal::ReadBinaryCollisionModel
+================
+*/
+bool idCollisionModelManagerLocal::ReadBinaryCollisionModel( idFile *fp ) {
+	int i, length;
+	cm_model_t *model;
+	cm_binaryModel_t binaryModel;
+	idStr name;
+	idList<const idMaterial *> materials;
+	cm_node_t *node, *nodes;
+	cm_polygonRef_t *pref, *polygonRefs;
+	cm_brushRef_t *bref, *brushRefs;
+	cm_polygon_t *p;
+	cm_brush_t *b;
+	byte *polygonData, *brushData;
+
+	if ( numModels >= MAX_SUBMODELS ) {
+		common->Error( "LoadModel: no free slots" );
+		return false;
+	}
+
+	fp->ReadString( name );
+	if ( fp->Read( &binaryModel, sizeof( binaryModel ) ) != sizeof( binaryModel ) ) {
+		return false;
+	}
+
+	materials.SetNum( binaryModel.numMaterials );
+	for ( i = 0; i < binaryModel.numMaterials; i++ ) {
+		idStr materialName;
+		fp->ReadString( materialName );
+		materials[i] = declManager->FindMaterial( materialName );
+	}
+
+	model = AllocModel();
+	model->name = name;
+	model->bounds = binaryModel.bounds;
+	model->contents = binaryModel.contents;
+	model->isConvex = ( binaryModel.isConvex != 0 );
+	model->numPolygons = binaryModel.numPolygons;
+	model->polygonMemory = binaryModel.polygonMemory;
+	model->numBrushes = binaryModel.numBrushes;
+	model->brushMemory = binaryModel.brushMemory;
+	model->numNodes = binaryModel.numNodes;
+	model->numPolygonRefs = binaryModel.numPolygonRefs;
+	model->numBrushRefs = binaryModel.numBrushRefs;
+	model->numInternalEdges = binaryModel.numInternalEdges;
+	model->numSharpEdges = binaryModel.numSharpEdges;
+	model->numRemovedPolys = binaryModel.numRemovedPolys;
+	model->numMergedPolys = binaryModel.numMergedPolys;
+
+	// read every section straight into the memory that will hold it
+	model->numVertices = model->maxVertices = binaryModel.numVertices;
+	model->vertices = (cm_vertex_t *) Mem_Alloc( model->maxVertices * sizeof( cm_vertex_t ) );
+	length = fp->Read( model->vertices, model->numVertices * sizeof( cm_vertex_t ) );
+
+	model->numEdges = model->maxEdges = binaryModel.numEdges;
+	model->edges = (cm_edge_t *) Mem_Alloc( model->maxEdges * sizeof( cm_edge_t ) );
+	length += fp->Read( model->edges, model->numEdges * sizeof( cm_edge_t ) );
+
+	model->nodeBlocks = (cm_nodeBlock_t *) Mem_Alloc( sizeof( cm_nodeBlock_t ) + model->numNodes * sizeof( cm_node_t ) );
+	model->nodeBlocks->nextNode = NULL;
+	model->nodeBlocks->next = NULL;
+	nodes = (cm_node_t *) ( ( (byte *) model->nodeBlocks ) + sizeof( cm_nodeBlock_t ) );
+	length += fp->Read( nodes, model->numNodes * sizeof( cm_node_t ) );
+
+	model->polygonRefBlocks = (cm_polygonRefBlock_t *) Mem_Alloc( sizeof( cm_polygonRefBlock_t ) + model->numPolygonRefs * sizeof( cm_polygonRef_t ) );
+	model->polygonRefBlocks->nextRef = NULL;
+	model->polygonRefBlocks->next = NULL;
+	polygonRefs = (cm_polygonRef_t *) ( ( (byte *) model->polygonRefBlocks ) + sizeof( cm_polygonRefBlock_t ) );
+	length += fp->Read( polygonRefs, model->numPolygonRefs * sizeof( cm_polygonRef_t ) );
+
+	model->brushRefBlocks = (cm_brushRefBlock_t *) Mem_Alloc( sizeof( cm_brushRefBlock_t ) + model->numBrushRefs * sizeof( cm_brushRef_t ) );
+	model->brushRefBlocks->nextRef = NULL;
+	model->brushRefBlocks->next = NULL;
+	brushRefs = (cm_brushRef_t *) ( ( (byte *) model->brushRefBlocks ) + sizeof( cm_brushRefBlock_t ) );
+	length += fp->Read( brushRefs, model->numBrushRefs * sizeof( cm_brushRef_t ) );
+
+	model->polygonBlock = (cm_polygonBlock_t *) Mem_Alloc( sizeof( cm_polygonBlock_t ) + model->polygonMemory );
+	polygonData = ( (byte *) model->polygonBlock ) + sizeof( cm_polygonBlock_t );
+	model->polygonBlock->bytesRemaining = 0;
+	model->polygonBlock->next = polygonData + model->polygonMemory;
+	length += fp->Read( polygonData, model->polygonMemory );
+
+	model->brushBlock = (cm_brushBlock_t *) Mem_Alloc( sizeof( cm_brushBlock_t ) + model->brushMemory );
+	brushData = ( (byte *) model->brushBlock ) + sizeof( cm_brushBlock_t );
+	model->brushBlock->bytesRemaining = 0;
+	model->brushBlock->next = brushData + model->brushMemory;
+	length += fp->Read( brushData, model->brushMemory );
+
+	models[numModels] = model;
+	numModels++;
+
+	if ( length != model->numVertices * (int)sizeof( cm_vertex_t ) + model->numEdges * (int)sizeof( cm_edge_t ) +
+					model->numNodes * (int)sizeof( cm_node_t ) + model->numPolygonRefs * (int)sizeof( cm_polygonRef_t ) +
+					model->numBrushRefs * (int)sizeof( cm_brushRef_t ) + model->polygonMemory + model->brushMemory ) {
+		return false;
+	}
+
+	// fix up the pointers
+	for ( p = (cm_polygon_t *) polygonData; (byte *) p < polygonData + model->polygonMemory;
+				p = (cm_polygon_t *) ( ( (byte *) p ) + sizeof( cm_polygon_t ) + ( p->numEdges - 1 ) * sizeof( p->edges[0] ) ) ) {
+		i = CM_PTR_TO_INDEX( p->material );
+		p->material = ( i >= 0 && i < materials.Num() ) ? materials[i] : NULL;
+	}
+	for ( b = (cm_brush_t *) brushData; (byte *) b < brushData + model->brushMemory;
+				b = (cm_brush_t *) ( ( (byte *) b ) + sizeof( cm_brush_t ) + ( b->numPlanes - 1 ) * sizeof( b->planes[0] ) ) ) {
+		i = CM_PTR_TO_INDEX( b->material );
+		b->material = ( i >= 0 && i < materials.Num() ) ? materials[i] : NULL;
+	}
+	for ( i = 0; i < model->numPolygonRefs; i++ ) {
+		pref = &polygonRefs[i];
+		pref->p = pref->p ? (cm_polygon_t *) ( polygonData + CM_PTR_TO_INDEX( pref->p ) - 1 ) : NULL;
+		pref->next = pref->next ? &polygonRefs[ CM_PTR_TO_INDEX( pref->next ) - 1 ] : NULL;
+	}
+	for ( i = 0; i < model->numBrushRefs; i++ ) {
+		bref = &brushRefs[i];
+		bref->b = bref->b ? (cm_brush_t *) ( brushData + CM_PTR_TO_INDEX( bref->b ) - 1 ) : NULL;
+		bref->next = bref->next ? &brushRefs[ CM_PTR_TO_INDEX( bref->next ) - 1 ] : NULL;
+	}
+	for ( i = 0; i < model->numNodes; i++ ) {
+		node = &nodes[i];
+		node->parent = node->parent ? &nodes[ CM_PTR_TO_INDEX( node->parent ) - 1 ] : NULL;
+		node->polygons = node->polygons ? &polygonRefs[ CM_PTR_TO_INDEX( node->polygons ) - 1 ] : NULL;
+		node->brushes = node->brushes ? &brushRefs[ CM_PTR_TO_INDEX( node->brushes ) - 1 ] : NULL;
+		if ( node->planeType != -1 ) {
+			node->children[0] = &nodes[ CM_PTR_TO_INDEX( node->children[0] ) ];
+			node->children[1] = &nodes[ CM_PTR_TO_INDEX( node->children[1] ) ];
+		} else {
+			node->children[0] = node->children[1] = NULL;
+		}
+	}
+	model->node = model->numNodes ? &nodes[0] : NULL;
+
+	//HUMANHEAD rww
+#if _HH_INLINED_PROC_CLIPMODELS
+	if (anyInlinedProcClipMats) {
+		if (model->name.Cmpn(PROC_CLIPMODEL_STRING_PRFX, strlen(PROC_CLIPMODEL_STRING_PRFX)) == 0) {
+			numInlinedProcClipModels++;
+		}
+	}
+#endif
+	//HUMANHEAD END
+
+	// total memory used by this model
+	model->usedMemory = model->numVertices * sizeof(cm_vertex_t) +
+						model->numEdges * sizeof(cm_edge_t) +
+						model->polygonMemory +
+						model->brushMemory +
+						model->numNodes * sizeof(cm_node_t) +
+						model->numPolygonRefs * sizeof(cm_polygonRef_t) +
+						model->numBrushRefs * sizeof(cm_brushRef_t);
+
+	return true;
+}
+
+/*
+================
+idCollisionModelManagerLocal::LoadBinaryCollisionModelFile
+================
+*/
+bool idCollisionModelManagerLocal::LoadBinaryCollisionModelFile( const char *name, unsigned int mapFileCRC ) {
+	int i, firstModel;
+	idFile *fp;
+	idStr fileName, sourceName;
+	ID_TIME_T sourceTimeStamp;
+	cm_binaryHeader_t header, expected;
+
+	if ( !cm_binaryModels.GetBool() ) {
+		return false;
+	}
+
+	fileName = name;
+	fileName.SetFileExtension( CM_BINARYFILE_EXT );
+	fp = fileSystem->OpenFileRead( fileName );
+	if ( !fp ) {
+		return false;
+	}
+
+	sourceName = name;
+	sourceName.SetFileExtension( CM_FILE_EXT );
+	fileSystem->ReadFile( sourceName, NULL, &sourceTimeStamp );
+
+	if ( fp->Read( &header, sizeof( header ) ) != sizeof( header ) ) {
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	CM_SetupBinaryHeader( &expected, header.mapFileCRC, sourceTimeStamp, header.numModels );
+	if ( memcmp( &header, &expected, sizeof( header ) ) != 0 ) {
+		common->DPrintf( "%s is out of date\n", fileName.c_str() );
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	if ( mapFileCRC && header.mapFileCRC != mapFileCRC ) {
+		common->DPrintf( "%s is out of date\n", fileName.c_str() );
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	firstModel = numModels;
+	for ( i = 0; i < header.numModels; i++ ) {
+		if ( !ReadBinaryCollisionModel( fp ) ) {
+			common->Warning( "%s is corrupt", fileName.c_str() );
+			// throw away whatever was read from the broken file
+			while( numModels > firstModel ) {
+				numModels--;
+				FreeModel( models[numModels] );
+				models[numModels] = NULL;
+			}
+			fileSystem->CloseFile( fp );
+			return false;
+		}
+	}
+
+	fileSystem->CloseFile( fp );
+
 	return true;
 }
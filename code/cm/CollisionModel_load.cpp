@@ -337,22 +337,21 @@ idCollisionModelManagerLocal::Clear
 ================
 */
 void idCollisionModelManagerLocal::Clear( void ) {
+	// recorded model handles are only valid for the current map
+	if ( recordedTraces.Num() ) {
+		WriteRecordedTraces();
+	}
+	maxRecordedTraces = 0;
 	mapName.Clear();
 	mapFileTime = 0;
 	loaded = 0;
-	checkCount = 0;
 	maxModels = 0;
 	numModels = 0;
 	models = NULL;
-	memset( trmPolygons, 0, sizeof( trmPolygons ) );
-	trmBrushes[0] = NULL;
 	trmMaterial = NULL;
 	numProcNodes = 0;
 	procNodes = NULL;
-	getContacts = false;
-	contacts = NULL;
-	maxContacts = 0;
-	numContacts = 0;
+	ClearTraceContexts();
 	//HUMANHEAD rww
 #if _HH_INLINED_PROC_CLIPMODELS
 	inlinedProcClipModelMats.Clear();
@@ -555,6 +554,9 @@ void idCollisionModelManagerLocal::FreeModel( cm_model_t *model ) {
 		nextNodeBlock = nodeBlock->next;
 		Mem_Free( nodeBlock );
 	}
+	// free the bounding volume hierarchy
+	Mem_Free( model->bvhNodes );
+	Mem_Free( model->bvhRefs );
 	// free block allocated polygons
 	Mem_Free( model->polygonBlock );
 	// free block allocated brushes
@@ -596,27 +598,54 @@ void idCollisionModelManagerLocal::FreeMap( void ) {
 	ShutdownHash();
 }
 
+/*
+================
+idCollisionModelManagerLocal::ClearTraceContexts
+
+  resets the per map state of all trace contexts, contexts stay allocated
+================
+*/
+void idCollisionModelManagerLocal::ClearTraceContexts( void ) {
+	int i;
+	bool inUse;
+
+	for ( i = 0; i < CM_MAX_TRACE_CONTEXTS; i++ ) {
+		inUse = traceContexts[i].inUse;
+		memset( &traceContexts[i], 0, sizeof( traceContexts[i] ) );
+		traceContexts[i].inUse = inUse;
+	}
+	traceContexts[CM_MAIN_TRACE_CONTEXT].inUse = true;
+}
+
 /*
 ================
 idCollisionModelManagerLocal::FreeTrmModelStructure
 ================
 */
 void idCollisionModelManagerLocal::FreeTrmModelStructure( void ) {
-	int i;
+	int i, j;
+	cm_model_t *model;
+	cm_traceContext_t *context;
 
 	assert( models );
-	if ( !models[MAX_SUBMODELS] ) {
-		return;
-	}
 
-	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
-		FreePolygon( models[MAX_SUBMODELS], trmPolygons[i]->p );
-	}
-	FreeBrush( models[MAX_SUBMODELS], trmBrushes[0]->b );
+	for ( i = 0; i < CM_MAX_TRACE_CONTEXTS; i++ ) {
+		model = models[TRACE_MODEL_HANDLE + i];
+		if ( !model ) {
+			continue;
+		}
+		context = &traceContexts[i];
+
+		for ( j = 0; j < MAX_TRACEMODEL_POLYS; j++ ) {
+			FreePolygon( model, context->trmPolygons[j]->p );
+		}
+		FreeBrush( model, context->trmBrushes[0]->b );
 
-	models[MAX_SUBMODELS]->node->polygons = NULL;
-	models[MAX_SUBMODELS]->node->brushes = NULL;
-	FreeModel( models[MAX_SUBMODELS] );
+		model->node->polygons = NULL;
+		model->node->brushes = NULL;
+		FreeModel( model );
+		models[TRACE_MODEL_HANDLE + i] = NULL;
+	}
 }
 
 
@@ -647,10 +676,10 @@ void idCollisionModelManagerLocal::CalculateEdgeNormals( cm_model_t *model, cm_n
 		for ( pref = node->polygons; pref; pref = pref->next ) {
 			p = pref->p;
 			// if we checked this polygon already
-			if ( p->checkcount == checkCount ) {
+			if ( p->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 				continue;
 			}
-			p->checkcount = checkCount;
+			p->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 
 			for ( i = 0; i < p->numEdges; i++ ) {
 				edgeNum = p->edges[i];
@@ -716,6 +745,10 @@ cm_model_t *idCollisionModelManagerLocal::AllocModel( void ) {
 	model->numEdges = 0;
 	model->edges= NULL;
 	model->node = NULL;
+	model->numBvhNodes = 0;
+	model->bvhNodes = NULL;
+	model->numBvhRefs = 0;
+	model->bvhRefs = NULL;
 	model->nodeBlocks = NULL;
 	model->polygonRefBlocks = NULL;
 	model->brushRefBlocks = NULL;
@@ -899,63 +932,74 @@ idCollisionModelManagerLocal::SetupTrmModelStructure
 ================
 */
 void idCollisionModelManagerLocal::SetupTrmModelStructure( void ) {
-	int i;
+	int i, j;
 	cm_node_t *node;
 	cm_model_t *model;
+	cm_traceContext_t *context;
+	cm_polygonRef_t **trmPolygons;
+	cm_brushRef_t **trmBrushes;
 
-	// setup model
-	model = AllocModel();
-
-	assert( models );
-	models[MAX_SUBMODELS] = model;
-	// create node to hold the collision data
-	node = (cm_node_t *) AllocNode( model, 1 );
-	node->planeType = -1;
-	model->node = node;
-	// allocate vertex and edge arrays
-	model->numVertices = 0;
-	model->maxVertices = MAX_TRACEMODEL_VERTS;
-	model->vertices = (cm_vertex_t *) Mem_ClearedAlloc( model->maxVertices * sizeof(cm_vertex_t) );
-	model->numEdges = 0;
-	model->maxEdges = MAX_TRACEMODEL_EDGES+1;
-	model->edges = (cm_edge_t *) Mem_ClearedAlloc( model->maxEdges * sizeof(cm_edge_t) );
 	// create a material for the trace model polygons
 	trmMaterial = declManager->FindMaterial( "_tracemodel", false );
 	if ( !trmMaterial ) {
 		common->FatalError( "_tracemodel material not found" );
 	}
 
-	// allocate polygons
-	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
-		trmPolygons[i] = AllocPolygonReference( model, MAX_TRACEMODEL_POLYS );
-		trmPolygons[i]->p = AllocPolygon( model, MAX_TRACEMODEL_POLYEDGES );
-		trmPolygons[i]->p->bounds.Clear();
-		trmPolygons[i]->p->plane.Zero();
-		trmPolygons[i]->p->checkcount = 0;
-		trmPolygons[i]->p->contents = -1;		// all contents
-		trmPolygons[i]->p->material = trmMaterial;
-		trmPolygons[i]->p->numEdges = 0;
+	assert( models );
+
+	// every trace context gets its own trace model slot
+	for ( j = 0; j < CM_MAX_TRACE_CONTEXTS; j++ ) {
+		context = &traceContexts[j];
+		trmPolygons = context->trmPolygons;
+		trmBrushes = context->trmBrushes;
+
+		// setup model
+		model = AllocModel();
+		models[TRACE_MODEL_HANDLE + j] = model;
+		// create node to hold the collision data
+		node = (cm_node_t *) AllocNode( model, 1 );
+		node->planeType = -1;
+		model->node = node;
+		// allocate vertex and edge arrays
+		model->numVertices = 0;
+		model->maxVertices = MAX_TRACEMODEL_VERTS;
+		model->vertices = (cm_vertex_t *) Mem_ClearedAlloc( model->maxVertices * sizeof(cm_vertex_t) );
+		model->numEdges = 0;
+		model->maxEdges = MAX_TRACEMODEL_EDGES+1;
+		model->edges = (cm_edge_t *) Mem_ClearedAlloc( model->maxEdges * sizeof(cm_edge_t) );
+
+		// allocate polygons
+		for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
+			trmPolygons[i] = AllocPolygonReference( model, MAX_TRACEMODEL_POLYS );
+			trmPolygons[i]->p = AllocPolygon( model, MAX_TRACEMODEL_POLYEDGES );
+			trmPolygons[i]->p->bounds.Clear();
+			trmPolygons[i]->p->plane.Zero();
+			memset( trmPolygons[i]->p->checkcount, 0, sizeof( trmPolygons[i]->p->checkcount ) );
+			trmPolygons[i]->p->contents = -1;		// all contents
+			trmPolygons[i]->p->material = trmMaterial;
+			trmPolygons[i]->p->numEdges = 0;
+		}
+		// allocate brush for position test
+		trmBrushes[0] = AllocBrushReference( model, 1 );
+		trmBrushes[0]->b = AllocBrush( model, MAX_TRACEMODEL_POLYS );
+		trmBrushes[0]->b->primitiveNum = 0;
+		trmBrushes[0]->b->bounds.Clear();
+		memset( trmBrushes[0]->b->checkcount, 0, sizeof( trmBrushes[0]->b->checkcount ) );
+		trmBrushes[0]->b->contents = -1;		// all contents
+		trmBrushes[0]->b->material = trmMaterial; //HUMANHEAD rww
+		trmBrushes[0]->b->numPlanes = 0;
 	}
-	// allocate brush for position test
-	trmBrushes[0] = AllocBrushReference( model, 1 );
-	trmBrushes[0]->b = AllocBrush( model, MAX_TRACEMODEL_POLYS );
-	trmBrushes[0]->b->primitiveNum = 0;
-	trmBrushes[0]->b->bounds.Clear();
-	trmBrushes[0]->b->checkcount = 0;
-	trmBrushes[0]->b->contents = -1;		// all contents
-	trmBrushes[0]->b->material = trmMaterial; //HUMANHEAD rww
-	trmBrushes[0]->b->numPlanes = 0;
 }
 
 /*
 ================
 idCollisionModelManagerLocal::SetupTrmModel
 
-Trace models (item boxes, etc) are converted to collision models on the fly, using the last model slot
-as a reusable temporary buffer
+Trace models (item boxes, etc) are converted to collision models on the fly, using the trace model slot
+of the trace context as a reusable temporary buffer
 ================
 */
-cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm, const idMaterial *material ) {
+cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm, const idMaterial *material, int traceContext ) {
 	int i, j;
 	cm_vertex_t *vertex;
 	cm_edge_t *edge;
@@ -964,19 +1008,25 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	const traceModelVert_t *trmVert;
 	const traceModelEdge_t *trmEdge;
 	const traceModelPoly_t *trmPoly;
+	cm_polygonRef_t **trmPolygons;
+	cm_brushRef_t **trmBrushes;
 
 	assert( models );
+	assert( traceContext >= 0 && traceContext < CM_MAX_TRACE_CONTEXTS );
 
 	if ( material == NULL ) {
 		material = trmMaterial;
 	}
 
-	model = models[MAX_SUBMODELS];
+	trmPolygons = traceContexts[traceContext].trmPolygons;
+	trmBrushes = traceContexts[traceContext].trmBrushes;
+
+	model = models[TRACE_MODEL_HANDLE + traceContext];
 	model->node->brushes = NULL;
 	model->node->polygons = NULL;
 	// if not a valid trace model
 	if ( trm.type == TRM_INVALID || !trm.numPolys ) {
-		return TRACE_MODEL_HANDLE;
+		return TRACE_MODEL_HANDLE + traceContext;
 	}
 	// vertices
 	model->numVertices = trm.numVerts;
@@ -984,7 +1034,7 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	trmVert = trm.verts;
 	for ( i = 0; i < trm.numVerts; i++, vertex++, trmVert++ ) {
 		vertex->p = *trmVert;
-		vertex->sideSet = 0;
+		vertex->stamps[traceContext].sideSet = 0;
 	}
 	// edges
 	model->numEdges = trm.numEdges;
@@ -995,7 +1045,7 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		edge->vertexNum[1] = trmEdge->v[1];
 		edge->normal = trmEdge->normal;
 		edge->internal = false;
-		edge->sideSet = 0;
+		edge->stamps[traceContext].sideSet = 0;
 	}
 	// polygons
 	model->numPolygons = trm.numPolys;
@@ -1031,7 +1081,36 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	// convex
 	model->isConvex = trm.isConvex;
 
-	return TRACE_MODEL_HANDLE;
+	return TRACE_MODEL_HANDLE + traceContext;
+}
+
+/*
+================
+idCollisionModelManagerLocal::AllocTraceContext
+================
+*/
+int idCollisionModelManagerLocal::AllocTraceContext( void ) {
+	int i;
+
+	for ( i = 0; i < CM_MAX_TRACE_CONTEXTS; i++ ) {
+		if ( i != CM_MAIN_TRACE_CONTEXT && !traceContexts[i].inUse ) {
+			traceContexts[i].inUse = true;
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idCollisionModelManagerLocal::FreeTraceContext
+================
+*/
+void idCollisionModelManagerLocal::FreeTraceContext( int traceContext ) {
+	if ( traceContext < 0 || traceContext >= CM_MAX_TRACE_CONTEXTS || traceContext == CM_MAIN_TRACE_CONTEXT ) {
+		return;
+	}
+	traceContexts[traceContext].inUse = false;
 }
 
 /*
@@ -1279,10 +1358,10 @@ void idCollisionModelManagerLocal::R_ChopWindingListWithTreeBrushes( cm_windingL
 		for ( bref = node->brushes; bref; bref = bref->next ) {
 			b = bref->b;
 			// if we checked this brush already
-			if ( b->checkcount == checkCount ) {
+			if ( b->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 				continue;
 			}
-			b->checkcount = checkCount;
+			b->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 			// if the windings in the list originate from this brush
 			if ( b->primitiveNum == list->primitiveNum ) {
 				continue;
@@ -1360,7 +1439,7 @@ idFixedWinding *idCollisionModelManagerLocal::WindingOutsideBrushes( idFixedWind
 	cm_windingList->contents = contents;
 	cm_windingList->primitiveNum = primitiveNum;
 	//
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	R_ChopWindingListWithTreeBrushes( cm_windingList, headNode );
 	//
 	if ( !cm_windingList->numWindings ) {
@@ -1622,7 +1701,7 @@ cm_polygon_t *idCollisionModelManagerLocal::TryMergePolygons( cm_model_t *model,
 	memcpy( newp, p1, sizeof(cm_polygon_t) );
 	memcpy( newp->edges, newEdges, newNumEdges * sizeof(int) );
 	newp->numEdges = newNumEdges;
-	newp->checkcount = 0;
+	memset( newp->checkcount, 0, sizeof( newp->checkcount ) );
 	// increase usage count for the edges of this polygon
 	for ( i = 0; i < newp->numEdges; i++ ) {
 		if ( !keep1 && newp->edges[i] == newEdgeNum1 ) {
@@ -1715,10 +1794,10 @@ void idCollisionModelManagerLocal::MergeTreePolygons( cm_model_t *model, cm_node
 			for ( pref = node->polygons; pref; pref = pref->next ) {
 				p = pref->p;
 				// if we checked this polygon already
-				if ( p->checkcount == checkCount ) {
+				if ( p->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 					continue;
 				}
-				p->checkcount = checkCount;
+				p->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 				// try to merge this polygon with other polygons in the tree
 				if ( MergePolygonWithTreePolygons( model, model->node, p ) ) {
 					merge = true;
@@ -1969,10 +2048,10 @@ void idCollisionModelManagerLocal::FindInternalEdges( cm_model_t *model, cm_node
 		for ( pref = node->polygons; pref; pref = pref->next ) {
 			p = pref->p;
 			// if we checked this polygon already
-			if ( p->checkcount == checkCount ) {
+			if ( p->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 				continue;
 			}
-			p->checkcount = checkCount;
+			p->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 
 			FindInternalPolygonEdges( model, model->node, p );
 
@@ -2480,7 +2559,7 @@ int idCollisionModelManagerLocal::GetVertex( cm_model_t *model, const idVec3 &v,
 		cm_vertexHash->ResizeIndex( model->maxVertices );
 	}
 	model->vertices[model->numVertices].p = vert;
-	model->vertices[model->numVertices].checkcount = 0;
+	memset( model->vertices[model->numVertices].stamps, 0, sizeof( model->vertices[0].stamps ) );
 	*vertexNum = model->numVertices;
 	// add vertice to hash
 	cm_vertexHash->Add( hashKey, model->numVertices );
@@ -2564,7 +2643,7 @@ int idCollisionModelManagerLocal::GetEdge( cm_model_t *model, const idVec3 &v1,
 	model->edges[model->numEdges].vertexNum[0] = v1num;
 	model->edges[model->numEdges].vertexNum[1] = v2num;
 	model->edges[model->numEdges].internal = false;
-	model->edges[model->numEdges].checkcount = 0;
+	memset( model->edges[model->numEdges].stamps, 0, sizeof( model->edges[0].stamps ) );
 	model->edges[model->numEdges].numUsers = 1; // used by one polygon atm
 	model->edges[model->numEdges].normal.Zero();
 	//
@@ -2627,7 +2706,7 @@ void idCollisionModelManagerLocal::CreatePolygon( cm_model_t *model, idFixedWind
 	p->numEdges = numPolyEdges;
 	p->contents = material->GetContentFlags();
 	p->material = material;
-	p->checkcount = 0;
+	memset( p->checkcount, 0, sizeof( p->checkcount ) );
 	p->plane = plane;
 	p->bounds = bounds;
 	for ( i = 0; i < numPolyEdges; i++ ) {
@@ -2897,7 +2976,7 @@ void idCollisionModelManagerLocal::ConvertBrush( cm_model_t *model, const idMapB
 	}
 	// create brush for position test
 	brush = AllocBrush( model, mapBrush->GetNumSides() );
-	brush->checkcount = 0;
+	memset( brush->checkcount, 0, sizeof( brush->checkcount ) );
 	brush->contents = contents;
 	brush->material = material;
 	brush->primitiveNum = primitiveNum;
@@ -3005,10 +3084,10 @@ void idCollisionModelManagerLocal::RemapEdges( cm_node_t *node, int *edgeRemap )
 		for ( pref = node->polygons; pref; pref = pref->next ) {
 			p = pref->p;
 			// if we checked this polygon already
-			if ( p->checkcount == checkCount ) {
+			if ( p->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 				continue;
 			}
-			p->checkcount = checkCount;
+			p->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 			for ( i = 0; i < p->numEdges; i++ ) {
 				if ( p->edges[i] < 0 ) {
 					p->edges[i] = -edgeRemap[ abs(p->edges[i]) ];
@@ -3075,7 +3154,7 @@ void idCollisionModelManagerLocal::OptimizeArrays( cm_model_t *model ) {
 		}
 	}
 	// change polygon edge indexes
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	RemapEdges( model->node, remap );
 	model->numEdges = newNumEdges;
 
@@ -3105,13 +3184,13 @@ idCollisionModelManagerLocal::FinishModel
 */
 void idCollisionModelManagerLocal::FinishModel( cm_model_t *model ) {
 	// try to merge polygons
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	MergeTreePolygons( model, model->node );
 	// find internal edges (no mesh can ever collide with internal edges)
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	FindInternalEdges( model, model->node );
 	// calculate edge normals
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	CalculateEdgeNormals( model, model->node );
 
 	//common->Printf( "%s vertex hash spread is %d\n", model->name.c_str(), cm_vertexHash->GetSpread() );
@@ -3424,7 +3503,7 @@ void idCollisionModelManagerLocal::ModelInfo( cmHandle_t model ) {
 		PrintModelInfo( &modelInfo );
 		return;
 	}
-	if ( model < 0 || model > MAX_SUBMODELS || model > maxModels ) {
+	if ( model < 0 || model >= TRACE_MODEL_HANDLE + CM_MAX_TRACE_CONTEXTS || model >= maxModels + CM_MAX_TRACE_CONTEXTS ) {
 		common->Printf( "idCollisionModelManagerLocal::ModelInfo: invalid model handle\n" );
 		return;
 	}
@@ -3553,8 +3632,10 @@ void idCollisionModelManagerLocal::BuildModels( const idMapFile *mapFile ) {
 		//	}
 		//}
 		WriteCollisionModelsToFile( mapFile->GetName(), firstModel, numModels, mapFile->GetGeometryCRC() );
+		WriteBinaryCollisionModelsToFile( mapFile->GetName(), firstModel, numModels, mapFile->GetGeometryCRC() );
 #else
 		WriteCollisionModelsToFile( mapFile->GetName(), 0, numModels, mapFile->GetGeometryCRC() );
+		WriteBinaryCollisionModelsToFile( mapFile->GetName(), 0, numModels, mapFile->GetGeometryCRC() );
 #endif
 	}
 
@@ -3599,7 +3680,7 @@ void idCollisionModelManagerLocal::LoadMap( const idMapFile *mapFile ) {
 	// models
 	maxModels = MAX_SUBMODELS;
 	numModels = 0;
-	models = (cm_model_t **) Mem_ClearedAlloc( (maxModels+1) * sizeof(cm_model_t *) );
+	models = (cm_model_t **) Mem_ClearedAlloc( (maxModels+CM_MAX_TRACE_CONTEXTS) * sizeof(cm_model_t *) );
 
 	// setup hash to speed up finding shared vertices and edges
 	SetupHash();
@@ -3609,6 +3690,7 @@ void idCollisionModelManagerLocal::LoadMap( const idMapFile *mapFile ) {
 
 	// build collision models
 	BuildModels( mapFile );
+	BuildModelBVHs();
 
 	// save name and time stamp
 	mapName = mapFile->GetName();
@@ -3732,6 +3814,86 @@ bool idCollisionModelManagerLocal::GetModelPolygon( cmHandle_t model, int polygo
 	return true;
 }
 
+/*
+===================
+idCollisionModelManagerLocal::GetNodePolygons_r
+===================
+*/
+bool idCollisionModelManagerLocal::GetNodePolygons_r( const cm_model_t *model, const cm_node_t *node, const idBounds &bounds, int contentMask,
+								cmPolygon_t *polygons, const int maxPolygons, int &numPolygons, idVec3 *points, const int maxPoints, int &numPoints ) {
+	int i, edgeNum;
+	cm_polygon_t *p;
+	cm_polygonRef_t *pref;
+
+	while( 1 ) {
+		for ( pref = node->polygons; pref; pref = pref->next ) {
+			p = pref->p;
+			if ( p->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
+				continue;
+			}
+			p->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
+			if ( !( p->contents & contentMask ) ) {
+				continue;
+			}
+			if ( !p->bounds.IntersectsBounds( bounds ) ) {
+				continue;
+			}
+			if ( numPolygons >= maxPolygons || numPoints + p->numEdges > maxPoints ) {
+				return false;
+			}
+			cmPolygon_t &polygon = polygons[numPolygons++];
+			polygon.plane = p->plane;
+			polygon.material = p->material;
+			polygon.contents = p->contents;
+			polygon.firstPoint = numPoints;
+			polygon.numPoints = p->numEdges;
+			for ( i = 0; i < p->numEdges; i++ ) {
+				edgeNum = p->edges[i];
+				points[numPoints++] = model->vertices[ model->edges[abs(edgeNum)].vertexNum[INTSIGNBITSET(edgeNum)] ].p;
+			}
+		}
+		if ( node->planeType == -1 ) {
+			break;
+		}
+		if ( bounds[0][node->planeType] > node->planeDist ) {
+			node = node->children[0];
+		} else if ( bounds[1][node->planeType] < node->planeDist ) {
+			node = node->children[1];
+		} else {
+			if ( !GetNodePolygons_r( model, node->children[1], bounds, contentMask, polygons, maxPolygons, numPolygons, points, maxPoints, numPoints ) ) {
+				return false;
+			}
+			node = node->children[0];
+		}
+	}
+	return true;
+}
+
+/*
+===================
+idCollisionModelManagerLocal::GetModelPolygons
+
+  Only call from the main thread, the polygons are marked with the check count of the main trace context.
+===================
+*/
+int idCollisionModelManagerLocal::GetModelPolygons( cmHandle_t model, const idBounds &bounds, int contentMask,
+								cmPolygon_t *polygons, const int maxPolygons, idVec3 *points, const int maxPoints ) {
+	int numPolygons, numPoints;
+
+	if ( model < 0 || model > MAX_SUBMODELS || model >= numModels || !models[model] ) {
+		common->Printf( "idCollisionModelManagerLocal::GetModelPolygons: invalid model handle\n" );
+		return -1;
+	}
+
+	numPolygons = 0;
+	numPoints = 0;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
+	if ( !GetNodePolygons_r( models[model], models[model]->node, bounds, contentMask, polygons, maxPolygons, numPolygons, points, maxPoints, numPoints ) ) {
+		return -1;
+	}
+	return numPolygons;
+}
+
 /*
 ==================
 idCollisionModelManagerLocal::LoadModel
@@ -3754,6 +3916,7 @@ cmHandle_t idCollisionModelManagerLocal::LoadModel( const char *modelName, const
 	if ( LoadCollisionModelFile( modelName, 0 ) ) {
 		handle = FindModel( modelName );
 		if ( handle >= 0 ) {
+			BuildModelBVHs();
 			return handle;
 		} else {
 			common->Warning( "idCollisionModelManagerLocal::LoadModel: collision file for '%s' contains different model", modelName );
@@ -3768,6 +3931,7 @@ cmHandle_t idCollisionModelManagerLocal::LoadModel( const char *modelName, const
 	// try to load a .ASE or .LWO model and convert it to a collision model
 	models[numModels] = LoadRenderModel( modelName );
 	if ( models[numModels] != NULL ) {
+		BuildBVH( models[numModels] );
 		numModels++;
 		return ( numModels - 1 );
 	}
@@ -3789,11 +3953,11 @@ bool idCollisionModelManagerLocal::TrmFromModel_r( idTraceModel &trm, cm_node_t
 		for ( pref = node->polygons; pref; pref = pref->next ) {
 			p = pref->p;
 
-			if ( p->checkcount == checkCount ) {
+			if ( p->checkcount[CM_MAIN_TRACE_CONTEXT] == traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount ) {
 				continue;
 			}
 
-			p->checkcount = checkCount;
+			p->checkcount[CM_MAIN_TRACE_CONTEXT] = traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount;
 
 			if ( trm.numPolys >= MAX_TRACEMODEL_POLYS ) {
 				return false;
@@ -3851,7 +4015,7 @@ bool idCollisionModelManagerLocal::TrmFromModel( const cm_model_t *model, idTrac
 	trm.bounds.Clear();
 
 	// copy polygons
-	checkCount++;
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
 	if ( !TrmFromModel_r( trm, model->node ) ) {
 		common->Printf( "idCollisionModelManagerLocal::TrmFromModel: model %s has too many polygons.\n", model->name.c_str() );
 		PrintModelInfo( model );
@@ -3929,6 +4093,248 @@ bool idCollisionModelManagerLocal::TrmFromModel( const char *modelName, idTraceM
 	return TrmFromModel( models[ handle ], trm );
 }
 
+
+/*
+===============================================================================
+
+Bounding volume hierarchy
+
+===============================================================================
+*/
+
+typedef struct cm_bvhPrimitive_s {
+	idBounds				bounds;
+	idVec3					center;
+	cm_bvhRef_t				ref;
+	bool					isBrush;
+} cm_bvhPrimitive_t;
+
+typedef struct cm_bvhBuild_s {
+	idList<cm_bvhPrimitive_t>	primitives;
+	idList<cm_bvhNode_t>		nodes;
+	idList<cm_bvhRef_t>			refs;
+} cm_bvhBuild_t;
+
+/*
+================
+CM_BoundsArea
+================
+*/
+static float CM_BoundsArea( const idBounds &bounds ) {
+	idVec3 d;
+
+	if ( bounds.IsCleared() ) {
+		return 0.0f;
+	}
+	d = bounds[1] - bounds[0];
+	return 2.0f * ( d[0] * d[1] + d[1] * d[2] + d[2] * d[0] );
+}
+
+/*
+================
+idCollisionModelManagerLocal::BuildBVH_r
+
+  Splits the primitives at the cheapest bin boundary according to the
+  surface area heuristic and returns the number of the created node.
+================
+*/
+int idCollisionModelManagerLocal::BuildBVH_r( cm_bvhBuild_t &build, int first, int count, int depth ) {
+	int i, j, axis, bin, nodeNum, numLeft, bestAxis, bestSplit;
+	int binCounts[CM_BVH_BINS], leftCounts[CM_BVH_BINS];
+	float area, cost, bestCost, extent, scale, rightArea;
+	float leftAreas[CM_BVH_BINS];
+	idBounds bounds, centerBounds, binBounds[CM_BVH_BINS], sweep;
+	cm_bvhPrimitive_t *prims, tmp;
+	cm_bvhNode_t *node;
+
+	prims = &build.primitives[first];
+
+	bounds.Clear();
+	centerBounds.Clear();
+	for ( i = 0; i < count; i++ ) {
+		bounds.AddBounds( prims[i].bounds );
+		centerBounds.AddPoint( prims[i].center );
+	}
+
+	nodeNum = build.nodes.Num();
+	node = &build.nodes.Alloc();
+	node->mins[0] = bounds[0][0];
+	node->mins[1] = bounds[0][1];
+	node->mins[2] = bounds[0][2];
+	node->maxs[0] = bounds[1][0];
+	node->maxs[1] = bounds[1][1];
+	node->maxs[2] = bounds[1][2];
+
+	// find the cheapest split, a leaf costs one intersection test per primitive
+	bestAxis = -1;
+	bestSplit = 0;
+	bestCost = count;
+	area = CM_BoundsArea( bounds );
+
+	if ( count > CM_BVH_MAX_LEAF_PRIMITIVES && depth < CM_BVH_MAX_DEPTH - 1 && area > 0.0f ) {
+		for ( axis = 0; axis < 3; axis++ ) {
+			extent = centerBounds[1][axis] - centerBounds[0][axis];
+			if ( extent <= 0.0f ) {
+				continue;
+			}
+			scale = CM_BVH_BINS / extent;
+
+			for ( bin = 0; bin < CM_BVH_BINS; bin++ ) {
+				binCounts[bin] = 0;
+				binBounds[bin].Clear();
+			}
+			for ( i = 0; i < count; i++ ) {
+				bin = idMath::FtoiFast( ( prims[i].center[axis] - centerBounds[0][axis] ) * scale );
+				if ( bin > CM_BVH_BINS - 1 ) {
+					bin = CM_BVH_BINS - 1;
+				}
+				binCounts[bin]++;
+				binBounds[bin].AddBounds( prims[i].bounds );
+			}
+
+			// sweep from the left to get the area and count left of each split
+			sweep.Clear();
+			numLeft = 0;
+			for ( bin = 0; bin < CM_BVH_BINS - 1; bin++ ) {
+				sweep.AddBounds( binBounds[bin] );
+				numLeft += binCounts[bin];
+				leftAreas[bin] = CM_BoundsArea( sweep );
+				leftCounts[bin] = numLeft;
+			}
+			// sweep from the right and evaluate the splits
+			sweep.Clear();
+			for ( bin = CM_BVH_BINS - 1; bin > 0; bin-- ) {
+				sweep.AddBounds( binBounds[bin] );
+				if ( leftCounts[bin-1] == 0 || leftCounts[bin-1] == count ) {
+					continue;
+				}
+				rightArea = CM_BoundsArea( sweep );
+				cost = 1.0f + ( leftAreas[bin-1] * leftCounts[bin-1] + rightArea * ( count - leftCounts[bin-1] ) ) / area;
+				if ( cost < bestCost ) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = bin;
+				}
+			}
+		}
+	}
+
+	if ( bestAxis == -1 ) {
+		assert( count <= 0x7FFF );
+		// create a leaf with the polygons first and the brushes after them
+		node->offset = build.refs.Num();
+		node->numPolygons = 0;
+		node->numBrushes = 0;
+		for ( i = 0; i < count; i++ ) {
+			if ( !prims[i].isBrush ) {
+				build.refs.Append( prims[i].ref );
+				node->numPolygons++;
+			}
+		}
+		for ( i = 0; i < count; i++ ) {
+			if ( prims[i].isBrush ) {
+				build.refs.Append( prims[i].ref );
+				node->numBrushes++;
+			}
+		}
+		return nodeNum;
+	}
+
+	// move all primitives left of the split to the front
+	scale = CM_BVH_BINS / ( centerBounds[1][bestAxis] - centerBounds[0][bestAxis] );
+	for ( i = 0, j = count - 1; i <= j; ) {
+		bin = idMath::FtoiFast( ( prims[i].center[bestAxis] - centerBounds[0][bestAxis] ) * scale );
+		if ( bin < bestSplit ) {
+			i++;
+		} else {
+			tmp = prims[i];
+			prims[i] = prims[j];
+			prims[j] = tmp;
+			j--;
+		}
+	}
+	numLeft = i;
+
+	node->numPolygons = -1;
+	node->numBrushes = 0;
+	// the first child directly follows the node
+	BuildBVH_r( build, first, numLeft, depth + 1 );
+	i = BuildBVH_r( build, first + numLeft, count - numLeft, depth + 1 );
+	// the node list may have been reallocated
+	build.nodes[nodeNum].offset = i;
+	return nodeNum;
+}
+
+/*
+================
+idCollisionModelManagerLocal::BuildBVH
+================
+*/
+void idCollisionModelManagerLocal::BuildBVH( cm_model_t *model ) {
+	int i;
+	idList<cm_polygon_t *> polygons;
+	idList<cm_brush_t *> brushes;
+	cm_bvhPrimitive_t *prim;
+	cm_bvhBuild_t build;
+
+	compile_time_assert( sizeof( cm_bvhNode_t ) == 32 );
+
+	if ( !model->node || model->bvhNodes ) {
+		return;
+	}
+
+	// every polygon and brush once
+	traceContexts[CM_MAIN_TRACE_CONTEXT].checkCount++;
+	GatherBinaryPolygons( model->node, polygons, brushes );
+	if ( !polygons.Num() && !brushes.Num() ) {
+		return;
+	}
+
+	build.primitives.SetNum( polygons.Num() + brushes.Num() );
+	for ( i = 0; i < polygons.Num(); i++ ) {
+		prim = &build.primitives[i];
+		prim->bounds = polygons[i]->bounds;
+		prim->center = prim->bounds.GetCenter();
+		prim->ref.p = polygons[i];
+		prim->isBrush = false;
+	}
+	for ( i = 0; i < brushes.Num(); i++ ) {
+		prim = &build.primitives[polygons.Num() + i];
+		prim->bounds = brushes[i]->bounds;
+		prim->center = prim->bounds.GetCenter();
+		prim->ref.b = brushes[i];
+		prim->isBrush = true;
+	}
+
+	build.nodes.SetGranularity( 1024 );
+	build.refs.SetGranularity( 1024 );
+	BuildBVH_r( build, 0, build.primitives.Num(), 0 );
+
+	model->numBvhNodes = build.nodes.Num();
+	model->bvhNodes = (cm_bvhNode_t *) Mem_Alloc( model->numBvhNodes * sizeof( cm_bvhNode_t ) );
+	memcpy( model->bvhNodes, build.nodes.Ptr(), model->numBvhNodes * sizeof( cm_bvhNode_t ) );
+	model->numBvhRefs = build.refs.Num();
+	model->bvhRefs = (cm_bvhRef_t *) Mem_Alloc( model->numBvhRefs * sizeof( cm_bvhRef_t ) );
+	memcpy( model->bvhRefs, build.refs.Ptr(), model->numBvhRefs * sizeof( cm_bvhRef_t ) );
+
+	model->usedMemory += model->numBvhNodes * sizeof( cm_bvhNode_t ) + model->numBvhRefs * sizeof( cm_bvhRef_t );
+}
+
+/*
+================
+idCollisionModelManagerLocal::BuildModelBVHs
+================
+*/
+void idCollisionModelManagerLocal::BuildModelBVHs( void ) {
+	int i;
+
+	for ( i = 0; i < numModels; i++ ) {
+		if ( models[i] ) {
+			BuildBVH( models[i] );
+		}
+	}
+}
+
 // HUMANHEAD pdm: Support for level appending
 #if DEATHWALK_AUTOLOAD
 bool idCollisionModelManagerLocal::WillUseAlreadyLoadedCollisionMap(const idMapFile *mapFile) {
@@ -3941,6 +4347,7 @@ void idCollisionModelManagerLocal::AppendMap( const idMapFile *mapFile ) {
 	// build collision models for our appended map
 	if (mapFile) {
 		idCollisionModelManagerLocal::BuildModels( mapFile );
+		idCollisionModelManagerLocal::BuildModelBVHs();
 	}
 }
 #endif
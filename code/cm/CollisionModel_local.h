@@ -15,7 +15,11 @@
 #define CIRCLE_APPROXIMATION_LENGTH			64.0f
 
 #define	MAX_SUBMODELS						2048
-#define	TRACE_MODEL_HANDLE					MAX_SUBMODELS
+#define	TRACE_MODEL_HANDLE					MAX_SUBMODELS		// first of CM_MAX_TRACE_CONTEXTS trace model slots
+#define CM_MAX_BATCH_NODES					2048	// node references gathered per trace batch
+#define CM_BVH_BINS							16		// number of bins for the surface area heuristic
+#define CM_BVH_MAX_LEAF_PRIMITIVES			8		// leaves with fewer primitives are never split
+#define CM_BVH_MAX_DEPTH					64		// depth of the traversal stack
 
 #define VERTEX_HASH_BOXSIZE					(1<<6)	// must be power of 2
 #define VERTEX_HASH_SIZE					(VERTEX_HASH_BOXSIZE*VERTEX_HASH_BOXSIZE)
@@ -51,21 +55,23 @@ Collision model
 ===============================================================================
 */
 
+typedef struct cm_traceStamp_s {
+	int						checkcount;			// for multi-check avoidance
+	unsigned long			side;				// each bit tells at which side of the trace model feature this vertex or edge passes
+	unsigned long			sideSet;			// each bit tells if sidedness for the trace model feature has been calculated yet
+} cm_traceStamp_t;
+
 typedef struct cm_vertex_s {
 	idVec3					p;					// vertex point
-	int						checkcount;			// for multi-check avoidance
-	unsigned long			side;				// each bit tells at which side this vertex passes one of the trace model edges
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model edge has been calculated yet
+	cm_traceStamp_t			stamps[CM_MAX_TRACE_CONTEXTS];	// per trace context
 } cm_vertex_t;
 
 typedef struct cm_edge_s {
-	int						checkcount;			// for multi-check avoidance
 	unsigned short			internal;			// a trace model can never collide with internal edges
 	unsigned short			numUsers;			// number of polygons using this edge
-	unsigned long			side;				// each bit tells at which side of this edge one of the trace model vertices passes
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model vertex has been calculated yet
 	int						vertexNum[2];		// start and end point of edge
 	idVec3					normal;				// edge normal
+	cm_traceStamp_t			stamps[CM_MAX_TRACE_CONTEXTS];	// per trace context
 } cm_edge_t;
 
 typedef struct cm_polygonBlock_s {
@@ -75,7 +81,7 @@ typedef struct cm_polygonBlock_s {
 
 typedef struct cm_polygon_s {
 	idBounds				bounds;				// polygon bounds
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount[CM_MAX_TRACE_CONTEXTS];	// for multi-check avoidance per trace context
 	int						contents;			// contents behind polygon
 	const idMaterial *		material;			// material
 	idPlane					plane;				// polygon plane
@@ -99,7 +105,7 @@ typedef struct cm_brushBlock_s {
 } cm_brushBlock_t;
 
 typedef struct cm_brush_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount[CM_MAX_TRACE_CONTEXTS];	// for multi-check avoidance per trace context
 	idBounds				bounds;				// brush bounds
 	int						contents;			// contents of brush
 	const idMaterial *		material;			// material
@@ -118,6 +124,32 @@ typedef struct cm_brushRefBlock_s {
 	struct cm_brushRefBlock_s *next;			// next block with brush references
 } cm_brushRefBlock_t;
 
+/*
+===============================================================================
+
+Bounding volume hierarchy
+
+	Optional hierarchy over all polygons and brushes of a model built with
+	the surface area heuristic. Unlike the axial tree every primitive is
+	referenced exactly once. Nodes are stored depth first, the first child
+	of an interior node directly follows its parent.
+
+===============================================================================
+*/
+
+typedef struct cm_bvhNode_s {
+	float					mins[3];			// node bounds
+	float					maxs[3];
+	int						offset;				// first reference for leaves, second child for interior nodes
+	short					numPolygons;		// polygon references of a leaf, -1 for interior nodes
+	short					numBrushes;			// brush references following the polygons of a leaf
+} cm_bvhNode_t;									// 32 bytes
+
+typedef union cm_bvhRef_u {
+	cm_polygon_t *			p;
+	cm_brush_t *			b;
+} cm_bvhRef_t;
+
 typedef struct cm_node_s {
 	int						planeType;			// node axial plane type
 	float					planeDist;			// node plane distance
@@ -145,6 +177,10 @@ typedef struct cm_model_s {
 	int						numEdges;			// number of edges
 	cm_edge_t *				edges;				// array with all edges used by the model
 	cm_node_t *				node;				// first node of spatial subdivision
+	int						numBvhNodes;		// number of bounding volume hierarchy nodes
+	cm_bvhNode_t *			bvhNodes;			// bounding volume hierarchy or NULL
+	int						numBvhRefs;			// number of primitive references in the hierarchy leaves
+	cm_bvhRef_t *			bvhRefs;			// primitive references of the hierarchy leaves
 	// blocks with allocated memory
 	cm_nodeBlock_t *		nodeBlocks;			// list with blocks of nodes
 	cm_polygonRefBlock_t *	polygonRefBlocks;	// list with blocks of polygon references
@@ -205,6 +241,8 @@ typedef struct cm_trmPolygon_s {
 } cm_trmPolygon_t;
 
 typedef struct cm_traceWork_s {
+	int context;									// trace context this trace runs in
+	int checkCount;									// check count stamped on model features in the context slot
 	int numVerts;
 	cm_trmVertex_t vertices[MAX_TRACEMODEL_VERTS];	// trm vertices
 	int numEdges;
@@ -253,11 +291,90 @@ typedef struct cm_traceWork_s {
 /*
 ===============================================================================
 
+Trace contexts
+
+	Everything a trace writes outside its cm_traceWork_t lives in a trace
+	context, so traces in different contexts can run at the same time.
+	Context 0 belongs to the main thread and is also used by the loading,
+	file writing and debug drawing code.
+
+===============================================================================
+*/
+
+typedef struct cm_batchNode_s {
+	cm_node_t *				node;				// node with collision data
+	struct cm_batchNode_s *	next;				// next node for the same trace
+} cm_batchNode_t;
+
+typedef struct cm_traceContext_s {
+	bool					inUse;				// allocated to a thread
+	int						checkCount;			// check count for this context's slot in the model features
+	int						entered;			// recursion guard for collision debugging
+	// for retrieving contact points
+	bool					getContacts;
+	contactInfo_t *			contacts;
+	int						maxContacts;
+	int						numContacts;
+	// polygons and brush for the trm model of this context
+	cm_polygonRef_t *		trmPolygons[MAX_TRACEMODEL_POLYS];
+	cm_brushRef_t *			trmBrushes[1];
+	// nodes gathered for a batch of translations
+	cm_batchNode_t			batchNodes[CM_MAX_BATCH_NODES];
+	int						numBatchNodes;
+	const cm_batchNode_t *	batchList;			// nodes for the translation in progress, NULL when not batched
+	// trace work space, too large for the stack
+	cm_traceWork_t			translationWork;
+	cm_traceWork_t			rotationWork;
+} cm_traceContext_t;
+
+typedef struct cm_recordedTrace_s {
+	idVec3					start;
+	idVec3					end;
+	idBounds				bounds;				// trace model bounds, cleared for point traces
+	idMat3					trmAxis;
+	int						contentMask;
+	int						model;
+	idVec3					modelOrigin;
+	idMat3					modelAxis;
+} cm_recordedTrace_t;
+
+typedef struct cm_traceBatch_s {
+	cm_traceContext_t *		context;
+	const idBounds *		bounds;				// model space bounds of each trace
+	const idVec3 *			starts;				// model space start of each trace
+	cm_batchNode_t **		heads;				// first gathered node of each trace
+	cm_batchNode_t **		tails;				// last gathered node of each trace
+	bool					overflow;			// ran out of batch nodes
+} cm_traceBatch_t;
+
+/*
+===============================================================================
+
 Collision Map
 
 ===============================================================================
 */
 
+/*
+===============================================================================
+
+Binary collision model cache
+
+===============================================================================
+*/
+
+typedef struct cm_binaryGather_s {
+	idList<cm_polygon_t *>	polygons;			// unique polygons in the tree
+	idList<int>				polygonOffsets;		// byte offset of each polygon in the polygon block
+	idHashIndex				polygonHash;		// polygon pointer to polygon index
+	idList<cm_brush_t *>	brushes;			// unique brushes in the tree
+	idList<int>				brushOffsets;		// byte offset of each brush in the brush block
+	idHashIndex				brushHash;			// brush pointer to brush index
+	idList<cm_node_t>		nodes;				// pre-order nodes with pointers stored as indices
+	idList<cm_polygonRef_t>	polygonRefs;		// polygon references with pointers stored as offsets
+	idList<cm_brushRef_t>	brushRefs;			// brush references with pointers stored as offsets
+} cm_binaryGather_t;
+
 typedef struct cm_procNode_s {
 	idPlane plane;
 	int children[2];				// negative numbers are (-1 - areaNumber), 0 = solid
@@ -282,7 +399,7 @@ public:
 	// get clip handle for model
 	cmHandle_t		LoadModel( const char *modelName, const bool precache );
 	// sets up a trace model for collision with other trace models
-	cmHandle_t		SetupTrmModel( const idTraceModel &trm, const idMaterial *material );
+	cmHandle_t		SetupTrmModel( const idTraceModel &trm, const idMaterial *material, int traceContext = CM_MAIN_TRACE_CONTEXT );
 	// create trace model from a collision model, returns true if succesfull
 	bool			TrmFromModel( const char *modelName, idTraceModel &trm );
 
@@ -298,23 +415,38 @@ public:
 	bool			GetModelEdge( cmHandle_t model, int edgeNum, idVec3 &start, idVec3 &end ) const;
 	// get the polygon of a model
 	bool			GetModelPolygon( cmHandle_t model, int polygonNum, idFixedWinding &winding ) const;
-
+	// get the polygons of a model touching the bounds
+	int				GetModelPolygons( cmHandle_t model, const idBounds &bounds, int contentMask,
+								cmPolygon_t *polygons, const int maxPolygons, idVec3 *points, const int maxPoints );
+
+	// reserves a trace context for a worker thread
+	int				AllocTraceContext( void );
+	// releases a trace context
+	void			FreeTraceContext( int traceContext );
 	// translates a trm and reports the first collision if any
 	void			Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+								int traceContext = CM_MAIN_TRACE_CONTEXT );
+	// translates a batch of points and boxes sharing the node tree walk
+	void			TranslationBatch( trace_t *results, const cmBatchTrace_t *traces, const int numTraces,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+								int traceContext = CM_MAIN_TRACE_CONTEXT );
 	// rotates a trm and reports the first collision if any
 	void			Rotation( trace_t *results, const idVec3 &start, const idRotation &rotation,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+								int traceContext = CM_MAIN_TRACE_CONTEXT );
 	// returns the contents the trm is stuck in or 0 if the trm is in free space
 	int				Contents( const idVec3 &start,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+								int traceContext = CM_MAIN_TRACE_CONTEXT );
 	// stores all contact points of the trm with the model, returns the number of contacts
 	int				Contacts( contactInfo_t *contacts, const int maxContacts, const idVec3 &start, const idVec6 &dir, const float depth,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+								int traceContext = CM_MAIN_TRACE_CONTEXT );
 	// test collision detection
 	void			DebugOutput( const idVec3 &origin );
 	// draw a model
@@ -324,6 +456,10 @@ public:
 	void			ModelInfo( cmHandle_t model );
 	// list all loaded models
 	void			ListModels( void );
+	// record the next translations of the main thread to a file
+	void			RecordTraces( const char *fileName, int numTraces );
+	// replay a recorded trace file through the axial tree and the bounding volume hierarchy
+	void			BenchmarkTraces( const char *fileName, int numIterations );
 	// write a collision model file for the map entity
 	bool			WriteCollisionModelForMapEntity( const idMapEntity *mapEnt, const char *filename, const bool testTraceModel = true );
 
@@ -369,7 +505,8 @@ private:			// CollisionMap_rotate.cpp
 	void			Rotation180( trace_t *results, const idVec3 &rorg, const idVec3 &axis,
 									const float startAngle, const float endAngle, const idVec3 &start,
 									const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-									cmHandle_t model, const idVec3 &origin, const idMat3 &modelAxis );
+									cmHandle_t model, const idVec3 &origin, const idMat3 &modelAxis,
+									int traceContext );
 
 private:			// CollisionMap_contents.cpp
 	bool			TestTrmVertsInBrush( cm_traceWork_t *tw, cm_brush_t *b );
@@ -379,17 +516,22 @@ private:			// CollisionMap_contents.cpp
 	int				TransformedPointContents( const idVec3 &p, cmHandle_t model, const idVec3 &origin, const idMat3 &modelAxis );
 	int				ContentsTrm( trace_t *results, const idVec3 &start,
 									const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-									cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+									cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+									int traceContext );
 
 private:			// CollisionMap_trace.cpp
 	void			TraceTrmThroughNode( cm_traceWork_t *tw, cm_node_t *node );
 	void			TraceThroughAxialBSPTree_r( cm_traceWork_t *tw, cm_node_t *node, float p1f, float p2f, idVec3 &p1, idVec3 &p2);
 	void			TraceThroughModel( cm_traceWork_t *tw );
+	void			TraceTrmThroughBVHLeaf( cm_traceWork_t *tw, const cm_bvhNode_t *node );
+	void			TraceThroughBVH( cm_traceWork_t *tw, const idVec3 &p1, const idVec3 &p2 );
+	void			TraceBatchThroughAxialBSPTree_r( cm_traceBatch_t *batch, cm_node_t *node, const int *active, const int numActive );
 	void			RecurseProcBSP_r( trace_t *results, int parentNodeNum, int nodeNum, float p1f, float p2f, const idVec3 &p1, const idVec3 &p2 );
 
 private:			// CollisionMap_load.cpp
 	void			Clear( void );
 	void			FreeTrmModelStructure( void );
+	void			ClearTraceContexts( void );
 					// model deallocation
 	void			RemovePolygonReferences_r( cm_node_t *node, cm_polygon_t *p );
 	void			RemoveBrushReferences_r( cm_node_t *node, cm_brush_t *b );
@@ -464,6 +606,12 @@ private:			// CollisionMap_load.cpp
 	cm_model_t *	LoadRenderModel( const char *fileName );					// ASE/LWO models
 	bool			TrmFromModel_r( idTraceModel &trm, cm_node_t *node );
 	bool			TrmFromModel( const cm_model_t *model, idTraceModel &trm );
+	bool			GetNodePolygons_r( const cm_model_t *model, const cm_node_t *node, const idBounds &bounds, int contentMask,
+								cmPolygon_t *polygons, const int maxPolygons, int &numPolygons, idVec3 *points, const int maxPoints, int &numPoints );
+					// bounding volume hierarchy
+	int				BuildBVH_r( struct cm_bvhBuild_s &build, int first, int count, int depth );
+	void			BuildBVH( cm_model_t *model );
+	void			BuildModelBVHs( void );
 
 private:			// CollisionMap_files.cpp
 					// writing
@@ -482,6 +630,13 @@ private:			// CollisionMap_files.cpp
 	void			ParseBrushes( idLexer *src, cm_model_t *model );
 	bool			ParseCollisionModel( idLexer *src );
 	bool			LoadCollisionModelFile( const char *name, unsigned int mapFileCRC );
+					// binary cache
+	void			GatherBinaryPolygons( cm_node_t *node, idList<cm_polygon_t *> &polygons, idList<cm_brush_t *> &brushes );
+	int				GatherBinaryNodes( cm_node_t *node, int parentNum, cm_binaryGather_t &gather );
+	void			WriteBinaryCollisionModel( idFile *fp, cm_model_t *model );
+	void			WriteBinaryCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC );
+	bool			ReadBinaryCollisionModel( idFile *fp );
+	bool			LoadBinaryCollisionModelFile( const char *name, unsigned int mapFileCRC );
 
 private:			// CollisionMap_debug
 	int				ContentsFromString( const char *string ) const;
@@ -491,29 +646,29 @@ private:			// CollisionMap_debug
 								const idVec3 &viewOrigin );
 	void			DrawNodePolygons( cm_model_t *model, cm_node_t *node, const idVec3 &origin, const idMat3 &axis,
 								const idVec3 &viewOrigin, const float radius );
+	void			RecordTrace( const idVec3 &start, const idVec3 &end, const idTraceModel *trm, const idMat3 &trmAxis,
+								int contentMask, cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+	void			WriteRecordedTraces( void );
 
 private:			// collision map data
 	idStr			mapName;
 	unsigned int	mapFileTime;
 	int				loaded;
-					// for multi-check avoidance
-	int				checkCount;
+					// per thread trace state
+	cm_traceContext_t traceContexts[CM_MAX_TRACE_CONTEXTS];
 					// models
 	int				maxModels;
 	int				numModels;
 	cm_model_t **	models;
-					// polygons and brush for trm model
-	cm_polygonRef_t*trmPolygons[MAX_TRACEMODEL_POLYS];
-	cm_brushRef_t *	trmBrushes[1];
+					// material for trm model polygons
 	const idMaterial *trmMaterial;
 					// for data pruning
 	int				numProcNodes;
 	cm_procNode_t *	procNodes;
-					// for retrieving contact points
-	bool			getContacts;
-	contactInfo_t *	contacts;
-	int				maxContacts;
-	int				numContacts;
+					// trace recording for benchmarks
+	idStr			recordFileName;
+	int				maxRecordedTraces;
+	idList<cm_recordedTrace_t> recordedTraces;
 	//HUMANHEAD rww
 #if _HH_INLINED_PROC_CLIPMODELS
 	idList<const char *>	inlinedProcClipModelMats;
@@ -525,3 +680,5 @@ private:			// collision map data
 
 // for debugging
 extern idCVar cm_debugCollision;
+extern idCVar cm_batchTraces;
+extern idCVar cm_useBVH;
@@ -486,7 +486,7 @@ void idCollisionModelManagerLocal::RotateTrmEdgeThroughPolygon( cm_traceWork_t *
 		edge = tw->model->edges + abs(edgeNum);
 
 		// if this edge is already checked
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		if ( edge->stamps[tw->context].checkcount == tw->checkCount ) {
 			continue;
 		}
 
@@ -1040,10 +1040,10 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t *tw,
 	idVec3 *rotationOrigin;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( p->checkcount[tw->context] == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->checkcount[tw->context] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -1139,11 +1139,11 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t *tw,
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
 
-			if ( e->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( e->stamps[tw->context].checkcount == tw->checkCount ) {
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			e->stamps[tw->context].checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if ( e->internal ) {
 				continue;
@@ -1154,11 +1154,11 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t *tw,
 				v = tw->model->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
 
 				// if this vertex is already checked
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( v->stamps[tw->context].checkcount == tw->checkCount ) {
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				v->stamps[tw->context].checkcount = tw->checkCount;
 
 				// if the vertex is outside the trm rotation bounds
 				if ( !tw->bounds.ContainsPoint( v->p ) ) {
@@ -1230,7 +1230,8 @@ idCollisionModelManagerLocal::Rotation180
 void idCollisionModelManagerLocal::Rotation180( trace_t *results, const idVec3 &rorg, const idVec3 &axis,
 										const float startAngle, const float endAngle, const idVec3 &start,
 										const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+										int traceContext ) {
 	int i, j, edgeNum;
 	float d, maxErr, initialTan;
 	bool model_rotated, trm_rotated;
@@ -1241,9 +1242,10 @@ void idCollisionModelManagerLocal::Rotation180( trace_t *results, const idVec3 &
 	cm_trmPolygon_t *poly;
 	cm_trmEdge_t *edge;
 	cm_trmVertex_t *vert;
-	ALIGN16( static cm_traceWork_t tw; )
+	cm_traceContext_t *context = &traceContexts[traceContext];
+	cm_traceWork_t &tw = context->rotationWork;
 
-	if ( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels ) {
+	if ( model < 0 || model >= TRACE_MODEL_HANDLE + CM_MAX_TRACE_CONTEXTS || model >= idCollisionModelManagerLocal::maxModels + CM_MAX_TRACE_CONTEXTS ) {
 		common->Printf("idCollisionModelManagerLocal::Rotation180: invalid model handle\n");
 		return;
 	}
@@ -1252,7 +1254,8 @@ void idCollisionModelManagerLocal::Rotation180( trace_t *results, const idVec3 &
 		return;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
+	tw.context = traceContext;
+	tw.checkCount = ++context->checkCount;
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -1588,16 +1591,18 @@ void idCollisionModelManagerLocal::Rotation180( trace_t *results, const idVec3 &
 idCollisionModelManagerLocal::Rotation
 ================
 */
-#ifdef _DEBUG
-static int entered = 0;
-#endif
-
 void idCollisionModelManagerLocal::Rotation( trace_t *results, const idVec3 &start, const idRotation &rotation,
 										const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+										int traceContext ) {
 	idVec3 tmp;
 	float maxa, stepa, a, lasta;
 
+	assert( traceContext >= 0 && traceContext < CM_MAX_TRACE_CONTEXTS );
+#ifdef _DEBUG
+	cm_traceContext_t *context = &traceContexts[traceContext];
+#endif
+
 	assert( ((byte *)&start) < ((byte *)results) || ((byte *)&start) > (((byte *)results) + sizeof( trace_t )) );
 	assert( ((byte *)&trmAxis) < ((byte *)results) || ((byte *)&trmAxis) > (((byte *)results) + sizeof( trace_t )) );
 
@@ -1605,7 +1610,7 @@ void idCollisionModelManagerLocal::Rotation( trace_t *results, const idVec3 &sta
 
 	// if special position test
 	if ( rotation.GetAngle() == 0.0f ) {
-		idCollisionModelManagerLocal::ContentsTrm( results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+		idCollisionModelManagerLocal::ContentsTrm( results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis, traceContext );
 		return;
 	}
 
@@ -1613,13 +1618,13 @@ void idCollisionModelManagerLocal::Rotation( trace_t *results, const idVec3 &sta
 	bool startsolid = false;
 	// test whether or not stuck to begin with
 	if ( cm_debugCollision.GetBool() ) {
-		if ( !entered ) {
-			entered = 1;
+		if ( !context->entered ) {
+			context->entered = 1;
 			// if already fucked up to begin with
-			if ( idCollisionModelManagerLocal::Contents( start, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask ) {
+			if ( idCollisionModelManagerLocal::Contents( start, trm, trmAxis, -1, model, modelOrigin, modelAxis, traceContext ) & contentMask ) {
 				startsolid = true;
 			}
-			entered = 0;
+			context->entered = 0;
 		}
 	}
 #endif
@@ -1637,7 +1642,7 @@ void idCollisionModelManagerLocal::Rotation( trace_t *results, const idVec3 &sta
 		}
 		for ( lasta = 0.0f, a = stepa; fabs( a ) < fabs( maxa ) + 1.0f; lasta = a, a += stepa ) {
 			// partial rotation
-			idCollisionModelManagerLocal::Rotation180( results, rotation.GetOrigin(), rotation.GetVec(), lasta, a, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+			idCollisionModelManagerLocal::Rotation180( results, rotation.GetOrigin(), rotation.GetVec(), lasta, a, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis, traceContext );
 			// if there is a collision
 			if ( results->fraction < 1.0f ) {
 				// fraction of total rotation
@@ -1649,23 +1654,23 @@ void idCollisionModelManagerLocal::Rotation( trace_t *results, const idVec3 &sta
 		return;
 	}
 
-	idCollisionModelManagerLocal::Rotation180( results, rotation.GetOrigin(), rotation.GetVec(), 0.0f, rotation.GetAngle(), start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+	idCollisionModelManagerLocal::Rotation180( results, rotation.GetOrigin(), rotation.GetVec(), 0.0f, rotation.GetAngle(), start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis, traceContext );
 
 #ifdef _DEBUG
 	// test for missed collisions
 	if ( cm_debugCollision.GetBool() ) {
-		if ( !entered ) {
-			entered = 1;
+		if ( !context->entered ) {
+			context->entered = 1;
 			// if the trm is stuck in the model
-			if ( idCollisionModelManagerLocal::Contents( results->endpos, trm, results->endAxis, -1, model, modelOrigin, modelAxis ) & contentMask ) {
+			if ( idCollisionModelManagerLocal::Contents( results->endpos, trm, results->endAxis, -1, model, modelOrigin, modelAxis, traceContext ) & contentMask ) {
 				trace_t tr;
 
 				// test where the trm is stuck in the model
-				idCollisionModelManagerLocal::Contents( results->endpos, trm, results->endAxis, -1, model, modelOrigin, modelAxis );
+				idCollisionModelManagerLocal::Contents( results->endpos, trm, results->endAxis, -1, model, modelOrigin, modelAxis, traceContext );
 				// re-run collision detection to find out where it failed
-				idCollisionModelManagerLocal::Rotation( &tr, start, rotation, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+				idCollisionModelManagerLocal::Rotation( &tr, start, rotation, trm, trmAxis, contentMask, model, modelOrigin, modelAxis, traceContext );
 			}
-			entered = 0;
+			context->entered = 0;
 		}
 	}
 #endif
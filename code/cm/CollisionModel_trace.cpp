@@ -181,6 +181,284 @@ void idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( cm_traceWork_t *t
 	idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, node->children[side^1], midf, p2f, mid, p2 );
 }
 
+/*
+================
+idCollisionModelManagerLocal::TraceTrmThroughBVHLeaf
+================
+*/
+void idCollisionModelManagerLocal::TraceTrmThroughBVHLeaf( cm_traceWork_t *tw, const cm_bvhNode_t *node ) {
+	int i;
+	const cm_bvhRef_t *polygons, *brushes;
+
+	polygons = &tw->model->bvhRefs[node->offset];
+	brushes = polygons + node->numPolygons;
+
+	// position test
+	if ( tw->positionTest ) {
+		// if already stuck in solid
+		if ( tw->trace.fraction == 0.0f ) {
+			return;
+		}
+		// test if any of the trm vertices is inside a brush
+		for ( i = 0; i < node->numBrushes; i++ ) {
+			if ( idCollisionModelManagerLocal::TestTrmVertsInBrush( tw, brushes[i].b ) ) {
+				return;
+			}
+		}
+		// if just testing a point we're done
+		if ( tw->pointTrace ) {
+			return;
+		}
+		// test if the trm is stuck in any polygons
+		for ( i = 0; i < node->numPolygons; i++ ) {
+			if ( idCollisionModelManagerLocal::TestTrmInPolygon( tw, polygons[i].p ) ) {
+				return;
+			}
+		}
+	}
+	else if ( tw->rotation ) {
+		// rotate through all polygons in this leaf
+		for ( i = 0; i < node->numPolygons; i++ ) {
+			if ( idCollisionModelManagerLocal::RotateTrmThroughPolygon( tw, polygons[i].p ) ) {
+				return;
+			}
+		}
+	}
+	else {
+		// trace through all polygons in this leaf
+		for ( i = 0; i < node->numPolygons; i++ ) {
+			if ( idCollisionModelManagerLocal::TranslateTrmThroughPolygon( tw, polygons[i].p ) ) {
+				return;
+			}
+		}
+	}
+}
+
+/*
+================
+CM_SegmentEntersBVHNode
+
+  Slab test of the segment against the node bounds expanded with the trace extents.
+================
+*/
+static ID_INLINE bool CM_SegmentEntersBVHNode( const cm_bvhNode_t *node, const idVec3 &p1, const idVec3 &invDir, const bool *parallel,
+												const idVec3 &extents, float &enter ) {
+	int i;
+	float min, max, t1, t2, tmin, tmax;
+
+	tmin = 0.0f;
+	tmax = 1.0f;
+	for ( i = 0; i < 3; i++ ) {
+		min = node->mins[i] - extents[i];
+		max = node->maxs[i] + extents[i];
+		if ( parallel[i] ) {
+			if ( p1[i] < min || p1[i] > max ) {
+				return false;
+			}
+			continue;
+		}
+		t1 = ( min - p1[i] ) * invDir[i];
+		t2 = ( max - p1[i] ) * invDir[i];
+		if ( t1 > t2 ) {
+			if ( t2 > tmin ) {
+				tmin = t2;
+			}
+			if ( t1 < tmax ) {
+				tmax = t1;
+			}
+		} else {
+			if ( t1 > tmin ) {
+				tmin = t1;
+			}
+			if ( t2 < tmax ) {
+				tmax = t2;
+			}
+		}
+		if ( tmin > tmax ) {
+			return false;
+		}
+	}
+	enter = tmin;
+	return true;
+}
+
+/*
+================
+idCollisionModelManagerLocal::TraceThroughBVH
+
+  Visits the leaves touched by the swept trace bounds nearest first and
+  skips every node that is entered beyond the current collision.
+================
+*/
+void idCollisionModelManagerLocal::TraceThroughBVH( cm_traceWork_t *tw, const idVec3 &p1, const idVec3 &p2 ) {
+	int i, numStack, nodeNum, child0, child1;
+	int stack[CM_BVH_MAX_DEPTH * 2];
+	float stackEnter[CM_BVH_MAX_DEPTH * 2];
+	float enter, enter0, enter1;
+	bool hit0, hit1, parallel[3];
+	idVec3 dir, invDir;
+	const cm_bvhNode_t *nodes, *node;
+
+	nodes = tw->model->bvhNodes;
+
+	dir = p2 - p1;
+	for ( i = 0; i < 3; i++ ) {
+		parallel[i] = ( dir[i] == 0.0f );
+		invDir[i] = parallel[i] ? 0.0f : 1.0f / dir[i];
+	}
+
+	if ( !CM_SegmentEntersBVHNode( &nodes[0], p1, invDir, parallel, tw->extents, enter ) ) {
+		return;
+	}
+	stack[0] = 0;
+	stackEnter[0] = enter;
+	numStack = 1;
+
+	while( numStack > 0 ) {
+		if ( tw->quickExit ) {
+			return;		// stop immediately
+		}
+
+		numStack--;
+		nodeNum = stack[numStack];
+		enter = stackEnter[numStack];
+
+		if ( !tw->positionTest && !tw->rotation && tw->trace.fraction <= enter ) {
+			continue;	// already hit something nearer
+		}
+
+		node = &nodes[nodeNum];
+		if ( node->numPolygons >= 0 ) {
+			if ( node->numPolygons || ( tw->positionTest && node->numBrushes ) ) {
+				idCollisionModelManagerLocal::TraceTrmThroughBVHLeaf( tw, node );
+			}
+			// if already stuck in solid
+			if ( tw->positionTest && tw->trace.fraction == 0.0f ) {
+				return;
+			}
+			continue;
+		}
+
+		child0 = nodeNum + 1;
+		child1 = node->offset;
+		hit0 = CM_SegmentEntersBVHNode( &nodes[child0], p1, invDir, parallel, tw->extents, enter0 );
+		hit1 = CM_SegmentEntersBVHNode( &nodes[child1], p1, invDir, parallel, tw->extents, enter1 );
+
+		// push the farther child first so the nearer one is visited first
+		if ( hit0 && hit1 ) {
+			if ( enter0 <= enter1 ) {
+				stack[numStack] = child1;
+				stackEnter[numStack++] = enter1;
+				stack[numStack] = child0;
+				stackEnter[numStack++] = enter0;
+			} else {
+				stack[numStack] = child0;
+				stackEnter[numStack++] = enter0;
+				stack[numStack] = child1;
+				stackEnter[numStack++] = enter1;
+			}
+		} else if ( hit0 ) {
+			stack[numStack] = child0;
+			stackEnter[numStack++] = enter0;
+		} else if ( hit1 ) {
+			stack[numStack] = child1;
+			stackEnter[numStack++] = enter1;
+		}
+		assert( numStack <= CM_BVH_MAX_DEPTH * 2 );
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::TraceBatchThroughAxialBSPTree_r
+
+  Gathers the nodes with collision data touched by each trace of a batch.
+  The node plane is tested against the bounds of all active traces at once.
+  Traces which straddle the plane get the child with their start point first
+  so each node list is still ordered along the trace.
+================
+*/
+void idCollisionModelManagerLocal::TraceBatchThroughAxialBSPTree_r( cm_traceBatch_t *batch, cm_node_t *node, const int *active, const int numActive ) {
+	int i, n, numFront, numBack, numStartBack;
+	int *frontList, *backList, *startBackList;
+	float *values;
+	byte *front, *back, *startFront;
+	cm_batchNode_t *bnode;
+	cm_traceContext_t *context;
+
+	if ( !node || numActive <= 0 || batch->overflow ) {
+		return;
+	}
+
+	// every trace reaching a node with collision data has to test it
+	if ( node->polygons || node->brushes ) {
+		context = batch->context;
+		if ( context->numBatchNodes + numActive > CM_MAX_BATCH_NODES ) {
+			batch->overflow = true;
+			return;
+		}
+		for ( i = 0; i < numActive; i++ ) {
+			n = active[i];
+			bnode = &context->batchNodes[context->numBatchNodes++];
+			bnode->node = node;
+			bnode->next = NULL;
+			if ( batch->tails[n] ) {
+				batch->tails[n]->next = bnode;
+			} else {
+				batch->heads[n] = bnode;
+			}
+			batch->tails[n] = bnode;
+		}
+	}
+	// if this is a leaf node
+	if ( node->planeType == -1 ) {
+		return;
+	}
+
+	values = (float *) _alloca16( numActive * sizeof( float ) );
+	front = (byte *) _alloca16( numActive * 3 * sizeof( byte ) );
+	back = front + numActive;
+	startFront = back + numActive;
+	frontList = (int *) _alloca16( numActive * 3 * sizeof( int ) );
+	backList = frontList + numActive;
+	startBackList = backList + numActive;
+
+	// traces completely at the front of the node plane
+	for ( i = 0; i < numActive; i++ ) {
+		values[i] = batch->bounds[active[i]][0][node->planeType];
+	}
+	SIMDProcessor->CmpGE( front, values, node->planeDist, numActive );
+	// traces completely at the back of the node plane
+	for ( i = 0; i < numActive; i++ ) {
+		values[i] = batch->bounds[active[i]][1][node->planeType];
+	}
+	SIMDProcessor->CmpLT( back, values, node->planeDist, numActive );
+	// side of the start point for traces crossing the node plane
+	for ( i = 0; i < numActive; i++ ) {
+		values[i] = batch->starts[active[i]][node->planeType];
+	}
+	SIMDProcessor->CmpGE( startFront, values, node->planeDist, numActive );
+
+	numFront = numBack = numStartBack = 0;
+	for ( i = 0; i < numActive; i++ ) {
+		if ( front[i] ) {
+			frontList[numFront++] = active[i];
+		} else if ( back[i] ) {
+			backList[numBack++] = active[i];
+		} else if ( startFront[i] ) {
+			frontList[numFront++] = active[i];
+			backList[numBack++] = active[i];
+		} else {
+			backList[numBack++] = active[i];
+			startBackList[numStartBack++] = active[i];
+		}
+	}
+
+	idCollisionModelManagerLocal::TraceBatchThroughAxialBSPTree_r( batch, node->children[0], frontList, numFront );
+	idCollisionModelManagerLocal::TraceBatchThroughAxialBSPTree_r( batch, node->children[1], backList, numBack );
+	idCollisionModelManagerLocal::TraceBatchThroughAxialBSPTree_r( batch, node->children[0], startBackList, numStartBack );
+}
+
 /*
 ================
 idCollisionModelManagerLocal::TraceThroughModel
@@ -191,10 +469,29 @@ void idCollisionModelManagerLocal::TraceThroughModel( cm_traceWork_t *tw ) {
 	int i, numSteps;
 	idVec3 start, end;
 	idRotation rot;
+	bool useBVH;
+	const cm_batchNode_t *bnode;
+
+	useBVH = ( tw->model->bvhNodes != NULL && cm_useBVH.GetBool() );
 
 	if ( !tw->rotation ) {
+		// batched translations gathered their nodes up front
+		bnode = traceContexts[tw->context].batchList;
+		if ( bnode && !tw->positionTest ) {
+			for ( ; bnode; bnode = bnode->next ) {
+				idCollisionModelManagerLocal::TraceTrmThroughNode( tw, bnode->node );
+				if ( tw->quickExit || tw->trace.fraction == 0.0f ) {
+					break;
+				}
+			}
+			return;
+		}
 		// trace through spatial subdivision and then through leafs
-		idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, tw->start, tw->end );
+		if ( useBVH ) {
+			idCollisionModelManagerLocal::TraceThroughBVH( tw, tw->start, tw->end );
+		} else {
+			idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, tw->start, tw->end );
+		}
 	}
 	else {
 		// approximate the rotation with a series of straight line movements
@@ -212,7 +509,11 @@ void idCollisionModelManagerLocal::TraceThroughModel( cm_traceWork_t *tw ) {
 				rot.Set( tw->origin, tw->axis, tw->angle * ((float) (i+1) / numSteps) );
 				end = start * rot;
 				// trace through spatial subdivision and then through leafs
-				idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, start, end );
+				if ( useBVH ) {
+					idCollisionModelManagerLocal::TraceThroughBVH( tw, start, end );
+				} else {
+					idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, start, end );
+				}
 				// no need to continue if something was hit already
 				if ( tw->trace.fraction < 1.0f ) {
 					return;
@@ -224,6 +525,10 @@ void idCollisionModelManagerLocal::TraceThroughModel( cm_traceWork_t *tw ) {
 			start = tw->start;
 		}
 		// last step of the approximation
-		idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, start, tw->end );
+		if ( useBVH ) {
+			idCollisionModelManagerLocal::TraceThroughBVH( tw, start, tw->end );
+		} else {
+			idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, start, tw->end );
+		}
 	}
 }
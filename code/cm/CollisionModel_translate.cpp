@@ -173,7 +173,7 @@ CM_SetVertexSidedness
   stores for the given model vertex at which side of one of the trm edges it passes
 ================
 */
-ID_INLINE void CM_SetVertexSidedness( cm_vertex_t *v, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
+ID_INLINE void CM_SetVertexSidedness( cm_traceStamp_t *v, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
 	if ( !(v->sideSet & (1<<bitNum)) ) {
 		float fl;
 		fl = vpl.PermutedInnerProduct( epl );
@@ -189,7 +189,7 @@ CM_SetEdgeSidedness
   stores for the given model edge at which side one of the trm vertices
 ================
 */
-ID_INLINE void CM_SetEdgeSidedness( cm_edge_t *edge, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
+ID_INLINE void CM_SetEdgeSidedness( cm_traceStamp_t *edge, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
 	if ( !(edge->sideSet & (1<<bitNum)) ) {
 		float fl;
 		fl = vpl.PermutedInnerProduct( epl );
@@ -209,14 +209,16 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 	idVec3 start, end, normal;
 	cm_edge_t *edge;
 	cm_vertex_t *v1, *v2;
+	cm_traceStamp_t *es, *vs1, *vs2;
 	idPluecker *pl, epsPl;
 
 	// check edges for a collision
 	for ( i = 0; i < poly->numEdges; i++) {
 		edgeNum = poly->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
+		es = &edge->stamps[tw->context];
 		// if this edge is already checked
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		if ( es->checkcount == tw->checkCount ) {
 			continue;
 		}
 		// can never collide with internal edges
@@ -225,19 +227,21 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 		}
 		pl = &tw->polygonEdgePlueckerCache[i];
 		// get the sides at which the trm edge vertices pass the polygon edge
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
+		CM_SetEdgeSidedness( es, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
+		CM_SetEdgeSidedness( es, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
 		// if the trm edge start and end vertex do not pass the polygon edge at different sides
-		if ( !(((edge->side >> trmEdge->vertexNum[0]) ^ (edge->side >> trmEdge->vertexNum[1])) & 1) ) {
+		if ( !(((es->side >> trmEdge->vertexNum[0]) ^ (es->side >> trmEdge->vertexNum[1])) & 1) ) {
 			continue;
 		}
 		// get the sides at which the polygon edge vertices pass the trm edge
 		v1 = tw->model->vertices + edge->vertexNum[INTSIGNBITSET(edgeNum)];
-		CM_SetVertexSidedness( v1, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
+		vs1 = &v1->stamps[tw->context];
+		CM_SetVertexSidedness( vs1, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
 		v2 = tw->model->vertices + edge->vertexNum[INTSIGNBITNOTSET(edgeNum)];
-		CM_SetVertexSidedness( v2, tw->polygonVertexPlueckerCache[i+1], trmEdge->pl, trmEdge->bitNum );
+		vs2 = &v2->stamps[tw->context];
+		CM_SetVertexSidedness( vs2, tw->polygonVertexPlueckerCache[i+1], trmEdge->pl, trmEdge->bitNum );
 		// if the polygon edge start and end vertex do not pass the trm edge at different sides
-		if ( !((v1->side ^ v2->side) & (1<<trmEdge->bitNum)) ) {
+		if ( !((vs1->side ^ vs2->side) & (1<<trmEdge->bitNum)) ) {
 			continue;
 		}
 		// if there is no possible collision between the trm edge and the polygon edge
@@ -374,16 +378,16 @@ idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon
 void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmVertex_t *v, int bitNum ) {
 	int i, edgeNum;
 	float f;
-	cm_edge_t *edge;
+	cm_traceStamp_t *es;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
 	if ( f < tw->trace.fraction ) {
 
 		for ( i = 0; i < poly->numEdges; i++ ) {
 			edgeNum = poly->edges[i];
-			edge = tw->model->edges + abs(edgeNum);
-			CM_SetEdgeSidedness( edge, tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
-			if ( INTSIGNBITSET(edgeNum) ^ ((edge->side >> bitNum) & 1) ) {
+			es = &tw->model->edges[abs(edgeNum)].stamps[tw->context];
+			CM_SetEdgeSidedness( es, tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
+			if ( INTSIGNBITSET(edgeNum) ^ ((es->side >> bitNum) & 1) ) {
 				return;
 			}
 		}
@@ -418,6 +422,7 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t
 	int i, edgeNum;
 	float f;
 	cm_edge_t *edge;
+	cm_traceStamp_t *es;
 	idPluecker pl;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
@@ -426,17 +431,18 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t
 		for ( i = 0; i < poly->numEdges; i++ ) {
 			edgeNum = poly->edges[i];
 			edge = tw->model->edges + abs(edgeNum);
+			es = &edge->stamps[tw->context];
 			// if we didn't yet calculate the sidedness for this edge
-			if ( edge->checkcount != idCollisionModelManagerLocal::checkCount ) {
+			if ( es->checkcount != tw->checkCount ) {
 				float fl;
-				edge->checkcount = idCollisionModelManagerLocal::checkCount;
+				es->checkcount = tw->checkCount;
 				pl.FromLine(tw->model->vertices[edge->vertexNum[0]].p, tw->model->vertices[edge->vertexNum[1]].p);
 				fl = v->pl.PermutedInnerProduct( pl );
-				edge->side = FLOATSIGNBITSET(fl);
+				es->side = FLOATSIGNBITSET(fl);
 			}
 			// if the point passes the edge at the wrong side
 			//if ( (edgeNum > 0) == edge->side ) {
-			if ( INTSIGNBITSET(edgeNum) ^ edge->side ) {
+			if ( INTSIGNBITSET(edgeNum) ^ es->side ) {
 				return;
 			}
 		}
@@ -479,8 +485,8 @@ void idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( cm_traceWor
 			edgeNum = trmpoly->edges[i];
 			edge = tw->edges + abs(edgeNum);
 
-			CM_SetVertexSidedness( v, pl, edge->pl, edge->bitNum );
-			if ( INTSIGNBITSET(edgeNum) ^ ((v->side >> edge->bitNum) & 1) ) {
+			CM_SetVertexSidedness( &v->stamps[tw->context], pl, edge->pl, edge->bitNum );
+			if ( INTSIGNBITSET(edgeNum) ^ ((v->stamps[tw->context].side >> edge->bitNum) & 1) ) {
 				return;
 			}
 		}
@@ -521,12 +527,13 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 	cm_trmPolygon_t *bp;
 	cm_vertex_t *v;
 	cm_edge_t *e;
+	cm_traceStamp_t *es, *vs;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( p->checkcount[tw->context] == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->checkcount[tw->context] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -579,18 +586,20 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 		for ( i = 0; i < p->numEdges; i++ ) {
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
+			es = &e->stamps[tw->context];
 			// reset sidedness cache if this is the first time we encounter this edge during this trace
-			if ( e->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				e->sideSet = 0;
+			if ( es->checkcount != tw->checkCount ) {
+				es->sideSet = 0;
 			}
 			// pluecker coordinate for edge
 			tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[e->vertexNum[0]].p,
 														tw->model->vertices[e->vertexNum[1]].p );
 
 			v = &tw->model->vertices[e->vertexNum[INTSIGNBITSET(edgeNum)]];
+			vs = &v->stamps[tw->context];
 			// reset sidedness cache if this is the first time we encounter this vertex during this trace
-			if ( v->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				v->sideSet = 0;
+			if ( vs->checkcount != tw->checkCount ) {
+				vs->sideSet = 0;
 			}
 			// pluecker coordinate for vertex movement vector
 			tw->polygonVertexPlueckerCache[i].FromRay( v->p, -tw->dir );
@@ -618,12 +627,13 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 		for ( i = 0; i < p->numEdges; i++ ) {
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
+			es = &e->stamps[tw->context];
 
-			if ( e->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( es->checkcount == tw->checkCount ) {
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			es->checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if ( e->internal ) {
 				continue;
@@ -632,12 +642,13 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 			for ( k = 0; k < 2; k++ ) {
 
 				v = tw->model->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
+				vs = &v->stamps[tw->context];
 				// if this vertex is already checked
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( vs->checkcount == tw->checkCount ) {
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				vs->checkcount = tw->checkCount;
 
 				// if the vertex is outside the trace bounds
 				if ( !tw->bounds.ContainsPoint( v->p ) ) {
@@ -737,13 +748,10 @@ void idCollisionModelManagerLocal::SetupTranslationHeartPlanes( cm_traceWork_t *
 idCollisionModelManagerLocal::Translation
 ================
 */
-#ifdef _DEBUG
-static int entered = 0;
-#endif
-
 void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
 										const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
-										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+										int traceContext ) {
 
 	int i, j;
 	float dist;
@@ -753,7 +761,10 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	cm_trmPolygon_t *poly;
 	cm_trmEdge_t *edge;
 	cm_trmVertex_t *vert;
-	ALIGN16( static cm_traceWork_t tw; )
+
+	assert( traceContext >= 0 && traceContext < CM_MAX_TRACE_CONTEXTS );
+	cm_traceContext_t *context = &traceContexts[traceContext];
+	cm_traceWork_t &tw = context->translationWork;
 
 	assert( ((byte *)&start) < ((byte *)results) || ((byte *)&start) > (((byte *)results) + sizeof( trace_t )) );
 	assert( ((byte *)&end) < ((byte *)results) || ((byte *)&end) > (((byte *)results) + sizeof( trace_t )) );
@@ -761,7 +772,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 
 	memset( results, 0, sizeof( *results ) );
 
-	if ( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels ) {
+	if ( model < 0 || model >= TRACE_MODEL_HANDLE + CM_MAX_TRACE_CONTEXTS || model >= idCollisionModelManagerLocal::maxModels + CM_MAX_TRACE_CONTEXTS ) {
 		common->Printf("idCollisionModelManagerLocal::Translation: invalid model handle\n");
 		return;
 	}
@@ -770,9 +781,14 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 		return;
 	}
 
+	// record traces of the main thread for benchmarks
+	if ( maxRecordedTraces && traceContext == CM_MAIN_TRACE_CONTEXT && !context->entered ) {
+		idCollisionModelManagerLocal::RecordTrace( start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+	}
+
 	// if case special position test
 	if ( start[0] == end[0] && start[1] == end[1] && start[2] == end[2] ) {
-		idCollisionModelManagerLocal::ContentsTrm( results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+		idCollisionModelManagerLocal::ContentsTrm( results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis, traceContext );
 		return;
 	}
 
@@ -780,18 +796,19 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	bool startsolid = false;
 	// test whether or not stuck to begin with
 	if ( cm_debugCollision.GetBool() ) {
-		if ( !entered && !idCollisionModelManagerLocal::getContacts ) {
-			entered = 1;
+		if ( !context->entered && !context->getContacts ) {
+			context->entered = 1;
 			// if already fucked up to begin with
-			if ( idCollisionModelManagerLocal::Contents( start, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask ) {
+			if ( idCollisionModelManagerLocal::Contents( start, trm, trmAxis, -1, model, modelOrigin, modelAxis, traceContext ) & contentMask ) {
 				startsolid = true;
 			}
-			entered = 0;
+			context->entered = 0;
 		}
 	}
 #endif
 
-	idCollisionModelManagerLocal::checkCount++;
+	tw.context = traceContext;
+	tw.checkCount = ++context->checkCount;
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -802,9 +819,9 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	tw.rotation = false;
 	tw.positionTest = false;
 	tw.quickExit = false;
-	tw.getContacts = idCollisionModelManagerLocal::getContacts;
-	tw.contacts = idCollisionModelManagerLocal::contacts;
-	tw.maxContacts = idCollisionModelManagerLocal::maxContacts;
+	tw.getContacts = context->getContacts;
+	tw.contacts = context->contacts;
+	tw.maxContacts = context->maxContacts;
 	tw.numContacts = 0;
 	tw.model = idCollisionModelManagerLocal::models[model];
 	tw.start = start - modelOrigin;
@@ -869,7 +886,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 			results->c.point += modelOrigin;
 			results->c.dist += modelOrigin * results->c.normal;
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		context->numContacts = tw.numContacts;
 		return;
 	}
 
@@ -1057,7 +1074,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 				tw.contacts[i].dist += modelOrigin * tw.contacts[i].normal;
 			}
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		context->numContacts = tw.numContacts;
 	} else {
 		// store results
 		*results = tw.trace;
@@ -1082,19 +1099,134 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 #ifdef _DEBUG
 	// test for missed collisions
 	if ( cm_debugCollision.GetBool() ) {
-		if ( !entered && !idCollisionModelManagerLocal::getContacts ) {
-			entered = 1;
+		if ( !context->entered && !context->getContacts ) {
+			context->entered = 1;
 			// if the trm is stuck in the model
-			if ( idCollisionModelManagerLocal::Contents( results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask ) {
+			if ( idCollisionModelManagerLocal::Contents( results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis, traceContext ) & contentMask ) {
 				trace_t tr;
 
 				// test where the trm is stuck in the model
-				idCollisionModelManagerLocal::Contents( results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis );
+				idCollisionModelManagerLocal::Contents( results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis, traceContext );
 				// re-run collision detection to find out where it failed
-				idCollisionModelManagerLocal::Translation( &tr, start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+				idCollisionModelManagerLocal::Translation( &tr, start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis, traceContext );
 			}
-			entered = 0;
+			context->entered = 0;
 		}
 	}
 #endif
 }
+
+/*
+================
+idCollisionModelManagerLocal::TranslationBatch
+
+  The model space bounds of all traces are pushed down the node tree together
+  to gather the nodes each trace touches, after which every trace is done as
+  a regular translation that only visits its own nodes.
+================
+*/
+void idCollisionModelManagerLocal::TranslationBatch( trace_t *results, const cmBatchTrace_t *traces, const int numTraces,
+										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis,
+										int traceContext ) {
+	int i, j;
+	int *active;
+	idBounds *bounds, worldBounds, trmBounds;
+	idVec3 *starts, invModelOrigin;
+	idMat3 invModelAxis;
+	idTraceModel trm;
+	cm_batchNode_t **heads;
+	cm_traceBatch_t batch;
+	const cmBatchTrace_t *t;
+	bool isPoint;
+
+	assert( traceContext >= 0 && traceContext < CM_MAX_TRACE_CONTEXTS );
+	cm_traceContext_t *context = &traceContexts[traceContext];
+
+	if ( numTraces <= 0 ) {
+		return;
+	}
+
+	heads = NULL;
+
+	// invalid handles are reported by the single translations
+	if ( cm_batchTraces.GetBool() && model >= 0 && model < TRACE_MODEL_HANDLE + CM_MAX_TRACE_CONTEXTS &&
+			model < idCollisionModelManagerLocal::maxModels + CM_MAX_TRACE_CONTEXTS && idCollisionModelManagerLocal::models[model] ) {
+
+		active = (int *) _alloca16( numTraces * sizeof( int ) );
+		bounds = (idBounds *) _alloca16( numTraces * sizeof( idBounds ) );
+		starts = (idVec3 *) _alloca16( numTraces * sizeof( idVec3 ) );
+		heads = (cm_batchNode_t **) _alloca16( numTraces * 2 * sizeof( cm_batchNode_t * ) );
+
+		invModelAxis = modelAxis.Transpose();
+		invModelOrigin = -( modelOrigin * invModelAxis );
+
+		// model space bounds and start point of each trace
+		for ( i = 0; i < numTraces; i++ ) {
+			t = &traces[i];
+			active[i] = i;
+			worldBounds.Clear();
+			worldBounds.AddPoint( t->start );
+			worldBounds.AddPoint( t->end );
+			if ( !t->bounds.IsCleared() ) {
+				worldBounds[0] += t->bounds[0];
+				worldBounds[1] += t->bounds[1];
+			}
+			worldBounds.ExpandSelf( CM_BOX_EPSILON );
+			bounds[i].FromTransformedBounds( worldBounds, invModelOrigin, invModelAxis );
+			starts[i] = ( t->start - modelOrigin ) * invModelAxis;
+		}
+
+		memset( heads, 0, numTraces * 2 * sizeof( cm_batchNode_t * ) );
+		context->numBatchNodes = 0;
+
+		batch.context = context;
+		batch.bounds = bounds;
+		batch.starts = starts;
+		batch.heads = heads;
+		batch.tails = heads + numTraces;
+		batch.overflow = false;
+
+		idCollisionModelManagerLocal::TraceBatchThroughAxialBSPTree_r( &batch, idCollisionModelManagerLocal::models[model]->node, active, numTraces );
+
+		// too many node references, fall back to walking the tree for every trace
+		if ( batch.overflow ) {
+			heads = NULL;
+		}
+	}
+
+	trmBounds.Zero();
+	for ( i = 0; i < numTraces; i++ ) {
+		t = &traces[i];
+
+		isPoint = t->bounds.IsCleared();
+		if ( !isPoint ) {
+			isPoint = true;
+			for ( j = 0; j < 3; j++ ) {
+				if ( t->bounds[1][j] - t->bounds[0][j] > 0.0f ) {
+					isPoint = false;
+				}
+			}
+		}
+
+		// consecutive traces with the same box share the trace model
+		if ( !isPoint && t->bounds != trmBounds ) {
+			trmBounds = t->bounds;
+			trm.SetupBox( trmBounds );
+		}
+
+		if ( heads ) {
+			if ( !heads[i] && ( isPoint || ( t->end - t->start ).LengthSqr() <= Square( CM_MAX_TRACE_DIST ) ) ) {
+				// no collision data along the trace
+				memset( &results[i], 0, sizeof( results[i] ) );
+				results[i].fraction = 1.0f;
+				results[i].endpos = t->end;
+				results[i].endAxis = mat3_identity;
+				continue;
+			}
+			context->batchList = heads[i];
+		}
+		idCollisionModelManagerLocal::Translation( &results[i], t->start, t->end, isPoint ? NULL : &trm, mat3_identity,
+													t->contentMask, model, modelOrigin, modelAxis, traceContext );
+		context->batchList = NULL;
+	}
+}
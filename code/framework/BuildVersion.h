@@ -25,4 +25,4 @@ If you have questions concerning this license or the applicable additional terms
 
 ===========================================================================
 */
-const int BUILD_NUMBER = 1304;
+const int BUILD_NUMBER = 1305;
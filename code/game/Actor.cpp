@@ -1623,6 +1623,66 @@ bool idActor::CanSee( idEntity *ent, bool useFov ) const {
 	return false;
 }
 
+/*
+=====================
+idActor::CanSeeList
+=====================
+*/
+void idActor::CanSeeList( idEntity * const *ents, const int numEnts, bool useFOV, bool *canSee ) {
+	cmBatchTrace_t	*traces;
+	trace_t			*results;
+	int				*traceEnts;
+	idEntity		*ent;
+	idVec3			eye;
+	idVec3			toPos;
+	int				i, numTraces;
+
+	if ( numEnts <= 0 ) {
+		return;
+	}
+
+	traces = (cmBatchTrace_t *) _alloca16( numEnts * sizeof( traces[0] ) );
+	results = (trace_t *) _alloca16( numEnts * sizeof( results[0] ) );
+	traceEnts = (int *) _alloca16( numEnts * sizeof( traceEnts[0] ) );
+
+	eye = GetEyePosition();
+
+	numTraces = 0;
+	for ( i = 0; i < numEnts; i++ ) {
+		canSee[i] = false;
+		ent = ents[i];
+
+		if ( ent->IsHidden() ) {
+			continue;
+		}
+
+		if ( ent->IsType( idActor::Type ) ) {
+			toPos = ( ( idActor * )ent )->GetEyePosition();
+		} else {
+			toPos = ent->GetPhysics()->GetOrigin();
+		}
+
+		if ( useFOV && !CheckFOV( toPos ) ) {
+			continue;
+		}
+
+		traces[numTraces].start = eye;
+		traces[numTraces].end = toPos;
+		traces[numTraces].bounds.Zero();
+		traces[numTraces].contentMask = MASK_SHOT_BOUNDINGBOX;
+		traceEnts[numTraces] = i;
+		numTraces++;
+	}
+
+	gameLocal.clip.TranslationBatch( results, traces, numTraces, this );
+
+	for ( i = 0; i < numTraces; i++ ) {
+		if ( results[i].fraction >= 1.0f || ( gameLocal.GetTraceEntity( results[i] ) == ents[traceEnts[i]] ) ) {
+			canSee[traceEnts[i]] = true;
+		}
+	}
+}
+
 /*
 =====================
 idActor::PointVisible
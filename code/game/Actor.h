@@ -164,6 +164,8 @@ public:
 #else
 	bool					CanSee( idEntity *ent, bool useFOV ) const;
 #endif
+							// CanSee for several entities with the sight traces done in one batch
+	virtual void			CanSeeList( idEntity * const *ents, const int numEnts, bool useFOV, bool *canSee );
 	bool					PointVisible( const idVec3 &point ) const;
 	virtual void			GetAIAimTargets( const idVec3 &lastSightPos, idVec3 &headPos, idVec3 &chestPos );
 
@@ -463,6 +463,11 @@ idEntity::idEntity() : reactions(1) { // HUMANHEAD JRM
 	thinkFlags		= 0;
 	dormantStart	= 0;
 	cinematic		= false;
+	thinkBudget		= THINKBUDGET_UNSET;
+	thinkLODInterval = 0;
+	lastThinkTime	= 0;
+	scriptHandle	= false;
+	inEntityPool	= false;
 	renderView		= NULL;
 	cameraTarget	= NULL;
 	health			= 0;
@@ -782,6 +787,8 @@ void idEntity::Save( idSaveGame *savefile ) const {
 	savefile->WriteInt( thinkFlags );
 	savefile->WriteInt( dormantStart );
 	savefile->WriteBool( cinematic );
+	savefile->WriteBool( scriptHandle );
+	savefile->WriteBool( inEntityPool );
 
 	savefile->WriteObject( cameraTarget );
 
@@ -867,6 +874,14 @@ void idEntity::Restore( idRestoreGame *savefile ) {
 	savefile->ReadInt( thinkFlags );
 	savefile->ReadInt( dormantStart );
 	savefile->ReadBool( cinematic );
+	if ( savefile->GetBuildNumber() < ENTITY_POOL_BUILD_NUMBER ) {
+		// these weren't saved out before the entity pool
+		scriptHandle = false;
+		inEntityPool = false;
+	} else {
+		savefile->ReadBool( scriptHandle );
+		savefile->ReadBool( inEntityPool );
+	}
 
 	savefile->ReadObject( reinterpret_cast<idClass *&>( cameraTarget ) );
 
@@ -1169,6 +1184,33 @@ called when entity wakes from being dormant
 void idEntity::DormantEnd( void ) {
 }
 
+/*
+================
+idEntity::GetThinkBudget
+
+The budget isn't saved, it's looked up again after a load
+================
+*/
+thinkBudget_t idEntity::GetThinkBudget( void ) {
+	const char *budget;
+
+	if ( thinkBudget == THINKBUDGET_UNSET ) {
+		if ( spawnArgs.GetString( "thinkBudget", NULL, &budget ) ) {
+			if ( !idStr::Icmp( budget, "low" ) ) {
+				thinkBudget = THINKBUDGET_LOW;
+			} else if ( !idStr::Icmp( budget, "normal" ) ) {
+				thinkBudget = THINKBUDGET_NORMAL;
+			} else {
+				thinkBudget = THINKBUDGET_FULL;
+			}
+		} else {
+			thinkBudget = DefaultThinkBudget();
+		}
+	}
+
+	return thinkBudget;
+}
+
 /*
 ================
 idEntity::IsActive
@@ -1448,15 +1490,21 @@ NOTE: Please notify nla if this changes. Is used in hhModelProxy::SetOriginAndAx
 ================
 */
 void idEntity::UpdateModelTransform( void ) {
-	idVec3 origin;
-	idMat3 axis;
+	idVec3 origin, physicsOrigin;
+	idMat3 axis, physicsAxis;
+
+	// physics stepping slower than the game renders between its last two steps
+	if ( !GetPhysics()->GetInterpolatedTransform( physicsOrigin, physicsAxis ) ) {
+		physicsOrigin = GetPhysics()->GetOrigin();
+		physicsAxis = GetPhysics()->GetAxis();
+	}
 
 	if ( GetPhysicsToVisualTransform( origin, axis ) ) {
-		renderEntity.axis = axis * GetPhysics()->GetAxis();
-		renderEntity.origin = GetPhysics()->GetOrigin() + origin * renderEntity.axis;
+		renderEntity.axis = axis * physicsAxis;
+		renderEntity.origin = physicsOrigin + origin * renderEntity.axis;
 	} else {
-		renderEntity.axis = GetPhysics()->GetAxis();
-		renderEntity.origin = GetPhysics()->GetOrigin();
+		renderEntity.axis = physicsAxis;
+		renderEntity.origin = physicsOrigin;
 	}
 }
 
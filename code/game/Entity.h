@@ -106,6 +106,14 @@ enum {
 	// HUMANHEAD END
 };
 
+// Think budgets, how often an entity out of view or far from all players needs to think
+typedef enum {
+	THINKBUDGET_UNSET = -1,
+	THINKBUDGET_FULL,					// think every frame
+	THINKBUDGET_NORMAL,					// think every g_thinkLODInterval milliseconds
+	THINKBUDGET_LOW						// think every g_thinkLODLowInterval milliseconds
+} thinkBudget_t;
+
 //
 // Signals
 // make sure to change script/doom_defs.script if you add any, or change their order
@@ -162,6 +170,11 @@ public:
 	int						thinkFlags;				// TH_? flags
 	int						dormantStart;			// time that the entity was first closed off from player
 	bool					cinematic;				// during cinematics, entity will only think if cinematic is set
+	thinkBudget_t			thinkBudget;			// from the "thinkBudget" key or DefaultThinkBudget, set on first use
+	int						thinkLODInterval;		// milliseconds between thinks at a reduced think rate, 0 to think every frame
+	int						lastThinkTime;			// game time of the last think
+	bool					scriptHandle;			// a script variable may hold this entity, so hhEntityPool won't recycle it
+	bool					inEntityPool;			// parked in hhEntityPool, scripts get $null_entity for it
 
 	renderView_t *			renderView;				// for camera views from this entity
 	idEntity *				cameraTarget;			// any remoteRenderMap shaders will use this
@@ -384,6 +397,8 @@ public:
 	bool					CheckDormant( void );	// dormant == on the active list, but out of PVS
 	virtual	void			DormantBegin( void );	// called when entity becomes dormant
 	virtual	void			DormantEnd( void );		// called when entity wakes from being dormant
+	virtual thinkBudget_t	GetThinkBudget( void );
+	virtual thinkBudget_t	DefaultThinkBudget( void ) const { return THINKBUDGET_FULL; }
 	bool					IsActive( void ) const;
 	virtual // HUMANHEAD
 	void					BecomeActive( int flags );
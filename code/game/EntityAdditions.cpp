@@ -402,6 +402,17 @@ hhEntityFx* idEntity::SpawnFxLocal( const char *fxName, const idVec3 &origin, co
 		return NULL;
 	}
 
+	// one shot fx are handed out again by the entity pool
+	bool pooled = hhEntityPool::CanPoolFx( fxInfo ) && !gameLocal.isClient;
+	if( pooled ) {
+		fx = gameLocal.entityPool.TakeFx( fxName, forceClient );
+		if( fx ) {
+			fx->LeavePool( origin, axis, *fxInfo );
+			fx->Show();
+			return fx;
+		}
+	}
+
 	// Spawn an fx 
 	fxArgs.Set( "fx", fxName );
 	fxArgs.SetBool( "start", fxInfo ? fxInfo->StartIsSet() : true );
@@ -429,6 +440,9 @@ hhEntityFx* idEntity::SpawnFxLocal( const char *fxName, const idVec3 &origin, co
 	if( fxInfo ) {
 		fx->SetFxInfo( *fxInfo );
 	}
+	if( pooled ) {
+		fx->AllowPooling( forceClient );
+	}
 
 	if( fxInfo && fxInfo->EntityIsSet() ) {
 		fx->fl.noRemoveWhenUnbound = fxInfo->NoRemoveWhenUnbound();
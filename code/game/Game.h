@@ -300,7 +300,7 @@ extern idGameEdit *				gameEdit;
 ===============================================================================
 */
 
-const int GAME_API_VERSION		= 7;
+const int GAME_API_VERSION		= 8;
 
 typedef struct {
 
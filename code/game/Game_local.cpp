@@ -184,6 +184,8 @@ void idGameLocal::Clear( void ) {
 	numEntitiesToDeactivate = 0;
 	sortPushers = false;
 	sortTeamMasters = false;
+	thinkCosts.Clear();
+	thinkCostFrames = 0;
 	//HUMANHEAD rww
 	sortSnapshotPushers = false;
 	sortSnapshotTeamMasters = false;
@@ -2448,6 +2450,24 @@ bool idGameLocal::InPlayerConnectedArea( idEntity *ent ) const {
     return pvs.InCurrentPVS( playerConnectedAreas, ent->GetPVSAreas(), ent->GetNumPVSAreas() );
 }
 
+/*
+================
+idGameLocal::NearAnyPlayer
+================
+*/
+bool idGameLocal::NearAnyPlayer( const idVec3 &origin, float distance ) const {
+	int i;
+	float maxDistSqr = Square( distance );
+
+	for ( i = 0; i < numClients; i++ ) {
+		if ( entities[i] && entities[i]->IsType( idPlayer::Type ) &&
+				( entities[i]->GetPhysics()->GetOrigin() - origin ).LengthSqr() < maxDistSqr ) {
+			return true;
+		}
+	}
+	return false;
+}
+
 /*
 ================
 idGameLocal::UpdateGravity
@@ -2484,6 +2504,254 @@ const idVec3 &idGameLocal::GetGravity( void ) const {
 	return gravity;
 }
 
+/*
+================
+idGameLocal::UpdatePhysicsLOD
+
+  Articulated figures and rigid bodies outside the PVS of all players or far away
+  from all of them are simulated at a reduced level of detail. They return to full
+  detail as soon as they come into view.
+================
+*/
+void idGameLocal::UpdatePhysicsLOD( void ) {
+	idEntity *ent;
+	idPhysics *phys;
+	bool reduced;
+
+	if ( isClient ) {
+		return;
+	}
+
+	for ( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		phys = ent->GetPhysics();
+		if ( !phys || ( !phys->IsType( idPhysics_AF::Type ) && !phys->IsType( idPhysics_RigidBody::Type ) ) ) {
+			continue;
+		}
+
+		reduced = false;
+		if ( g_physicsLOD.GetBool() && !ent->GetBindMaster() && !ent->IsType( idProjectile::Type ) && !ent->IsType( hhVehicle::Type ) ) {
+			reduced = !InPlayerPVS( ent ) || !NearAnyPlayer( phys->GetOrigin(), g_physicsLODDistance.GetFloat() );
+		}
+
+		if ( phys->IsType( idPhysics_AF::Type ) ) {
+			static_cast<idPhysics_AF *>( phys )->SetReducedLOD( reduced );
+		} else {
+			static_cast<idPhysics_RigidBody *>( phys )->SetReducedLOD( reduced );
+		}
+	}
+}
+
+/*
+================
+idGameLocal::UpdateThinkLOD
+
+  Entities with a think budget that are outside the PVS of all players think at a
+  reduced rate, as do the ones far away from all players when g_thinkLODDistance is
+  set. Entities that are moving, bound or part of a team always think every frame,
+  as do the players.
+================
+*/
+void idGameLocal::UpdateThinkLOD( void ) {
+	idEntity *ent;
+	idPhysics *phys;
+	int interval;
+
+	for ( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		interval = 0;
+
+		if ( g_thinkLOD.GetBool() && !isClient && !ent->GetBindMaster() && !ent->GetTeamMaster() && !ent->IsType( idPlayer::Type ) ) {
+			switch( ent->GetThinkBudget() ) {
+				case THINKBUDGET_NORMAL:
+					interval = g_thinkLODInterval.GetInteger();
+					break;
+				case THINKBUDGET_LOW:
+					interval = g_thinkLODLowInterval.GetInteger();
+					break;
+				default:
+					break;
+			}
+
+			// moving bodies are left to the physics level of detail
+			phys = ent->GetPhysics();
+			if ( ( ent->thinkFlags & TH_PHYSICS ) && !phys->IsAtRest() ) {
+				interval = 0;
+			}
+
+			if ( interval >= 2 * msec && InPlayerPVS( ent ) && ( g_thinkLODDistance.GetFloat() <= 0.0f || NearAnyPlayer( phys->GetOrigin(), g_thinkLODDistance.GetFloat() ) ) ) {
+				interval = 0;
+			}
+		}
+
+		ent->thinkLODInterval = ( interval >= 2 * msec ) ? interval : 0;
+	}
+}
+
+/*
+================
+idGameLocal::ThinkEntity
+
+  Returns false if the entity skips this frame because it thinks at a reduced rate.
+  The entities at a reduced rate are spread over the frames of their interval and
+  see all the time since they last thought as the previous frame time.
+================
+*/
+bool idGameLocal::ThinkEntity( idEntity *ent ) {
+	int savedPreviousTime;
+
+	if ( !ent->thinkLODInterval ) {
+		ent->Think();
+		ent->lastThinkTime = time;
+		return true;
+	}
+
+	if ( ( framenum + ent->entityNumber ) % ( ent->thinkLODInterval / msec ) ) {
+		return false;
+	}
+
+	// entities that were inactive or dormant don't catch up on more than one interval
+	savedPreviousTime = previousTime;
+	previousTime = Max( ent->lastThinkTime, time - ent->thinkLODInterval );
+	ent->Think();
+	previousTime = savedPreviousTime;
+	ent->lastThinkTime = time;
+
+	return true;
+}
+
+/*
+================
+idGameLocal::AddThinkCost
+================
+*/
+void idGameLocal::AddThinkCost( const idEntity *ent, bool thought, float ms ) {
+	int i;
+	int typeNum;
+
+	typeNum = ent->GetType()->typeNum;
+	if ( typeNum >= thinkCosts.Num() ) {
+		i = thinkCosts.Num();
+		thinkCosts.SetNum( idClass::GetNumTypes() );
+		for( ; i < thinkCosts.Num(); i++ ) {
+			memset( &thinkCosts[ i ], 0, sizeof( thinkCosts[ i ] ) );
+		}
+	}
+
+	if ( thought ) {
+		thinkCosts[ typeNum ].thinks++;
+		thinkCosts[ typeNum ].ms += ms;
+	} else {
+		thinkCosts[ typeNum ].skipped++;
+	}
+}
+
+/*
+================
+SortThinkCosts
+================
+*/
+static const idList<thinkCost_t> *sortThinkCosts;
+
+static int SortThinkCosts( const int *a, const int *b ) {
+	double msA = ( *sortThinkCosts )[ *a ].ms;
+	double msB = ( *sortThinkCosts )[ *b ].ms;
+
+	if ( msA > msB ) {
+		return -1;
+	}
+	return ( msA < msB ) ? 1 : 0;
+}
+
+/*
+================
+idGameLocal::ListThinkCosts
+================
+*/
+void idGameLocal::ListThinkCosts( void ) const {
+	int i;
+	int frames;
+	double totalMS;
+	idList<int> order;
+
+	for( i = 0; i < thinkCosts.Num(); i++ ) {
+		if ( thinkCosts[ i ].thinks || thinkCosts[ i ].skipped ) {
+			order.Append( i );
+		}
+	}
+	if ( !order.Num() ) {
+		Printf( "no think costs recorded, set g_timeEntityClasses 1 first\n" );
+		return;
+	}
+
+	sortThinkCosts = &thinkCosts;
+	order.Sort( SortThinkCosts );
+
+	frames = Max( thinkCostFrames, 1 );
+	totalMS = 0.0;
+
+	Printf( "%10s %10s %10s %8s %8s  %s\n", "total ms", "ms/frame", "ms/think", "thinks", "skipped", "class" );
+	Printf( "----------------------------------------------------------------------\n" );
+	for( i = 0; i < order.Num(); i++ ) {
+		const thinkCost_t &cost = thinkCosts[ order[ i ] ];
+		Printf( "%10.2f %10.4f %10.4f %8d %8d  %s\n", cost.ms, cost.ms / frames, cost.thinks ? cost.ms / cost.thinks : 0.0,
+			cost.thinks, cost.skipped, idClass::GetType( order[ i ] )->classname );
+		totalMS += cost.ms;
+	}
+	Printf( "%.2f ms over %d frames, %.4f ms per frame\n", totalMS, thinkCostFrames, totalMS / frames );
+}
+
+/*
+================
+idGameLocal::RunPhysicsIslands
+
+  Evaluates the active articulated figures ahead of the think loop so
+  figures that cannot touch each other are solved in parallel.
+================
+*/
+void idGameLocal::RunPhysicsIslands( void ) {
+	idEntity *ent, *part;
+	idPhysics_AF **figures;
+	int numFigures;
+
+	if ( af_parallelIslands.GetInteger() <= 0 || isClient ) {
+		return;
+	}
+
+	figures = (idPhysics_AF **) _alloca16( num_entities * sizeof( idPhysics_AF * ) );
+	numFigures = 0;
+
+	for ( ent = activeEntities.Next(); ent != NULL && numFigures < num_entities; ent = ent->activeNode.Next() ) {
+		if ( !( ent->thinkFlags & TH_PHYSICS ) || ent->fl.isDormant ) {
+			continue;
+		}
+		// team slaves move with their master
+		if ( ent->GetTeamMaster() && ent->GetTeamMaster() != ent ) {
+			continue;
+		}
+		// a blocked pusher on the team restores the master to the state saved by RunPhysics,
+		// which has to be from before the master moved
+		for ( part = ent->GetNextTeamEntity(); part != NULL; part = part->GetNextTeamEntity() ) {
+			if ( part->GetPhysics()->IsType( idPhysics_Parametric::Type ) ) {
+				break;
+			}
+		}
+		if ( part ) {
+			continue;
+		}
+		if ( g_cinematic.GetBool() && inCinematic && !ent->cinematic ) {
+			continue;
+		}
+		idPhysics *phys = ent->GetPhysics();
+		if ( !phys || !phys->IsType( idPhysics_AF::Type ) || phys->IsAtRest() ) {
+			continue;
+		}
+		figures[numFigures++] = static_cast<idPhysics_AF *>( phys );
+	}
+
+	if ( numFigures > 1 ) {
+		idPhysics_AF::EvaluateIslands( figures, numFigures, time - previousTime, time );
+	}
+}
+
 /*
 ================
 idGameLocal::SortActiveEntityList
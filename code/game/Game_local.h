@@ -202,6 +202,12 @@ typedef struct {
 	int			dist;
 } spawnSpot_t;
 
+typedef struct {
+	int			thinks;
+	int			skipped;			// frames skipped by the think level of detail
+	double		ms;
+} thinkCost_t;
+
 //============================================================================
 
 class idEventQueue {
@@ -469,6 +475,9 @@ public:
 
 	int						vacuumAreaNum;			// -1 if level doesn't have any outside areas
 
+	idList<thinkCost_t>		thinkCosts;				// think time of each entity class by type number, with g_timeEntityClasses
+	int						thinkCostFrames;		// number of frames in thinkCosts
+
 	gameType_t				gameType;
 	bool					isMultiplayer;			// set if the game is run in multiplayer mode
 	bool					isServer;				// set if the game is run for a dedicated or listen server
@@ -595,6 +604,10 @@ public:
 
 	bool					InPlayerPVS( idEntity *ent ) const;
 	bool					InPlayerConnectedArea( idEntity *ent ) const;
+	bool					NearAnyPlayer( const idVec3 &origin, float distance ) const;
+
+	void					AddThinkCost( const idEntity *ent, bool thought, float ms );
+	void					ListThinkCosts( void ) const;
 
 	void					SetCamera( idCamera *cam );
 	idCamera *				GetCamera( void ) const;
@@ -837,6 +850,10 @@ protected:	// HUMANHEAD
 	void					FreePlayerPVS( void );
 	void					UpdateGravity( void );
 	void					SortActiveEntityList( void );
+	void					UpdatePhysicsLOD( void );
+	void					UpdateThinkLOD( void );
+	bool					ThinkEntity( idEntity *ent );
+	void					RunPhysicsIslands( void );
 	//HUMANHEAD
 	void					SortSnapshotEntityList( void );
 	void					RegisterLocationsWithSoundWorld();
@@ -140,6 +140,7 @@ void idMoveable::Spawn( void ) {
 	physicsObj.SetGravity( gameLocal.GetGravity() );
 	physicsObj.SetContents( CONTENTS_SOLID );
 	physicsObj.SetClipMask( MASK_SOLID | CONTENTS_BODY | CONTENTS_CORPSE | CONTENTS_MOVEABLECLIP );
+	physicsObj.SetStepTime( spawnArgs.GetInt( "physicsStepTime" ) );
 	SetPhysics( &physicsObj );
 
 	if ( spawnArgs.GetFloat( "mass", "10", mass ) ) {
@@ -221,6 +222,7 @@ void idMoveable::Restore( idRestoreGame *savefile ) {
 
 	savefile->ReadStaticObject( physicsObj );
 	RestorePhysics( &physicsObj );
+	physicsObj.SetStepTime( spawnArgs.GetInt( "physicsStepTime" ) );
 }
 
 /*
@@ -288,17 +288,66 @@ void idAI::Event_Touch( idEntity *other, trace_t *trace ) {
 	AI_PUSHED = true;
 }
 
+// sight checks for the find enemy events are traced this many at a time, so the search can stop early
+#define FIND_ENEMY_SIGHT_BATCH		4
+
+typedef struct {
+	idEntity *		actor;
+	float			dist;
+} enemyCandidate_t;
+
+/*
+=====================
+SortEnemyCandidates
+=====================
+*/
+static int SortEnemyCandidates( const void *a, const void *b ) {
+	float d = ( (const enemyCandidate_t *)a )->dist - ( (const enemyCandidate_t *)b )->dist;
+	return ( d < 0.0f ) ? -1 : ( ( d > 0.0f ) ? 1 : 0 );
+}
+
+/*
+=====================
+FirstVisibleCandidate
+
+Returns the first of the candidates the actor can see, tracing them in small batches
+so nothing past the first visible batch is traced.
+=====================
+*/
+static idEntity *FirstVisibleCandidate( idActor *self, const enemyCandidate_t *candidates, int num, bool useFOV ) {
+	idEntity	*ents[ FIND_ENEMY_SIGHT_BATCH ];
+	bool		visible[ FIND_ENEMY_SIGHT_BATCH ];
+	int			i, j, count;
+
+	for ( i = 0; i < num; i += FIND_ENEMY_SIGHT_BATCH ) {
+		count = Min( num - i, FIND_ENEMY_SIGHT_BATCH );
+		for ( j = 0; j < count; j++ ) {
+			ents[ j ] = candidates[ i + j ].actor;
+		}
+		self->CanSeeList( ents, count, useFOV, visible );
+		for ( j = 0; j < count; j++ ) {
+			if ( visible[ j ] ) {
+				return ents[ j ];
+			}
+		}
+	}
+
+	return NULL;
+}
+
 /*
 =====================
 idAI::Event_FindEnemy
 =====================
 */
 void idAI::Event_FindEnemy( int useFOV ) {
-	int			i;
-	idEntity	*ent;
-	idActor		*actor;
+	int					i, num;
+	idEntity			*ent;
+	idActor				*actor;
+	enemyCandidate_t	candidates[ MAX_CLIENTS ];
 
 	if ( gameLocal.InPlayerPVS( this ) ) {
+		num = 0;
 		for ( i = 0; i < gameLocal.numClients ; i++ ) {
 			ent = gameLocal.entities[ i ];
 
@@ -311,11 +360,14 @@ void idAI::Event_FindEnemy( int useFOV ) {
 				continue;
 			}
 
-			if ( CanSee( actor, useFOV != 0 ) ) {
-				idThread::ReturnEntity( actor );
-				return;
-			}
+			candidates[ num ].actor = actor;
+			candidates[ num ].dist = 0.0f;
+			num++;
 		}
+
+		// clients keep their order, the first visible one is the enemy
+		idThread::ReturnEntity( FirstVisibleCandidate( this, candidates, num, useFOV != 0 ) );
+		return;
 	}
 
 	idThread::ReturnEntity( NULL );
@@ -327,19 +379,20 @@ idAI::Event_FindEnemyAI
 =====================
 */
 void idAI::Event_FindEnemyAI( int useFOV ) {
-	idEntity	*ent;
-	idActor		*actor;
-	idActor		*bestEnemy;
-	float		bestDist;
-	float		dist;
-	idVec3		delta;
-	pvsHandle_t pvs;
+	idEntity			*ent;
+	idActor				*actor;
+	idVec3				delta;
+	pvsHandle_t			pvs;
+	int					num;
+	enemyCandidate_t	*candidates;
 
 	pvs = gameLocal.pvs.SetupCurrentPVS( GetPVSAreas(), GetNumPVSAreas() );
 
-	bestDist = idMath::INFINITY;
-	bestEnemy = NULL;
-	for ( ent = gameLocal.activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+	candidates = (enemyCandidate_t *) _alloca16( gameLocal.num_entities * sizeof( candidates[0] ) );
+
+	// gather the actors in the PVS, then trace the closest ones first
+	num = 0;
+	for ( ent = gameLocal.activeEntities.Next(); ent != NULL && num < gameLocal.num_entities; ent = ent->activeNode.Next() ) {
 		if ( ent->fl.hidden || ent->fl.isDormant || !ent->IsType( idActor::Type ) ) {
 			continue;
 		}
@@ -354,15 +407,16 @@ void idAI::Event_FindEnemyAI( int useFOV ) {
 		}
 
 		delta = physicsObj.GetOrigin() - actor->GetPhysics()->GetOrigin();
-		dist = delta.LengthSqr();
-		if ( ( dist < bestDist ) && CanSee( actor, useFOV != 0 ) ) {
-			bestDist = dist;
-			bestEnemy = actor;
-		}
+		candidates[ num ].actor = actor;
+		candidates[ num ].dist = delta.LengthSqr();
+		num++;
 	}
 
 	gameLocal.pvs.FreeCurrentPVS( pvs );
-	idThread::ReturnEntity( bestEnemy );
+
+	qsort( candidates, num, sizeof( candidates[0] ), SortEnemyCandidates );
+
+	idThread::ReturnEntity( FirstVisibleCandidate( this, candidates, num, useFOV != 0 ) );
 }
 
 /*
@@ -54,6 +54,9 @@ void idMD5Anim::Free( void ) {
 	jointInfo.Clear();
 	bounds.Clear();
 	componentFrames.Clear();
+	quantizedFrames.Clear();
+	componentBias.Clear();
+	componentScale.Clear();
 }
 
 /*
@@ -121,7 +124,7 @@ idMD5Anim::Allocated
 ====================
 */
 size_t idMD5Anim::Allocated( void ) const {
-	size_t	size = bounds.Allocated() + jointInfo.Allocated() + componentFrames.Allocated() + name.Allocated();
+	size_t	size = bounds.Allocated() + jointInfo.Allocated() + componentFrames.Allocated() + quantizedFrames.Allocated() + componentBias.Allocated() + componentScale.Allocated() + name.Allocated();
 	return size;
 }
 
@@ -295,6 +298,10 @@ bool idMD5Anim::LoadAnim( const char *filename ) {
 	}
 	baseFrame[ 0 ].t.Zero();
 
+	if ( g_quantizeAnims.GetBool() ) {
+		QuantizeFrames();
+	}
+
 	// we don't count last frame because it would cause a 1 frame pause at the end
 	animLength = ( ( numFrames - 1 ) * 1000 + frameRate - 1 ) / frameRate;
 
@@ -302,6 +309,77 @@ bool idMD5Anim::LoadAnim( const char *filename ) {
 	return true;
 }
 
+/*
+====================
+idMD5Anim::QuantizeFrames
+
+Replaces the float components with 16 bit values spread over the range each
+component covers in this anim.  Quaternions are already stored without w.
+====================
+*/
+void idMD5Anim::QuantizeFrames( void ) {
+	int			i, j;
+	float		minValue, maxValue, invScale;
+	const float	*componentPtr;
+	short		*quantizedPtr;
+
+	if ( !numAnimatedComponents ) {
+		return;
+	}
+
+	componentBias.SetGranularity( 1 );
+	componentBias.SetNum( numAnimatedComponents );
+	componentScale.SetGranularity( 1 );
+	componentScale.SetNum( numAnimatedComponents );
+	quantizedFrames.SetGranularity( 1 );
+	quantizedFrames.SetNum( numAnimatedComponents * numFrames );
+
+	for( j = 0; j < numAnimatedComponents; j++ ) {
+		componentPtr = &componentFrames[ j ];
+		minValue = maxValue = componentPtr[ 0 ];
+		for( i = 1; i < numFrames; i++ ) {
+			float value = componentPtr[ numAnimatedComponents * i ];
+			if ( value < minValue ) {
+				minValue = value;
+			} else if ( value > maxValue ) {
+				maxValue = value;
+			}
+		}
+
+		// map [minValue, maxValue] onto [-32767, 32767]
+		componentBias[ j ] = ( minValue + maxValue ) * 0.5f;
+		componentScale[ j ] = ( maxValue - minValue ) * ( 1.0f / 65534.0f );
+		invScale = ( componentScale[ j ] > 0.0f ) ? 1.0f / componentScale[ j ] : 0.0f;
+
+		quantizedPtr = &quantizedFrames[ j ];
+		for( i = 0; i < numFrames; i++ ) {
+			float value = ( componentPtr[ numAnimatedComponents * i ] - componentBias[ j ] ) * invScale;
+			quantizedPtr[ numAnimatedComponents * i ] = idMath::ClampShort( (int)floor( value + 0.5f ) );
+		}
+	}
+
+	componentFrames.Clear();
+}
+
+/*
+====================
+idMD5Anim::GetFrameComponents
+
+Returns count animated components of a frame starting at first.  Quantized
+anims are decoded into the caller's buffer.
+====================
+*/
+const float *idMD5Anim::GetFrameComponents( int framenum, int first, int count, float *decoded ) const {
+	int offset = framenum * numAnimatedComponents + first;
+
+	if ( !quantizedFrames.Num() ) {
+		return &componentFrames[ offset ];
+	}
+
+	SIMDProcessor->DecodeAnimComponents( decoded, &quantizedFrames[ offset ], &componentBias[ first ], &componentScale[ first ], count );
+	return decoded;
+}
+
 /*
 ====================
 idMD5Anim::IncreaseRefs
@@ -417,8 +495,11 @@ void idMD5Anim::GetOrigin( idVec3 &offset, int time, int cyclecount ) const {
 
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float decoded1[ 3 ], decoded2[ 3 ];
+	int first = jointInfo[ 0 ].firstComponent;
+	int count = Min( 3, numAnimatedComponents - first );
+	const float *componentPtr1 = GetFrameComponents( frame.frame1, first, count, decoded1 );
+	const float *componentPtr2 = GetFrameComponents( frame.frame2, first, count, decoded2 );
 
 	if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 		offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -459,8 +540,11 @@ void idMD5Anim::GetOriginRotation( idQuat &rotation, int time, int cyclecount )
 
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float	*jointframe1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float	*jointframe2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float		decoded1[ 6 ], decoded2[ 6 ];
+	int			first = jointInfo[ 0 ].firstComponent;
+	int			count = Min( 6, numAnimatedComponents - first );
+	const float	*jointframe1 = GetFrameComponents( frame.frame1, first, count, decoded1 );
+	const float	*jointframe2 = GetFrameComponents( frame.frame2, first, count, decoded2 );
 
 	if ( animBits & ANIM_TX ) {
 		jointframe1++;
@@ -573,8 +657,11 @@ void idMD5Anim::GetBounds( idBounds &bnds, int time, int cyclecount ) const {
 	// origin position
 	offset = baseFrame[ 0 ].t;
 	if ( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) ) {
-		const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-		const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+		float decoded1[ 3 ], decoded2[ 3 ];
+		int first = jointInfo[ 0 ].firstComponent;
+		int count = Min( 3, numAnimatedComponents - first );
+		const float *componentPtr1 = GetFrameComponents( frame.frame1, first, count, decoded1 );
+		const float *componentPtr2 = GetFrameComponents( frame.frame2, first, count, decoded2 );
 
 		if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 			offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -627,8 +714,8 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints,
 	lerpIndex = (int *)_alloca16( baseFrame.Num() * sizeof( lerpIndex[ 0 ] ) );
 	numLerpJoints = 0;
 
-	frame1 = &componentFrames[ frame.frame1 * numAnimatedComponents ];
-	frame2 = &componentFrames[ frame.frame2 * numAnimatedComponents ];
+	frame1 = GetFrameComponents( frame.frame1, 0, numAnimatedComponents, (float *)_alloca16( numAnimatedComponents * sizeof( float ) ) );
+	frame2 = GetFrameComponents( frame.frame2, 0, numAnimatedComponents, (float *)_alloca16( numAnimatedComponents * sizeof( float ) ) );
 
 	for ( i = 0; i < numIndexes; i++ ) {
 		int j = index[i];
@@ -944,7 +1031,7 @@ void idMD5Anim::GetSingleFrame( int framenum, idJointQuat *joints, const int *in
 		return;
 	}
 
-	frame = &componentFrames[ framenum * numAnimatedComponents ];
+	frame = GetFrameComponents( framenum, 0, numAnimatedComponents, (float *)_alloca16( numAnimatedComponents * sizeof( float ) ) );
 
 	for ( i = 0; i < numIndexes; i++ ) {
 		int j = index[i];
@@ -232,10 +232,16 @@ protected:
 	idList<jointAnimInfo_t>	jointInfo;
 	idList<idJointQuat>		baseFrame;
 	idList<float>			componentFrames;
+	idList<short>			quantizedFrames;		// replaces componentFrames when g_quantizeAnims is set
+	idList<float>			componentBias;
+	idList<float>			componentScale;
 	idStr					name;
 	idVec3					totaldelta;
 	mutable int				ref_count;
 
+	void					QuantizeFrames( void );
+	const float *			GetFrameComponents( int framenum, int first, int count, float *decoded ) const;
+
 public:
 							idMD5Anim();
 							~idMD5Anim();
@@ -244,6 +244,10 @@ protected:	// HUMANHEAD
 	static int					typeNumBits;
 	static int					memused;
 	static int					numobjects;
+
+private:
+	friend class idEvent;
+	idLinkList<idEvent>			eventList;			// events queued on this object
 };
 
 /***********************************************************************
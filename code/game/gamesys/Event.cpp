@@ -14,6 +14,12 @@ Event are used for scheduling tasks and for linking script commands.
 
 #define MAX_EVENTSPERFRAME			4096
 
+// hierarchical timing wheel, each level covers EVENT_WHEEL_SLOTS slots of the level below
+#define EVENT_WHEEL_BITS			5
+#define EVENT_WHEEL_SLOTS			( 1 << EVENT_WHEEL_BITS )
+#define EVENT_WHEEL_MASK			( EVENT_WHEEL_SLOTS - 1 )
+#define EVENT_WHEEL_LEVELS			5
+
 //HUMANHEAD: aob - needed for networking to send the least amount of bits
 const int MAX_EVENTS_NUM_BITS		= hhMath::BitsForInteger( MAX_EVENTS );
 //HUMANHEAD END
@@ -32,6 +38,22 @@ int idEventDef::numEventDefs = 0;
 static bool eventError = false;
 static char eventErrorMsg[ 128 ];
 
+/*
+================
+EventArgGroup
+================
+*/
+static int EventArgGroup( char format ) {
+	switch( format ) {
+		case D_EVENT_INTEGER :		return EVENT_ARGGROUP_INTEGER;
+		case D_EVENT_FLOAT :		return EVENT_ARGGROUP_FLOAT;
+		case D_EVENT_ENTITY :		return EVENT_ARGGROUP_ENTITY;
+		case D_EVENT_ENTITY_NULL :	return EVENT_ARGGROUP_ENTITY_NULL;
+		case D_EVENT_TRACE :		return EVENT_ARGGROUP_TRACE;
+		default :					return EVENT_ARGGROUP_POINTER;
+	}
+}
+
 /*
 ================
 idEventDef::idEventDef
@@ -41,6 +63,7 @@ idEventDef::idEventDef( const char *command, const char *formatspec, char return
 	idEventDef		*ev;
 	int				i;
 	unsigned int	bits;
+	byte			groupNum[ EVENT_ARGGROUP_NUM ];
 
 	assert( command );
 	assert( !idEvent::initialized );
@@ -120,6 +143,19 @@ idEventDef::idEventDef( const char *command, const char *formatspec, char return
 	// calculate the formatspecindex
 	formatspecIndex = ( 1 << ( numargs + D_EVENT_MAXARGS ) ) | bits;
 
+	// group the args by how they are passed
+	memset( argGroupStart, 0, sizeof( argGroupStart ) );
+	for( i = 0; i < numargs; i++ ) {
+		argGroupStart[ EventArgGroup( formatspec[ i ] ) + 1 ]++;
+	}
+	for( i = 0; i < EVENT_ARGGROUP_NUM; i++ ) {
+		argGroupStart[ i + 1 ] += argGroupStart[ i ];
+		groupNum[ i ] = argGroupStart[ i ];
+	}
+	for( i = 0; i < numargs; i++ ) {
+		argGroupArgs[ groupNum[ EventArgGroup( formatspec[ i ] ) ]++ ] = i;
+	}
+
 	// go through the list of defined events and check for duplicates
 	// and mismatched format strings
 	eventnum = numEventDefs;
@@ -218,22 +254,25 @@ const idEventDef *idEventDef::FindEvent( int eventId ) {
 
 ***********************************************************************/
 
-static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
-static idEvent EventPool[ MAX_EVENTS ];
+/*
+Queued events are kept in a hierarchical timing wheel.  Level 0 has a slot for each
+millisecond of the current EVENT_WHEEL_SLOTS milliseconds, level 1 a slot for each
+EVENT_WHEEL_SLOTS milliseconds of the current EVENT_WHEEL_SLOTS^2 milliseconds, and so on.
+Events beyond the last level wait in the overflow list.  When the wheel time moves into
+the range of a slot on a higher level the events in that slot are moved down a level.
+Events are appended to the slots, so events with the same time are serviced in the
+order they were scheduled, the same as the sorted list the wheel replaces.
+*/
+static idLinkList<idEvent> EventWheel[ EVENT_WHEEL_LEVELS ][ EVENT_WHEEL_SLOTS ];
+static unsigned int EventWheelUsed[ EVENT_WHEEL_LEVELS ];	// slots that may hold events
+static idLinkList<idEvent> EventOverflow;
+static int EventWheelTime;									// all queued events are at or after this time
+static int EventSequence;
 
 bool idEvent::initialized = false;
 
 idDynamicBlockAlloc<byte, 16 * 1024, 256>	idEvent::eventDataAllocator;
-
-/*
-================
-idEvent::~idEvent()
-================
-*/
-idEvent::~idEvent() {
-	Free();
-}
+idBlockAlloc<idEvent, 256>					idEvent::eventAllocator;
 
 /*
 ================
@@ -249,12 +288,13 @@ idEvent *idEvent::Alloc( const idEventDef *evdef, int numargs, va_list args ) {
 	int			i;
 	const char	*materialName;
 
-	if ( FreeEvents.IsListEmpty() ) {
-		gameLocal.Error( "idEvent::Alloc : No more free events" );
-	}
-
-	ev = FreeEvents.Next();
-	ev->eventNode.Remove();
+	ev = eventAllocator.Alloc();
+	ev->eventNode.SetOwner( ev );
+	ev->objectNode.SetOwner( ev );
+	ev->time = 0;
+	ev->sequence = 0;
+	ev->object = NULL;
+	ev->typeinfo = NULL;
 
 	ev->eventdef = evdef;
 
@@ -375,18 +415,185 @@ void idEvent::Free( void ) {
 	object		= NULL;
 	typeinfo	= NULL;
 
-	eventNode.SetOwner( this );
-	eventNode.AddToEnd( FreeEvents );
+	eventNode.Remove();
+	objectNode.Remove();
+	eventAllocator.Free( this );
 }
 
 /*
 ================
-idEvent::Schedule
+idEvent::Link
+
+Adds the event to the timing wheel slot for its time.
 ================
 */
-void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
+void idEvent::Link( void ) {
+	int level, shift, slot;
+
+	if ( time < EventWheelTime ) {
+		// game time went back, which happens during client side prediction
+		RewindQueue( time );
+	}
+
+	for( level = 0; level < EVENT_WHEEL_LEVELS; level++ ) {
+		shift = level * EVENT_WHEEL_BITS;
+		if ( ( time >> ( shift + EVENT_WHEEL_BITS ) ) == ( EventWheelTime >> ( shift + EVENT_WHEEL_BITS ) ) ) {
+			slot = ( time >> shift ) & EVENT_WHEEL_MASK;
+			eventNode.AddToEnd( EventWheel[ level ][ slot ] );
+			EventWheelUsed[ level ] |= BIT( slot );
+			return;
+		}
+	}
+
+	eventNode.AddToEnd( EventOverflow );
+}
+
+/*
+================
+idEvent::NextEvent
+
+Returns the first event due at or before endTime, or NULL if there is none.
+Advances the wheel and moves events down the levels as needed.
+================
+*/
+idEvent *idEvent::NextEvent( int endTime ) {
+	idLinkList<idEvent> moved;
+	idEvent *event;
+	int level, shift, slot, slotTime, minTime;
+
+	while( 1 ) {
+		// find the first used slot on the lowest level that has events
+		slot = -1;
+		for( level = 0; level < EVENT_WHEEL_LEVELS; level++ ) {
+			while( EventWheelUsed[ level ] ) {
+				for( slot = 0; !( EventWheelUsed[ level ] & BIT( slot ) ); slot++ ) {
+				}
+				if ( !EventWheel[ level ][ slot ].IsListEmpty() ) {
+					break;
+				}
+				EventWheelUsed[ level ] &= ~BIT( slot );
+				slot = -1;
+			}
+			if ( slot >= 0 ) {
+				break;
+			}
+		}
+
+		if ( slot < 0 ) {
+			if ( EventOverflow.IsListEmpty() ) {
+				EventWheelTime = Max( EventWheelTime, endTime );
+				return NULL;
+			}
+
+			// refill the wheel from the overflow list
+			minTime = EventOverflow.Next()->time;
+			for( event = EventOverflow.Next(); event != NULL; event = event->eventNode.Next() ) {
+				minTime = Min( minTime, event->time );
+			}
+			shift = EVENT_WHEEL_LEVELS * EVENT_WHEEL_BITS;
+			if ( minTime > endTime && ( endTime >> shift ) == ( EventWheelTime >> shift ) ) {
+				EventWheelTime = Max( EventWheelTime, endTime );
+				return NULL;
+			}
+			EventWheelTime = Min( minTime, endTime );
+			level = EVENT_WHEEL_LEVELS;
+		} else {
+			shift = level * EVENT_WHEEL_BITS;
+			slotTime = ( ( EventWheelTime >> ( shift + EVENT_WHEEL_BITS ) ) << ( shift + EVENT_WHEEL_BITS ) ) | ( slot << shift );
+			if ( slotTime > endTime ) {
+				EventWheelTime = Max( EventWheelTime, endTime );
+				return NULL;
+			}
+			EventWheelTime = Max( EventWheelTime, slotTime );
+
+			if ( level == 0 ) {
+				return EventWheel[ 0 ][ slot ].Next();
+			}
+		}
+
+		// move the events down, keeping them in the order they were scheduled
+		if ( level < EVENT_WHEEL_LEVELS ) {
+			EventWheelUsed[ level ] &= ~BIT( slot );
+			while( ( event = EventWheel[ level ][ slot ].Next() ) != NULL ) {
+				event->eventNode.AddToEnd( moved );
+			}
+		} else {
+			while( ( event = EventOverflow.Next() ) != NULL ) {
+				event->eventNode.AddToEnd( moved );
+			}
+		}
+		while( ( event = moved.Next() ) != NULL ) {
+			event->Link();
+		}
+	}
+}
+
+/*
+================
+idEvent::SortByTime
+================
+*/
+int idEvent::SortByTime( idEvent * const *a, idEvent * const *b ) {
+	if ( ( *a )->time != ( *b )->time ) {
+		return ( *a )->time - ( *b )->time;
+	}
+	return ( *a )->sequence - ( *b )->sequence;
+}
+
+/*
+================
+idEvent::GetQueuedEvents
+
+Gets all queued events in the order they will be serviced.
+================
+*/
+void idEvent::GetQueuedEvents( idList<idEvent *> &list ) {
 	idEvent *event;
+	int i, j;
+
+	list.Clear();
+	for( i = 0; i < EVENT_WHEEL_LEVELS; i++ ) {
+		for( j = 0; j < EVENT_WHEEL_SLOTS; j++ ) {
+			for( event = EventWheel[ i ][ j ].Next(); event != NULL; event = event->eventNode.Next() ) {
+				list.Append( event );
+			}
+		}
+	}
+	for( event = EventOverflow.Next(); event != NULL; event = event->eventNode.Next() ) {
+		list.Append( event );
+	}
+	list.Sort( SortByTime );
+}
+
+/*
+================
+idEvent::RewindQueue
+
+Moves the wheel back to an earlier time.
+================
+*/
+void idEvent::RewindQueue( int newTime ) {
+	idList<idEvent *> list;
+	int i;
+
+	GetQueuedEvents( list );
+	for( i = 0; i < list.Num(); i++ ) {
+		list[ i ]->eventNode.Remove();
+	}
+	memset( EventWheelUsed, 0, sizeof( EventWheelUsed ) );
 
+	EventWheelTime = newTime;
+	for( i = 0; i < list.Num(); i++ ) {
+		list[ i ]->Link();
+	}
+}
+
+/*
+================
+idEvent::Schedule
+================
+*/
+void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
 	assert( initialized );
 	if ( !initialized ) {
 		return;
@@ -397,19 +604,12 @@ void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
 
 	// wraps after 24 days...like I care. ;)
 	this->time = gameLocal.time + time;
+	sequence = EventSequence++;
 
 	eventNode.Remove();
+	Link();
 
-	event = EventQueue.Next();
-	while( ( event != NULL ) && ( this->time >= event->time ) ) {
-		event = event->eventNode.Next();
-	}
-
-	if ( event ) {
-		eventNode.InsertBefore( event->eventNode );
-	} else {
-		eventNode.AddToEnd( EventQueue );
-	}
+	objectNode.AddToEnd( obj->eventList );
 }
 
 /*
@@ -425,12 +625,10 @@ void idEvent::CancelEvents( const idClass *obj, const idEventDef *evdef ) {
 		return;
 	}
 
-	for( event = EventQueue.Next(); event != NULL; event = next ) {
-		next = event->eventNode.Next();
-		if ( event->object == obj ) {
-			if ( !evdef || ( evdef == event->eventdef ) ) {
-				event->Free();
-			}
+	for( event = obj->eventList.Next(); event != NULL; event = next ) {
+		next = event->objectNode.Next();
+		if ( !evdef || ( evdef == event->eventdef ) ) {
+			event->Free();
 		}
 	}
 }
@@ -441,20 +639,17 @@ idEvent::ClearEventList
 ================
 */
 void idEvent::ClearEventList( void ) {
+	idList<idEvent *> list;
 	int i;
 
-	//
-	// initialize lists
-	//
-	FreeEvents.Clear();
-	EventQueue.Clear();
-   
-	// 
-	// add the events to the free list
-	//
-	for( i = 0; i < MAX_EVENTS; i++ ) {
-		EventPool[ i ].Free();
+	GetQueuedEvents( list );
+	for( i = 0; i < list.Num(); i++ ) {
+		list[ i ]->Free();
 	}
+
+	memset( EventWheelUsed, 0, sizeof( EventWheelUsed ) );
+	EventWheelTime = 0;
+	EventSequence = 0;
 }
 
 /*
@@ -469,70 +664,65 @@ void idEvent::ServiceEvents( void ) {
 	int			offset;
 	int			i;
 	int			numargs;
-	const char	*formatspec;
+	const byte	*group;
 	trace_t		**tracePtr;
 	const idEventDef *ev;
 	byte		*data;
 	const char  *materialName;
 
 	num = 0;
-	while( !EventQueue.IsListEmpty() ) {
-		event = EventQueue.Next();
-		assert( event );
-
-		if ( event->time > gameLocal.time ) {
-			break;
-		}
+	while( ( event = NextEvent( gameLocal.time ) ) != NULL ) {
 
 		// copy the data into the local args array and set up pointers
 		ev = event->eventdef;
-		formatspec = ev->GetArgFormat();
-		numargs = ev->GetNumArgs();
+		data = event->data;
+
+		group = ev->GetArgGroup( EVENT_ARGGROUP_INTEGER, numargs );
 		for( i = 0; i < numargs; i++ ) {
-			offset = ev->GetArgOffset( i );
-			data = event->data;
-			switch( formatspec[ i ] ) {
-			case D_EVENT_FLOAT :
-			case D_EVENT_INTEGER :
-				args[ i ] = *reinterpret_cast<int *>( &data[ offset ] );
-				break;
+			args[ group[ i ] ] = *reinterpret_cast<int *>( &data[ ev->GetArgOffset( group[ i ] ) ] );
+		}
 
-			case D_EVENT_VECTOR :
-				*reinterpret_cast<idVec3 **>( &args[ i ] ) = reinterpret_cast<idVec3 *>( &data[ offset ] );
-				break;
+		group = ev->GetArgGroup( EVENT_ARGGROUP_FLOAT, numargs );
+		for( i = 0; i < numargs; i++ ) {
+			args[ group[ i ] ] = *reinterpret_cast<int *>( &data[ ev->GetArgOffset( group[ i ] ) ] );
+		}
 
-			case D_EVENT_STRING :
-				*reinterpret_cast<const char **>( &args[ i ] ) = reinterpret_cast<const char *>( &data[ offset ] );
-				break;
+		group = ev->GetArgGroup( EVENT_ARGGROUP_POINTER, numargs );
+		for( i = 0; i < numargs; i++ ) {
+			*reinterpret_cast<byte **>( &args[ group[ i ] ] ) = &data[ ev->GetArgOffset( group[ i ] ) ];
+		}
 
-			case D_EVENT_ENTITY :
-			case D_EVENT_ENTITY_NULL :
-				*reinterpret_cast<idEntity **>( &args[ i ] ) = reinterpret_cast< idEntityPtr<idEntity> * >( &data[ offset ] )->GetEntity();
-				break;
+		group = ev->GetArgGroup( EVENT_ARGGROUP_ENTITY, numargs );
+		for( i = 0; i < numargs; i++ ) {
+			*reinterpret_cast<idEntity **>( &args[ group[ i ] ] ) = reinterpret_cast< idEntityPtr<idEntity> * >( &data[ ev->GetArgOffset( group[ i ] ) ] )->GetEntity();
+		}
 
-			case D_EVENT_TRACE :
-				tracePtr = reinterpret_cast<trace_t **>( &args[ i ] );
-				if ( *reinterpret_cast<bool *>( &data[ offset ] ) ) {
-					*tracePtr = reinterpret_cast<trace_t *>( &data[ offset + sizeof( bool ) ] );
+		group = ev->GetArgGroup( EVENT_ARGGROUP_ENTITY_NULL, numargs );
+		for( i = 0; i < numargs; i++ ) {
+			*reinterpret_cast<idEntity **>( &args[ group[ i ] ] ) = reinterpret_cast< idEntityPtr<idEntity> * >( &data[ ev->GetArgOffset( group[ i ] ) ] )->GetEntity();
+		}
 
-					if ( ( *tracePtr )->c.material != NULL ) {
-						// look up the material name to get the material pointer
-						materialName = reinterpret_cast<const char *>( &data[ offset + sizeof( bool ) + sizeof( trace_t ) ] );
-						( *tracePtr )->c.material = declManager->FindMaterial( materialName, true );
-					}
-				} else {
-					*tracePtr = NULL;
+		group = ev->GetArgGroup( EVENT_ARGGROUP_TRACE, numargs );
+		for( i = 0; i < numargs; i++ ) {
+			offset = ev->GetArgOffset( group[ i ] );
+			tracePtr = reinterpret_cast<trace_t **>( &args[ group[ i ] ] );
+			if ( *reinterpret_cast<bool *>( &data[ offset ] ) ) {
+				*tracePtr = reinterpret_cast<trace_t *>( &data[ offset + sizeof( bool ) ] );
+
+				if ( ( *tracePtr )->c.material != NULL ) {
+					// look up the material name to get the material pointer
+					materialName = reinterpret_cast<const char *>( &data[ offset + sizeof( bool ) + sizeof( trace_t ) ] );
+					( *tracePtr )->c.material = declManager->FindMaterial( materialName, true );
 				}
-				break;
-
-			default:
-				gameLocal.Error( "idEvent::ServiceEvents : Invalid arg format '%s' string for '%s' event.", formatspec, ev->GetName() );
+			} else {
+				*tracePtr = NULL;
 			}
 		}
 
-		// the event is removed from its list so that if then object
+		// the event is removed from its lists so that if then object
 		// is deleted, the event won't be freed twice
 		event->eventNode.Remove();
+		event->objectNode.Remove();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -606,6 +796,7 @@ void idEvent::Shutdown( void ) {
 	ClearEventList();
 	
 	eventDataAllocator.Shutdown();
+	eventAllocator.Shutdown();
 
 	// say it is now shutdown
 	initialized = false;
@@ -614,19 +805,15 @@ void idEvent::Shutdown( void ) {
 // HUMANHEAD pdm
 int idEvent::NumQueuedEvents( const idClass *obj, const idEventDef *evdef ) {
 	idEvent *event;
-	idEvent *next;
 	int count=0;
 
 	if ( !initialized ) {
 		return 0;
 	}
 
-	for( event = EventQueue.Next(); event != NULL; event = next ) {
-		next = event->eventNode.Next();
-		if ( event->object == obj ) {
-			if ( !evdef || ( evdef == event->eventdef ) ) {
-				count++;
-			}
+	for( event = obj->eventList.Next(); event != NULL; event = event->objectNode.Next() ) {
+		if ( !evdef || ( evdef == event->eventdef ) ) {
+			count++;
 		}
 	}
 	return count;
@@ -640,8 +827,9 @@ idEvent::Save
 */
 void idEvent::Save(idSaveGame* savefile) {
 	char* str;
-	int i, size;
+	int i, j, size;
 	idEvent* event;
+	idList<idEvent*> list;
 	byte* dataPtr;
 	bool validTrace;
 	const char* format;
@@ -649,11 +837,13 @@ void idEvent::Save(idSaveGame* savefile) {
 	idStr s;
 	// RB end
 
-	savefile->WriteInt(EventQueue.Num());
+	// write the events in the order they will be serviced
+	GetQueuedEvents(list);
+	savefile->WriteInt(list.Num());
 
-	event = EventQueue.Next();
-	while (event != NULL)
+	for (j = 0; j < list.Num(); j++)
 	{
+		event = list[j];
 		savefile->WriteInt(event->time);
 		savefile->WriteString(event->eventdef->GetName());
 		savefile->WriteString(event->typeinfo->classname);
@@ -723,7 +913,6 @@ void idEvent::Save(idSaveGame* savefile) {
 			}
 		}
 		assert(size == (int)event->eventdef->GetArgSize());
-		event = event->eventNode.Next();
 	}
 }
 
@@ -747,14 +936,10 @@ void idEvent::Restore(idRestoreGame* savefile) {
 
 	for (i = 0; i < num; i++)
 	{
-		if (FreeEvents.IsListEmpty())
-		{
-			gameLocal.Error("idEvent::Restore : No more free events");
-		}
-
-		event = FreeEvents.Next();
-		event->eventNode.Remove();
-		event->eventNode.AddToEnd(EventQueue);
+		event = eventAllocator.Alloc();
+		event->eventNode.SetOwner(event);
+		event->objectNode.SetOwner(event);
+		event->data = NULL;
 
 		savefile->ReadInt(event->time);
 
@@ -778,6 +963,14 @@ void idEvent::Restore(idRestoreGame* savefile) {
 
 		savefile->ReadObject(event->object);
 
+		// the events were saved in order, so linking them in order keeps it
+		event->sequence = EventSequence++;
+		event->Link();
+		if (event->object)
+		{
+			event->objectNode.AddToEnd(event->object->eventList);
+		}
+
 		// read the args
 		savefile->ReadInt(argsize);
 		if (argsize != (int)event->eventdef->GetArgSize())
@@ -32,6 +32,18 @@ extern const int MAX_EVENTS_NUM_BITS;
 class idClass;
 class idTypeInfo;
 
+// event args are grouped by how they are passed so they can be marshalled
+// without parsing the format string on every call
+enum {
+	EVENT_ARGGROUP_INTEGER,
+	EVENT_ARGGROUP_FLOAT,
+	EVENT_ARGGROUP_POINTER,						// vectors and strings are passed by pointer
+	EVENT_ARGGROUP_ENTITY,
+	EVENT_ARGGROUP_ENTITY_NULL,
+	EVENT_ARGGROUP_TRACE,
+	EVENT_ARGGROUP_NUM
+};
+
 class idEventDef {
 private:
 	const char					*name;
@@ -41,6 +53,8 @@ private:
 	int							numargs;
 	size_t						argsize;
 	int							argOffset[ D_EVENT_MAXARGS ];
+	byte						argGroupStart[ EVENT_ARGGROUP_NUM + 1 ];
+	byte						argGroupArgs[ D_EVENT_MAXARGS ];
 	int							eventnum;
 	const idEventDef *			next;
 
@@ -58,6 +72,7 @@ public:
 	int							GetNumArgs( void ) const;
 	size_t						GetArgSize( void ) const;
 	int							GetArgOffset( int arg ) const;
+	const byte *				GetArgGroup( int group, int &num ) const;
 
 	static int					NumEventCommands( void );
 	static const idEventDef		*GetEventCommand( int eventnum );
@@ -76,19 +91,25 @@ private:
 	const idEventDef			*eventdef;
 	byte						*data;
 	int							time;
+	int							sequence;		// orders events scheduled for the same time
 	idClass						*object;
 	const idTypeInfo			*typeinfo;
 
-	idLinkList<idEvent>			eventNode;
+	idLinkList<idEvent>			eventNode;		// node in a timing wheel slot
+	idLinkList<idEvent>			objectNode;		// node in the event list of the object
 
 	static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
+	static idBlockAlloc<idEvent, 256> eventAllocator;
 
+	void						Link( void );
+	static idEvent *			NextEvent( int endTime );
+	static void					RewindQueue( int newTime );
+	static void					GetQueuedEvents( idList<idEvent *> &list );
+	static int					SortByTime( idEvent * const *a, idEvent * const *b );
 
 public:
 	static bool					initialized;
 
-								~idEvent();
-
 	static idEvent				*Alloc( const idEventDef *evdef, int numargs, va_list args );
 	static void					CopyArgs( const idEventDef *evdef, int numargs, va_list args, intptr_t data[ D_EVENT_MAXARGS ]  );
 	
@@ -187,6 +208,19 @@ ID_INLINE int idEventDef::GetArgOffset( int arg ) const {
 	return argOffset[ arg ];
 }
 
+/*
+================
+idEventDef::GetArgGroup
+
+Returns the indices of the args in the given group.
+================
+*/
+ID_INLINE const byte *idEventDef::GetArgGroup( int group, int &num ) const {
+	assert( ( group >= 0 ) && ( group < EVENT_ARGGROUP_NUM ) );
+	num = argGroupStart[ group + 1 ] - argGroupStart[ group ];
+	return &argGroupArgs[ argGroupStart[ group ] ];
+}
+
 /*
 ================
 idEventDef::GetEventNum
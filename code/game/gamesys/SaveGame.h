@@ -11,6 +11,7 @@ Save game related helper classes.
 */
 
 const int INITIAL_RELEASE_BUILD_NUMBER = 1262;
+const int ENTITY_POOL_BUILD_NUMBER = 1305;	// first build saving the entity pool flags
 
 class idSaveGame {
 public:
@@ -94,6 +94,33 @@ void Cmd_ActiveEntityList_f( const idCmdArgs &args ) {
 	gameLocal.Printf( "...%d active entities\n", count );
 }
 
+/*
+===================
+Cmd_ListThinkCosts_f
+===================
+*/
+void Cmd_ListThinkCosts_f( const idCmdArgs &args ) {
+	if ( !idStr::Icmp( args.Argv( 1 ), "clear" ) ) {
+		gameLocal.thinkCosts.Clear();
+		gameLocal.thinkCostFrames = 0;
+		return;
+	}
+	gameLocal.ListThinkCosts();
+}
+
+/*
+===================
+Cmd_ListEntityPools_f
+===================
+*/
+void Cmd_ListEntityPools_f( const idCmdArgs &args ) {
+	if ( !idStr::Icmp( args.Argv( 1 ), "clear" ) ) {
+		gameLocal.entityPool.ClearStats();
+		return;
+	}
+	gameLocal.entityPool.ListPools();
+}
+
 /*
 ===================
 Cmd_ListSpawnArgs_f
@@ -1568,6 +1595,42 @@ static void Cmd_CollisionModelInfo_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+==================
+Cmd_RecordCollisionTraces_f
+==================
+*/
+static void Cmd_RecordCollisionTraces_f( const idCmdArgs &args ) {
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	if ( args.Argc() < 3 ) {
+		gameLocal.Printf( "usage: recordCollisionTraces <file> <numTraces>\n" );
+		return;
+	}
+
+	collisionModelManager->RecordTraces( args.Argv( 1 ), atoi( args.Argv( 2 ) ) );
+}
+
+/*
+==================
+Cmd_BenchmarkCollisionTraces_f
+==================
+*/
+static void Cmd_BenchmarkCollisionTraces_f( const idCmdArgs &args ) {
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	if ( args.Argc() < 2 ) {
+		gameLocal.Printf( "usage: benchmarkCollisionTraces <file> [iterations]\n" );
+		return;
+	}
+
+	collisionModelManager->BenchmarkTraces( args.Argv( 1 ), args.Argc() > 2 ? atoi( args.Argv( 2 ) ) : 1 );
+}
+
 /*
 ==================
 Cmd_ExportModels_f
@@ -2245,6 +2308,54 @@ static void Cmd_DisasmScript_f( const idCmdArgs &args ) {
 	gameLocal.program.Disassemble();
 }
 
+/*
+==================
+Cmd_ScriptWriteNative_f
+==================
+*/
+static void Cmd_ScriptWriteNative_f( const idCmdArgs &args ) {
+	gameLocal.program.WriteNativeFunctions( ( args.Argc() > 1 ) ? args.Argv( 1 ) : "script/Script_NativeFunctions.h" );
+}
+
+/*
+==================
+Cmd_ScriptOptimizeStats_f
+
+Lists the statement counts of the script functions before and after g_scriptOptimize
+==================
+*/
+static void Cmd_ScriptOptimizeStats_f( const idCmdArgs &args ) {
+	int			i;
+	int			numFunctions;
+	int			before;
+	int			after;
+	const char	*filter;
+	const function_t *func;
+
+	filter = ( args.Argc() > 1 ) ? args.Argv( 1 ) : NULL;
+
+	numFunctions = 0;
+	before = 0;
+	after = 0;
+	for( i = 0; i < gameLocal.program.NumFunctions(); i++ ) {
+		func = gameLocal.program.GetFunction( i );
+		if ( func->eventdef || !func->numUnoptimizedStatements ) {
+			continue;
+		}
+		if ( filter && idStr::FindText( func->Name(), filter, false ) < 0 ) {
+			continue;
+		}
+		if ( filter || ( func->numStatements != func->numUnoptimizedStatements ) ) {
+			gameLocal.Printf( "%5d %5d %s\n", func->numUnoptimizedStatements, func->numStatements, func->Name() );
+		}
+		numFunctions++;
+		before += func->numUnoptimizedStatements;
+		after += func->numStatements;
+	}
+
+	gameLocal.Printf( "%d functions, %d statements before optimization, %d after, %.1f%% fewer\n", numFunctions, before, after, before ? 100.0f * ( before - after ) / before : 0.0f );
+}
+
 /*
 ==================
 Cmd_TestSave_f
@@ -2717,8 +2828,12 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "game_memory",			idClass::DisplayInfo_f,		CMD_FL_GAME,				"displays game class info" );
 	cmdSystem->AddCommand( "listClasses",			idClass::ListClasses_f,		CMD_FL_GAME,				"lists game classes" );
 	cmdSystem->AddCommand( "listThreads",			idThread::ListThreads_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"lists script threads" );
+	cmdSystem->AddCommand( "scriptBenchmark",		idInterpreter::Benchmark_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"compares the speed and results of the plain and threaded script interpreters" );
+	cmdSystem->AddCommand( "scriptProfile",			idScriptProfiler::Profile_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"clears the g_scriptProfile times or writes the flat and call tree report" );
 	cmdSystem->AddCommand( "listEntities",			Cmd_EntityList_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"lists game entities" );
 	cmdSystem->AddCommand( "listActiveEntities",	Cmd_ActiveEntityList_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"lists active game entities" );
+	cmdSystem->AddCommand( "listThinkCosts",		Cmd_ListThinkCosts_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"lists the think time of each entity class collected with g_timeEntityClasses, 'clear' resets it" );
+	cmdSystem->AddCommand( "listEntityPools",		Cmd_ListEntityPools_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"lists the projectile and fx pools with their hits and misses, 'clear' resets the counts" );
 	cmdSystem->AddCommand( "listMonsters",			idAI::List_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"lists monsters" );
 	cmdSystem->AddCommand( "listSpawnArgs",			Cmd_ListSpawnArgs_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"list the spawn args of an entity", idGameLocal::ArgCompletion_EntityName );
 	cmdSystem->AddCommand( "say",					Cmd_Say_f,					CMD_FL_GAME,				"text chat" );
@@ -2776,6 +2891,9 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "script",				Cmd_Script_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"executes a line of script" );
 	cmdSystem->AddCommand( "listCollisionModels",	Cmd_ListCollisionModels_f,	CMD_FL_GAME,				"lists collision models" );
 	cmdSystem->AddCommand( "collisionModelInfo",	Cmd_CollisionModelInfo_f,	CMD_FL_GAME,				"shows collision model info" );
+	cmdSystem->AddCommand( "recordCollisionTraces",	Cmd_RecordCollisionTraces_f,	CMD_FL_GAME,	"records collision model translations for benchmarkCollisionTraces" );
+	cmdSystem->AddCommand( "benchmarkCollisionTraces",	Cmd_BenchmarkCollisionTraces_f,	CMD_FL_GAME,	"replays recorded translations through both collision model trees" );
+	cmdSystem->AddCommand( "testLCP",				idLCP::Test_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"compares the LCP solvers on systems captured with lcp_captureSystems" );
 	cmdSystem->AddCommand( "reexportmodels",		Cmd_ReexportModels_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"reexports models", ArgCompletion_DefFile );
 	cmdSystem->AddCommand( "reloadanims",			Cmd_ReloadAnims_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"reloads animations" );
 	cmdSystem->AddCommand( "listAnims",				Cmd_ListAnims_f,			CMD_FL_GAME,				"lists all animations" );
@@ -2795,6 +2913,8 @@ void idGameLocal::InitConsoleCommands( void ) {
 
 #ifndef	ID_DEMO_BUILD
 	cmdSystem->AddCommand( "disasmScript",			Cmd_DisasmScript_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"disassembles script" );
+	cmdSystem->AddCommand( "scriptWriteNative",		Cmd_ScriptWriteNative_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"writes the script functions as C++ to script/Script_NativeFunctions.h under fs_savepath, copy it over game/script/Script_NativeFunctions.h to build them in" );
+	cmdSystem->AddCommand( "scriptOptimizeStats",	Cmd_ScriptOptimizeStats_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"lists script functions shortened by g_scriptOptimize, or the ones matching a filter" );
 	cmdSystem->AddCommand( "recordViewNotes",		Cmd_RecordViewNotes_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"record the current view position with notes" );
 	cmdSystem->AddCommand( "showViewNotes",			Cmd_ShowViewNotes_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"show any view notes for the current map, successive calls will cycle to the next note" );
 	cmdSystem->AddCommand( "closeViewNotes",		Cmd_CloseViewNotes_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"close the view showing any notes for this map" );
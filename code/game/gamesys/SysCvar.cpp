@@ -44,7 +44,10 @@ idCVar g_nodormant(					"g_nodormant",					"0",			CVAR_GAME | CVAR_BOOL,			"Disa
 idCVar g_robustDormantAll(			"g_robustDormantAll",			"0",			CVAR_GAME | CVAR_BOOL,			"All dormant checks check all areas" );
 idCVar g_dormanttests(				"g_dormanttests",				"0",			CVAR_GAME | CVAR_BOOL,			"" );
 idCVar pm_wallwalkstepsize(			"pm_wallwalkstepsize",			"8",			CVAR_GAME | CVAR_FLOAT,			"Step size while wallwalking" );
+idCVar pm_wallwalkPatchCache(		"pm_wallwalkPatchCache",		"0",			CVAR_GAME | CVAR_BOOL,			"ray test the wallwalk ground probes against the world polygons around the player instead of tracing them" );
+idCVar pm_wallwalkPatchRadius(		"pm_wallwalkPatchRadius",		"32",			CVAR_GAME | CVAR_FLOAT,			"distance the player can move before the world polygons around the wallwalk ground probes are gathered again", 0, 256 );
 idCVar g_vehicleDebug(				"g_vehicleDebug",				"0",			CVAR_GAME | CVAR_INTEGER,		"print out vehicle physics debug info" );
+idCVar g_vehicleStepTime(			"g_vehicleStepTime",			"8",			CVAR_GAME | CVAR_INTEGER,		"physics step time in milliseconds for vehicles without a physicsStepTime spawn arg, 0 = one step per game frame", 0, 100 );
 idCVar sys_SavedPosition(			"sys_savedPosition",			"",				CVAR_GAME | CVAR_ARCHIVE,		"saved position used by getpos/putpos" );
 idCVar g_crosshair(					"g_crosshair",					"1",			CVAR_GAME | CVAR_INTEGER | CVAR_ARCHIVE,	"Which crosshair to use (0=off)", 0, 8 );
 idCVar g_springConstant(			"g_springConstant",				"200000",		CVAR_GAME | CVAR_FLOAT,			"Modify factor for bind controller tension" );
@@ -155,6 +158,8 @@ idCVar g_cinematicMaxSkipTime(		"g_cinematicMaxSkipTime",	"600",			CVAR_GAME | C
 
 idCVar g_muzzleFlash(				"g_muzzleFlash",			"1",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "show muzzle flashes" );
 idCVar g_projectileLights(			"g_projectileLights",		"1",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "show dynamic lights on projectiles" );
+idCVar g_entityPool(				"g_entityPool",				"1",			CVAR_GAME | CVAR_BOOL, "keep removed projectiles and one shot fx to hand out again instead of spawning new ones, single player only" );
+idCVar g_entityPoolSize(			"g_entityPoolSize",			"16",			CVAR_GAME | CVAR_INTEGER, "number of removed entities kept for each projectile entityDef or fx", 0, 256 );
 idCVar g_bloodEffects(				"g_bloodEffects",			"1",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "show blood splats, sprays and gibs" );
 idCVar g_doubleVision(				"g_doubleVision",			"1",			CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "show double vision when taking damage" );
 idCVar g_monsters(					"g_monsters",				"1",			CVAR_GAME | CVAR_BOOL, "" );
@@ -170,10 +175,26 @@ idCVar g_ragdollDecals(				"g_ragdollDecals",			"1",			CVAR_GAME | CVAR_ARCHIVE
 idCVar g_disasm(					"g_disasm",					"0",			CVAR_GAME | CVAR_BOOL, "disassemble script into base/script/disasm.txt on the local drive when script is compiled" );
 idCVar g_debugBounds(				"g_debugBounds",			"0",			CVAR_GAME | CVAR_BOOL, "checks for models with bounds > 2048" );
 idCVar g_debugAnim(					"g_debugAnim",				"-1",			CVAR_GAME | CVAR_INTEGER, "displays information on which animations are playing on the specified entity number.  set to -1 to disable." );
+idCVar g_quantizeAnims(				"g_quantizeAnims",			"1",			CVAR_GAME | CVAR_BOOL, "store md5 animation frames as 16 bit values scaled to the range of each component.  takes effect when anims are loaded." );
+idCVar g_clipModelTree(				"g_clipModelTree",			"1",			CVAR_GAME | CVAR_INTEGER, "0 = find clip models through the fixed clip sectors, 1 = through a dynamic AABB tree, 2 = use both and report differences.  takes effect when a map is loaded.", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+idCVar g_physicsLOD(					"g_physicsLOD",				"1",			CVAR_GAME | CVAR_BOOL, "simulate articulated figures and rigid bodies outside the player PVS or beyond g_physicsLODDistance at a reduced level of detail" );
+idCVar g_physicsLODDistance(		"g_physicsLODDistance",		"1536",			CVAR_GAME | CVAR_FLOAT, "distance to the nearest player beyond which bodies are simulated at a reduced level of detail" );
+idCVar g_physicsLODUpdateTime(		"g_physicsLODUpdateTime",	"32",			CVAR_GAME | CVAR_INTEGER, "minimum number of milliseconds between updates of bodies at a reduced level of detail", 0, 100 );
+idCVar g_physicsLODRestScale(		"g_physicsLODRestScale",	"3",			CVAR_GAME | CVAR_FLOAT, "scales the velocity and movement tolerances used to put bodies at a reduced level of detail to rest", 1, 10 );
+idCVar g_thinkLOD(					"g_thinkLOD",				"1",			CVAR_GAME | CVAR_BOOL, "entities with a think budget think less often when outside the PVS of every player, or beyond g_thinkLODDistance when it is set" );
+idCVar g_thinkLODDistance(			"g_thinkLODDistance",		"0",			CVAR_GAME | CVAR_FLOAT, "distance to the nearest player beyond which entities with a think budget think less often even when in a player PVS, 0 = only throttle outside the PVS" );
+idCVar g_thinkLODInterval(			"g_thinkLODInterval",		"100",			CVAR_GAME | CVAR_INTEGER, "milliseconds between thinks of entities with a normal think budget at the reduced rate", 0, 1000 );
+idCVar g_thinkLODLowInterval(		"g_thinkLODLowInterval",	"250",			CVAR_GAME | CVAR_INTEGER, "milliseconds between thinks of entities with a low think budget at the reduced rate", 0, 1000 );
+idCVar g_traceCache(				"g_traceCache",				"0",			CVAR_GAME | CVAR_BOOL, "reuse the results of identical point and box traces within a game frame" );
+idCVar g_zoneRegistry(			"g_zoneRegistry",			"1",			CVAR_GAME | CVAR_BOOL, "keep the entities touching each zone up to date from clip model links instead of searching the clip world every zone think" );
 idCVar g_debugMove(					"g_debugMove",				"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugDamage(				"g_debugDamage",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugWeapon(				"g_debugWeapon",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugScript(				"g_debugScript",			"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar g_scriptOptimize(			"g_scriptOptimize",			"0",			CVAR_GAME | CVAR_BOOL, "optimize script functions as they're compiled, applies to scripts compiled after it's changed" );
+idCVar g_scriptNative(				"g_scriptNative",			"0",			CVAR_GAME | CVAR_BOOL, "run script functions from the native code in Script_NativeFunctions.h when their checksums match, applies to scripts compiled after it's changed" );
+idCVar g_scriptProfile(			"g_scriptProfile",			"0",			CVAR_GAME | CVAR_BOOL, "collects per function script times for the scriptProfile report" );
+idCVar g_scriptThreadedCode(		"g_scriptThreadedCode",		"0",			CVAR_GAME | CVAR_BOOL, "run scripts from pre-decoded statements with fused superinstructions" );
 idCVar g_debugMover(				"g_debugMover",				"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugTriggers(				"g_debugTriggers",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugCinematic(			"g_debugCinematic",			"0",			CVAR_GAME | CVAR_BOOL, "" );
@@ -207,6 +228,7 @@ idCVar g_artificialPlayerCount(		"g_artificialPlayerCount",	"0",			CVAR_GAME | C
 
 idCVar g_frametime(					"g_frametime",				"0",			CVAR_GAME | CVAR_BOOL, "displays timing information for each game frame" );
 idCVar g_timeentities(				"g_timeEntities",			"0",			CVAR_GAME | CVAR_FLOAT, "when non-zero, shows entities whose think functions exceeded the # of milliseconds specified" );
+idCVar g_timeEntityClasses(			"g_timeEntityClasses",		"0",			CVAR_GAME | CVAR_BOOL, "adds up the think time of each entity class for listThinkCosts" );
 	
 idCVar ai_debugScript(				"ai_debugScript",			"-1",			CVAR_GAME | CVAR_INTEGER, "displays script calls for the specified monster entity number" );
 idCVar ai_debugMove(				"ai_debugMove",				"0",			CVAR_GAME | CVAR_BOOL, "draws movement information for monsters" );
@@ -281,6 +303,8 @@ idCVar af_showInertia(				"af_showInertia",			"0",			CVAR_GAME | CVAR_BOOL, "sho
 idCVar af_showVelocity(				"af_showVelocity",			"0",			CVAR_GAME | CVAR_BOOL, "show the velocity of each body" );
 idCVar af_showActive(				"af_showActive",			"0",			CVAR_GAME | CVAR_BOOL, "show tree-like structures of articulated figures not at rest" );
 idCVar af_testSolid(				"af_testSolid",				"1",			CVAR_GAME | CVAR_BOOL, "test for bodies initially stuck in solid" );
+idCVar af_lodMaxIterations(		"af_lodMaxIterations",		"8",			CVAR_GAME | CVAR_INTEGER, "maximum LCP iterations of articulated figures at a reduced level of detail", 1, 32 );
+idCVar af_parallelIslands(			"af_parallelIslands",		"2",			CVAR_GAME | CVAR_INTEGER, "number of extra threads used to solve independent articulated figures, 0 = solve each figure during its think", 0, MAX_JOB_THREADS, idCmdSystem::ArgCompletion_Integer<0,MAX_JOB_THREADS> );
 
 idCVar rb_showTimings(				"rb_showTimings",			"0",			CVAR_GAME | CVAR_BOOL, "show rigid body cpu usage" );
 idCVar rb_showBodies(				"rb_showBodies",			"0",			CVAR_GAME | CVAR_BOOL, "show rigid bodies" );
@@ -29,7 +29,10 @@ extern idCVar	g_nodormant;
 extern idCVar	g_robustDormantAll;
 extern idCVar	g_dormanttests;
 extern idCVar	pm_wallwalkstepsize;
+extern idCVar	pm_wallwalkPatchCache;
+extern idCVar	pm_wallwalkPatchRadius;
 extern idCVar	g_vehicleDebug;
+extern idCVar	g_vehicleStepTime;
 extern idCVar	sys_SavedPosition;
 extern idCVar	g_crosshair;
 extern idCVar	g_springConstant;
@@ -79,6 +82,8 @@ extern idCVar	g_skipFX;
 extern idCVar	g_skipParticles;
 extern idCVar	g_bloodEffects;
 extern idCVar	g_projectileLights;
+extern idCVar	g_entityPool;
+extern idCVar	g_entityPoolSize;
 extern idCVar	g_doubleVision;
 extern idCVar	g_muzzleFlash;
 extern idCVar	g_ragdollDecals;
@@ -86,10 +91,26 @@ extern idCVar	g_ragdollDecals;
 extern idCVar	g_disasm;
 extern idCVar	g_debugBounds;
 extern idCVar	g_debugAnim;
+extern idCVar	g_quantizeAnims;
+extern idCVar	g_clipModelTree;
+extern idCVar	g_physicsLOD;
+extern idCVar	g_physicsLODDistance;
+extern idCVar	g_physicsLODUpdateTime;
+extern idCVar	g_physicsLODRestScale;
+extern idCVar	g_thinkLOD;
+extern idCVar	g_thinkLODDistance;
+extern idCVar	g_thinkLODInterval;
+extern idCVar	g_thinkLODLowInterval;
+extern idCVar	g_traceCache;
+extern idCVar	g_zoneRegistry;
 extern idCVar	g_debugMove;
 extern idCVar	g_debugDamage;
 extern idCVar	g_debugWeapon;
 extern idCVar	g_debugScript;
+extern idCVar	g_scriptOptimize;
+extern idCVar	g_scriptNative;
+extern idCVar	g_scriptProfile;
+extern idCVar	g_scriptThreadedCode;
 extern idCVar	g_debugMover;
 extern idCVar	g_debugTriggers;
 extern idCVar	g_debugCinematic;
@@ -120,6 +141,7 @@ extern idCVar	g_artificialPlayerCount; //HUMANHEAD rww
 
 extern idCVar	g_frametime;
 extern idCVar	g_timeentities;
+extern idCVar	g_timeEntityClasses;
 
 extern idCVar	ai_debugScript;
 extern idCVar	ai_debugMove;
@@ -187,6 +209,8 @@ extern idCVar	af_showInertia;
 extern idCVar	af_showVelocity;
 extern idCVar	af_showActive;
 extern idCVar	af_testSolid;
+extern idCVar	af_lodMaxIterations;
+extern idCVar	af_parallelIslands;
 
 extern idCVar	rb_showTimings;
 extern idCVar	rb_showBodies;
@@ -32,6 +32,31 @@ typedef struct clipLink_s {
 	struct clipLink_s *		nextLink;
 } clipLink_t;
 
+typedef struct clipTreeNode_s {
+	idBounds				bounds;			// enlarged bounds of the clip model for leaves
+	idClipModel *			clipModel;		// clip model of a leaf, NULL for interior nodes
+	int						parent;			// parent node, next free node for unused nodes
+	int						children[2];	// -1 for leaves
+	int						height;			// 0 for leaves, -1 for unused nodes
+} clipTreeNode_t;
+
+#define TRACECACHE_SIZE			512
+
+typedef struct traceCacheEntry_s {
+	bool					valid;
+	idVec3					start;
+	idVec3					end;
+	idBounds				trmBounds;		// cleared for point traces
+	idMat3					trmAxis;
+	int						contentMask;
+	const idEntity *		passEntity;
+	idBounds				traceBounds;	// bounds of the whole translation
+	trace_t					results;
+} traceCacheEntry_t;
+
+#define CLIPTREE_MARGIN			16.0f		// leaves are enlarged so small moves don't touch the tree
+#define CLIPTREE_STACK_SIZE		256
+
 typedef struct trmCache_s {
 	idTraceModel			trm;
 	int						refCount;
@@ -52,6 +77,8 @@ idBlockAlloc<clipLink_t, 1024>	clipLinkAllocator;
 ===============================================================
 */
 
+int idClipModel::stateChangeCount = 0;
+
 static idList<trmCache_s*>		traceModelCache;
 static idHashIndex				traceModelHash;
 	
@@ -200,6 +227,20 @@ void idClipModel::UpdateDynamicContents( void ) {
 }
 #endif //HUMANHEAD END
 
+/*
+================
+idClipModel::ClipStateChanged
+
+  A clip model enabled or given new contents without moving may now touch zones
+  it didn't before, so the zone registry has to test it again.
+================
+*/
+void idClipModel::ClipStateChanged( void ) {
+	if ( entity && IsLinked() ) {
+		gameLocal.zoneRegistry.EntityMoved( entity->entityNumber );
+	}
+}
+
 /*
 ================
 idClipModel::LoadModel
@@ -279,6 +320,8 @@ void idClipModel::Init( void ) {
 	renderModelHandle = -1;
 	traceModelIndex = -1;
 	clipLinks = NULL;
+	clipTreeNode = -1;
+	inClipTree = false;
 	touchCount = -1;
 #if _HH_CLIP_FASTSECTORS //HUMANHEAD rww
 	checked = false;
@@ -348,6 +391,8 @@ idClipModel::idClipModel( const idClipModel *model ) {
 	}
 	renderModelHandle = model->renderModelHandle;
 	clipLinks = NULL;
+	clipTreeNode = -1;
+	inClipTree = false;
 	touchCount = -1;
 #if _HH_CLIP_FASTSECTORS //HUMANHEAD rww
 	checked = false;
@@ -362,6 +407,9 @@ idClipModel::~idClipModel
 idClipModel::~idClipModel( void ) {
 	// make sure the clip model is no longer linked
 	Unlink();
+	if ( clipTreeNode != -1 ) {
+		gameLocal.clip.RemoveFromTree( this );
+	}
 	if ( traceModelIndex != -1 ) {
 		FreeTraceModel( traceModelIndex );
 	}
@@ -390,7 +438,7 @@ void idClipModel::Save( idSaveGame *savefile ) const {
 	}
 	savefile->WriteInt( traceModelIndex );
 	savefile->WriteInt( renderModelHandle );
-	savefile->WriteBool( clipLinks != NULL );
+	savefile->WriteBool( IsLinked() );
 	savefile->WriteInt( touchCount );
 
 #if _HH_CLIP_FASTSECTORS //HUMANHEAD rww
@@ -438,6 +486,8 @@ void idClipModel::Restore( idRestoreGame *savefile ) {
 	// the render model will be set when the clip model is linked
 	renderModelHandle = -1;
 	clipLinks = NULL;
+	clipTreeNode = -1;
+	inClipTree = false;
 	touchCount = -1;
 
 	if ( linked ) {
@@ -451,7 +501,7 @@ idClipModel::SetPosition
 ================
 */
 void idClipModel::SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis ) {
-	if ( clipLinks ) {
+	if ( IsLinked() ) {
 		Unlink();	// unlink from old position
 	}
 	origin = newOrigin;
@@ -500,6 +550,16 @@ idClipModel::Unlink
 void idClipModel::Unlink( void ) {
 	clipLink_t *link;
 
+	if ( IsLinked() ) {
+		gameLocal.clip.InvalidateTraceCache( absBounds );
+		if ( entity ) {
+			gameLocal.zoneRegistry.EntityMoved( entity->entityNumber );
+		}
+	}
+
+	// the tree leaf is kept so linking close to the old position is cheap
+	inClipTree = false;
+
 	for ( link = clipLinks; link; link = clipLinks ) {
 		clipLinks = link->nextLink;
 		if ( link->prevInSector ) {
@@ -564,7 +624,7 @@ void idClipModel::Link( idClip &clp ) {
 		return;
 	}
 
-	if ( clipLinks ) {
+	if ( IsLinked() ) {
 		Unlink();	// unlink from old position
 	}
 
@@ -587,6 +647,16 @@ void idClipModel::Link( idClip &clp ) {
 	absBounds[0] -= vec3_boxEpsilon;
 	absBounds[1] += vec3_boxEpsilon;
 
+	clp.InvalidateTraceCache( absBounds );
+	gameLocal.zoneRegistry.EntityMoved( entity->entityNumber );
+
+	if ( clp.broadphase != CLIP_BROADPHASE_SECTORS ) {
+		clp.LinkIntoTree( this );
+		if ( clp.broadphase == CLIP_BROADPHASE_TREE ) {
+			return;
+		}
+	}
+
 #if _HH_CLIP_FASTSECTORS //HUMANHEAD rww
 	int coords[ 4 ];
 	clp.CoordsForBounds( coords, absBounds );
@@ -661,8 +731,18 @@ idClip::idClip
 ===============
 */
 idClip::idClip( void ) {
+	broadphase = CLIP_BROADPHASE_SECTORS;
 	numClipSectors = 0;
 	clipSectors = NULL;
+	treeNodes = NULL;
+	numTreeNodes = maxTreeNodes = 0;
+	treeRoot = freeTreeNode = -1;
+	numBroadphaseMismatches = 0;
+	traceCache = NULL;
+	numTraceCacheEntries = 0;
+	traceCacheFrame = -1;
+	traceCacheStateChangeCount = 0;
+	numTraceCacheHits = numTraceCacheMisses = 0;
 	worldBounds.Zero();
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
@@ -749,6 +829,16 @@ void idClip::Init( void ) {
 	memset( clipSectors, 0, MAX_SECTORS * sizeof( clipSector_t ) );
 	numClipSectors = 0;
 	touchCount = -1;
+	// clear the clip model tree
+	ClearTree();
+	broadphase = (clipBroadphase_t) idMath::ClampInt( CLIP_BROADPHASE_SECTORS, CLIP_BROADPHASE_COMPARE, g_clipModelTree.GetInteger() );
+	numBroadphaseMismatches = 0;
+	// clear the trace cache
+	if ( !traceCache ) {
+		traceCache = new traceCacheEntry_t[TRACECACHE_SIZE];
+	}
+	ClearTraceCache();
+	numTraceCacheHits = numTraceCacheMisses = 0;
 	// get world map bounds
 	h = collisionModelManager->LoadModel( "worldMap", false );
 	collisionModelManager->GetModelBounds( h, worldBounds );
@@ -792,6 +882,13 @@ void idClip::Shutdown( void ) {
 	delete[] clipSectors;
 	clipSectors = NULL;
 
+	ClearTree();
+
+	delete[] traceCache;
+	traceCache = NULL;
+	numTraceCacheEntries = 0;
+	traceCacheHash.Clear();
+
 	// free the trace model used for the temporaryClipModel
 	if ( temporaryClipModel.traceModelIndex != -1 ) {
 		idClipModel::FreeTraceModel( temporaryClipModel.traceModelIndex );
@@ -807,6 +904,314 @@ void idClip::Shutdown( void ) {
 	clipLinkAllocator.Shutdown();
 }
 
+/*
+===============================================================
+
+	dynamic AABB tree
+
+	Leaves store the bounds of a clip model enlarged by CLIPTREE_MARGIN so
+	a clip model that moves within its enlarged bounds is relinked without
+	touching the tree. The tree is kept balanced with rotations on the way
+	back up after every insertion and removal.
+
+===============================================================
+*/
+
+/*
+===============
+ClipTree_Cost
+
+  half the surface area of the bounds
+===============
+*/
+static ID_INLINE float ClipTree_Cost( const idBounds &bounds ) {
+	idVec3 size = bounds[1] - bounds[0];
+	return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+/*
+===============
+idClip::ClearTree
+===============
+*/
+void idClip::ClearTree( void ) {
+	int i;
+
+	for ( i = 0; i < maxTreeNodes; i++ ) {
+		if ( treeNodes[i].height == 0 && treeNodes[i].clipModel ) {
+			treeNodes[i].clipModel->clipTreeNode = -1;
+			treeNodes[i].clipModel->inClipTree = false;
+		}
+	}
+	delete[] treeNodes;
+	treeNodes = NULL;
+	numTreeNodes = maxTreeNodes = 0;
+	treeRoot = freeTreeNode = -1;
+}
+
+/*
+===============
+idClip::AllocTreeNode
+
+  may reallocate the node array so node pointers are not valid across calls
+===============
+*/
+int idClip::AllocTreeNode( void ) {
+	int i, nodeNum;
+
+	if ( freeTreeNode == -1 ) {
+		int newMaxTreeNodes = maxTreeNodes ? maxTreeNodes * 2 : 256;
+		clipTreeNode_t *newTreeNodes = new clipTreeNode_t[newMaxTreeNodes];
+		if ( treeNodes ) {
+			memcpy( newTreeNodes, treeNodes, maxTreeNodes * sizeof( treeNodes[0] ) );
+			delete[] treeNodes;
+		}
+		treeNodes = newTreeNodes;
+		for ( i = maxTreeNodes; i < newMaxTreeNodes; i++ ) {
+			treeNodes[i].clipModel = NULL;
+			treeNodes[i].parent = ( i + 1 < newMaxTreeNodes ) ? i + 1 : -1;
+			treeNodes[i].height = -1;
+		}
+		freeTreeNode = maxTreeNodes;
+		maxTreeNodes = newMaxTreeNodes;
+	}
+
+	nodeNum = freeTreeNode;
+	clipTreeNode_t &node = treeNodes[nodeNum];
+	freeTreeNode = node.parent;
+	node.bounds.Clear();
+	node.clipModel = NULL;
+	node.parent = -1;
+	node.children[0] = node.children[1] = -1;
+	node.height = 0;
+	numTreeNodes++;
+
+	return nodeNum;
+}
+
+/*
+===============
+idClip::FreeTreeNode
+===============
+*/
+void idClip::FreeTreeNode( int nodeNum ) {
+	assert( nodeNum >= 0 && nodeNum < maxTreeNodes );
+	treeNodes[nodeNum].clipModel = NULL;
+	treeNodes[nodeNum].parent = freeTreeNode;
+	treeNodes[nodeNum].height = -1;
+	freeTreeNode = nodeNum;
+	numTreeNodes--;
+}
+
+/*
+===============
+idClip::BalanceTreeNode
+
+  rotates the higher child up if the subtree is unbalanced, returns the new subtree root
+===============
+*/
+int idClip::BalanceTreeNode( int nodeNum ) {
+	clipTreeNode_t *a = &treeNodes[nodeNum];
+
+	if ( a->children[0] == -1 || a->height < 2 ) {
+		return nodeNum;
+	}
+
+	int balance = treeNodes[a->children[1]].height - treeNodes[a->children[0]].height;
+	if ( balance >= -1 && balance <= 1 ) {
+		return nodeNum;
+	}
+
+	// the higher child takes the place of the node
+	int up = ( balance > 1 ) ? 1 : 0;
+	int upNum = a->children[up];
+	int otherNum = a->children[up^1];
+	clipTreeNode_t *c = &treeNodes[upNum];
+	int f = c->children[0];
+	int g = c->children[1];
+
+	c->children[0] = nodeNum;
+	c->parent = a->parent;
+	a->parent = upNum;
+
+	if ( c->parent != -1 ) {
+		clipTreeNode_t &parent = treeNodes[c->parent];
+		parent.children[ parent.children[0] == nodeNum ? 0 : 1 ] = upNum;
+	} else {
+		treeRoot = upNum;
+	}
+
+	// the higher grandchild stays with the rotated child, the other one moves to the node
+	if ( treeNodes[f].height > treeNodes[g].height ) {
+		idSwap( f, g );
+	}
+	c->children[1] = g;
+	a->children[up] = f;
+	treeNodes[f].parent = nodeNum;
+
+	a->bounds = treeNodes[otherNum].bounds + treeNodes[f].bounds;
+	a->height = 1 + Max( treeNodes[otherNum].height, treeNodes[f].height );
+	c->bounds = a->bounds + treeNodes[g].bounds;
+	c->height = 1 + Max( a->height, treeNodes[g].height );
+
+	return upNum;
+}
+
+/*
+===============
+idClip::InsertTreeLeaf
+===============
+*/
+void idClip::InsertTreeLeaf( int leaf ) {
+	int nodeNum, sibling, oldParent, newParent;
+	float cost, inheritanceCost, childCost[2];
+
+	if ( treeRoot == -1 ) {
+		treeRoot = leaf;
+		treeNodes[leaf].parent = -1;
+		return;
+	}
+
+	// find the sibling with the smallest increase in surface area
+	idBounds leafBounds = treeNodes[leaf].bounds;
+	nodeNum = treeRoot;
+	while ( treeNodes[nodeNum].children[0] != -1 ) {
+		const clipTreeNode_t &node = treeNodes[nodeNum];
+
+		float area = ClipTree_Cost( node.bounds );
+		float combinedArea = ClipTree_Cost( node.bounds + leafBounds );
+
+		// cost of creating a new parent for this node and the leaf
+		cost = 2.0f * combinedArea;
+		// minimum cost of pushing the leaf further down the tree
+		inheritanceCost = 2.0f * ( combinedArea - area );
+
+		for ( int i = 0; i < 2; i++ ) {
+			const clipTreeNode_t &child = treeNodes[node.children[i]];
+			childCost[i] = ClipTree_Cost( child.bounds + leafBounds ) + inheritanceCost;
+			if ( child.children[0] != -1 ) {
+				childCost[i] -= ClipTree_Cost( child.bounds );
+			}
+		}
+
+		if ( cost < childCost[0] && cost < childCost[1] ) {
+			break;
+		}
+		nodeNum = node.children[ childCost[0] < childCost[1] ? 0 : 1 ];
+	}
+	sibling = nodeNum;
+
+	// create a new parent for the sibling and the leaf
+	newParent = AllocTreeNode();
+	oldParent = treeNodes[sibling].parent;
+	treeNodes[newParent].parent = oldParent;
+	treeNodes[newParent].bounds = treeNodes[sibling].bounds + leafBounds;
+	treeNodes[newParent].height = treeNodes[sibling].height + 1;
+	treeNodes[newParent].children[0] = sibling;
+	treeNodes[newParent].children[1] = leaf;
+	treeNodes[sibling].parent = newParent;
+	treeNodes[leaf].parent = newParent;
+
+	if ( oldParent != -1 ) {
+		clipTreeNode_t &parent = treeNodes[oldParent];
+		parent.children[ parent.children[0] == sibling ? 0 : 1 ] = newParent;
+	} else {
+		treeRoot = newParent;
+	}
+
+	// walk back up the tree fixing heights and bounds
+	for ( nodeNum = treeNodes[leaf].parent; nodeNum != -1; nodeNum = treeNodes[nodeNum].parent ) {
+		nodeNum = BalanceTreeNode( nodeNum );
+		clipTreeNode_t &node = treeNodes[nodeNum];
+		node.height = 1 + Max( treeNodes[node.children[0]].height, treeNodes[node.children[1]].height );
+		node.bounds = treeNodes[node.children[0]].bounds + treeNodes[node.children[1]].bounds;
+	}
+}
+
+/*
+===============
+idClip::RemoveTreeLeaf
+===============
+*/
+void idClip::RemoveTreeLeaf( int leaf ) {
+	int nodeNum, parent, grandParent, sibling;
+
+	if ( leaf == treeRoot ) {
+		treeRoot = -1;
+		return;
+	}
+
+	parent = treeNodes[leaf].parent;
+	grandParent = treeNodes[parent].parent;
+	sibling = treeNodes[parent].children[ treeNodes[parent].children[0] == leaf ? 1 : 0 ];
+
+	FreeTreeNode( parent );
+	treeNodes[leaf].parent = -1;
+
+	if ( grandParent == -1 ) {
+		treeRoot = sibling;
+		treeNodes[sibling].parent = -1;
+		return;
+	}
+
+	// the sibling takes the place of the parent
+	clipTreeNode_t &gp = treeNodes[grandParent];
+	gp.children[ gp.children[0] == parent ? 0 : 1 ] = sibling;
+	treeNodes[sibling].parent = grandParent;
+
+	for ( nodeNum = grandParent; nodeNum != -1; nodeNum = treeNodes[nodeNum].parent ) {
+		nodeNum = BalanceTreeNode( nodeNum );
+		clipTreeNode_t &node = treeNodes[nodeNum];
+		node.height = 1 + Max( treeNodes[node.children[0]].height, treeNodes[node.children[1]].height );
+		node.bounds = treeNodes[node.children[0]].bounds + treeNodes[node.children[1]].bounds;
+	}
+}
+
+/*
+===============
+idClip::LinkIntoTree
+===============
+*/
+void idClip::LinkIntoTree( idClipModel *clipModel ) {
+	int leaf;
+
+	leaf = clipModel->clipTreeNode;
+	if ( leaf != -1 ) {
+		const idBounds &leafBounds = treeNodes[leaf].bounds;
+		// keep the leaf if the clip model is still inside the enlarged bounds
+		if (	clipModel->absBounds[0][0] >= leafBounds[0][0] && clipModel->absBounds[1][0] <= leafBounds[1][0] &&
+				clipModel->absBounds[0][1] >= leafBounds[0][1] && clipModel->absBounds[1][1] <= leafBounds[1][1] &&
+				clipModel->absBounds[0][2] >= leafBounds[0][2] && clipModel->absBounds[1][2] <= leafBounds[1][2] ) {
+			clipModel->inClipTree = true;
+			return;
+		}
+		RemoveTreeLeaf( leaf );
+	} else {
+		leaf = AllocTreeNode();
+		treeNodes[leaf].clipModel = clipModel;
+		clipModel->clipTreeNode = leaf;
+	}
+
+	treeNodes[leaf].bounds = clipModel->absBounds.Expand( CLIPTREE_MARGIN );
+	InsertTreeLeaf( leaf );
+	clipModel->inClipTree = true;
+}
+
+/*
+===============
+idClip::RemoveFromTree
+===============
+*/
+void idClip::RemoveFromTree( idClipModel *clipModel ) {
+	if ( clipModel->clipTreeNode == -1 ) {
+		return;
+	}
+	RemoveTreeLeaf( clipModel->clipTreeNode );
+	FreeTreeNode( clipModel->clipTreeNode );
+	clipModel->clipTreeNode = -1;
+	clipModel->inClipTree = false;
+}
+
 /*
 ====================
 idClip::ClipModelsTouchingBounds_r
@@ -876,6 +1281,25 @@ void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listPa
 
 #if !GOLD //HUMANHEAD rww
 bool idClip::CheckClipEntMatch( const struct clipSector_s *node, const idClipModel *currentClip, const idEntity *ent ) const {
+	if ( !node && broadphase != CLIP_BROADPHASE_SECTORS ) {
+		for ( int i = 0; i < maxTreeNodes; i++ ) {
+			idClipModel *check = treeNodes[i].clipModel;
+
+			if ( treeNodes[i].height != 0 || !check || !check->inClipTree ) {
+				continue;
+			}
+			if ( check == currentClip || !check->enabled ) {
+				continue;
+			}
+			if ( check->GetEntity() == ent ) {
+				return true;
+			}
+		}
+		if ( broadphase == CLIP_BROADPHASE_TREE ) {
+			return false;
+		}
+	}
+
 #if !_HH_CLIP_FASTSECTORS
 	if (!node) {
 		node = clipSectors;
@@ -912,6 +1336,130 @@ bool idClip::CheckClipEntMatch( const struct clipSector_s *node, const idClipMod
 }
 #endif //HUMANHEAD END
 
+/*
+================
+idClip::ClipModelsTouchingTree
+================
+*/
+void idClip::ClipModelsTouchingTree( listParms_t &parms ) const {
+	int stack[CLIPTREE_STACK_SIZE];
+	int stackDepth;
+
+	if ( treeRoot == -1 ) {
+		return;
+	}
+
+	stack[0] = treeRoot;
+	stackDepth = 1;
+	while ( stackDepth > 0 ) {
+		const clipTreeNode_t &node = treeNodes[stack[--stackDepth]];
+
+		if ( !node.bounds.IntersectsBounds( parms.bounds ) ) {
+			continue;
+		}
+
+		if ( node.children[0] != -1 ) {
+			if ( stackDepth + 2 > CLIPTREE_STACK_SIZE ) {
+				gameLocal.Warning( "idClip::ClipModelsTouchingTree: stack overflow" );
+				return;
+			}
+			stack[stackDepth++] = node.children[0];
+			stack[stackDepth++] = node.children[1];
+			continue;
+		}
+
+		idClipModel *check = node.clipModel;
+
+		// the leaf is kept while the clip model is unlinked
+		if ( !check->inClipTree ) {
+			continue;
+		}
+
+		// if the clip model is enabled
+		if ( !check->enabled ) {
+			continue;
+		}
+
+		// if the clip model does not have any contents we are looking for
+		if ( !( check->contents & parms.contentMask ) ) {
+			continue;
+		}
+
+		// if the bounds really do overlap
+		if (	check->absBounds[0][0] > parms.bounds[1][0] ||
+				check->absBounds[1][0] < parms.bounds[0][0] ||
+				check->absBounds[0][1] > parms.bounds[1][1] ||
+				check->absBounds[1][1] < parms.bounds[0][1] ||
+				check->absBounds[0][2] > parms.bounds[1][2] ||
+				check->absBounds[1][2] < parms.bounds[0][2] ) {
+			continue;
+		}
+
+		if ( parms.count >= parms.maxCount ) {
+			gameLocal.Warning( "idClip::ClipModelsTouchingTree: max count" );
+			return;
+		}
+
+		parms.list[parms.count] = check;
+		parms.count++;
+	}
+}
+
+/*
+================
+ClipModelPointerCompare
+================
+*/
+static int ClipModelPointerCompare( const void *a, const void *b ) {
+	const idClipModel *ca = *(const idClipModel * const *)a;
+	const idClipModel *cb = *(const idClipModel * const *)b;
+	return ( ca < cb ) ? -1 : ( ca > cb );
+}
+
+/*
+================
+idClip::CompareBroadphase
+
+  checks the clip models found in the clip sectors against the clip model tree
+================
+*/
+void idClip::CompareBroadphase( const listParms_t &parms ) const {
+	idClipModel *sectorList[MAX_GENTITIES];
+	idClipModel *treeList[MAX_GENTITIES];
+	listParms_t treeParms;
+	int i;
+
+	// the sector results are incomplete if the list filled up
+	if ( parms.count >= parms.maxCount || parms.count > MAX_GENTITIES ) {
+		return;
+	}
+
+	treeParms = parms;
+	treeParms.list = treeList;
+	treeParms.count = 0;
+	treeParms.maxCount = MAX_GENTITIES;
+	ClipModelsTouchingTree( treeParms );
+
+	memcpy( sectorList, parms.list, parms.count * sizeof( sectorList[0] ) );
+	qsort( sectorList, parms.count, sizeof( sectorList[0] ), ClipModelPointerCompare );
+	qsort( treeList, treeParms.count, sizeof( treeList[0] ), ClipModelPointerCompare );
+
+	if ( treeParms.count == parms.count ) {
+		for ( i = 0; i < parms.count; i++ ) {
+			if ( sectorList[i] != treeList[i] ) {
+				break;
+			}
+		}
+		if ( i >= parms.count ) {
+			return;
+		}
+	}
+
+	numBroadphaseMismatches++;
+	gameLocal.Warning( "idClip::CompareBroadphase: %d clip models in sectors, %d in tree for bounds (%s) (%s)",
+						parms.count, treeParms.count, parms.bounds[0].ToString( 0 ), parms.bounds[1].ToString( 0 ) );
+}
+
 /*
 ================
 idClip::ClipModelsTouchingBounds
@@ -945,6 +1493,11 @@ int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, i
 	parms.count = 0;
 	parms.maxCount = maxCount;
 
+	if ( broadphase == CLIP_BROADPHASE_TREE ) {
+		ClipModelsTouchingTree( parms );
+		return parms.count;
+	}
+
 #if _HH_CLIP_FASTSECTORS //HUMANHEAD rww
 	int coords[ 4 ];
 	CoordsForBounds( coords, parms.bounds );
@@ -1000,6 +1553,10 @@ int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, i
 	ClipModelsTouchingBounds_r( clipSectors, parms );
 #endif //HUMANHEAD END
 
+	if ( broadphase == CLIP_BROADPHASE_COMPARE ) {
+		CompareBroadphase( parms );
+	}
+
 	return parms.count;
 }
 
@@ -1277,14 +1834,128 @@ void idClip::TranslationEntities( trace_t &results, const idVec3 &start, const i
 	} // HUMANHEAD CJR PCF 04/26/06
 }
 
+/*
+===============================================================
+
+	trace cache
+
+	Results of point and box translations are kept until the end of the
+	game frame. Entries are dropped when a clip model is linked or unlinked
+	within the bounds of the trace, and the whole cache is cleared when a
+	clip model is enabled, disabled or changes contents.
+
+===============================================================
+*/
+
 /*
 ============
-idClip::Translation
+idClip::ClearTraceCache
 ============
 */
+void idClip::ClearTraceCache( void ) {
+	numTraceCacheEntries = 0;
+	traceCacheHash.Clear();
+	traceCacheFrame = gameLocal.framenum;
+	traceCacheStateChangeCount = idClipModel::stateChangeCount;
+}
+
+/*
+============
+idClip::InvalidateTraceCache
+============
+*/
+void idClip::InvalidateTraceCache( const idBounds &bounds ) {
+	int i;
+
+	for ( i = 0; i < numTraceCacheEntries; i++ ) {
+		traceCacheEntry_t &entry = traceCache[i];
+		if ( entry.valid && entry.traceBounds.IntersectsBounds( bounds ) ) {
+			entry.valid = false;
+		}
+	}
+}
 
+/*
+============
+idClip::Translation
+============
+*/
 bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &end,
 						const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity ) {
+	const idTraceModel *trm;
+	bool touchedPortal;
+	int i, key;
+
+	if ( !g_traceCache.GetBool() || !traceCache ) {
+		return TranslationUncached( results, start, end, mdl, trmAxis, contentMask, passEntity, touchedPortal );
+	}
+
+	// only point and box traces are fully described by the key
+	trm = TraceModelForClipModel( mdl );
+	if ( trm && trm->type != TRM_BOX ) {
+		return TranslationUncached( results, start, end, mdl, trmAxis, contentMask, passEntity, touchedPortal );
+	}
+
+	if ( traceCacheFrame != gameLocal.framenum || traceCacheStateChangeCount != idClipModel::stateChangeCount ) {
+		ClearTraceCache();
+	}
+
+	key = traceCacheHash.GenerateKey( start ) + traceCacheHash.GenerateKey( end ) * 3 + contentMask;
+	for ( i = traceCacheHash.First( key ); i != -1; i = traceCacheHash.Next( i ) ) {
+		const traceCacheEntry_t &entry = traceCache[i];
+		if ( !entry.valid || entry.contentMask != contentMask || entry.passEntity != passEntity ) {
+			continue;
+		}
+		if ( entry.start != start || entry.end != end ) {
+			continue;
+		}
+		if ( trm ) {
+			if ( entry.trmBounds.IsCleared() || entry.trmBounds != trm->bounds || entry.trmAxis != trmAxis ) {
+				continue;
+			}
+		} else if ( !entry.trmBounds.IsCleared() ) {
+			continue;
+		}
+		numTraceCacheHits++;
+		results = entry.results;
+		return ( results.fraction < 1.0f );
+	}
+	numTraceCacheMisses++;
+
+	TranslationUncached( results, start, end, mdl, trmAxis, contentMask, passEntity, touchedPortal );
+
+	// portals are notified when a trace touches them so those traces are never cached
+	if ( !touchedPortal && numTraceCacheEntries < TRACECACHE_SIZE ) {
+		traceCacheEntry_t &entry = traceCache[numTraceCacheEntries];
+		entry.valid = true;
+		entry.start = start;
+		entry.end = end;
+		entry.contentMask = contentMask;
+		entry.passEntity = passEntity;
+		if ( trm ) {
+			entry.trmBounds = trm->bounds;
+			entry.trmAxis = trmAxis;
+			entry.traceBounds.FromBoundsTranslation( trm->bounds, start, trmAxis, end - start );
+		} else {
+			entry.trmBounds.Clear();
+			entry.trmAxis = mat3_identity;
+			entry.traceBounds.FromPointTranslation( start, end - start );
+		}
+		entry.results = results;
+		traceCacheHash.Add( key, numTraceCacheEntries );
+		numTraceCacheEntries++;
+	}
+
+	return ( results.fraction < 1.0f );
+}
+
+/*
+============
+idClip::TranslationUncached
+============
+*/
+bool idClip::TranslationUncached( trace_t &results, const idVec3 &start, const idVec3 &end,
+						const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity, bool &touchedPortal ) {
 	int i, num;
 	idClipModel *touch, *clipModelList[MAX_GENTITIES];
 	idBounds traceBounds;
@@ -1294,6 +1965,8 @@ bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &e
 	idEntity *portalEntity = NULL; // HUMANHEAD CJR PCF 04/26/06
 	float portalFraction = 1.0f; // HUMANHEAD CJR PCF 04/26/06
 
+	touchedPortal = false;
+
 	if ( TestHugeTranslation( results, mdl, start, end, trmAxis ) ) {
 		return true;
 	}
@@ -1363,11 +2036,168 @@ bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &e
 	// HUMANHEAD CJR PCF 04/26/06
 	if ( portalFraction < 1.0f && portalEntity ) {
 		portalEntity->CollideWithPortal( mdl );
+		touchedPortal = true;
 	} // END HUMANHEAD CJR PCF 04/26/06
 
 	return ( results.fraction < 1.0f );
 }
 
+/*
+============
+BatchTraceIsPoint
+============
+*/
+ID_INLINE bool BatchTraceIsPoint( const cmBatchTrace_t &trace ) {
+	return ( trace.bounds.IsCleared() || trace.bounds[0] == trace.bounds[1] );
+}
+
+/*
+============
+idClip::TranslationBatch
+
+  Same results as a TracePoint or TraceBounds for every trace, but the world is
+  traced with a single collision model batch and the clip models touching any of
+  the traces are only gathered once. The trace cache is not used.
+============
+*/
+void idClip::TranslationBatch( trace_t *results, const cmBatchTrace_t *traces, const int numTraces, const idEntity *passEntity ) {
+	int i, j, num, contentMask;
+	idClipModel *touch, *mdl, *clipModelList[MAX_GENTITIES];
+	idBounds *traceBounds, totalBounds, trmBounds;
+	float radius;
+	trace_t trace;
+	const idTraceModel *trm;
+	const cmBatchTrace_t *t;
+	idEntity *portalEntity;
+	float portalFraction;
+
+	if ( numTraces <= 0 ) {
+		return;
+	}
+
+	// huge box translations are rejected by the single translation
+	for ( i = 0; i < numTraces; i++ ) {
+		t = &traces[i];
+		if ( !BatchTraceIsPoint( *t ) && ( t->end - t->start ).LengthSqr() > Square( CM_MAX_TRACE_DIST ) ) {
+			break;
+		}
+	}
+	if ( i < numTraces ) {
+		for ( i = 0; i < numTraces; i++ ) {
+			t = &traces[i];
+			if ( BatchTraceIsPoint( *t ) ) {
+				TracePoint( results[i], t->start, t->end, t->contentMask, passEntity );
+			} else {
+				TraceBounds( results[i], t->start, t->end, t->bounds, t->contentMask, passEntity );
+			}
+		}
+		return;
+	}
+
+	if ( !passEntity || passEntity->entityNumber != ENTITYNUM_WORLD ) {
+		// test world
+		idClip::numTranslations += numTraces;
+		collisionModelManager->TranslationBatch( results, traces, numTraces, 0, vec3_origin, mat3_default );
+		for ( i = 0; i < numTraces; i++ ) {
+			results[i].c.entityNum = results[i].fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+		}
+	} else {
+		for ( i = 0; i < numTraces; i++ ) {
+			memset( &results[i], 0, sizeof( results[i] ) );
+			results[i].fraction = 1.0f;
+			results[i].endpos = traces[i].end;
+			results[i].endAxis = mat3_identity;
+		}
+	}
+
+	// gather the clip models touching any of the traces once
+	traceBounds = (idBounds *) _alloca16( numTraces * sizeof( idBounds ) );
+	totalBounds.Clear();
+	contentMask = 0;
+	for ( i = 0; i < numTraces; i++ ) {
+		t = &traces[i];
+		if ( BatchTraceIsPoint( *t ) ) {
+			traceBounds[i].FromPointTranslation( t->start, results[i].endpos - t->start );
+		} else {
+			traceBounds[i].FromBoundsTranslation( t->bounds, t->start, mat3_identity, results[i].endpos - t->start );
+		}
+		totalBounds += traceBounds[i];
+		contentMask |= t->contentMask;
+	}
+
+	num = GetTraceClipModels( totalBounds, contentMask, passEntity, clipModelList );
+
+	trmBounds.Zero();
+	for ( i = 0; i < numTraces; i++ ) {
+		t = &traces[i];
+
+		if ( results[i].fraction == 0.0f ) {
+			continue;		// blocked immediately by the world
+		}
+
+		if ( BatchTraceIsPoint( *t ) ) {
+			mdl = NULL;
+			trm = NULL;
+			radius = 0.0f;
+		} else {
+			// consecutive traces with the same box share the trace model
+			if ( t->bounds != trmBounds ) {
+				trmBounds = t->bounds;
+				temporaryClipModel.LoadModel( idTraceModel( trmBounds ) );
+			}
+			mdl = &temporaryClipModel;
+			trm = TraceModelForClipModel( mdl );
+			radius = trm->bounds.GetRadius();
+		}
+
+		portalEntity = NULL;
+		portalFraction = 1.0f;
+
+		for ( j = 0; j < num; j++ ) {
+			touch = clipModelList[j];
+
+			if ( !touch || !( touch->GetContents() & t->contentMask ) ) {
+				continue;
+			}
+
+			if ( !touch->absBounds.IntersectsBounds( traceBounds[i] ) ) {
+				continue;
+			}
+
+			if ( touch->renderModelHandle != -1 ) {
+				idClip::numRenderModelTraces++;
+				TraceRenderModel( trace, t->start, t->end, radius, mat3_identity, touch );
+			} else {
+				idClip::numTranslations++;
+				collisionModelManager->Translation( &trace, t->start, t->end, trm, mat3_identity, t->contentMask,
+										touch->Handle(), touch->origin, touch->axis );
+			}
+
+			if ( trace.fraction < results[i].fraction ) {
+				// HUMANHEAD CJR:  If the hit entity is a portal, then inform the portal it was touched
+				if ( touch->entity->CheckPortal( mdl, t->contentMask ) ) {
+					if ( trace.fraction < portalFraction ) {
+						portalFraction = trace.fraction;
+						portalEntity = touch->entity;
+					}
+					continue; // Don't collide with portals
+				}
+
+				results[i] = trace;
+				results[i].c.entityNum = touch->entity->entityNumber;
+				results[i].c.id = touch->id;
+				if ( results[i].fraction == 0.0f ) {
+					break;
+				}
+			}
+		}
+
+		if ( portalFraction < 1.0f && portalEntity ) {
+			portalEntity->CollideWithPortal( mdl );
+		}
+	}
+}
+
 //HUMANHEAD rww
 /*
 ============
@@ -2014,6 +2844,15 @@ idClip::PrintStatistics
 void idClip::PrintStatistics( void ) {
 	gameLocal.Printf( "t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, contacts = %-3d\n",
 					numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContacts );
+	if ( broadphase == CLIP_BROADPHASE_COMPARE ) {
+		gameLocal.Printf( "clip model tree: %d nodes, %d broadphase mismatches\n", numTreeNodes, numBroadphaseMismatches );
+	}
+	if ( g_traceCache.GetBool() ) {
+		int numLookups = numTraceCacheHits + numTraceCacheMisses;
+		gameLocal.Printf( "trace cache: %d hits, %d misses (%.1f%%), %d entries\n", numTraceCacheHits, numTraceCacheMisses,
+						numLookups ? numTraceCacheHits * 100.0f / numLookups : 0.0f, numTraceCacheEntries );
+		numTraceCacheHits = numTraceCacheMisses = 0;
+	}
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
 
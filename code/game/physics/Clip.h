@@ -25,6 +25,13 @@ class idClip;
 class idClipModel;
 class idEntity;
 
+// spatial structure used to find the clip models touching some bounds
+typedef enum {
+	CLIP_BROADPHASE_SECTORS,				// fixed clip sector tree
+	CLIP_BROADPHASE_TREE,					// dynamic AABB tree
+	CLIP_BROADPHASE_COMPARE					// both, the tree results are checked against the sectors
+} clipBroadphase_t;
+
 
 //===============================================================
 //
@@ -57,7 +64,7 @@ public:
 
 	void					Link( idClip &clp );				// must have been linked with an entity and id before
 	void					Link( idClip &clp, idEntity *ent, int newId, const idVec3 &newOrigin, const idMat3 &newAxis, int renderModelHandle = -1 );
-	void					Unlink( void );						// unlink from sectors
+	void					Unlink( void );						// unlink from sectors and the clip model tree
 	void					SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis );	// unlinks the clip model
 	void					Translate( const idVec3 &translation );							// unlinks the clip model
 	void					Rotate( const idRotation &rotation );							// unlinks the clip model
@@ -93,6 +100,8 @@ public:
 	static void				SaveTraceModels( idSaveGame *savefile );
 	static void				RestoreTraceModels( idRestoreGame *savefile );
 
+	static int				stateChangeCount;		// incremented when any clip model is enabled, disabled or changes contents
+
 private:
 	bool					enabled;				// true if this clip model is used for clipping
 #if _HH_CLIP_FASTSECTORS //HUMANHEAD rww
@@ -112,9 +121,12 @@ private:
 	int						renderModelHandle;		// render model def handle
 
 	struct clipLink_s *		clipLinks;				// links into sectors
+	int						clipTreeNode;			// leaf in the clip model tree or -1, may be kept while unlinked
+	bool					inClipTree;				// linked into the clip model tree
 	int						touchCount;
 
 	void					Init( void );			// initialize
+	void					ClipStateChanged( void );	// enabled or contents changed in place
 #if !_HH_CLIP_FASTSECTORS //HUMANHEAD rww
 	void					Link_r( struct clipSector_s *node );
 #endif //HUMANHEAD END
@@ -138,10 +150,17 @@ ID_INLINE void idClipModel::Rotate( const idRotation &rotation ) {
 }
 
 ID_INLINE void idClipModel::Enable( void ) {
-	enabled = true;
+	if ( !enabled ) {
+		stateChangeCount++;
+		enabled = true;
+		ClipStateChanged();
+	}
 }
 
 ID_INLINE void idClipModel::Disable( void ) {
+	if ( enabled ) {
+		stateChangeCount++;
+	}
 	enabled = false;
 }
 
@@ -154,7 +173,11 @@ ID_INLINE const idMaterial * idClipModel::GetMaterial( void ) const {
 }
 
 ID_INLINE void idClipModel::SetContents( int newContents ) {
-	contents = newContents;
+	if ( contents != newContents ) {
+		stateChangeCount++;
+		contents = newContents;
+		ClipStateChanged();
+	}
 #if _HH_CLIP_FASTSECTORS //HUMANHEAD rww
 	UpdateDynamicContents();
 #endif //HUMANHEAD END
@@ -213,7 +236,7 @@ ID_INLINE bool idClipModel::IsTraceModel( void ) const {
 }
 
 ID_INLINE bool idClipModel::IsLinked( void ) const {
-	return ( clipLinks != NULL );
+	return ( clipLinks != NULL || inClipTree );
 }
 
 ID_INLINE bool idClipModel::IsEnabled( void ) const {
@@ -269,6 +292,9 @@ public:
 								int contentMask, const idEntity *passEntity );
 	bool					TraceBounds( trace_t &results, const idVec3 &start, const idVec3 &end, const idBounds &bounds,
 								int contentMask, const idEntity *passEntity );
+	// many point and box translations at once, the traces share the walk through the world and the entity list
+	void					TranslationBatch( trace_t *results, const cmBatchTrace_t *traces, const int numTraces,
+								const idEntity *passEntity );
 
 	// clip versus a specific model
 	void					TranslationModel( trace_t &results, const idVec3 &start, const idVec3 &end,
@@ -298,6 +324,9 @@ public:
 	const idBounds &		GetWorldBounds( void ) const;
 	idClipModel *			DefaultClipModel( void );
 
+							// trace results cached for the current game frame
+	void					ClearTraceCache( void );
+
 							// stats and debug drawing
 	void					PrintStatistics( void );
 	void					DrawClipModels( const idVec3 &eye, const float radius, const idEntity *passEntity );
@@ -323,8 +352,24 @@ private:
 	idVec3					nodeOffset;
 	idVec3					nodeOffsetVisual;
 #endif //HUMANHEAD END
+	clipBroadphase_t		broadphase;
 	int						numClipSectors;
 	struct clipSector_s *	clipSectors;
+							// dynamic AABB tree
+	struct clipTreeNode_s *	treeNodes;
+	int						numTreeNodes;
+	int						maxTreeNodes;
+	int						treeRoot;
+	int						freeTreeNode;
+	mutable int				numBroadphaseMismatches;
+							// trace cache
+	struct traceCacheEntry_s *traceCache;
+	int						numTraceCacheEntries;
+	idHashIndex				traceCacheHash;
+	int						traceCacheFrame;
+	int						traceCacheStateChangeCount;
+	int						numTraceCacheHits;
+	int						numTraceCacheMisses;
 	idBounds				worldBounds;
 	idClipModel				temporaryClipModel;
 	idClipModel				defaultClipModel;
@@ -342,6 +387,19 @@ private:
 #if !_HH_CLIP_FASTSECTORS //HUMANHEAD rww
 	void					ClipModelsTouchingBounds_r( const struct clipSector_s *node, struct listParms_s &parms ) const;
 #endif //HUMANHEAD END
+	void					ClearTree( void );
+	int						AllocTreeNode( void );
+	void					FreeTreeNode( int nodeNum );
+	int						BalanceTreeNode( int nodeNum );
+	void					InsertTreeLeaf( int leaf );
+	void					RemoveTreeLeaf( int leaf );
+	void					LinkIntoTree( idClipModel *clipModel );
+	void					RemoveFromTree( idClipModel *clipModel );
+	void					ClipModelsTouchingTree( struct listParms_s &parms ) const;
+	void					CompareBroadphase( const struct listParms_s &parms ) const;
+	bool					TranslationUncached( trace_t &results, const idVec3 &start, const idVec3 &end,
+								const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity, bool &touchedPortal );
+	void					InvalidateTraceCache( const idBounds &bounds );
 	const idTraceModel *	TraceModelForClipModel( const idClipModel *mdl ) const;
 	int						GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const;
 	void					TraceRenderModel( trace_t &trace, const idVec3 &start, const idVec3 &end, const float radius, const idMat3 &axis, idClipModel *touch ) const;
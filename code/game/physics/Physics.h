@@ -157,6 +157,8 @@ public:	// common physics interface
 	//HUMANHEAD: aob - need declarations so we can call these with GetPhysics()
 	virtual void				ActivateContactEntities( void ) {}
 	//HUMANHEAD END
+								// position and orientation to render when interpolating between physics steps
+	virtual bool				GetInterpolatedTransform( idVec3 &origin, idMat3 &axis ) const { return false; }
 };
 
 #endif /* !__PHYSICS_H__ */
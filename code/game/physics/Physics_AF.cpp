@@ -37,6 +37,8 @@ static int numArticulatedFigures = 0;
 static idTimer timer_total, timer_pc, timer_ac, timer_collision, timer_lcp;
 #endif
 
+static bool solvingIslands = false;		// set while figures are solved in parallel, the solver timers and LCP capture are not used
+
 //===============================================================
 //
 //	idAFConstraint
@@ -4527,9 +4529,12 @@ void idAFTree::Factor( void ) const {
 	int i, j;
 	idAFBody *body;
 	idAFConstraint *child;
-	idMatX childI;
+	idMatX childI, tmp1, tmp2;
 
+	// no idMatX temporaries are used so figures can be factored in parallel
 	childI.SetData( 6, 6, MATX_ALLOCA( 6 * 6 ) );
+	tmp1.SetData( 6, 6, MATX_ALLOCA( 6 * 6 ) );
+	tmp2.SetData( 6, 6, MATX_ALLOCA( 6 * 6 ) );
 
 	// from the leaves up towards the root
 	for ( i = sortedBodies.Num() - 1; i >= 0; i-- ) {
@@ -4542,35 +4547,82 @@ void idAFTree::Factor( void ) const {
 				child = body->children[j]->primaryConstraint;
 
 				// child->I = - child->body1->J.Transpose() * child->body1->I * child->body1->J;
+				tmp1.SetSize( child->body1->J.GetNumColumns(), child->body1->I.GetNumColumns() );
+				child->body1->J.TransposeMultiply( tmp1, child->body1->I );
 				childI.SetSize( child->J1.GetNumRows(), child->J1.GetNumRows() );
-				child->body1->J.TransposeMultiply( child->body1->I ).Multiply( childI, child->body1->J );
+				tmp1.Multiply( childI, child->body1->J );
 				childI.Negate();
 
 				child->invI = childI;
 				if ( !child->invI.InverseFastSelf() ) {
-					gameLocal.Warning( "idAFTree::Factor: couldn't invert %dx%d matrix for constraint '%s'",
-									child->invI.GetNumRows(), child->invI.GetNumColumns(), child->GetName().c_str() );
+					if ( solvingIslands ) {
+						if ( !factorFailedConstraint ) {
+							factorFailedConstraint = child;
+						}
+					} else {
+						gameLocal.Warning( "idAFTree::Factor: couldn't invert %dx%d matrix for constraint '%s'",
+										child->invI.GetNumRows(), child->invI.GetNumColumns(), child->GetName().c_str() );
+					}
 				}
-				child->J = child->invI * child->J;
-
-				body->I -= child->J.TransposeMultiply( childI ) * child->J;
+				// child->J = child->invI * child->J;
+				tmp1.SetSize( child->invI.GetNumRows(), child->J.GetNumColumns() );
+				child->invI.Multiply( tmp1, child->J );
+				child->J = tmp1;
+
+				// body->I -= child->J.Transpose() * childI * child->J;
+				tmp1.SetSize( child->J.GetNumColumns(), childI.GetNumColumns() );
+				child->J.TransposeMultiply( tmp1, childI );
+				tmp2.SetSize( tmp1.GetNumRows(), child->J.GetNumColumns() );
+				tmp1.Multiply( tmp2, child->J );
+				body->I -= tmp2;
 			}
 
 			body->invI = body->I;
 			if ( !body->invI.InverseFastSelf() ) {
-				gameLocal.Warning( "idAFTree::Factor: couldn't invert %dx%d matrix for body %s",
-								child->invI.GetNumRows(), child->invI.GetNumColumns(), body->GetName().c_str() );
+				if ( solvingIslands ) {
+					if ( !factorFailedBody ) {
+						factorFailedBody = body;
+					}
+				} else {
+					gameLocal.Warning( "idAFTree::Factor: couldn't invert %dx%d matrix for body %s",
+									child->invI.GetNumRows(), child->invI.GetNumColumns(), body->GetName().c_str() );
+				}
 			}
 			if ( body->primaryConstraint ) {
-				body->J = body->invI * body->J;
+				tmp1.SetSize( body->invI.GetNumRows(), body->J.GetNumColumns() );
+				body->invI.Multiply( tmp1, body->J );
+				body->J = tmp1;
 			}
 		}
 		else if ( body->primaryConstraint ) {
-			body->J = body->inverseWorldSpatialInertia * body->J;
+			tmp1.SetSize( body->inverseWorldSpatialInertia.GetNumRows(), body->J.GetNumColumns() );
+			body->inverseWorldSpatialInertia.Multiply( tmp1, body->J );
+			body->J = tmp1;
 		}
 	}
 }
 
+/*
+================
+idAFTree::ReportFactorFailures
+
+  Factor does not print while figures are solved on job threads,
+  the first failures are printed here once the jobs are done.
+================
+*/
+void idAFTree::ReportFactorFailures( void ) const {
+	if ( factorFailedConstraint ) {
+		gameLocal.Warning( "idAFTree::Factor: couldn't invert %dx%d matrix for constraint '%s'",
+						factorFailedConstraint->invI.GetNumRows(), factorFailedConstraint->invI.GetNumColumns(), factorFailedConstraint->GetName().c_str() );
+		factorFailedConstraint = NULL;
+	}
+	if ( factorFailedBody ) {
+		gameLocal.Warning( "idAFTree::Factor: couldn't invert %dx%d matrix for body %s",
+						factorFailedBody->invI.GetNumRows(), factorFailedBody->invI.GetNumColumns(), factorFailedBody->GetName().c_str() );
+		factorFailedBody = NULL;
+	}
+}
+
 /*
 ================
 idAFTree::Solve
@@ -4582,6 +4634,9 @@ void idAFTree::Solve( int auxiliaryIndex ) const {
 	int i, j;
 	idAFBody *body, *child;
 	idAFConstraint *primaryConstraint;
+	idVecX tmp;
+
+	tmp.SetData( 6, VECX_ALLOCA( 6 ) );
 
 	// from the leaves up towards the root
 	for ( i = sortedBodies.Num() - 1; i >= 0; i-- ) {
@@ -4616,7 +4671,9 @@ void idAFTree::Solve( int auxiliaryIndex ) const {
 			}
 
 			if ( !primaryConstraint->fl.isZero ) {
-				primaryConstraint->s = primaryConstraint->invI * primaryConstraint->s;
+				tmp.SetSize( primaryConstraint->invI.GetNumRows() );
+				primaryConstraint->invI.Multiply( tmp, primaryConstraint->s );
+				primaryConstraint->s = tmp;
 			}
 			primaryConstraint->J.MultiplySub( primaryConstraint->s, primaryConstraint->body2->s );
 
@@ -4628,12 +4685,16 @@ void idAFTree::Solve( int auxiliaryIndex ) const {
 
 			if ( body->children.Num() ) {
 				if ( !body->fl.isZero ) {
-					body->s = body->invI * body->s;
+					tmp.SetSize( body->invI.GetNumRows() );
+					body->invI.Multiply( tmp, body->s );
+					body->s = tmp;
 				}
 				body->J.MultiplySub( body->s, primaryConstraint->s );
 			}
 		} else if ( body->children.Num() ) {
-			body->s = body->invI * body->s;
+			tmp.SetSize( body->invI.GetNumRows() );
+			body->invI.Multiply( tmp, body->s );
+			body->s = tmp;
 		}
 	}
 }
@@ -4783,7 +4844,12 @@ void idAFTree::CalculateForces( float timeStep ) const {
 		if ( primaryConstraint ) {
 			// b = ( J * acc + c )
 			c = primaryConstraint;
-			c->s = c->J1 * c->body1->acceleration + c->J2 * c->body2->acceleration + invStep * ( c->c1 + c->c2 );
+			c->s.SetSize( c->J1.GetNumRows() );
+			c->J1.Multiply( c->s, c->body1->acceleration );
+			c->J2.MultiplyAdd( c->s, c->body2->acceleration );
+			for ( j = 0; j < c->s.GetSize(); j++ ) {
+				c->s[j] += invStep * ( c->c1[j] + c->c2[j] );
+			}
 			c->fl.isZero = false;
 		}
 		body->s.Zero();
@@ -5265,16 +5331,26 @@ void idPhysics_AF::AuxiliaryForces( float timeStep ) {
 	}
 
 #ifdef AF_TIMINGS
-	timer_lcp.Start();
+	if ( !solvingIslands ) {
+		timer_lcp.Start();
+	}
 #endif
 
-	// calculate lagrange multipliers for auxiliary constraints
+	// keep a copy of the system for testLCP
+	if ( !solvingIslands ) {
+		idLCP::CaptureSystem( jmk, rhs, lo, hi, boxIndex );
+	}
+
+	// calculate lagrange multipliers for auxiliary constraints, failures are reported after the island jobs
+	lcp->DeferFailures( solvingIslands );
 	if ( !lcp->Solve( jmk, lm, rhs, lo, hi, boxIndex ) ) {
 		return;		// bad monkey!
 	}
 
 #ifdef AF_TIMINGS
-	timer_lcp.Stop();
+	if ( !solvingIslands ) {
+		timer_lcp.Stop();
+	}
 #endif
 
 	// calculate auxiliary constraint forces
@@ -5512,7 +5588,7 @@ idEntity *idPhysics_AF::SetupCollisionForBody( idAFBody *body ) const {
 
 	passEntity = NULL;
 
-	if ( !selfCollision || !body->fl.selfCollision || af_skipSelfCollision.GetBool() ) {
+	if ( !selfCollision || !body->fl.selfCollision || af_skipSelfCollision.GetBool() || reducedLOD ) {
 
 		// disable all bodies
 		for ( i = 0; i < bodies.Num(); i++ ) {
@@ -5869,6 +5945,25 @@ void idPhysics_AF::SetSuspendTime( const float minTime, const float maxTime ) {
 	this->maxMoveTime = maxTime;
 }
 
+/*
+================
+idPhysics_AF::SetReducedLOD
+================
+*/
+void idPhysics_AF::SetReducedLOD( bool reduced ) {
+	if ( reduced == reducedLOD ) {
+		return;
+	}
+	if ( reduced ) {
+		lodMaxIterations = lcp->GetMaxIterations();
+		lcp->SetMaxIterations( Min( lodMaxIterations, af_lodMaxIterations.GetInteger() ) );
+	} else {
+		lcp->SetMaxIterations( lodMaxIterations );
+	}
+	reducedLOD = reduced;
+	lodSkippedTime = 0;
+}
+
 /*
 ================
 idPhysics_AF::SetSuspendTolerance
@@ -5951,9 +6046,12 @@ idPhysics_AF::TestIfAtRest
 */
 bool idPhysics_AF::TestIfAtRest( float timeStep ) {
 	int i;
-	float translationSqr, maxTranslationSqr, rotation, maxRotation;
+	float translationSqr, maxTranslationSqr, rotation, maxRotation, restScale;
 	idAFBody *body;
 
+	// figures at the reduced level of detail come to rest sooner
+	restScale = reducedLOD ? g_physicsLODRestScale.GetFloat() : 1.0f;
+
 	if ( current.atRest >= 0 ) {
 		return true;
 	}
@@ -6001,7 +6099,7 @@ bool idPhysics_AF::TestIfAtRest( float timeStep ) {
 			}
 		}
 
-		if ( maxTranslationSqr < Square( noMoveTranslation ) && maxRotation < noMoveRotation ) {
+		if ( maxTranslationSqr < Square( noMoveTranslation * restScale ) && maxRotation < noMoveRotation * restScale ) {
 			// hardly moved over a period of time so the articulated figure may come to rest
 			// HUMANHEAD nla
 			if ( g_debugAFs.GetInteger() ) {
@@ -6020,7 +6118,7 @@ bool idPhysics_AF::TestIfAtRest( float timeStep ) {
 	for ( i = 0; i < bodies.Num(); i++ ) {
 		body = bodies[i];
 
-		if ( body->current->spatialVelocity.SubVec3(0).LengthSqr() > Square( suspendVelocity[0] ) ) {
+		if ( body->current->spatialVelocity.SubVec3(0).LengthSqr() > Square( suspendVelocity[0] * restScale ) ) {
 			// HUMANHEAD nla
 			if ( g_debugAFs.GetInteger() ) {
 				gameLocal.Printf("1 Going because Linear Vel %.2f > %.2f\n", body->current->spatialVelocity.SubVec3(0).Length(), suspendVelocity[0] );
@@ -6028,7 +6126,7 @@ bool idPhysics_AF::TestIfAtRest( float timeStep ) {
 			// HUMANHEAD END
 			return false;
 		}
-		if ( body->current->spatialVelocity.SubVec3(1).LengthSqr() > Square( suspendVelocity[1] ) ) {
+		if ( body->current->spatialVelocity.SubVec3(1).LengthSqr() > Square( suspendVelocity[1] * restScale ) ) {
 			// HUMANHEAD nla
 			if ( g_debugAFs.GetInteger() ) {
 				gameLocal.Printf("2 Going because Angular Vel %.2f > %.2f\n", body->current->spatialVelocity.SubVec3(1).Length(), suspendVelocity[1] );
@@ -6036,7 +6134,7 @@ bool idPhysics_AF::TestIfAtRest( float timeStep ) {
 			// HUMANHEAD END
 			return false;
 		}
-		if ( body->acceleration.SubVec3(0).LengthSqr() > Square( suspendAcceleration[0] ) ) {
+		if ( body->acceleration.SubVec3(0).LengthSqr() > Square( suspendAcceleration[0] * restScale ) ) {
 			// HUMANHEAD nla
 			if ( g_debugAFs.GetInteger() ) {
 				gameLocal.Printf("3 Going because Linear Acc %.2f > %.2f\n", body->acceleration.SubVec3(0).Length(), suspendAcceleration[0] );
@@ -6044,7 +6142,7 @@ bool idPhysics_AF::TestIfAtRest( float timeStep ) {
 			// HUMANHEAD END
 			return false;
 		}
-		if ( body->acceleration.SubVec3(1).LengthSqr() > Square( suspendAcceleration[1] ) ) {
+		if ( body->acceleration.SubVec3(1).LengthSqr() > Square( suspendAcceleration[1] * restScale ) ) {
 			// HUMANHEAD nla
 			if ( g_debugAFs.GetInteger() ) {			
 				gameLocal.Printf("4 Going because Angular Acc %.2f > %.2f\n", body->acceleration.SubVec3(1).Length(), suspendAcceleration[1] );
@@ -6302,11 +6400,12 @@ const idBounds &idPhysics_AF::GetAbsBounds( int id ) const {
 
 /*
 ================
-idPhysics_AF::Evaluate
+idPhysics_AF::EvaluateBegin
+
+  runs the evaluation up to solving the constraints, returns false if the evaluation is already done
 ================
 */
-bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
-	PROFILE_SCOPE("AF", PROFMASK_PHYSICS);
+bool idPhysics_AF::EvaluateBegin( int timeStepMSec, int endTimeMSec, bool &moved ) {
 	float timeStep;
 
 	if ( timeScaleRampStart < MS2SEC( endTimeMSec ) && timeScaleRampEnd > MS2SEC( endTimeMSec ) ) {
@@ -6366,16 +6465,31 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 		masterBody->current->worldAxis = masterAxis;
 
 		// HUMANHEAD nla
-		if ( frozen ) { return( true ); }
+		if ( frozen ) { moved = true; return false; }
 		// HUMANHEAD END
 	}
 
 	// if the simulation is suspended because the figure is at rest
 	if ( current.atRest >= 0 || timeStep <= 0.0f ) {
 		DebugDraw();
+		moved = false;
 		return false;
 	}
 
+	// figures at the reduced level of detail skip frames and take one larger step
+	if ( reducedLOD && !masterBody ) {
+		lodSkippedTime += timeStepMSec;
+		if ( lodSkippedTime < g_physicsLODUpdateTime.GetInteger() ) {
+			// only the forces of the last frame are applied over the larger step
+			ClearExternalForce();
+			moved = false;
+			return false;
+		}
+		timeStep *= (float) lodSkippedTime / timeStepMSec;
+		current.lastTimeStep = timeStep;
+		lodSkippedTime = 0;
+	}
+
 	// move the af velocity into the frame of a pusher
 	AddPushVelocity( -current.pushVelocity );
 
@@ -6406,15 +6520,23 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	// add frame constraints
 	AddFrameConstraints();
 
+	return true;
+}
+
+/*
+================
+idPhysics_AF::EvaluateSolve
+
+  solves the constraints and evolves the next state, only touches the figure itself
+================
+*/
+void idPhysics_AF::EvaluateSolve( void ) {
+	float timeStep = current.lastTimeStep;
+
 #ifdef AF_TIMINGS
-	int i, numPrimary = 0, numAuxiliary = 0;
-	for ( i = 0; i < primaryConstraints.Num(); i++ ) {
-		numPrimary += primaryConstraints[i]->J1.GetNumRows();
+	if ( !solvingIslands ) {
+		timer_pc.Start();
 	}
-	for ( i = 0; i < auxiliaryConstraints.Num(); i++ ) {
-		numAuxiliary += auxiliaryConstraints[i]->J1.GetNumRows();
-	}
-	timer_pc.Start();
 #endif
 
 	// factor matrices for primary constraints
@@ -6424,19 +6546,42 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	PrimaryForces( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_pc.Stop();
-	timer_ac.Start();
+	if ( !solvingIslands ) {
+		timer_pc.Stop();
+		timer_ac.Start();
+	}
 #endif
 
 	// calculate and apply auxiliary constraint forces
 	AuxiliaryForces( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_ac.Stop();
+	if ( !solvingIslands ) {
+		timer_ac.Stop();
+	}
 #endif
 
 	// evolve current state to next state
 	Evolve( timeStep );
+}
+
+/*
+================
+idPhysics_AF::EvaluateEnd
+================
+*/
+bool idPhysics_AF::EvaluateEnd( int endTimeMSec ) {
+	float timeStep = current.lastTimeStep;
+
+#ifdef AF_TIMINGS
+	int i, numPrimary = 0, numAuxiliary = 0;
+	for ( i = 0; i < primaryConstraints.Num(); i++ ) {
+		numPrimary += primaryConstraints[i]->J1.GetNumRows();
+	}
+	for ( i = 0; i < auxiliaryConstraints.Num(); i++ ) {
+		numAuxiliary += auxiliaryConstraints[i]->J1.GetNumRows();
+	}
+#endif
 
 	// debug graphics
 	DebugDraw();
@@ -6532,6 +6677,201 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	return true;
 }
 
+/*
+================
+idPhysics_AF::Evaluate
+================
+*/
+bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
+	PROFILE_SCOPE("AF", PROFMASK_PHYSICS);
+	bool moved;
+
+	// the figure may already have been evaluated for this frame together with the other islands
+	if ( islandEvaluateTime == endTimeMSec ) {
+		islandEvaluateTime = -1;
+		return islandMoved;
+	}
+	islandEvaluateTime = -1;
+
+	if ( !EvaluateBegin( timeStepMSec, endTimeMSec, moved ) ) {
+		return moved;
+	}
+	EvaluateSolve();
+	return EvaluateEnd( endTimeMSec );
+}
+
+/*
+================
+idPhysics_AF::SolveIslandJob
+================
+*/
+void idPhysics_AF::SolveIslandJob( void *data ) {
+	reinterpret_cast<idPhysics_AF *>( data )->EvaluateSolve();
+}
+
+/*
+================
+SetTeamClip
+
+  disables or enables the clip models of all team parts that are not solid for
+  their team, the same way idEntity::RunPhysics does around Evaluate
+================
+*/
+static void SetTeamClip( idEntity *self, bool enable ) {
+	idEntity *part;
+
+	part = self->GetTeamMaster() ? self->GetTeamMaster() : self;
+	for ( ; part != NULL; part = part->GetTeamChain() ) {
+		if ( !part->fl.solidForTeam ) {
+			if ( enable ) {
+				part->GetPhysics()->EnableClip();
+			} else {
+				part->GetPhysics()->DisableClip();
+			}
+		}
+	}
+}
+
+/*
+================
+idPhysics_AF::EvaluateIslands
+
+  Evaluates articulated figures ahead of the entity think loop. Figures whose
+  bounds, expanded by the distance they can move this frame, touch each other
+  end up in the same island. Figures of an island are evaluated one after the
+  other in list order, figures of different islands cannot interact and are
+  solved in parallel. Collision detection uses idClip so it stays on the calling
+  thread and always runs in the same order, which keeps the results deterministic.
+  The entities pick up the results when their think calls Evaluate.
+================
+*/
+void idPhysics_AF::EvaluateIslands( idPhysics_AF **figures, int numFigures, int timeStepMSec, int endTimeMSec ) {
+	int i, j, round, numIslands, numJobs, numThreads;
+	int *island, *islandIndex, *islandSize, *member;
+	idBounds *bounds;
+	idPhysics_AF **jobs;
+	bool *solve;
+	float timeStep;
+
+	if ( numFigures <= 0 ) {
+		return;
+	}
+
+	island = (int *) _alloca16( numFigures * sizeof( int ) );
+	islandIndex = (int *) _alloca16( numFigures * sizeof( int ) );
+	islandSize = (int *) _alloca16( numFigures * sizeof( int ) );
+	member = (int *) _alloca16( numFigures * sizeof( int ) );
+	bounds = (idBounds *) _alloca16( numFigures * sizeof( idBounds ) );
+	jobs = (idPhysics_AF **) _alloca16( numFigures * sizeof( idPhysics_AF * ) );
+	solve = (bool *) _alloca16( numFigures * sizeof( bool ) );
+
+	timeStep = MS2SEC( timeStepMSec );
+
+	// get the bounds each figure may touch this frame
+	for ( i = 0; i < numFigures; i++ ) {
+		idPhysics_AF *af = figures[i];
+		float move = 0.0f;
+		float figureStep = timeStep + MS2SEC( af->lodSkippedTime );
+
+		for ( j = 0; j < af->bodies.Num(); j++ ) {
+			const idAFBody *body = af->bodies[j];
+			float radius = body->GetClipModel()->GetBounds().GetRadius();
+			float speed = body->current->spatialVelocity.SubVec3(0).Length() + body->current->spatialVelocity.SubVec3(1).Length() * radius;
+			move = Max( move, speed * figureStep );
+		}
+
+		bounds[i] = af->GetAbsBounds().Expand( move + 2.0f * CONTACT_EPSILON + 1.0f );
+		island[i] = i;
+	}
+
+	// merge the islands of figures that may touch, the island of a figure is the island of the first figure in it
+	for ( i = 1; i < numFigures; i++ ) {
+		for ( j = 0; j < i; j++ ) {
+			if ( island[j] == island[i] || !bounds[i].IntersectsBounds( bounds[j] ) ) {
+				continue;
+			}
+			int from = Max( island[i], island[j] );
+			int to = Min( island[i], island[j] );
+			for ( int k = 0; k <= i; k++ ) {
+				if ( island[k] == from ) {
+					island[k] = to;
+				}
+			}
+		}
+	}
+
+	// number the islands in list order
+	numIslands = 0;
+	for ( i = 0; i < numFigures; i++ ) {
+		if ( island[i] == i ) {
+			islandIndex[i] = numIslands;
+			islandSize[numIslands++] = 0;
+		}
+	}
+
+	// the figures of each island are evaluated in rounds, one figure of each island per round
+	for ( round = 0; ; round++ ) {
+
+		// find the figure of each island for this round
+		numJobs = 0;
+		for ( i = 0; i < numIslands; i++ ) {
+			islandSize[i] = 0;
+		}
+		for ( i = 0; i < numFigures; i++ ) {
+			int n = islandIndex[island[i]];
+			if ( islandSize[n]++ == round ) {
+				member[numJobs++] = i;
+			}
+		}
+		if ( !numJobs ) {
+			break;
+		}
+
+		// evaluate contacts and constraints
+		for ( i = 0; i < numJobs; i++ ) {
+			idPhysics_AF *af = figures[member[i]];
+			SetTeamClip( af->self, false );
+			solve[i] = af->EvaluateBegin( timeStepMSec, endTimeMSec, af->islandMoved );
+			SetTeamClip( af->self, true );
+		}
+
+		// solve the figures of this round
+		for ( i = j = 0; i < numJobs; i++ ) {
+			if ( solve[i] ) {
+				jobs[j++] = figures[member[i]];
+			}
+		}
+		numThreads = af_parallelIslands.GetInteger();
+		if ( j > 1 && numThreads > 0 ) {
+			solvingIslands = true;
+			sys->RunJobs( SolveIslandJob, (void **)jobs, j, numThreads );
+			solvingIslands = false;
+
+			for ( i = 0; i < j; i++ ) {
+				for ( int k = 0; k < jobs[i]->trees.Num(); k++ ) {
+					jobs[i]->trees[k]->ReportFactorFailures();
+				}
+				jobs[i]->lcp->ReportFailures();
+			}
+		} else {
+			for ( i = 0; i < j; i++ ) {
+				jobs[i]->EvaluateSolve();
+			}
+		}
+
+		// check collisions and move to the next state
+		for ( i = 0; i < numJobs; i++ ) {
+			idPhysics_AF *af = figures[member[i]];
+			if ( solve[i] ) {
+				SetTeamClip( af->self, false );
+				af->islandMoved = af->EvaluateEnd( endTimeMSec );
+				SetTeamClip( af->self, true );
+			}
+			af->islandEvaluateTime = endTimeMSec;
+		}
+	}
+}
+
 /*
 ================
 idPhysics_AF::UpdateTime
@@ -6722,6 +7062,9 @@ idPhysics_AF::idPhysics_AF( void ) {
 	masterBody = NULL;
 
 	lcp = idLCP::AllocSymmetric();
+	reducedLOD = false;
+	lodSkippedTime = 0;
+	lodMaxIterations = lcp->GetMaxIterations();
 
 	memset( &current, 0, sizeof( current ) );
 	current.atRest = -1;
@@ -6773,6 +7116,9 @@ idPhysics_AF::idPhysics_AF( void ) {
 	invMass = 1;
 	// HUMANHEAD
 
+	islandEvaluateTime = -1;
+	islandMoved = false;
+
 #ifdef AF_TIMINGS
 	lastTimerReset = 0;
 #endif
@@ -6992,6 +7338,10 @@ void idPhysics_AF::Restore( idRestoreGame *saveFile ) {
 	saveFile->ReadBool( frozen );
 	saveFile->ReadFloat( invMass );
 	// HUMANHEAD END
+
+	islandEvaluateTime = -1;
+	reducedLOD = false;
+	lodSkippedTime = 0;
 }
 
 /*
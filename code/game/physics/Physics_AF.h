@@ -752,7 +752,10 @@ class idAFTree {
 	friend class idPhysics_AF;
 
 public:
+							idAFTree( void ) : factorFailedConstraint( NULL ), factorFailedBody( NULL ) {}
+
 	void					Factor( void ) const;
+	void					ReportFactorFailures( void ) const;
 	void					Solve( int auxiliaryIndex = 0 ) const;
 	void					Response( const idAFConstraint *constraint, int row, int auxiliaryIndex ) const;
 	void					CalculateForces( float timeStep ) const;
@@ -763,6 +766,9 @@ public:
 
 private:
 	idList<idAFBody *>		sortedBodies;
+							// failures of Factor on a job thread, reported later from the main thread
+	mutable const idAFConstraint *factorFailedConstraint;
+	mutable const idAFBody *factorFailedBody;
 };
 
 
@@ -832,6 +838,9 @@ public:
 	void					SetSuspendTolerance( const float noMoveTime, const float translationTolerance, const float rotationTolerance );
 							// set minimum and maximum simulation time in seconds
 	void					SetSuspendTime( const float minTime, const float maxTime );
+							// lower update rate, fewer LCP iterations, no self collision and looser rest tolerances for figures far away or out of view
+	void					SetReducedLOD( bool reduced );
+	bool					IsReducedLOD( void ) const { return reducedLOD; }
 							// set the time scale value
 	void					SetTimeScale( const float ts ) { timeScale = ts; }
 							// set time scale ramp
@@ -936,6 +945,9 @@ public:	// common physics interface
 
 	void					SetMaster( idEntity *master, const bool orientated = true );
 
+							// evaluate the figures ahead of the entity think loop, solving independent islands in parallel
+	static void				EvaluateIslands( idPhysics_AF **figures, int numFigures, int timeStepMSec, int endTimeMSec );
+
 	void					WriteToSnapshot( idBitMsgDelta &msg ) const;
 	void					ReadFromSnapshot( const idBitMsgDelta &msg );
 
@@ -1005,6 +1017,13 @@ private:
 	float					invMass;	// The inv mass of the body
 	// HUMANHEAD END
 
+	int						islandEvaluateTime;				// end time of an evaluation done by EvaluateIslands, -1 if none
+	bool					islandMoved;					// result of that evaluation
+
+	bool					reducedLOD;						// true if simulated at the reduced level of detail
+	int						lodSkippedTime;					// msec of frames skipped since the last update
+	int						lodMaxIterations;				// LCP iterations at full detail
+
 private:
 	void					BuildTrees( void );
 	bool					IsClosedLoop( const idAFBody *body1, const idAFBody *body2 ) const;
@@ -1031,6 +1050,10 @@ private:
 	void					Rest( void );
 	void					AddPushVelocity( const idVec6 &pushVelocity );
 	void					DebugDraw( void );
+	bool					EvaluateBegin( int timeStepMSec, int endTimeMSec, bool &moved );
+	void					EvaluateSolve( void );
+	bool					EvaluateEnd( int endTimeMSec );
+	static void				SolveIslandJob( void *data );
 };
 
 #endif /* !__PHYSICS_AF_H__ */
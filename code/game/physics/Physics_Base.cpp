@@ -17,6 +17,8 @@ idPhysics_Base::idPhysics_Base
 idPhysics_Base::idPhysics_Base( void ) {
 	self = NULL;
 	clipMask = 0;
+	stepTime = 0;
+	stepAccumTime = 0;
 	SetGravity( gameLocal.GetGravity() );
 	ClearContacts();
 }
@@ -842,3 +844,43 @@ idPhysics_Base::ReadFromSnapshot
 */
 void idPhysics_Base::ReadFromSnapshot( const idBitMsgDelta &msg ) {
 }
+
+/*
+================
+idPhysics_Base::SetStepTime
+================
+*/
+void idPhysics_Base::SetStepTime( int msec ) {
+	stepTime = Max( msec, 0 );
+	stepAccumTime = 0;
+}
+
+/*
+================
+idPhysics_Base::ScheduleSteps
+================
+*/
+int idPhysics_Base::ScheduleSteps( int timeStepMSec ) {
+	int numSteps;
+
+	if ( stepTime <= 0 ) {
+		return 1;
+	}
+
+	stepAccumTime += timeStepMSec;
+	numSteps = stepAccumTime / stepTime;
+	stepAccumTime -= numSteps * stepTime;
+	return numSteps;
+}
+
+/*
+================
+idPhysics_Base::GetStepFraction
+================
+*/
+float idPhysics_Base::GetStepFraction( void ) const {
+	if ( stepTime <= 0 ) {
+		return 1.0f;
+	}
+	return (float) stepAccumTime / stepTime;
+}
@@ -121,6 +121,10 @@ public:	// common physics interface
 	void					WriteToSnapshot( idBitMsgDelta &msg ) const;
 	void					ReadFromSnapshot( const idBitMsgDelta &msg );
 
+							// fixed step time in milliseconds, zero steps once per game frame
+	void					SetStepTime( int msec );
+	int						GetStepTime( void ) const { return stepTime; }
+
 protected:
 	idEntity *				self;					// entity using this physics object
 	int						clipMask;				// contents the physics object collides with
@@ -128,6 +132,8 @@ protected:
 	idVec3					gravityNormal;			// normalized direction of gravity
 	idList<contactInfo_t>	contacts;				// contacts with other physics objects
 	idList<contactEntity_t>	contactEntities;		// entities touching this physics object
+	int						stepTime;				// fixed step time in milliseconds
+	int						stepAccumTime;			// milliseconds not yet simulated with a fixed step
 
 protected:
 							// add ground contacts for the clip model
@@ -140,6 +146,10 @@ protected:
 	bool					IsOutsideWorld( void ) const;
 							// draw linear and angular velocity
 	void					DrawVelocity( int id, float linearScale, float angularScale ) const;
+							// adds the elapsed time and returns the number of fixed steps to take
+	int						ScheduleSteps( int timeStepMSec );
+							// fraction of the next fixed step that already elapsed
+	float					GetStepFraction( void ) const;
 };
 
 #endif /* !__PHYSICS_BASE_H__ */
@@ -57,6 +57,11 @@ hhPhysics_Player::hhPhysics_Player( void ): idPhysics_Player() {
 	oldOrigin.Zero();
 	oldAxis.Identity();
 
+	wallwalkPatchNumPolygons = -1;
+	wallwalkPatchOrigin.Zero();
+	wallwalkPatchAxis.Identity();
+	wallwalkPatchStateCount = 0;
+
 	//HUMANHEAD PCF rww 05/11/06 - hack fix for stuck bugs
 	stuckCount = 0;
 	stuckOrigin.Zero();
@@ -487,15 +492,27 @@ void hhPhysics_Player::ForceCrouching() {
 /*
 ================
 hhPhysics_Player::PerformGroundTraces
+	Traces every ground probe from the trace origin table in one batch
 ================
 */
-void hhPhysics_Player::PerformGroundTrace( trace_t& TraceInfo, const idVec3& Start ) {
-	idVec3 End = Start + (-clipModelAxis[2]) * c_fGroundTraceDistance;
+void hhPhysics_Player::PerformGroundTraces( trace_t TraceInfo[ c_iNumWallwalkTraces ] ) {
+	cmBatchTrace_t Traces[ c_iNumWallwalkTraces ];
+	idVec3 Dir = (-clipModelAxis[2]) * c_fGroundTraceDistance;
+	int iIndex;
+
+	for( iIndex = 0; iIndex < c_iNumWallwalkTraces; ++iIndex ) {
+		Traces[iIndex].start = wallwalkTraceOriginTable[iIndex];
+		Traces[iIndex].end = wallwalkTraceOriginTable[iIndex] + Dir;
+		Traces[iIndex].bounds.Zero();
+		Traces[iIndex].contentMask = clipMask;
+	}
 
-	gameLocal.clip.TracePoint(TraceInfo, Start, End, clipMask, self);
+	gameLocal.clip.TranslationBatch(TraceInfo, Traces, c_iNumWallwalkTraces, self);
 
 	if(p_playerPhysicsDebug.GetInteger() == 1) {
-		gameRenderWorld->DebugLine(colorRed, Start, Start + (-clipModelAxis[2]) * c_fGroundTraceDistance * TraceInfo.fraction);
+		for( iIndex = 0; iIndex < c_iNumWallwalkTraces; ++iIndex ) {
+			gameRenderWorld->DebugLine(colorRed, Traces[iIndex].start, Traces[iIndex].start + Dir * TraceInfo[iIndex].fraction);
+		}
 	}
 }
 
@@ -537,6 +554,212 @@ void hhPhysics_Player::BuildWallwalkTraceOriginTable( const idMat3& Axis ) {
 	wallwalkTraceOriginTable[0] = current.origin + (UpVector * c_fTraceOriginOffset);
 }
 
+/*
+=============
+hhPhysics_Player::FindWallwalkSurface
+	Returns the index of the first ground probe that hits a wallwalk surface, or -1 if there is none.
+	The probes are answered from the cached wallwalk patch while the player stays within it.
+=============
+*/
+int hhPhysics_Player::FindWallwalkSurface( idVec3& Normal ) {
+	trace_t TraceInfo[ c_iNumWallwalkTraces ];
+	int iIndex;
+
+	if( TestWallwalkPatch(iIndex, Normal) ) {
+		return iIndex;
+	}
+
+	PerformGroundTraces( TraceInfo );
+
+	for( iIndex = 0; iIndex < c_iNumWallwalkTraces; ++iIndex ) {
+		if( EvaluateGroundTrace(TraceInfo[iIndex]) ) {
+			Normal = TraceInfo[iIndex].c.normal;
+			break;
+		}
+	}
+
+	BuildWallwalkPatch();
+
+	return ( iIndex < c_iNumWallwalkTraces ) ? iIndex : -1;
+}
+
+/*
+=============
+hhPhysics_Player::WallwalkProbesTouchEntities
+	Returns true if a clip model other than the world may be hit by the ground probes.
+=============
+*/
+bool hhPhysics_Player::WallwalkProbesTouchEntities( void ) const {
+	idClipModel *clipModels[ MAX_GENTITIES ];
+	idBounds bounds;
+	idVec3 Dir;
+	int i, num;
+
+	Dir = -clipModelAxis[2] * c_fGroundTraceDistance;
+
+	bounds.Clear();
+	for( i = 0; i < c_iNumWallwalkTraces; i++ ) {
+		bounds.AddPoint( wallwalkTraceOriginTable[i] );
+		bounds.AddPoint( wallwalkTraceOriginTable[i] + Dir );
+	}
+	num = gameLocal.clip.ClipModelsTouchingBounds( bounds, clipMask, clipModels, MAX_GENTITIES );
+	for( i = 0; i < num; i++ ) {
+		if( clipModels[i]->GetEntity() != self && clipModels[i]->GetOwner() != self ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+=============
+hhPhysics_Player::BuildWallwalkPatch
+	Stores every world polygon the ground probes can hit while the player moves less
+	than pm_wallwalkPatchRadius, so ledges and steps next to the player are included.
+=============
+*/
+void hhPhysics_Player::BuildWallwalkPatch( void ) {
+	idBounds bounds;
+	idVec3 Dir;
+	int i;
+
+	wallwalkPatchNumPolygons = -1;
+
+	if( !pm_wallwalkPatchCache.GetBool() || WallwalkProbesTouchEntities() ) {
+		return;
+	}
+
+	Dir = -clipModelAxis[2] * c_fGroundTraceDistance;
+
+	bounds.Clear();
+	for( i = 0; i < c_iNumWallwalkTraces; i++ ) {
+		bounds.AddPoint( wallwalkTraceOriginTable[i] );
+		bounds.AddPoint( wallwalkTraceOriginTable[i] + Dir );
+	}
+	bounds.ExpandSelf( pm_wallwalkPatchRadius.GetFloat() + CM_BOX_EPSILON );
+
+	wallwalkPatchNumPolygons = collisionModelManager->GetModelPolygons( 0, bounds, clipMask, wallwalkPatchPolygons, c_iMaxWallwalkPatchPolygons,
+																		wallwalkPatchPoints, c_iMaxWallwalkPatchPoints );
+	for( i = 0; i < wallwalkPatchNumPolygons; i++ ) {
+		wallwalkPatchSurface[i] = ( gameLocal.GetMatterType(gameLocal.world, wallwalkPatchPolygons[i].material, NULL) == SURFTYPE_WALLWALK );
+	}
+
+	wallwalkPatchOrigin = current.origin;
+	wallwalkPatchAxis = clipModelAxis;
+	wallwalkPatchStateCount = idClipModel::stateChangeCount;
+}
+
+/*
+=============
+PointInsideWallwalkPolygon
+=============
+*/
+static bool PointInsideWallwalkPolygon( const cmPolygon_t &polygon, const idVec3 *points, const idVec3 &point ) {
+	int i, front, back;
+	float d;
+
+	front = back = 0;
+	for( i = 0; i < polygon.numPoints; i++ ) {
+		const idVec3 &p1 = points[ polygon.firstPoint + i ];
+		const idVec3 &p2 = points[ polygon.firstPoint + ( i + 1 ) % polygon.numPoints ];
+		d = ( polygon.plane.Normal().Cross( p2 - p1 ) ) * ( point - p1 );
+		if( d > ON_EPSILON ) {
+			front++;
+		} else if( d < -ON_EPSILON ) {
+			back++;
+		}
+		if( front && back ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+=============
+hhPhysics_Player::TestWallwalkPatch
+	Answers the ground probes by ray testing them against the polygons of the wallwalk patch.
+	Returns false when the player has left the patch or the patch may be out of date, in which
+	case the probes must be traced.
+=============
+*/
+bool hhPhysics_Player::TestWallwalkPatch( int& iHitIndex, idVec3& Normal ) {
+	trace_t TraceInfo;
+	idVec3 Dir, Start, End;
+	float d0, d1, f, bestFraction, margin;
+	int i, j, best;
+
+	if( !pm_wallwalkPatchCache.GetBool() || wallwalkPatchNumPolygons < 0 ) {
+		return false;
+	}
+
+	if( wallwalkPatchStateCount != idClipModel::stateChangeCount ) {
+		wallwalkPatchNumPolygons = -1;
+		return false;
+	}
+
+	if( !clipModelAxis.Compare(wallwalkPatchAxis, VECTOR_EPSILON) ||
+		( current.origin - wallwalkPatchOrigin ).LengthSqr() > Square( pm_wallwalkPatchRadius.GetFloat() ) ) {
+		return false;
+	}
+
+	// the patch only holds world polygons, anything else between the probes and the ground has to be traced
+	if( WallwalkProbesTouchEntities() ) {
+		return false;
+	}
+
+	Dir = -clipModelAxis[2] * c_fGroundTraceDistance;
+
+	for( i = 0; i < c_iNumWallwalkTraces; i++ ) {
+		Start = wallwalkTraceOriginTable[i];
+
+		// closest polygon facing the probe
+		best = -1;
+		bestFraction = 1.0f;
+		for( j = 0; j < wallwalkPatchNumPolygons; j++ ) {
+			const cmPolygon_t &polygon = wallwalkPatchPolygons[j];
+
+			d0 = polygon.plane.Distance( Start );
+			d1 = d0 + polygon.plane.Normal() * Dir;
+			if( d0 < 0.0f || d1 >= 0.0f ) {
+				continue;
+			}
+			f = d0 / ( d0 - d1 );
+			if( f >= bestFraction || !PointInsideWallwalkPolygon( polygon, wallwalkPatchPoints, Start + Dir * f ) ) {
+				continue;
+			}
+			best = j;
+			bestFraction = f;
+		}
+
+		if( p_playerPhysicsDebug.GetInteger() == 1 ) {
+			gameRenderWorld->DebugLine( colorGreen, Start, Start + Dir * bestFraction );
+		}
+
+		if( best == -1 || !wallwalkPatchSurface[best] ) {
+			continue;
+		}
+
+		// validate the hit with a short trace around it
+		margin = 4.0f / c_fGroundTraceDistance;
+		End = Start + Dir * Min( bestFraction + margin, 1.0f );
+		Start = Start + Dir * Max( bestFraction - margin, 0.0f );
+		gameLocal.clip.TracePoint( TraceInfo, Start, End, clipMask, self );
+		if( TraceInfo.fraction >= 1.0f || TraceInfo.c.entityNum != ENTITYNUM_WORLD ||
+			TraceInfo.c.normal * wallwalkPatchPolygons[best].plane.Normal() < 0.99f || !EvaluateGroundTrace(TraceInfo) ) {
+			wallwalkPatchNumPolygons = -1;
+			return false;
+		}
+
+		iHitIndex = i;
+		Normal = TraceInfo.c.normal;
+		return true;
+	}
+
+	iHitIndex = -1;
+	return true;
+}
+
 /*
 =============
 hhPhysics_Player::EvaluateGroundTrace
@@ -649,24 +872,22 @@ hhPhysics_Player::CheckWallWalk
 ================
 */
 void hhPhysics_Player::CheckWallWalk( bool bForce ) {
-	trace_t TraceInfo;
+	idVec3 Normal;
+	int iIndex;
 
 	assert( self );
 
 	if( bForce || WallWalkIsAllowed() ) {
 		BuildWallwalkTraceOriginTable( clipModelAxis );
-	
-		for( int iIndex = 0; iIndex < c_iNumWallwalkTraces; ++iIndex ) {
-			PerformGroundTrace( TraceInfo, wallwalkTraceOriginTable[iIndex] );
-
-			if( EvaluateGroundTrace(TraceInfo) ) {
-				SetGravity( -TraceInfo.c.normal * hhUtils::GetLocalGravity(GetOrigin(), GetBounds(), gameLocal.GetGravity()).Length() );
-				ClipModelRotationOrigin = wallwalkTraceOriginTable[iIndex];
-				IsWallWalking( true );
-				ShouldRemainAlignedToAxial( false );
-				OrientToGravity( true );
-				return;
-			}
+
+		iIndex = FindWallwalkSurface( Normal );
+		if( iIndex >= 0 ) {
+			SetGravity( -Normal * hhUtils::GetLocalGravity(GetOrigin(), GetBounds(), gameLocal.GetGravity()).Length() );
+			ClipModelRotationOrigin = wallwalkTraceOriginTable[iIndex];
+			IsWallWalking( true );
+			ShouldRemainAlignedToAxial( false );
+			OrientToGravity( true );
+			return;
 		}
 	}
 
@@ -1154,6 +1375,8 @@ void hhPhysics_Player::Restore( idRestoreGame *savefile ) {
 	}
 	savefile->ReadBool(bMoveNextFrame); //HUMANHEAD rww
 
+	wallwalkPatchNumPolygons = -1;
+
 	if( castSelf ) {
 		camera = &(castSelf->cameraInterpolator);
 	} else {
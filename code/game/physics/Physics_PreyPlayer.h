@@ -7,6 +7,8 @@ hhPhysics_Player
 
 **********************************************************************/
 const int c_iNumWallwalkTraces = 5;
+const int c_iMaxWallwalkPatchPolygons = 128;
+const int c_iMaxWallwalkPatchPoints = 1024;
 
 class hhPhysics_Player: public idPhysics_Player
 {
@@ -99,13 +101,26 @@ class hhPhysics_Player: public idPhysics_Player
 		idVec3				wallwalkTraceOriginTable[ c_iNumWallwalkTraces ];
 		bool				bMoveNextFrame; //HUMANHEAD rww
 
+		// world polygons around the ground probes, the probes are tested against them while the player stays close
+		cmPolygon_t			wallwalkPatchPolygons[ c_iMaxWallwalkPatchPolygons ];
+		bool				wallwalkPatchSurface[ c_iMaxWallwalkPatchPolygons ];	// polygon has a wallwalk surface
+		idVec3				wallwalkPatchPoints[ c_iMaxWallwalkPatchPoints ];
+		int					wallwalkPatchNumPolygons;	// -1 = no patch
+		idVec3				wallwalkPatchOrigin;
+		idMat3				wallwalkPatchAxis;
+		int					wallwalkPatchStateCount;
+
 	protected:
 		void				EvaluateOwnerCamera( const int timeStep );
 		void				SetOwnerCameraTarget( const idVec3& Origin, const idMat3& Axis, int iInterpFlags );
         void				LinkClip( const idVec3& Origin, const idMat3& Axis );
 		virtual idVec3		DetermineJumpVelocity();
 		void				BuildWallwalkTraceOriginTable( const idMat3& Axis );
-		void				PerformGroundTrace( trace_t& TraceInfo, const idVec3& Start );
+		void				PerformGroundTraces( trace_t TraceInfo[ c_iNumWallwalkTraces ] );
+		int					FindWallwalkSurface( idVec3& Normal );
+		bool				TestWallwalkPatch( int& iHitIndex, idVec3& Normal );
+		void				BuildWallwalkPatch( void );
+		bool				WallwalkProbesTouchEntities( void ) const;
 	
 		bool				EvaluateGroundTrace( const trace_t& TraceInfo );
 
@@ -294,7 +294,7 @@ idPhysics_RigidBody::TestIfAtRest
 */
 bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 	int i;
-	float gv;
+	float gv, stopSpeed;
 	idVec3 v, av, normal, point;
 	idMat3 inverseWorldInertiaTensor;
 	idFixedWinding contactWinding;
@@ -343,6 +343,12 @@ bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 		return false;
 	}
 
+	// bodies at the reduced level of detail come to rest sooner
+	stopSpeed = STOP_SPEED;
+	if ( reducedLOD ) {
+		stopSpeed *= g_physicsLODRestScale.GetFloat();
+	}
+
 	// linear velocity of body
 	v = inverseMass * current.i.linearMomentum;
 	// linear velocity in gravity direction
@@ -351,11 +357,11 @@ bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 	v -= gv * gravityNormal;
 
 	// if too much velocity orthogonal to gravity direction
-	if ( v.Length() > STOP_SPEED ) {
+	if ( v.Length() > stopSpeed ) {
 		return false;
 	}
 	// if too much velocity in gravity direction
-	if ( gv > 2.0f * STOP_SPEED || gv < -2.0f * STOP_SPEED ) {
+	if ( gv > 2.0f * stopSpeed || gv < -2.0f * stopSpeed ) {
 		return false;
 	}
 
@@ -364,7 +370,7 @@ bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 	av = inverseWorldInertiaTensor * current.i.angularMomentum;
 
 	// if too much rotational velocity
-	if ( av.LengthSqr() > STOP_SPEED ) {
+	if ( av.LengthSqr() > stopSpeed ) {
 		return false;
 	}
 
@@ -495,6 +501,13 @@ idPhysics_RigidBody::idPhysics_RigidBody( void ) {
 	hasMaster = false;
 	isOrientated = false;
 
+	reducedLOD = false;
+	lodSkippedTime = 0;
+
+	interpolate = false;
+	interpolateOrigin.Zero();
+	interpolateAxis.Identity();
+
 #ifdef RB_TIMINGS
 	lastTimerReset = 0;
 #endif
@@ -614,6 +627,10 @@ void idPhysics_RigidBody::Restore( idRestoreGame *savefile ) {
 
 	savefile->ReadBool( hasMaster );
 	savefile->ReadBool( isOrientated );
+
+	reducedLOD = false;
+	lodSkippedTime = 0;
+	interpolate = false;
 }
 
 /*
@@ -753,6 +770,18 @@ void idPhysics_RigidBody::Rest( void ) {
 	self->BecomeInactive( TH_PHYSICS );
 }
 
+/*
+================
+idPhysics_RigidBody::SetReducedLOD
+================
+*/
+void idPhysics_RigidBody::SetReducedLOD( bool reduced ) {
+	if ( reduced != reducedLOD ) {
+		reducedLOD = reduced;
+		lodSkippedTime = 0;
+	}
+}
+
 /*
 ================
 idPhysics_RigidBody::DropToFloor
@@ -859,15 +888,11 @@ idPhysics_RigidBody::Evaluate
 bool idPhysics_RigidBody::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	PROFILE_SCOPE("RigidBody", PROFMASK_PHYSICS);
 
-	rigidBodyPState_t next;
-	idAngles angles;
-	trace_t collision;
-	idVec3 impulse;
-	idEntity *ent;
-	idVec3 oldOrigin, masterOrigin;
+	idVec3 oldOrigin, masterOrigin, force, torque;
 	idMat3 oldAxis, masterAxis;
 	float timeStep;
-	bool collided, cameToRest = false;
+	int i, numSteps;
+	bool moved;
 
 	timeStep = MS2SEC( timeStepMSec );
 	current.lastTimeStep = timeStep;
@@ -888,6 +913,7 @@ bool idPhysics_RigidBody::Evaluate( int timeStepMSec, int endTimeMSec ) {
 		current.i.angularMomentum = inertiaTensor * ( ( current.i.orientation * oldAxis.Transpose() ).ToAngularVelocity() / timeStep );
 		current.externalForce.Zero();
 		current.externalTorque.Zero();
+		interpolate = false;
 
 		return ( current.i.position != oldOrigin || current.i.orientation != oldAxis );
 	}
@@ -906,6 +932,68 @@ bool idPhysics_RigidBody::Evaluate( int timeStepMSec, int endTimeMSec ) {
 		return true;
 	}
 
+	// bodies at the reduced level of detail skip frames and take one larger step
+	if ( reducedLOD ) {
+		lodSkippedTime += timeStepMSec;
+		if ( lodSkippedTime < g_physicsLODUpdateTime.GetInteger() ) {
+			// only the forces of the last frame are applied over the larger step
+			current.externalForce.Zero();
+			current.externalTorque.Zero();
+			return false;
+		}
+		timeStepMSec = lodSkippedTime;
+		timeStep = MS2SEC( lodSkippedTime );
+		current.lastTimeStep = timeStep;
+		lodSkippedTime = 0;
+	}
+
+	// bodies with their own step time take as many fixed steps as fit in the elapsed time
+	numSteps = 1;
+	if ( stepTime > 0 ) {
+		numSteps = ScheduleSteps( timeStepMSec );
+		timeStep = MS2SEC( stepTime );
+		if ( numSteps == 0 ) {
+			// only the forces of the last frame are applied over the next step
+			current.externalForce.Zero();
+			current.externalTorque.Zero();
+			// the rendered position moves on towards the last step
+			return interpolate;
+		}
+	}
+
+	// the external forces apply to every step
+	force = current.externalForce;
+	torque = current.externalTorque;
+
+	moved = false;
+	for ( i = 0; i < numSteps && current.atRest < 0; i++ ) {
+		interpolateOrigin = current.i.position;
+		interpolateAxis = current.i.orientation;
+		current.externalForce = force;
+		current.externalTorque = torque;
+		moved |= EvaluateStep( timeStep, endTimeMSec );
+	}
+
+	// interpolate the rendered position when stepping slower than the game
+	interpolate = ( stepTime > gameLocal.msec && current.atRest < 0 );
+
+	return moved;
+}
+
+/*
+================
+idPhysics_RigidBody::EvaluateStep
+
+  Takes a single step of the rigid body physics.
+================
+*/
+bool idPhysics_RigidBody::EvaluateStep( float timeStep, int endTimeMSec ) {
+	rigidBodyPState_t next;
+	trace_t collision;
+	idVec3 impulse;
+	idEntity *ent;
+	bool collided, cameToRest = false;
+
 #ifdef RB_TIMINGS
 	timer_total.Start();
 #endif
@@ -1036,6 +1124,25 @@ bool idPhysics_RigidBody::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	return true;
 }
 
+/*
+================
+idPhysics_RigidBody::GetInterpolatedTransform
+================
+*/
+bool idPhysics_RigidBody::GetInterpolatedTransform( idVec3 &origin, idMat3 &axis ) const {
+	idQuat q;
+	float f;
+
+	if ( !interpolate ) {
+		return false;
+	}
+
+	f = GetStepFraction();
+	origin.Lerp( interpolateOrigin, current.i.position, f );
+	axis = q.Slerp( interpolateAxis.ToQuat(), current.i.orientation.ToQuat(), f ).ToMat3();
+	return true;
+}
+
 /*
 ================
 idPhysics_RigidBody::UpdateTime
@@ -1163,6 +1270,8 @@ void idPhysics_RigidBody::SetOrigin( const idVec3 &newOrigin, int id ) {
 	idVec3 masterOrigin;
 	idMat3 masterAxis;
 
+	interpolate = false;
+
 	current.localOrigin = newOrigin;
 	if ( hasMaster ) {
 		self->GetMasterPosition( masterOrigin, masterAxis );
@@ -1186,6 +1295,8 @@ void idPhysics_RigidBody::SetAxis( const idMat3 &newAxis, int id ) {
 	idVec3 masterOrigin;
 	idMat3 masterAxis;
 
+	interpolate = false;
+
 	current.localAxis = newAxis;
 	if ( hasMaster && isOrientated ) {
 		self->GetMasterPosition( masterOrigin, masterAxis );
@@ -1207,6 +1318,7 @@ idPhysics::Move
 */
 void idPhysics_RigidBody::Translate( const idVec3 &translation, int id ) {
 
+	interpolate = false;
 	current.localOrigin += translation;
 	current.i.position += translation;
 
@@ -1224,6 +1336,8 @@ void idPhysics_RigidBody::Rotate( const idRotation &rotation, int id ) {
 	idVec3 masterOrigin;
 	idMat3 masterAxis;
 
+	interpolate = false;
+
 	current.i.orientation *= rotation.ToMat3();
 	current.i.position *= rotation;
 
@@ -60,6 +60,9 @@ public:
 							// enable/disable activation by impact
 	void					EnableImpact( void );
 	void					DisableImpact( void );
+							// lower update rate and looser rest tolerances for bodies far away or out of view
+	void					SetReducedLOD( bool reduced );
+	bool					IsReducedLOD( void ) const { return reducedLOD; }
 
 public:	// common physics interface
 	void					SetClipModel( idClipModel *model, float density, int id = 0, bool freeOld = true );
@@ -77,6 +80,7 @@ public:	// common physics interface
 
 	bool					Evaluate( int timeStepMSec, int endTimeMSec );
 	void					UpdateTime( int endTimeMSec );
+	bool					GetInterpolatedTransform( idVec3 &origin, idMat3 &axis ) const;
 	int						GetTime( void ) const;
 
 	void					GetImpactInfo( const int id, const idVec3 &point, impactInfo_t *info ) const;
@@ -159,12 +163,22 @@ protected:	// HUMANHEAD
 	bool					hasMaster;
 	bool					isOrientated;
 
+	// level of detail
+	bool					reducedLOD;					// true if updated at the reduced rate
+	int						lodSkippedTime;				// msec of frames skipped since the last update
+
+	// interpolation between steps
+	bool					interpolate;				// true if the rendered position is interpolated
+	idVec3					interpolateOrigin;			// position before the last step
+	idMat3					interpolateAxis;			// orientation before the last step
+
 protected:	// HUMANHEAD
 	friend void				RigidBodyDerivatives( const float t, const void *clientData, const float *state, float *derivatives );
 	virtual	// HUMANHEAD: made virtual
 	void					Integrate( const float deltaTime, rigidBodyPState_t &next );
 	virtual	// HUMANHEAD: made virtual
 	bool					CheckForCollisions( const float deltaTime, rigidBodyPState_t &next, trace_t &collision );
+	bool					EvaluateStep( float timeStep, int endTimeMSec );
 	bool					CollisionImpulse( const trace_t &collision, idVec3 &impulse );
 	void					ContactFriction( float deltaTime );
 	void					DropToFloorAndRest( void );
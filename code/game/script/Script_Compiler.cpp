@@ -2083,6 +2083,274 @@ idTypeDef *idCompiler::ParseFunction( idTypeDef *returnType, const char *name )
 	return gameLocal.program.GetType( newtype, true );
 }
 
+/*
+============
+JumpTarget
+
+Returns the statement a jump goes to, or -1 if the statement isn't a jump
+============
+*/
+static int JumpTarget( const statement_t &st, int index ) {
+	switch( st.op ) {
+		case OP_IF:
+		case OP_IFNOT:
+			return index + st.b->value.jumpOffset;
+		case OP_GOTO:
+			return index + st.a->value.jumpOffset;
+	}
+	return -1;
+}
+
+/*
+============
+OverwritesDef
+
+Returns true if the statement sets def without reading it first
+============
+*/
+static bool OverwritesDef( const statement_t &st, const idVarDef *def ) {
+	const opcode_t *op = &idCompiler::opcodes[ st.op ];
+
+	if ( st.a == def ) {
+		return false;
+	}
+	if ( ( st.op >= OP_STORE_F ) && ( st.op <= OP_STORE_BOOLTOF ) ) {
+		return ( st.b == def );
+	}
+	if ( !op->rightAssociative && ( op->type_c != &def_void ) ) {
+		return ( st.b != def ) && ( st.c == def );
+	}
+	return false;
+}
+
+/*
+============
+CanForwardResult
+
+Returns true if the opcode reads all its operands before writing its result, so the result can
+go straight into a variable that is also one of the operands
+============
+*/
+static bool CanForwardResult( int op ) {
+	switch( op ) {
+		case OP_ADD_F:		case OP_ADD_V:		case OP_SUB_F:		case OP_SUB_V:
+		case OP_MUL_F:		case OP_MUL_V:		case OP_MUL_FV:		case OP_MUL_VF:
+		case OP_DIV_F:		case OP_MOD_F:		case OP_BITAND:		case OP_BITOR:
+		case OP_GE:			case OP_LE:			case OP_GT:			case OP_LT:
+		case OP_AND:		case OP_AND_BOOLF:	case OP_AND_FBOOL:	case OP_AND_BOOLBOOL:
+		case OP_OR:			case OP_OR_BOOLF:	case OP_OR_FBOOL:	case OP_OR_BOOLBOOL:
+		case OP_NOT_BOOL:	case OP_NOT_F:		case OP_NOT_V:		case OP_NOT_ENT:
+		case OP_NEG_F:		case OP_NEG_V:		case OP_INT_F:		case OP_COMP_F:
+		case OP_EQ_F:		case OP_EQ_V:		case OP_EQ_E:		case OP_EQ_EO:
+		case OP_EQ_OE:		case OP_EQ_OO:		case OP_NE_F:		case OP_NE_V:
+		case OP_NE_E:		case OP_NE_EO:		case OP_NE_OE:		case OP_NE_OO:
+		case OP_INDIRECT_F:	case OP_INDIRECT_V:	case OP_INDIRECT_ENT:	case OP_INDIRECT_BOOL:
+			return true;
+	}
+	return false;
+}
+
+/*
+============
+idCompiler::OptimizeFunction
+
+Cleans up the statements of the function that was just parsed.  Branches on constants are
+resolved, jumps to jumps are threaded, results that are only copied into a variable are written
+to it directly, and code that can't be reached is dropped.  The function is always the last one
+in the program, so the statements after it can be moved down and freed.
+============
+*/
+void idCompiler::OptimizeFunction( function_t *func ) {
+	int			first;
+	int			end;
+	int			i;
+	int			j;
+	int			k;
+	int			t;
+	int			num;
+	idList<int>	target;
+	idList<int>	remap;
+	idList<int>	stack;
+	idList<bool> removed;
+	idList<bool> jumpedTo;
+	idList<bool> reachable;
+
+	first = func->firstStatement;
+	end = gameLocal.program.NumStatements();
+	num = end - first;
+	if ( num <= 1 ) {
+		return;
+	}
+
+	// statements are indexed relative to the start of the function, jump targets are absolute
+	target.SetNum( num );
+	removed.SetNum( num );
+	for( i = 0; i < num; i++ ) {
+		target[ i ] = JumpTarget( gameLocal.program.GetStatement( first + i ), first + i );
+		removed[ i ] = false;
+	}
+
+	// resolve branches on constants
+	for( i = 0; i < num; i++ ) {
+		statement_t &st = gameLocal.program.GetStatement( first + i );
+		if ( ( ( st.op == OP_IF ) || ( st.op == OP_IFNOT ) ) && ( st.a->initialized == idVarDef::initializedConstant ) ) {
+			if ( ( *st.a->value.intPtr != 0 ) == ( st.op == OP_IF ) ) {
+				st.op = OP_GOTO;
+				st.b = NULL;
+			} else {
+				removed[ i ] = true;
+			}
+		}
+	}
+
+	// thread jumps through gotos, and drop the ones that go to the next statement
+	for( i = 0; i < num; i++ ) {
+		statement_t &st = gameLocal.program.GetStatement( first + i );
+		if ( removed[ i ] || ( target[ i ] < 0 ) ) {
+			continue;
+		}
+
+		t = target[ i ];
+		for( j = 0; j < 32; j++ ) {
+			while( ( t >= first ) && ( t < end ) && removed[ t - first ] ) {
+				t++;
+			}
+			if ( ( t < first ) || ( t >= end ) || ( t == first + i ) || ( gameLocal.program.GetStatement( t ).op != OP_GOTO ) ) {
+				break;
+			}
+			t = target[ t - first ];
+		}
+		target[ i ] = t;
+
+		if ( ( st.op == OP_GOTO ) && ( t >= first ) && ( t < end ) && ( gameLocal.program.GetStatement( t ).op == OP_RETURN ) ) {
+			st.op = OP_RETURN;
+			st.a = gameLocal.program.GetStatement( t ).a;
+			target[ i ] = -1;
+			continue;
+		}
+
+		for( k = i + 1; ( k < num ) && removed[ k ]; k++ ) {
+		}
+		if ( first + k == t ) {
+			removed[ i ] = true;
+		}
+	}
+
+	jumpedTo.SetNum( num );
+	memset( jumpedTo.Ptr(), 0, num * sizeof( bool ) );
+	for( i = 0; i < num; i++ ) {
+		if ( !removed[ i ] && ( target[ i ] >= first ) && ( target[ i ] < end ) ) {
+			jumpedTo[ target[ i ] - first ] = true;
+		}
+	}
+
+	// write results straight into the variable when the temp is only used to copy it there
+	for( i = 0; i < num - 1; i++ ) {
+		statement_t &st = gameLocal.program.GetStatement( first + i );
+		statement_t &store = gameLocal.program.GetStatement( first + i + 1 );
+		if ( removed[ i ] || removed[ i + 1 ] || jumpedTo[ i + 1 ] || !CanForwardResult( st.op ) ) {
+			continue;
+		}
+		if ( ( store.op != OP_STORE_F ) && ( store.op != OP_STORE_V ) && ( store.op != OP_STORE_ENT ) && ( store.op != OP_STORE_BOOL ) ) {
+			continue;
+		}
+		if ( ( store.a != st.c ) || ( store.b == st.c ) || ( store.b->Type() != st.c->Type() ) ) {
+			continue;
+		}
+		if ( ( st.c->initialized != idVarDef::stackVariable ) || strcmp( st.c->Name(), RESULT_STRING ) ) {
+			continue;
+		}
+
+		// the temp has to be dead after the copy, follow the code up to the next jump
+		for( k = i + 2; k < num; k++ ) {
+			const statement_t &next = gameLocal.program.GetStatement( first + k );
+			if ( removed[ k ] ) {
+				continue;
+			}
+			if ( OverwritesDef( next, st.c ) ) {
+				break;
+			}
+			if ( ( next.a == st.c ) || ( next.b == st.c ) || ( next.c == st.c ) || ( target[ k ] >= 0 ) ) {
+				k = -1;
+				break;
+			}
+			if ( next.op == OP_RETURN ) {
+				break;
+			}
+		}
+		if ( ( k < 0 ) || ( k >= num ) ) {
+			continue;
+		}
+
+		st.c = store.b;
+		removed[ i + 1 ] = true;
+	}
+
+	// drop the code that can't be reached, but always keep the closing return
+	reachable.SetNum( num );
+	memset( reachable.Ptr(), 0, num * sizeof( bool ) );
+	stack.Append( 0 );
+	while( stack.Num() ) {
+		i = stack[ stack.Num() - 1 ];
+		stack.RemoveIndex( stack.Num() - 1 );
+		if ( ( i < 0 ) || ( i >= num ) || reachable[ i ] ) {
+			continue;
+		}
+		reachable[ i ] = true;
+
+		const statement_t &st = gameLocal.program.GetStatement( first + i );
+		if ( removed[ i ] ) {
+			stack.Append( i + 1 );
+		} else if ( st.op == OP_GOTO ) {
+			stack.Append( target[ i ] - first );
+		} else if ( st.op != OP_RETURN ) {
+			stack.Append( i + 1 );
+			if ( target[ i ] >= 0 ) {
+				stack.Append( target[ i ] - first );
+			}
+		}
+	}
+	for( i = 0; i < num - 1; i++ ) {
+		if ( !reachable[ i ] ) {
+			removed[ i ] = true;
+		}
+	}
+
+	// a removed statement moves to the next one that is kept
+	remap.SetNum( num + 1 );
+	for( i = 0, j = 0; i < num; i++ ) {
+		if ( !removed[ i ] ) {
+			remap[ i ] = j++;
+		}
+	}
+	remap[ num ] = j;
+	for( i = num - 1; i >= 0; i-- ) {
+		if ( removed[ i ] ) {
+			remap[ i ] = remap[ i + 1 ];
+		}
+	}
+
+	for( i = 0; i < num; i++ ) {
+		statement_t &st = gameLocal.program.GetStatement( first + i );
+		if ( removed[ i ] ) {
+			continue;
+		}
+		if ( target[ i ] >= 0 ) {
+			idVarDef *jump = JumpConstant( remap[ idMath::ClampInt( 0, num, target[ i ] - first ) ] - remap[ i ] );
+			if ( st.op == OP_GOTO ) {
+				st.a = jump;
+			} else {
+				st.b = jump;
+			}
+		}
+		if ( remap[ i ] != i ) {
+			gameLocal.program.GetStatement( first + remap[ i ] ) = st;
+		}
+	}
+
+	gameLocal.program.FreeStatements( first + remap[ num ] );
+}
+
 /*
 ================
 idCompiler::ParseFunctionDef
@@ -2229,6 +2497,10 @@ void idCompiler::ParseFunctionDef( idTypeDef *returnType, const char *name ) {
 #endif
 
 	// record the number of statements in the function
+	func->numUnoptimizedStatements = gameLocal.program.NumStatements() - func->firstStatement;
+	if ( g_scriptOptimize.GetBool() ) {
+		OptimizeFunction( func );
+	}
 	func->numStatements = gameLocal.program.NumStatements() - func->firstStatement;
 
 	scope = oldscope;
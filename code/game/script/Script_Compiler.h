@@ -169,6 +169,23 @@ enum {
 	NUM_OPCODES
 };
 
+// superinstructions only found in the threaded code built by idProgram::DecodeStatements.
+// each one executes its statement and the one following it.
+enum {
+	OP_EQ_F_IFNOT = NUM_OPCODES,
+	OP_NE_F_IFNOT,
+	OP_LT_IFNOT,
+	OP_LE_IFNOT,
+	OP_GT_IFNOT,
+	OP_GE_IFNOT,
+	OP_ADDRESS_STOREP_F,
+	OP_ADDRESS_STOREP_V,
+	OP_ADDRESS_STOREP_INT,		// OP_STOREP_ENT, OP_STOREP_FLD, OP_STOREP_BOOL and OP_STOREP_OBJ
+	OP_INDIRECT_PUSH,			// 4 byte OP_INDIRECT_* followed by a 4 byte OP_PUSH_* of the result
+
+	NUM_THREADED_OPCODES
+};
+
 class idCompiler {
 private:
 	static bool		punctuationValid[ 256 ];
@@ -237,6 +254,7 @@ private:
 	void			ParseStatement( void );
 	void			ParseObjectDef( const char *objname );
 	idTypeDef		*ParseFunction( idTypeDef *returnType, const char *name );
+	void			OptimizeFunction( function_t *func );
 	void			ParseFunctionDef( idTypeDef *returnType, const char *name );
 	void			ParseVariableDef( idTypeDef *type, const char *name );
 	void			ParseEventDef( idTypeDef *type, const char *name );
@@ -6,6 +6,9 @@
 
 #include "../Game_local.h"
 
+// scriptBenchmark stops a function after this many statements instead of erroring
+#define BENCHMARK_RUNAWAY	100000
+
 /*
 ================
 idInterpreter::idInterpreter()
@@ -15,6 +18,12 @@ idInterpreter::idInterpreter() {
 	localstackUsed = 0;
 	terminateOnExit = true;
 	debug = 0;
+	instructionCount = 0;
+	benchmarking = false;
+	benchmarkRunaway = false;
+	profiling = false;
+	profileGeneration = 0;
+	profileTicks = 0.0;
 	memset( localstack, 0, sizeof( localstack ) );
 	memset( callStack, 0, sizeof( callStack ) );
 	Reset();
@@ -142,11 +151,15 @@ void idInterpreter::Reset( void ) {
 	multiFrameEvent = NULL;
 	eventEntity = NULL;
 
+	profileNode = -1;
+
 	currentFunction = 0;
 	NextInstruction( 0 );
 
 	threadDying 	= false;
 	doneProcessing	= true;
+	nativeSwitch	= false;
+	interpreting	= false;
 }
 
 /*
@@ -440,6 +453,10 @@ void idInterpreter::Warning( char *fmt, ... ) const {
 	va_list argptr;
 	char	text[ 1024 ];
 
+	if ( benchmarking ) {
+		return;
+	}
+
 	va_start( argptr, fmt );
 	vsprintf( text, fmt, argptr );
 	va_end( argptr );
@@ -524,6 +541,7 @@ void idInterpreter::EnterObjectFunction( idEntity *self, const function_t *func,
 		PopParms( popParms );
 		popParms = 0;
 	}
+	self->scriptHandle = true;
 	Push( self->entityNumber + 1 );
 	EnterFunction( func, false );
 }
@@ -549,6 +567,14 @@ void idInterpreter::EnterFunction( const function_t *func, bool clearStack ) {
 		popParms = 0;
 	}
 
+	if ( func && g_scriptProfile.GetBool() ) {
+		if ( profiling ) {
+			AddProfileTime();
+		}
+		profileNode = scriptProfiler.GetNode( GetProfileNode(), func );
+		scriptProfiler.GetNode( profileNode ).calls++;
+	}
+
 	if ( callStackDepth >= MAX_STACK_DEPTH ) {
 		Error( "call stack overflow" );
 	}
@@ -599,6 +625,8 @@ void idInterpreter::EnterFunction( const function_t *func, bool clearStack ) {
 	if ( localstackUsed > maxLocalstackUsed ) {
 		maxLocalstackUsed = localstackUsed ;
 	}
+
+	CheckNativeSwitch();
 }
 
 /*
@@ -614,6 +642,13 @@ void idInterpreter::LeaveFunction( idVarDef *returnDef ) {
 		Error( "prog stack underflow" );
 	}
 
+	if ( profileNode >= 0 ) {
+		if ( profiling ) {
+			AddProfileTime();
+		}
+		profileNode = scriptProfiler.GetParent( GetProfileNode() );
+	}
+
 	// return value
 	if ( returnDef ) {
 		switch( returnDef->Type() ) {
@@ -658,7 +693,78 @@ void idInterpreter::LeaveFunction( idVarDef *returnDef ) {
 		doneProcessing = true;
 		threadDying = true;
 		currentFunction = 0;
+	} else {
+		CheckNativeSwitch();
+	}
+}
+
+/*
+====================
+idInterpreter::CheckNativeSwitch
+
+The interpreter loops don't look for native code, so they stop when a function with native
+code is entered or returned to and Execute continues with ExecuteNative.
+====================
+*/
+void idInterpreter::CheckNativeSwitch( void ) {
+	if ( interpreting && currentFunction->nativeFunc && !doneProcessing ) {
+		doneProcessing = true;
+		nativeSwitch = true;
+	}
+}
+
+/*
+================
+idInterpreter::MarshalEventArgs
+
+Copies the args of an event call from the stack.  Script parms are laid out with the same
+sizes as the event data, so the arg offsets of the event def are also the stack offsets.
+Returns false if an entity arg that can't be NULL was not found.
+================
+*/
+bool idInterpreter::MarshalEventArgs( const idEventDef *evdef, int start, intptr_t data[ D_EVENT_MAXARGS ] ) {
+	const byte			*group;
+	const byte			*stack;
+	int					i;
+	int					num;
+
+	stack = &localstack[ start ];
+
+	group = evdef->GetArgGroup( EVENT_ARGGROUP_INTEGER, num );
+	for( i = 0; i < num; i++ ) {
+		*( int * )&data[ group[ i ] ] = int( *( const float * )&stack[ evdef->GetArgOffset( group[ i ] ) ] );
 	}
+
+	group = evdef->GetArgGroup( EVENT_ARGGROUP_FLOAT, num );
+	for( i = 0; i < num; i++ ) {
+		*( float * )&data[ group[ i ] ] = *( const float * )&stack[ evdef->GetArgOffset( group[ i ] ) ];
+	}
+
+	group = evdef->GetArgGroup( EVENT_ARGGROUP_POINTER, num );
+	for( i = 0; i < num; i++ ) {
+		*( const byte ** )&data[ group[ i ] ] = &stack[ evdef->GetArgOffset( group[ i ] ) ];
+	}
+
+	group = evdef->GetArgGroup( EVENT_ARGGROUP_ENTITY_NULL, num );
+	for( i = 0; i < num; i++ ) {
+		*( idEntity ** )&data[ group[ i ] ] = GetEntity( *( const int * )&stack[ evdef->GetArgOffset( group[ i ] ) ] );
+	}
+
+	group = evdef->GetArgGroup( EVENT_ARGGROUP_TRACE, num );
+	if ( num ) {
+		Error( "trace type not supported from script for '%s' event.", evdef->GetName() );
+	}
+
+	group = evdef->GetArgGroup( EVENT_ARGGROUP_ENTITY, num );
+	for( i = 0; i < num; i++ ) {
+		*( idEntity ** )&data[ group[ i ] ] = GetEntity( *( const int * )&stack[ evdef->GetArgOffset( group[ i ] ) ] );
+		if ( !*( idEntity ** )&data[ group[ i ] ] ) {
+			Warning( "Entity not found for event '%s'. Terminating thread.", evdef->GetName() );
+			return false;
+		}
+	}
+
+	return true;
 }
 
 /*
@@ -667,16 +773,12 @@ idInterpreter::CallEvent
 ================
 */
 void idInterpreter::CallEvent( const function_t *func, int argsize ) {
-	int 				i;
-	int					j;
 	varEval_t			var;
-	int 				pos;
 	int 				start;
 	// RB: 64 bit fixes, changed int to intptr_t
 	intptr_t			data[D_EVENT_MAXARGS];
 	// RB end
 	const idEventDef	*evdef;
-	const char			*format;
 
 	if ( !func ) {
 		Error( "NULL function" );
@@ -741,63 +843,21 @@ void idInterpreter::CallEvent( const function_t *func, int argsize ) {
 		return;
 	}
 
-	format = evdef->GetArgFormat();
-	for( j = 0, i = 0, pos = type_object.Size(); ( pos < argsize ) || ( format[ i ] != 0 ); i++ ) {
-		switch( format[ i ] ) {
-		case D_EVENT_INTEGER :
-			var.intPtr = (int*)&localstack[start + pos];
-			// RB: fixed data alignment	
-			//data[ i ] = int( *var.floatPtr );	
-			(*(int*)&data[i]) = int(*var.floatPtr);
-			// RB end
-			break;
-
-		case D_EVENT_FLOAT :
-			var.intPtr = ( int * )&localstack[ start + pos ];
-			( *( float * )&data[ i ] ) = *var.floatPtr;
-			static float value;
-			value = (*(float*)&data[i]);
-			break;
-
-		case D_EVENT_VECTOR :
-			var.intPtr = ( int * )&localstack[ start + pos ];
-			( *( idVec3 ** )&data[ i ] ) = var.vectorPtr;
-			break;
-
-		case D_EVENT_STRING :
-			( *( const char ** )&data[ i ] ) = ( char * )&localstack[ start + pos ];
-			break;
-
-		case D_EVENT_ENTITY :
-			var.intPtr = ( int * )&localstack[ start + pos ];
-			( *( idEntity ** )&data[ i ] ) = GetEntity( *var.entityNumberPtr );
-			if ( !( *( idEntity ** )&data[ i ] ) ) {
-				Warning( "Entity not found for event '%s'. Terminating thread.", evdef->GetName() );
-				threadDying = true;
-				PopParms( argsize );
-				return;
-			}
-			break;
-
-		case D_EVENT_ENTITY_NULL :
-			var.intPtr = ( int * )&localstack[ start + pos ];
-			( *( idEntity ** )&data[ i ] ) = GetEntity( *var.entityNumberPtr );
-			break;
-
-		case D_EVENT_TRACE :
-			Error( "trace type not supported from script for '%s' event.", evdef->GetName() );
-			break;
-
-		default :
-			Error( "Invalid arg format string for '%s' event.", evdef->GetName() );
-			break;
-		}
-
-		pos += func->parmSize[ j++ ];
+	assert( argsize == type_object.Size() + func->parmTotal );
+	if ( !MarshalEventArgs( evdef, start + type_object.Size(), data ) ) {
+		threadDying = true;
+		PopParms( argsize );
+		return;
 	}
 
 	popParms = argsize;
-	eventEntity->ProcessEventArgPtr( evdef, data );
+	if ( profiling ) {
+		double start = idLib::sys->GetClockTicks();
+		eventEntity->ProcessEventArgPtr( evdef, data );
+		scriptProfiler.AddEventTime( evdef, idLib::sys->GetClockTicks() - start );
+	} else {
+		eventEntity->ProcessEventArgPtr( evdef, data );
+	}
 
 	if ( !multiFrameEvent ) {
 		if ( popParms ) {
@@ -806,6 +866,7 @@ void idInterpreter::CallEvent( const function_t *func, int argsize ) {
 		eventEntity = NULL;
 	} else {
 		doneProcessing = true;
+		nativeSwitch = false;
 	}
 	popParms = 0;
 }
@@ -875,16 +936,11 @@ idInterpreter::CallSysEvent
 ================
 */
 void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
-	int 				i;
-	int					j;
-	varEval_t			source;
-	int 				pos;
 	int 				start;
 	// RB: 64 bit fixes, changed int to intptr_t
 	intptr_t			data[D_EVENT_MAXARGS];
 	// RB end
 	const idEventDef	*evdef;
-	const char			*format;
 
 	if ( !func ) {
 		Error( "NULL function" );
@@ -895,60 +951,23 @@ void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
 
 	start = localstackUsed - argsize;
 
-	format = evdef->GetArgFormat();
-	for( j = 0, i = 0, pos = 0; ( pos < argsize ) || ( format[ i ] != 0 ); i++ ) {
-		switch( format[ i ] ) {
-		case D_EVENT_INTEGER :
-			source.intPtr = ( int * )&localstack[ start + pos ];
-			*( int * )&data[ i ] = int( *source.floatPtr );
-			break;
-
-		case D_EVENT_FLOAT :
-			source.intPtr = ( int * )&localstack[ start + pos ];
-			*( float * )&data[ i ] = *source.floatPtr;
-			break;
-
-		case D_EVENT_VECTOR :
-			source.intPtr = ( int * )&localstack[ start + pos ];
-			*( idVec3 ** )&data[ i ] = source.vectorPtr;
-			break;
-
-		case D_EVENT_STRING :
-			*( const char ** )&data[ i ] = ( char * )&localstack[ start + pos ];
-			break;
-
-		case D_EVENT_ENTITY :
-			source.intPtr = ( int * )&localstack[ start + pos ];
-			*( idEntity ** )&data[ i ] = GetEntity( *source.entityNumberPtr );
-			if ( !*( idEntity ** )&data[ i ] ) {
-				Warning( "Entity not found for event '%s'. Terminating thread.", evdef->GetName() );
-				// HUMANHEAD pdm: Do we want let the thread run here for safety?  That way a missing / removed entity
-				// getting a sys function called on it (eg sys.trigger) won't end the whole thread.  Currently, no change made.
-				threadDying = true;
-				PopParms( argsize );
-				return;
-			}
-			break;
-
-		case D_EVENT_ENTITY_NULL :
-			source.intPtr = ( int * )&localstack[ start + pos ];
-			*( idEntity ** )&data[ i ] = GetEntity( *source.entityNumberPtr );
-			break;
-
-		case D_EVENT_TRACE :
-			Error( "trace type not supported from script for '%s' event.", evdef->GetName() );
-			break;
-
-		default :
-			Error( "Invalid arg format string for '%s' event.", evdef->GetName() );
-			break;
-		}
-
-		pos += func->parmSize[ j++ ];
+	assert( argsize == func->parmTotal );
+	if ( !MarshalEventArgs( evdef, start, data ) ) {
+		// HUMANHEAD pdm: Do we want let the thread run here for safety?  That way a missing / removed entity
+		// getting a sys function called on it (eg sys.trigger) won't end the whole thread.  Currently, no change made.
+		threadDying = true;
+		PopParms( argsize );
+		return;
 	}
 
 	popParms = argsize;
-	thread->ProcessEventArgPtr( evdef, data );
+	if ( profiling ) {
+		double start = idLib::sys->GetClockTicks();
+		thread->ProcessEventArgPtr( evdef, data );
+		scriptProfiler.AddEventTime( evdef, idLib::sys->GetClockTicks() - start );
+	} else {
+		thread->ProcessEventArgPtr( evdef, data );
+	}
 	if ( popParms ) {
 		PopParms( popParms );
 	}
@@ -961,1075 +980,2272 @@ void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
 
 /*
 ====================
-idInterpreter::Execute
+idInterpreter::ExecuteStatement
 ====================
 */
-bool idInterpreter::Execute( void ) {
+template< bool benchmark >
+void idInterpreter::ExecuteStatement( statement_t *st ) {
 	varEval_t	var_a;
 	varEval_t	var_b;
 	varEval_t	var_c;
 	varEval_t	var;
-	statement_t	*st;
-	int 		runaway;
 	idThread	*newThread;
 	float		floatVal;
 	idScriptObject *obj;
 	const function_t *func;
 
-	PROFILE_SCOPE("Scripting", PROFMASK_NORMAL);		// HUMANHEAD pdm
-
-	if ( threadDying || !currentFunction ) {
-		return true;
-	}
-
-	if ( multiFrameEvent ) {
-		// move to previous instruction and call it again
-		instructionPointer--;
-	}
-
-	runaway = 5000000;
-
-	doneProcessing = false;
-	while( !doneProcessing && !threadDying ) {
-		instructionPointer++;
+	switch( st->op ) {
+	case OP_RETURN:
+		LeaveFunction( st->a );
+		break;
 
-		if ( !--runaway ) {
-			Error( "runaway loop error" );
+	case OP_THREAD:
+		if ( benchmark ) {
+			BenchmarkCall( st->b->value.argSize );
+			break;
 		}
+		newThread = new idThread( this, st->a->value.functionPtr, st->b->value.argSize );
+		newThread->Start();
 
-		// next statement
-		st = &gameLocal.program.GetStatement( instructionPointer );
+		// return the thread number to the script
+		gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
+		PopParms( st->b->value.argSize );
+		break;
 
-		switch( st->op ) {
-		case OP_RETURN:
-			LeaveFunction( st->a );
+	case OP_OBJTHREAD:
+		if ( benchmark ) {
+			BenchmarkCall( st->c->value.argSize );
 			break;
-
-		case OP_THREAD:
-			newThread = new idThread( this, st->a->value.functionPtr, st->b->value.argSize );
+		}
+		var_a = GetVariable( st->a );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
+			assert( st->c->value.argSize == func->parmTotal );
+			newThread = new idThread( this, GetEntity( *var_a.entityNumberPtr ), func, func->parmTotal );
 			newThread->Start();
 
 			// return the thread number to the script
 			gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
-			PopParms( st->b->value.argSize );
-			break;
-
-		case OP_OBJTHREAD:
-			var_a = GetVariable( st->a );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
-				assert( st->c->value.argSize == func->parmTotal );
-				newThread = new idThread( this, GetEntity( *var_a.entityNumberPtr ), func, func->parmTotal );
-				newThread->Start();
-
-				// return the thread number to the script
-				gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
-			} else {
-				// return a null thread to the script
-				gameLocal.program.ReturnFloat( 0.0f );
-			}
-			PopParms( st->c->value.argSize );
-			break;
+		} else {
+			// return a null thread to the script
+			gameLocal.program.ReturnFloat( 0.0f );
+		}
+		PopParms( st->c->value.argSize );
+		break;
 
-		case OP_CALL:
-			EnterFunction( st->a->value.functionPtr, false );
+	case OP_CALL:
+		if ( benchmark ) {
+			BenchmarkCall( st->a->value.functionPtr->parmTotal );
 			break;
+		}
+		EnterFunction( st->a->value.functionPtr, false );
+		break;
 
-		case OP_EVENTCALL:
-			CallEvent( st->a->value.functionPtr, st->b->value.argSize );
+	case OP_EVENTCALL:
+		if ( benchmark ) {
+			BenchmarkCall( st->b->value.argSize );
 			break;
+		}
+		CallEvent( st->a->value.functionPtr, st->b->value.argSize );
+		break;
 
-		case OP_OBJECTCALL:	
-			var_a = GetVariable( st->a );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
-				EnterFunction( func, false );
-			} else {
-				// return a 'safe' value
-				gameLocal.program.ReturnVector( vec3_zero );
-				gameLocal.program.ReturnString( "" );
-				PopParms( st->c->value.argSize );
-			}
+	case OP_OBJECTCALL:	
+		if ( benchmark ) {
+			BenchmarkCall( st->c->value.argSize );
 			break;
+		}
+		var_a = GetVariable( st->a );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
+			EnterFunction( func, false );
+		} else {
+			// return a 'safe' value
+			gameLocal.program.ReturnVector( vec3_zero );
+			gameLocal.program.ReturnString( "" );
+			PopParms( st->c->value.argSize );
+		}
+		break;
 
-		case OP_SYSCALL:
-			CallSysEvent( st->a->value.functionPtr, st->b->value.argSize );
+	case OP_SYSCALL:
+		if ( benchmark ) {
+			BenchmarkCall( st->b->value.argSize );
 			break;
+		}
+		CallSysEvent( st->a->value.functionPtr, st->b->value.argSize );
+		break;
 
-		case OP_IFNOT:
-			var_a = GetVariable( st->a );
-			if ( *var_a.intPtr == 0 ) {
-				NextInstruction( instructionPointer + st->b->value.jumpOffset );
-			}
-			break;
+	case OP_IFNOT:
+		var_a = GetVariable( st->a );
+		if ( *var_a.intPtr == 0 ) {
+			NextInstruction( instructionPointer + st->b->value.jumpOffset );
+		}
+		break;
 
-		case OP_IF:
-			var_a = GetVariable( st->a );
-			if ( *var_a.intPtr != 0 ) {
-				NextInstruction( instructionPointer + st->b->value.jumpOffset );
-			}
-			break;
+	case OP_IF:
+		var_a = GetVariable( st->a );
+		if ( *var_a.intPtr != 0 ) {
+			NextInstruction( instructionPointer + st->b->value.jumpOffset );
+		}
+		break;
 
-		case OP_GOTO:
-			NextInstruction( instructionPointer + st->a->value.jumpOffset );
-			break;
+	case OP_GOTO:
+		NextInstruction( instructionPointer + st->a->value.jumpOffset );
+		break;
 
-		case OP_ADD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
-			//HUMANHEAD rww - float debugging
+	case OP_ADD_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_ADD_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
-			//HUMANHEAD rww - float debugging
+	case OP_ADD_V:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(var_a.vectorPtr->x));
-			assert(!FLOAT_IS_INVALID(var_a.vectorPtr->y));
-			assert(!FLOAT_IS_INVALID(var_a.vectorPtr->z));
-			assert(!FLOAT_IS_INVALID(var_b.vectorPtr->x));
-			assert(!FLOAT_IS_INVALID(var_b.vectorPtr->y));
-			assert(!FLOAT_IS_INVALID(var_b.vectorPtr->z));
-			assert(!FLOAT_IS_INVALID(var_c.vectorPtr->x));
-			assert(!FLOAT_IS_INVALID(var_c.vectorPtr->y));
-			assert(!FLOAT_IS_INVALID(var_c.vectorPtr->z));
+		assert(!FLOAT_IS_INVALID(var_a.vectorPtr->x));
+		assert(!FLOAT_IS_INVALID(var_a.vectorPtr->y));
+		assert(!FLOAT_IS_INVALID(var_a.vectorPtr->z));
+		assert(!FLOAT_IS_INVALID(var_b.vectorPtr->x));
+		assert(!FLOAT_IS_INVALID(var_b.vectorPtr->y));
+		assert(!FLOAT_IS_INVALID(var_b.vectorPtr->z));
+		assert(!FLOAT_IS_INVALID(var_c.vectorPtr->x));
+		assert(!FLOAT_IS_INVALID(var_c.vectorPtr->y));
+		assert(!FLOAT_IS_INVALID(var_c.vectorPtr->z));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_ADD_S:
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, GetString( st->b ) );
-			break;
+	case OP_ADD_S:
+		SetString( st->c, GetString( st->a ) );
+		AppendString( st->c, GetString( st->b ) );
+		break;
 
-		case OP_ADD_FS:
-			var_a = GetVariable( st->a );
-			SetString( st->c, FloatToString( *var_a.floatPtr ) );
-			AppendString( st->c, GetString( st->b ) );
-			break;
+	case OP_ADD_FS:
+		var_a = GetVariable( st->a );
+		SetString( st->c, FloatToString( *var_a.floatPtr ) );
+		AppendString( st->c, GetString( st->b ) );
+		break;
 
-		case OP_ADD_SF:
-			var_b = GetVariable( st->b );
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, FloatToString( *var_b.floatPtr ) );
-			break;
+	case OP_ADD_SF:
+		var_b = GetVariable( st->b );
+		SetString( st->c, GetString( st->a ) );
+		AppendString( st->c, FloatToString( *var_b.floatPtr ) );
+		break;
 
-		case OP_ADD_VS:
-			var_a = GetVariable( st->a );
-			SetString( st->c, var_a.vectorPtr->ToString() );
-			AppendString( st->c, GetString( st->b ) );
-			break;
+	case OP_ADD_VS:
+		var_a = GetVariable( st->a );
+		SetString( st->c, var_a.vectorPtr->ToString() );
+		AppendString( st->c, GetString( st->b ) );
+		break;
 
-		case OP_ADD_SV:
-			var_b = GetVariable( st->b );
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, var_b.vectorPtr->ToString() );
-			break;
+	case OP_ADD_SV:
+		var_b = GetVariable( st->b );
+		SetString( st->c, GetString( st->a ) );
+		AppendString( st->c, var_b.vectorPtr->ToString() );
+		break;
 
-		case OP_SUB_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
-			//HUMANHEAD rww - float debugging
+	case OP_SUB_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_SUB_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
-			//HUMANHEAD rww - float debugging
+	case OP_SUB_V:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(var_a.vectorPtr->x));
-			assert(!FLOAT_IS_INVALID(var_a.vectorPtr->y));
-			assert(!FLOAT_IS_INVALID(var_a.vectorPtr->z));
-			assert(!FLOAT_IS_INVALID(var_b.vectorPtr->x));
-			assert(!FLOAT_IS_INVALID(var_b.vectorPtr->y));
-			assert(!FLOAT_IS_INVALID(var_b.vectorPtr->z));
-			assert(!FLOAT_IS_INVALID(var_c.vectorPtr->x));
-			assert(!FLOAT_IS_INVALID(var_c.vectorPtr->y));
-			assert(!FLOAT_IS_INVALID(var_c.vectorPtr->z));
+		assert(!FLOAT_IS_INVALID(var_a.vectorPtr->x));
+		assert(!FLOAT_IS_INVALID(var_a.vectorPtr->y));
+		assert(!FLOAT_IS_INVALID(var_a.vectorPtr->z));
+		assert(!FLOAT_IS_INVALID(var_b.vectorPtr->x));
+		assert(!FLOAT_IS_INVALID(var_b.vectorPtr->y));
+		assert(!FLOAT_IS_INVALID(var_b.vectorPtr->z));
+		assert(!FLOAT_IS_INVALID(var_c.vectorPtr->x));
+		assert(!FLOAT_IS_INVALID(var_c.vectorPtr->y));
+		assert(!FLOAT_IS_INVALID(var_c.vectorPtr->z));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_MUL_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
-			//HUMANHEAD rww - float debugging
+	case OP_MUL_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_MUL_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = *var_a.vectorPtr * *var_b.vectorPtr;
-			//HUMANHEAD rww - float debugging
+	case OP_MUL_V:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = *var_a.vectorPtr * *var_b.vectorPtr;
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(var_a.vectorPtr->x));
-			assert(!FLOAT_IS_INVALID(var_a.vectorPtr->y));
-			assert(!FLOAT_IS_INVALID(var_a.vectorPtr->z));
-			assert(!FLOAT_IS_INVALID(var_b.vectorPtr->x));
-			assert(!FLOAT_IS_INVALID(var_b.vectorPtr->y));
-			assert(!FLOAT_IS_INVALID(var_b.vectorPtr->z));
-			assert(!FLOAT_IS_INVALID(var_c.vectorPtr->x));
-			assert(!FLOAT_IS_INVALID(var_c.vectorPtr->y));
-			assert(!FLOAT_IS_INVALID(var_c.vectorPtr->z));
+		assert(!FLOAT_IS_INVALID(var_a.vectorPtr->x));
+		assert(!FLOAT_IS_INVALID(var_a.vectorPtr->y));
+		assert(!FLOAT_IS_INVALID(var_a.vectorPtr->z));
+		assert(!FLOAT_IS_INVALID(var_b.vectorPtr->x));
+		assert(!FLOAT_IS_INVALID(var_b.vectorPtr->y));
+		assert(!FLOAT_IS_INVALID(var_b.vectorPtr->z));
+		assert(!FLOAT_IS_INVALID(var_c.vectorPtr->x));
+		assert(!FLOAT_IS_INVALID(var_c.vectorPtr->y));
+		assert(!FLOAT_IS_INVALID(var_c.vectorPtr->z));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_MUL_FV:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.vectorPtr = *var_a.floatPtr * *var_b.vectorPtr;
-			break;
+	case OP_MUL_FV:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.vectorPtr = *var_a.floatPtr * *var_b.vectorPtr;
+		break;
 
-		case OP_MUL_VF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.vectorPtr = *var_a.vectorPtr * *var_b.floatPtr;
-			break;
+	case OP_MUL_VF:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.vectorPtr = *var_a.vectorPtr * *var_b.floatPtr;
+		break;
 
-		case OP_DIV_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+	case OP_DIV_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
 
-			if ( *var_b.floatPtr == 0.0f ) {
-				Warning( "Divide by zero" );
-				*var_c.floatPtr = idMath::INFINITY;
-			} else {
-				*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
-			}
-			break;
+		if ( *var_b.floatPtr == 0.0f ) {
+			Warning( "Divide by zero" );
+			*var_c.floatPtr = idMath::INFINITY;
+		} else {
+			*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
+		}
+		break;
 
-		case OP_MOD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable ( st->c );
+	case OP_MOD_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable ( st->c );
 
-			if ( *var_b.floatPtr == 0.0f ) {
-				Warning( "Divide by zero" );
-				*var_c.floatPtr = *var_a.floatPtr;
-			} else {
-				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) % static_cast<int>( *var_b.floatPtr );
-			}
-			break;
+		if ( *var_b.floatPtr == 0.0f ) {
+			Warning( "Divide by zero" );
+			*var_c.floatPtr = *var_a.floatPtr;
+		} else {
+			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) % static_cast<int>( *var_b.floatPtr );
+		}
+		break;
 
-		case OP_BITAND:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) & static_cast<int>( *var_b.floatPtr );
-			break;
+	case OP_BITAND:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) & static_cast<int>( *var_b.floatPtr );
+		break;
 
-		case OP_BITOR:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) | static_cast<int>( *var_b.floatPtr );
-			break;
+	case OP_BITOR:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) | static_cast<int>( *var_b.floatPtr );
+		break;
 
-		case OP_GE:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
-			break;
+	case OP_GE:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
+		break;
 
-		case OP_LE:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
-			break;
+	case OP_LE:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
+		break;
 
-		case OP_GT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
-			break;
+	case OP_GT:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
+		break;
 
-		case OP_LT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
-			break;
+	case OP_LT:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
+		break;
 
-		case OP_AND:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
-			break;
+	case OP_AND:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
+		break;
 
-		case OP_AND_BOOLF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
-			break;
+	case OP_AND_BOOLF:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
+		break;
 
-		case OP_AND_FBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
-			break;
+	case OP_AND_FBOOL:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
+		break;
 
-		case OP_AND_BOOLBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
-			break;
+	case OP_AND_BOOLBOOL:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
+		break;
 
-		case OP_OR:	
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
-			break;
+	case OP_OR:	
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
+		break;
 
-		case OP_OR_BOOLF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
-			break;
+	case OP_OR_BOOLF:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
+		break;
 
-		case OP_OR_FBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
-			break;
-			
-		case OP_OR_BOOLBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
-			break;
-			
-		case OP_NOT_BOOL:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.intPtr == 0 );
-			break;
+	case OP_OR_FBOOL:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
+		break;
+		
+	case OP_OR_BOOLBOOL:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
+		break;
+		
+	case OP_NOT_BOOL:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.intPtr == 0 );
+		break;
 
-		case OP_NOT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
-			//HUMANHEAD rww - float debugging
+	case OP_NOT_F:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_NOT_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.vectorPtr == vec3_zero );
-			break;
+	case OP_NOT_V:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.vectorPtr == vec3_zero );
+		break;
 
-		case OP_NOT_S:
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( strlen( GetString( st->a ) ) == 0 );
-			break;
+	case OP_NOT_S:
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( strlen( GetString( st->a ) ) == 0 );
+		break;
 
-		case OP_NOT_ENT:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
-			break;
+	case OP_NOT_ENT:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
+		break;
 
-		case OP_NEG_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = -*var_a.floatPtr;
-			//HUMANHEAD rww - float debugging
+	case OP_NEG_F:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = -*var_a.floatPtr;
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_NEG_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.vectorPtr = -*var_a.vectorPtr;
-			break;
+	case OP_NEG_V:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		*var_c.vectorPtr = -*var_a.vectorPtr;
+		break;
 
-		case OP_INT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
-			break;
+	case OP_INT_F:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
+		break;
 
-		case OP_EQ_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
-			break;
+	case OP_EQ_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
+		break;
 
-		case OP_EQ_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.vectorPtr == *var_b.vectorPtr );
-			break;
+	case OP_EQ_V:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.vectorPtr == *var_b.vectorPtr );
+		break;
 
-		case OP_EQ_S:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) == 0 );
-			break;
+	case OP_EQ_S:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) == 0 );
+		break;
 
-		case OP_EQ_E:
-		case OP_EQ_EO:
-		case OP_EQ_OE:
-		case OP_EQ_OO:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
-			break;
+	case OP_EQ_E:
+	case OP_EQ_EO:
+	case OP_EQ_OE:
+	case OP_EQ_OO:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
+		break;
 
-		case OP_NE_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
-			break;
+	case OP_NE_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
+		break;
 
-		case OP_NE_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.vectorPtr != *var_b.vectorPtr );
-			break;
+	case OP_NE_V:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.vectorPtr != *var_b.vectorPtr );
+		break;
 
-		case OP_NE_S:
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) != 0 );
-			break;
+	case OP_NE_S:
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) != 0 );
+		break;
 
-		case OP_NE_E:
-		case OP_NE_EO:
-		case OP_NE_OE:
-		case OP_NE_OO:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
-			break;
+	case OP_NE_E:
+	case OP_NE_EO:
+	case OP_NE_OE:
+	case OP_NE_OO:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		var_c = GetVariable( st->c );
+		*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
+		break;
 
-		case OP_UADD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr += *var_a.floatPtr;
-			//HUMANHEAD rww - float debugging
+	case OP_UADD_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.floatPtr += *var_a.floatPtr;
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_UADD_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.vectorPtr += *var_a.vectorPtr;
-			break;
+	case OP_UADD_V:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.vectorPtr += *var_a.vectorPtr;
+		break;
 
-		case OP_USUB_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr -= *var_a.floatPtr;
-			//HUMANHEAD rww - float debugging
+	case OP_USUB_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.floatPtr -= *var_a.floatPtr;
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_USUB_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.vectorPtr -= *var_a.vectorPtr;
-			break;
+	case OP_USUB_V:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.vectorPtr -= *var_a.vectorPtr;
+		break;
 
-		case OP_UMUL_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr *= *var_a.floatPtr;
-			//HUMANHEAD rww - float debugging
+	case OP_UMUL_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.floatPtr *= *var_a.floatPtr;
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_UMUL_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.vectorPtr *= *var_a.floatPtr;
-			break;
+	case OP_UMUL_V:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.vectorPtr *= *var_a.floatPtr;
+		break;
 
-		case OP_UDIV_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+	case OP_UDIV_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
 
-			if ( *var_a.floatPtr == 0.0f ) {
-				Warning( "Divide by zero" );
-				*var_b.floatPtr = idMath::INFINITY;
-			} else {
-				*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
-			}
+		if ( *var_a.floatPtr == 0.0f ) {
+			Warning( "Divide by zero" );
+			*var_b.floatPtr = idMath::INFINITY;
+		} else {
+			*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
+		}
 
-			//HUMANHEAD rww - float debugging
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_UDIV_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+	case OP_UDIV_V:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
 
-			if ( *var_a.floatPtr == 0.0f ) {
-				Warning( "Divide by zero" );
-				var_b.vectorPtr->Set( idMath::INFINITY, idMath::INFINITY, idMath::INFINITY );
-			} else {
-				*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
-			}
-			break;
+		if ( *var_a.floatPtr == 0.0f ) {
+			Warning( "Divide by zero" );
+			var_b.vectorPtr->Set( idMath::INFINITY, idMath::INFINITY, idMath::INFINITY );
+		} else {
+			*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
+		}
+		break;
 
-		case OP_UMOD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+	case OP_UMOD_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
 
-			if ( *var_a.floatPtr == 0.0f ) {
-				Warning( "Divide by zero" );
-				*var_b.floatPtr = *var_a.floatPtr;
-			} else {
-				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) % static_cast<int>( *var_a.floatPtr );
-			}
+		if ( *var_a.floatPtr == 0.0f ) {
+			Warning( "Divide by zero" );
+			*var_b.floatPtr = *var_a.floatPtr;
+		} else {
+			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) % static_cast<int>( *var_a.floatPtr );
+		}
 
-			//HUMANHEAD rww - float debugging
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_UOR_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) | static_cast<int>( *var_a.floatPtr );
+	case OP_UOR_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) | static_cast<int>( *var_a.floatPtr );
 
-			//HUMANHEAD rww - float debugging
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_UAND_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) & static_cast<int>( *var_a.floatPtr );
+	case OP_UAND_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) & static_cast<int>( *var_a.floatPtr );
 
-			//HUMANHEAD rww - float debugging
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
 #endif
-			//HUMANHEAD END
-			break;
+		//HUMANHEAD END
+		break;
 
-		case OP_UINC_F:
-			var_a = GetVariable( st->a );
+	case OP_UINC_F:
+		var_a = GetVariable( st->a );
 
-			//HUMANHEAD rww - float debugging
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
 #endif
-			//HUMANHEAD END
+		//HUMANHEAD END
 
-			( *var_a.floatPtr )++;
-			break;
+		( *var_a.floatPtr )++;
+		break;
 
-		case OP_UINCP_F:
-			var_a = GetVariable( st->a );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+	case OP_UINCP_F:
+		var_a = GetVariable( st->a );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
 
-				//HUMANHEAD rww - float debugging
+			//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-				assert(!FLOAT_IS_INVALID(*var.floatPtr));
+			assert(!FLOAT_IS_INVALID(*var.floatPtr));
 #endif
-				//HUMANHEAD END
+			//HUMANHEAD END
 
-				( *var.floatPtr )++;
-			}
-			break;
+			( *var.floatPtr )++;
+		}
+		break;
 
-		case OP_UDEC_F:
-			var_a = GetVariable( st->a );
+	case OP_UDEC_F:
+		var_a = GetVariable( st->a );
+		//HUMANHEAD rww - float debugging
+#ifdef _ASSERT_ON_INTERPRETER_NANS
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+#endif
+		//HUMANHEAD END
+		( *var_a.floatPtr )--;
+		break;
+
+	case OP_UDECP_F:
+		var_a = GetVariable( st->a );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
 			//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+			assert(!FLOAT_IS_INVALID(*var.floatPtr));
 #endif
 			//HUMANHEAD END
-			( *var_a.floatPtr )--;
-			break;
+			( *var.floatPtr )--;
+		}
+		break;
 
-		case OP_UDECP_F:
-			var_a = GetVariable( st->a );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				//HUMANHEAD rww - float debugging
+	case OP_COMP_F:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-				assert(!FLOAT_IS_INVALID(*var.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
 #endif
-				//HUMANHEAD END
-				( *var.floatPtr )--;
-			}
-			break;
+		//HUMANHEAD END
+		*var_c.floatPtr = ~static_cast<int>( *var_a.floatPtr );
+		break;
 
-		case OP_COMP_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			//HUMANHEAD rww - float debugging
+	case OP_STORE_F:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
-			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_c.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
+		assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
 #endif
-			//HUMANHEAD END
-			*var_c.floatPtr = ~static_cast<int>( *var_a.floatPtr );
-			break;
+		//HUMANHEAD END
+		*var_b.floatPtr = *var_a.floatPtr;
+		break;
 
-		case OP_STORE_F:
+	case OP_STORE_ENT:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.entityNumberPtr = *var_a.entityNumberPtr;
+		break;
+
+	case OP_STORE_BOOL:	
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.intPtr = *var_a.intPtr;
+		break;
+
+	case OP_STORE_OBJENT:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( !obj ) {
+			*var_b.entityNumberPtr = 0;
+		} else if ( !obj->GetTypeDef()->Inherits( st->b->TypeDef() ) ) {
+			//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->b->TypeDef()->Name() );
+			*var_b.entityNumberPtr = 0;
+		} else {
+			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
+		}
+		break;
+
+	case OP_STORE_OBJ:
+	case OP_STORE_ENTOBJ:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.entityNumberPtr = *var_a.entityNumberPtr;
+		break;
+
+	case OP_STORE_S:
+		SetString( st->b, GetString( st->a ) );
+		break;
+
+	case OP_STORE_V:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.vectorPtr = *var_a.vectorPtr;
+		break;
+
+	case OP_STORE_FTOS:
+		var_a = GetVariable( st->a );
+		SetString( st->b, FloatToString( *var_a.floatPtr ) );
+		break;
+
+	case OP_STORE_BTOS:
+		var_a = GetVariable( st->a );
+		SetString( st->b, *var_a.intPtr ? "true" : "false" );
+		break;
+
+	case OP_STORE_VTOS:
+		var_a = GetVariable( st->a );
+		SetString( st->b, var_a.vectorPtr->ToString() );
+		break;
+
+	case OP_STORE_FTOBOOL:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		if ( *var_a.floatPtr != 0.0f ) {
+			*var_b.intPtr = 1;
+		} else {
+			*var_b.intPtr = 0;
+		}
+		break;
+
+	case OP_STORE_BOOLTOF:
+		var_a = GetVariable( st->a );
+		var_b = GetVariable( st->b );
+		*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
+		break;
+
+	case OP_STOREP_F:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
 			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+
 			//HUMANHEAD rww - float debugging
 #ifdef _ASSERT_ON_INTERPRETER_NANS
 			assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-			assert(!FLOAT_IS_INVALID(*var_b.floatPtr));
 #endif
 			//HUMANHEAD END
-			*var_b.floatPtr = *var_a.floatPtr;
-			break;
 
-		case OP_STORE_ENT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			break;
+			*var_b.evalPtr->floatPtr = *var_a.floatPtr;
+		}
+		break;
 
-		case OP_STORE_BOOL:	
+	case OP_STOREP_ENT:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
 			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.intPtr = *var_a.intPtr;
-			break;
+			*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
+		}
+		break;
 
-		case OP_STORE_OBJENT:
+	case OP_STOREP_FLD:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
 			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( !obj ) {
-				*var_b.entityNumberPtr = 0;
-			} else if ( !obj->GetTypeDef()->Inherits( st->b->TypeDef() ) ) {
-				//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->b->TypeDef()->Name() );
-				*var_b.entityNumberPtr = 0;
-			} else {
-				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			}
-			break;
+			*var_b.evalPtr->intPtr = *var_a.intPtr;
+		}
+		break;
 
-		case OP_STORE_OBJ:
-		case OP_STORE_ENTOBJ:
+	case OP_STOREP_BOOL:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
 			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			break;
+			*var_b.evalPtr->intPtr = *var_a.intPtr;
+		}
+		break;
 
-		case OP_STORE_S:
-			SetString( st->b, GetString( st->a ) );
-			break;
+	case OP_STOREP_S:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
+			idStr::Copynz( var_b.evalPtr->stringPtr, GetString( st->a ), MAX_STRING_LEN );
+		}
+		break;
 
-		case OP_STORE_V:
+	case OP_STOREP_V:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->vectorPtr ) {
 			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.vectorPtr = *var_a.vectorPtr;
-			break;
-
-		case OP_STORE_FTOS:
+			*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
+		}
+		break;
+	
+	case OP_STOREP_FTOS:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
 			var_a = GetVariable( st->a );
-			SetString( st->b, FloatToString( *var_a.floatPtr ) );
-			break;
+			idStr::Copynz( var_b.evalPtr->stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
+		}
+		break;
 
-		case OP_STORE_BTOS:
+	case OP_STOREP_BTOS:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
 			var_a = GetVariable( st->a );
-			SetString( st->b, *var_a.intPtr ? "true" : "false" );
-			break;
+			if ( *var_a.floatPtr != 0.0f ) {
+				idStr::Copynz( var_b.evalPtr->stringPtr, "true", MAX_STRING_LEN );
+			} else {
+				idStr::Copynz( var_b.evalPtr->stringPtr, "false", MAX_STRING_LEN );
+			}
+		}
+		break;
 
-		case OP_STORE_VTOS:
+	case OP_STOREP_VTOS:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
 			var_a = GetVariable( st->a );
-			SetString( st->b, var_a.vectorPtr->ToString() );
-			break;
+			idStr::Copynz( var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
+		}
+		break;
 
-		case OP_STORE_FTOBOOL:
+	case OP_STOREP_FTOBOOL:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
 			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
 			if ( *var_a.floatPtr != 0.0f ) {
-				*var_b.intPtr = 1;
+				*var_b.evalPtr->intPtr = 1;
 			} else {
-				*var_b.intPtr = 0;
+				*var_b.evalPtr->intPtr = 0;
 			}
-			break;
+		}
+		break;
 
-		case OP_STORE_BOOLTOF:
+	case OP_STOREP_BOOLTOF:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
 			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
-			break;
-
-		case OP_STOREP_F:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
-				var_a = GetVariable( st->a );
-
-				//HUMANHEAD rww - float debugging
-#ifdef _ASSERT_ON_INTERPRETER_NANS
-				assert(!FLOAT_IS_INVALID(*var_a.floatPtr));
-#endif
-				//HUMANHEAD END
+			*var_b.evalPtr->floatPtr = static_cast<float>( *var_a.intPtr );
+		}
+		break;
 
-				*var_b.evalPtr->floatPtr = *var_a.floatPtr;
-			}
-			break;
+	case OP_STOREP_OBJ:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
+			var_a = GetVariable( st->a );
+			*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
+		}
+		break;
 
-		case OP_STOREP_ENT:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
+	case OP_STOREP_OBJENT:
+		var_b = GetVariable( st->b );
+		if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
+			var_a = GetVariable( st->a );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if ( !obj ) {
+				*var_b.evalPtr->entityNumberPtr = 0;
+
+			// st->b points to type_pointer, which is just a temporary that gets its type reassigned, so we store the real type in st->c
+			// so that we can do a type check during run time since we don't know what type the script object is at compile time because it
+			// comes from an entity
+			} else if ( !obj->GetTypeDef()->Inherits( st->c->TypeDef() ) ) {
+				//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->c->TypeDef()->Name() );
+				*var_b.evalPtr->entityNumberPtr = 0;
+			} else {
 				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 			}
-			break;
+		}
+		break;
 
-		case OP_STOREP_FLD:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->intPtr = *var_a.intPtr;
-			}
-			break;
+	case OP_ADDRESS:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var_c.evalPtr->bytePtr = &obj->data[ st->b->value.ptrOffset ];
+		} else {
+			var_c.evalPtr->bytePtr = NULL;
+		}
+		break;
 
-		case OP_STOREP_BOOL:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->intPtr = *var_a.intPtr;
-			}
-			break;
+	case OP_INDIRECT_F:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+			*var_c.floatPtr = *var.floatPtr;
+		} else {
+			*var_c.floatPtr = 0.0f;
+		}
+		break;
 
-		case OP_STOREP_S:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				idStr::Copynz( var_b.evalPtr->stringPtr, GetString( st->a ), MAX_STRING_LEN );
-			}
-			break;
+	case OP_INDIRECT_ENT:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+			*var_c.entityNumberPtr = *var.entityNumberPtr;
+		} else {
+			*var_c.entityNumberPtr = 0;
+		}
+		break;
 
-		case OP_STOREP_V:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->vectorPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
-			}
-			break;
-		
-		case OP_STOREP_FTOS:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
-				idStr::Copynz( var_b.evalPtr->stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
-			}
-			break;
+	case OP_INDIRECT_BOOL:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+			*var_c.intPtr = *var.intPtr;
+		} else {
+			*var_c.intPtr = 0;
+		}
+		break;
 
-		case OP_STOREP_BTOS:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
-				if ( *var_a.floatPtr != 0.0f ) {
-					idStr::Copynz( var_b.evalPtr->stringPtr, "true", MAX_STRING_LEN );
-				} else {
-					idStr::Copynz( var_b.evalPtr->stringPtr, "false", MAX_STRING_LEN );
-				}
-			}
-			break;
+	case OP_INDIRECT_S:
+		var_a = GetVariable( st->a );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+			SetString( st->c, var.stringPtr );
+		} else {
+			SetString( st->c, "" );
+		}
+		break;
 
-		case OP_STOREP_VTOS:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
-				idStr::Copynz( var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
-			}
-			break;
+	case OP_INDIRECT_V:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( obj ) {
+			var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+			*var_c.vectorPtr = *var.vectorPtr;
+		} else {
+			var_c.vectorPtr->Zero();
+		}
+		break;
 
-		case OP_STOREP_FTOBOOL:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
-				if ( *var_a.floatPtr != 0.0f ) {
-					*var_b.evalPtr->intPtr = 1;
-				} else {
-					*var_b.evalPtr->intPtr = 0;
-				}
-			}
-			break;
+	case OP_INDIRECT_OBJ:
+		var_a = GetVariable( st->a );
+		var_c = GetVariable( st->c );
+		obj = GetScriptObject( *var_a.entityNumberPtr );
+		if ( !obj ) {
+			*var_c.entityNumberPtr = 0;
+		} else {
+			var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+			*var_c.entityNumberPtr = *var.entityNumberPtr;
+		}
+		break;
 
-		case OP_STOREP_BOOLTOF:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->floatPtr = static_cast<float>( *var_a.intPtr );
-			}
-			break;
+	case OP_PUSH_F:
+		var_a = GetVariable( st->a );
+		Push( *var_a.intPtr );
+		break;
 
-		case OP_STOREP_OBJ:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
-				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
-			}
-			break;
+	case OP_PUSH_FTOS:
+		var_a = GetVariable( st->a );
+		PushString( FloatToString( *var_a.floatPtr ) );
+		break;
 
-		case OP_STOREP_OBJENT:
-			var_b = GetVariable( st->b );
-			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
-				obj = GetScriptObject( *var_a.entityNumberPtr );
-				if ( !obj ) {
-					*var_b.evalPtr->entityNumberPtr = 0;
-
-				// st->b points to type_pointer, which is just a temporary that gets its type reassigned, so we store the real type in st->c
-				// so that we can do a type check during run time since we don't know what type the script object is at compile time because it
-				// comes from an entity
-				} else if ( !obj->GetTypeDef()->Inherits( st->c->TypeDef() ) ) {
-					//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->c->TypeDef()->Name() );
-					*var_b.evalPtr->entityNumberPtr = 0;
-				} else {
-					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
-				}
-			}
-			break;
+	case OP_PUSH_BTOF:
+		var_a = GetVariable( st->a );
+		floatVal = *var_a.intPtr;
+		Push( *reinterpret_cast<int *>( &floatVal ) );
+		break;
 
-		case OP_ADDRESS:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var_c.evalPtr->bytePtr = &obj->data[ st->b->value.ptrOffset ];
-			} else {
-				var_c.evalPtr->bytePtr = NULL;
-			}
-			break;
+	case OP_PUSH_FTOB:
+		var_a = GetVariable( st->a );
+		if ( *var_a.floatPtr != 0.0f ) {
+			Push( 1 );
+		} else {
+			Push( 0 );
+		}
+		break;
 
-		case OP_INDIRECT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				*var_c.floatPtr = *var.floatPtr;
-			} else {
-				*var_c.floatPtr = 0.0f;
-			}
-			break;
+	case OP_PUSH_VTOS:
+		var_a = GetVariable( st->a );
+		PushString( var_a.vectorPtr->ToString() );
+		break;
 
-		case OP_INDIRECT_ENT:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				*var_c.entityNumberPtr = *var.entityNumberPtr;
-			} else {
-				*var_c.entityNumberPtr = 0;
-			}
-			break;
+	case OP_PUSH_BTOS:
+		var_a = GetVariable( st->a );
+		PushString( *var_a.intPtr ? "true" : "false" );
+		break;
 
-		case OP_INDIRECT_BOOL:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				*var_c.intPtr = *var.intPtr;
-			} else {
-				*var_c.intPtr = 0;
-			}
-			break;
+	case OP_PUSH_ENT:
+		var_a = GetVariable( st->a );
+		Push( *var_a.entityNumberPtr );
+		break;
 
-		case OP_INDIRECT_S:
-			var_a = GetVariable( st->a );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				SetString( st->c, var.stringPtr );
-			} else {
-				SetString( st->c, "" );
-			}
-			break;
+	case OP_PUSH_S:
+		PushString( GetString( st->a ) );
+		break;
 
-		case OP_INDIRECT_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				*var_c.vectorPtr = *var.vectorPtr;
-			} else {
-				var_c.vectorPtr->Zero();
-			}
-			break;
+	case OP_PUSH_V:
+		var_a = GetVariable(st->a);
+		// RB: 64 bit fix, changed individual pushes with PushVector
+		/*
+		Push( *reinterpret_cast<int *>( &var_a.vectorPtr->x ) );
+		Push( *reinterpret_cast<int *>( &var_a.vectorPtr->y ) );
+		Push( *reinterpret_cast<int *>( &var_a.vectorPtr->z ) );
+		*/
+		PushVector(*var_a.vectorPtr);
+		// RB end
+		break;
 
-		case OP_INDIRECT_OBJ:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
-			obj = GetScriptObject( *var_a.entityNumberPtr );
-			if ( !obj ) {
-				*var_c.entityNumberPtr = 0;
-			} else {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				*var_c.entityNumberPtr = *var.entityNumberPtr;
+	case OP_PUSH_OBJ:
+		var_a = GetVariable( st->a );
+		Push( *var_a.entityNumberPtr );
+		break;
+
+	case OP_PUSH_OBJENT:
+		var_a = GetVariable( st->a );
+		Push( *var_a.entityNumberPtr );
+		break;
+
+	case OP_BREAK:
+	case OP_CONTINUE:
+	default:
+		Error( "Bad opcode %i", st->op );
+		break;
+	}
+}
+
+/*
+====================
+idInterpreter::ExecuteStatements
+
+benchmark is only set for BenchmarkFunction: calls, threads and events are stubbed and a
+runaway loop stops the function instead of erroring.  The branches are compiled out of the
+instantiations Execute uses.
+====================
+*/
+template< bool benchmark >
+bool idInterpreter::ExecuteStatements( void ) {
+	int 		runaway;
+	int			runawayLimit;
+
+	PROFILE_SCOPE("Scripting", PROFMASK_NORMAL);		// HUMANHEAD pdm
+
+	if ( threadDying || !currentFunction ) {
+		return true;
+	}
+
+	if ( multiFrameEvent ) {
+		// move to previous instruction and call it again
+		instructionPointer--;
+	}
+
+	runawayLimit = benchmark ? BENCHMARK_RUNAWAY : 5000000;
+	runaway = runawayLimit;
+
+	doneProcessing = false;
+	while( !doneProcessing && !threadDying ) {
+		instructionPointer++;
+
+		if ( !--runaway ) {
+			if ( benchmark ) {
+				benchmarkRunaway = true;
+				break;
+			}
+			Error( "runaway loop error" );
+		}
+
+		if ( profiling ) {
+			scriptProfiler.GetNode( GetProfileNode() ).instructions++;
+		}
+
+		// next statement
+		ExecuteStatement<benchmark>( &gameLocal.program.GetStatement( instructionPointer ) );
+	}
+
+	instructionCount += runawayLimit - runaway;
+
+	return threadDying;
+}
+
+#define THREADED_A	GetThreadedVariable( ts->a, ts->stackOperands & THREADED_STACK_A )
+#define THREADED_B	GetThreadedVariable( ts->b, ts->stackOperands & THREADED_STACK_B )
+#define THREADED_C	GetThreadedVariable( ts->c, ts->stackOperands & THREADED_STACK_C )
+
+/*
+====================
+idInterpreter::ExecuteThreaded
+
+Same as ExecuteStatements, but runs the decoded statements from idProgram::GetThreadedStatement.
+The common opcodes and the superinstructions are handled here, anything else goes through
+ExecuteStatement.  A superinstruction leaves the instruction pointer on its second statement,
+so jumps, errors and stack traces see the same positions as with the plain statements.
+====================
+*/
+template< bool benchmark >
+bool idInterpreter::ExecuteThreaded( void ) {
+	varEval_t	var_a;
+	varEval_t	var_b;
+	varEval_t	var_c;
+	varEval_t	var;
+	const threadedStatement_t *ts;
+	int 		runaway;
+	int			runawayLimit;
+	float		floatVal;
+	idScriptObject *obj;
+
+	PROFILE_SCOPE("Scripting", PROFMASK_NORMAL);
+
+	if ( threadDying || !currentFunction ) {
+		return true;
+	}
+
+	if ( multiFrameEvent ) {
+		// move to previous instruction and call it again
+		instructionPointer--;
+	}
+
+	runawayLimit = benchmark ? BENCHMARK_RUNAWAY : 5000000;
+	runaway = runawayLimit;
+
+	doneProcessing = false;
+	while( !doneProcessing && !threadDying ) {
+		instructionPointer++;
+
+		// superinstructions count as two statements, so runaway can skip past zero
+		if ( --runaway <= 0 ) {
+			if ( benchmark ) {
+				benchmarkRunaway = true;
+				break;
+			}
+			Error( "runaway loop error" );
+		}
+
+		if ( profiling ) {
+			scriptProfiler.GetNode( GetProfileNode() ).instructions++;
+		}
+
+		// next statement
+		ts = &gameLocal.program.GetThreadedStatement( instructionPointer );
+
+		switch( ts->op ) {
+		case OP_CALL:
+			if ( benchmark ) {
+				BenchmarkCall( ts->a.functionPtr->parmTotal );
+				break;
 			}
+			EnterFunction( ts->a.functionPtr, false );
 			break;
 
-		case OP_PUSH_F:
-			var_a = GetVariable( st->a );
-			Push( *var_a.intPtr );
+		case OP_EVENTCALL:
+			if ( benchmark ) {
+				BenchmarkCall( ts->b.argSize );
+				break;
+			}
+			CallEvent( ts->a.functionPtr, ts->b.argSize );
 			break;
 
-		case OP_PUSH_FTOS:
-			var_a = GetVariable( st->a );
-			PushString( FloatToString( *var_a.floatPtr ) );
+		case OP_SYSCALL:
+			if ( benchmark ) {
+				BenchmarkCall( ts->b.argSize );
+				break;
+			}
+			CallSysEvent( ts->a.functionPtr, ts->b.argSize );
 			break;
 
-		case OP_PUSH_BTOF:
-			var_a = GetVariable( st->a );
-			floatVal = *var_a.intPtr;
-			Push( *reinterpret_cast<int *>( &floatVal ) );
+		case OP_IFNOT:
+			var_a = THREADED_A;
+			if ( *var_a.intPtr == 0 ) {
+				NextInstruction( instructionPointer + ts->b.jumpOffset );
+			}
 			break;
 
-		case OP_PUSH_FTOB:
-			var_a = GetVariable( st->a );
-			if ( *var_a.floatPtr != 0.0f ) {
-				Push( 1 );
-			} else {
-				Push( 0 );
+		case OP_IF:
+			var_a = THREADED_A;
+			if ( *var_a.intPtr != 0 ) {
+				NextInstruction( instructionPointer + ts->b.jumpOffset );
 			}
 			break;
 
-		case OP_PUSH_VTOS:
-			var_a = GetVariable( st->a );
-			PushString( var_a.vectorPtr->ToString() );
+		case OP_GOTO:
+			NextInstruction( instructionPointer + ts->a.jumpOffset );
 			break;
 
-		case OP_PUSH_BTOS:
-			var_a = GetVariable( st->a );
-			PushString( *var_a.intPtr ? "true" : "false" );
+		case OP_ADD_F:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
 			break;
 
-		case OP_PUSH_ENT:
-			var_a = GetVariable( st->a );
-			Push( *var_a.entityNumberPtr );
+		case OP_ADD_V:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
 			break;
 
-		case OP_PUSH_S:
-			PushString( GetString( st->a ) );
+		case OP_SUB_F:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
 			break;
 
-		case OP_PUSH_V:
-			var_a = GetVariable(st->a);
-			// RB: 64 bit fix, changed individual pushes with PushVector
-			/*
-			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->x ) );
-			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->y ) );
-			Push( *reinterpret_cast<int *>( &var_a.vectorPtr->z ) );
-			*/
-			PushVector(*var_a.vectorPtr);
-			// RB end
+		case OP_SUB_V:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
 			break;
 
-		case OP_PUSH_OBJ:
-			var_a = GetVariable( st->a );
-			Push( *var_a.entityNumberPtr );
+		case OP_MUL_F:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
 			break;
 
-		case OP_PUSH_OBJENT:
-			var_a = GetVariable( st->a );
-			Push( *var_a.entityNumberPtr );
+		case OP_MUL_V:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = *var_a.vectorPtr * *var_b.vectorPtr;
 			break;
 
-		case OP_BREAK:
-		case OP_CONTINUE:
-		default:
-			Error( "Bad opcode %i", st->op );
+		case OP_MUL_FV:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.vectorPtr = *var_a.floatPtr * *var_b.vectorPtr;
 			break;
-		}
-	}
 
-	return threadDying;
-}
+		case OP_MUL_VF:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.vectorPtr = *var_a.vectorPtr * *var_b.floatPtr;
+			break;
+
+		case OP_EQ_F_IFNOT:
+		case OP_NE_F_IFNOT:
+		case OP_LT_IFNOT:
+		case OP_LE_IFNOT:
+		case OP_GT_IFNOT:
+		case OP_GE_IFNOT:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			switch( ts->op ) {
+				case OP_EQ_F_IFNOT:	*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr ); break;
+				case OP_NE_F_IFNOT:	*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr ); break;
+				case OP_LT_IFNOT:	*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr ); break;
+				case OP_LE_IFNOT:	*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr ); break;
+				case OP_GT_IFNOT:	*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr ); break;
+				default:			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr ); break;
+			}
+
+			// the OP_IFNOT testing the result
+			instructionPointer++;
+			runaway--;
+			ts++;
+			if ( *var_c.intPtr == 0 ) {
+				NextInstruction( instructionPointer + ts->b.jumpOffset );
+			}
+			break;
+
+		case OP_GE:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
+			break;
+
+		case OP_LE:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
+			break;
+
+		case OP_GT:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
+			break;
+
+		case OP_LT:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
+			break;
+
+		case OP_EQ_F:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
+			break;
+
+		case OP_NE_F:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
+			break;
+
+		case OP_EQ_E:
+		case OP_EQ_EO:
+		case OP_EQ_OE:
+		case OP_EQ_OO:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
+			break;
+
+		case OP_NE_E:
+		case OP_NE_EO:
+		case OP_NE_OE:
+		case OP_NE_OO:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
+			break;
+
+		case OP_AND:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
+			break;
+
+		case OP_AND_BOOLF:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
+			break;
+
+		case OP_AND_FBOOL:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
+			break;
+
+		case OP_AND_BOOLBOOL:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
+			break;
+
+		case OP_OR:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
+			break;
+
+		case OP_OR_BOOLF:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
+			break;
+
+		case OP_OR_FBOOL:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
+			break;
+
+		case OP_OR_BOOLBOOL:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
+			break;
+
+		case OP_NOT_BOOL:
+			var_a = THREADED_A;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.intPtr == 0 );
+			break;
+
+		case OP_NOT_F:
+			var_a = THREADED_A;
+			var_c = THREADED_C;
+			*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
+			break;
+
+		case OP_NEG_F:
+			var_a = THREADED_A;
+			var_c = THREADED_C;
+			*var_c.floatPtr = -*var_a.floatPtr;
+			break;
+
+		case OP_INT_F:
+			var_a = THREADED_A;
+			var_c = THREADED_C;
+			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
+			break;
+
+		case OP_UADD_F:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			*var_b.floatPtr += *var_a.floatPtr;
+			break;
+
+		case OP_USUB_F:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			*var_b.floatPtr -= *var_a.floatPtr;
+			break;
+
+		case OP_UMUL_F:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			*var_b.floatPtr *= *var_a.floatPtr;
+			break;
+
+		case OP_UINC_F:
+			var_a = THREADED_A;
+			( *var_a.floatPtr )++;
+			break;
+
+		case OP_UDEC_F:
+			var_a = THREADED_A;
+			( *var_a.floatPtr )--;
+			break;
+
+		case OP_STORE_F:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			*var_b.floatPtr = *var_a.floatPtr;
+			break;
 
+		case OP_STORE_ENT:
+		case OP_STORE_BOOL:
+		case OP_STORE_OBJ:
+		case OP_STORE_ENTOBJ:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			*var_b.intPtr = *var_a.intPtr;
+			break;
+
+		case OP_STORE_V:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			*var_b.vectorPtr = *var_a.vectorPtr;
+			break;
+
+		case OP_STORE_FTOBOOL:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			*var_b.intPtr = ( *var_a.floatPtr != 0.0f ) ? 1 : 0;
+			break;
+
+		case OP_STORE_BOOLTOF:
+			var_a = THREADED_A;
+			var_b = THREADED_B;
+			*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
+			break;
+
+		case OP_ADDRESS:
+		case OP_ADDRESS_STOREP_F:
+		case OP_ADDRESS_STOREP_V:
+		case OP_ADDRESS_STOREP_INT:
+			var_a = THREADED_A;
+			var_c = THREADED_C;
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if ( obj ) {
+				var_c.evalPtr->bytePtr = &obj->data[ ts->b.ptrOffset ];
+			} else {
+				var_c.evalPtr->bytePtr = NULL;
+			}
+			if ( ts->op == OP_ADDRESS ) {
+				break;
+			}
+
+			// the OP_STOREP_* through the pointer
+			instructionPointer++;
+			runaway--;
+			ts++;
+			var_b = THREADED_B;
+			if ( var_b.evalPtr && var_b.evalPtr->bytePtr ) {
+				var_a = THREADED_A;
+				if ( ts[ -1 ].op == OP_ADDRESS_STOREP_F ) {
+					*var_b.evalPtr->floatPtr = *var_a.floatPtr;
+				} else if ( ts[ -1 ].op == OP_ADDRESS_STOREP_V ) {
+					*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
+				} else {
+					*var_b.evalPtr->intPtr = *var_a.intPtr;
+				}
+			}
+			break;
+
+		case OP_STOREP_F:
+			var_b = THREADED_B;
+			if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
+				var_a = THREADED_A;
+				*var_b.evalPtr->floatPtr = *var_a.floatPtr;
+			}
+			break;
+
+		case OP_STOREP_ENT:
+		case OP_STOREP_FLD:
+		case OP_STOREP_BOOL:
+		case OP_STOREP_OBJ:
+			var_b = THREADED_B;
+			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
+				var_a = THREADED_A;
+				*var_b.evalPtr->intPtr = *var_a.intPtr;
+			}
+			break;
+
+		case OP_STOREP_V:
+			var_b = THREADED_B;
+			if ( var_b.evalPtr && var_b.evalPtr->vectorPtr ) {
+				var_a = THREADED_A;
+				*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
+			}
+			break;
+
+		case OP_INDIRECT_F:
+		case OP_INDIRECT_ENT:
+		case OP_INDIRECT_BOOL:
+		case OP_INDIRECT_OBJ:
+		case OP_INDIRECT_PUSH:
+			// 0.0f and entity 0 are both all zero bits
+			var_a = THREADED_A;
+			var_c = THREADED_C;
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if ( obj ) {
+				var.bytePtr = &obj->data[ ts->b.ptrOffset ];
+				*var_c.intPtr = *var.intPtr;
+			} else {
+				*var_c.intPtr = 0;
+			}
+			if ( ts->op != OP_INDIRECT_PUSH ) {
+				break;
+			}
+
+			// the OP_PUSH_* of the result
+			instructionPointer++;
+			runaway--;
+			Push( *var_c.intPtr );
+			break;
+
+		case OP_INDIRECT_V:
+			var_a = THREADED_A;
+			var_c = THREADED_C;
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if ( obj ) {
+				var.bytePtr = &obj->data[ ts->b.ptrOffset ];
+				*var_c.vectorPtr = *var.vectorPtr;
+			} else {
+				var_c.vectorPtr->Zero();
+			}
+			break;
+
+		case OP_PUSH_F:
+		case OP_PUSH_ENT:
+		case OP_PUSH_OBJ:
+		case OP_PUSH_OBJENT:
+			var_a = THREADED_A;
+			Push( *var_a.intPtr );
+			break;
+
+		case OP_PUSH_BTOF:
+			var_a = THREADED_A;
+			floatVal = *var_a.intPtr;
+			Push( *reinterpret_cast<int *>( &floatVal ) );
+			break;
+
+		case OP_PUSH_FTOB:
+			var_a = THREADED_A;
+			Push( ( *var_a.floatPtr != 0.0f ) ? 1 : 0 );
+			break;
+
+		case OP_PUSH_V:
+			var_a = THREADED_A;
+			PushVector( *var_a.vectorPtr );
+			break;
+
+		default:
+			ExecuteStatement<benchmark>( &gameLocal.program.GetStatement( instructionPointer ) );
+			break;
+		}
+	}
+
+	instructionCount += runawayLimit - runaway;
+
+	return threadDying;
+}
+
+#undef THREADED_A
+#undef THREADED_B
+#undef THREADED_C
+
+/*
+====================
+idInterpreter::ExecuteNative
+
+Runs functions with native code, the native code runs the statements it can and stops at the
+statement the interpreter has to run.  Returns to Execute as soon as a function without native
+code is entered or returned to.
+====================
+*/
+bool idInterpreter::ExecuteNative( void ) {
+	int 		runaway;
+
+	PROFILE_SCOPE("Scripting", PROFMASK_NORMAL);
+
+	if ( threadDying || !currentFunction ) {
+		return true;
+	}
+
+	if ( multiFrameEvent ) {
+		// move to previous instruction and call it again
+		instructionPointer--;
+	}
+
+	runaway = 5000000;
+
+	doneProcessing = false;
+	while( !doneProcessing && !threadDying ) {
+		if ( !currentFunction->nativeFunc ) {
+			nativeSwitch = true;
+			break;
+		}
+
+		instructionPointer++;
+
+		if ( !--runaway ) {
+			Error( "runaway loop error" );
+		}
+
+		// run what the native code can, it stops at the statement the interpreter has to run
+		instructionPointer = currentFunction->firstStatement + currentFunction->nativeFunc( instructionPointer - currentFunction->firstStatement, &localstack[ localstackBase ], gameLocal.program.GetVariables() );
+
+		if ( profiling ) {
+			scriptProfiler.GetNode( GetProfileNode() ).instructions++;
+		}
+
+		// next statement
+		ExecuteStatement<false>( &gameLocal.program.GetStatement( instructionPointer ) );
+	}
+
+	instructionCount += 5000000 - runaway;
+
+	return threadDying;
+}
+
+/*
+====================
+idInterpreter::Execute
+====================
+*/
+bool idInterpreter::Execute( void ) {
+	bool done;
+
+	profiling = g_scriptProfile.GetBool();
+	if ( profiling ) {
+		GetProfileNode();
+		profileTicks = idLib::sys->GetClockTicks();
+	} else {
+		profileNode = -1;
+	}
+
+	// the loops stop to switch when a function with native code is entered or left
+	do {
+		nativeSwitch = false;
+		if ( currentFunction && currentFunction->nativeFunc ) {
+			done = ExecuteNative();
+		} else {
+			interpreting = true;
+			if ( g_scriptThreadedCode.GetBool() ) {
+				done = ExecuteThreaded<false>();
+			} else {
+				done = ExecuteStatements<false>();
+			}
+			interpreting = false;
+		}
+	} while( nativeSwitch && !done );
+
+	if ( profiling ) {
+		AddProfileTime();
+		profiling = false;
+	}
+
+	return done;
+}
+
+/*
+====================
+idInterpreter::GetProfileNode
+
+The node is rebuilt from the call stack when profiling starts in the middle of a thread or the profile was cleared
+====================
+*/
+int idInterpreter::GetProfileNode( void ) {
+	int i;
+
+	if ( ( profileNode >= 0 ) && ( profileGeneration == scriptProfiler.GetGeneration() ) ) {
+		return profileNode;
+	}
+
+	profileGeneration = scriptProfiler.GetGeneration();
+	profileNode = scriptProfiler.GetNode( -1, NULL );
+	for( i = 0; i < callStackDepth; i++ ) {
+		if ( callStack[ i ].f ) {
+			profileNode = scriptProfiler.GetNode( profileNode, callStack[ i ].f );
+		}
+	}
+	if ( currentFunction ) {
+		profileNode = scriptProfiler.GetNode( profileNode, currentFunction );
+	}
+
+	return profileNode;
+}
+
+/*
+====================
+idInterpreter::AddProfileTime
+====================
+*/
+void idInterpreter::AddProfileTime( void ) {
+	double now;
+
+	now = idLib::sys->GetClockTicks();
+	scriptProfiler.GetNode( GetProfileNode() ).selfTicks += now - profileTicks;
+	profileTicks = now;
+}
+
+
+/*
+====================
+CanBenchmarkFunction
+
+Calls, threads and events are stubbed while benchmarking, so a function is run on its own with
+all parms zero.  Pointers may only come from parms, which always give a NULL object and never
+write outside the globals.  Float modulo truncates to int and can divide by zero, so it is left out.
+====================
+*/
+static bool CanBenchmarkFunction( const function_t *func ) {
+	int i;
+	int j;
+
+	for( i = func->firstStatement; i < func->firstStatement + func->numStatements; i++ ) {
+		const statement_t &st = gameLocal.program.GetStatement( i );
+		switch( st.op ) {
+			case OP_MOD_F:
+			case OP_UMOD_F:
+				return false;
+
+			case OP_ADDRESS:
+			case OP_UINCP_F:
+			case OP_UDECP_F:
+				if ( ( st.a->initialized != idVarDef::stackVariable ) || ( st.a->value.stackOffset >= func->parmTotal ) ) {
+					return false;
+				}
+				for( j = func->firstStatement; j < func->firstStatement + func->numStatements; j++ ) {
+					const statement_t &store = gameLocal.program.GetStatement( j );
+					if ( ( store.b == st.a ) && ( ( store.op == OP_STORE_ENT ) || ( store.op == OP_STORE_OBJ ) || ( store.op == OP_STORE_ENTOBJ ) || ( store.op == OP_STORE_OBJENT ) ) ) {
+						return false;
+					}
+				}
+				break;
+		}
+	}
+
+	return true;
+}
+
+/*
+====================
+idInterpreter::BenchmarkCall
+
+Stands in for a call, thread or event while benchmarking: pops the parms and returns zero.
+====================
+*/
+void idInterpreter::BenchmarkCall( int argSize ) {
+	PopParms( argSize );
+	gameLocal.program.ReturnVector( vec3_zero );
+	gameLocal.program.ReturnString( "" );
+}
+
+/*
+====================
+idInterpreter::BenchmarkFunction
+====================
+*/
+void idInterpreter::BenchmarkFunction( const function_t *func, bool threaded ) {
+	Reset();
+
+	memset( localstack, 0, func->parmTotal );
+	localstackUsed = func->parmTotal;
+	EnterFunction( func, false );
+
+	benchmarking = true;
+	benchmarkRunaway = false;
+	if ( threaded ) {
+		ExecuteThreaded<true>();
+	} else {
+		ExecuteStatements<true>();
+	}
+	benchmarking = false;
+}
+
+/*
+====================
+idInterpreter::Benchmark_f
+
+Runs every script function with both ExecuteStatements and ExecuteThreaded, checks that they
+leave the globals in the same state and reports their speed and how many functions were covered.
+====================
+*/
+void idInterpreter::Benchmark_f( const idCmdArgs &args ) {
+	idProgram		&program = gameLocal.program;
+	idThread		*thread;
+	idInterpreter	*interpreter;
+	idTimer			statementsTimer;
+	idTimer			threadedTimer;
+	byte			*variables;
+	byte			*snapshot;
+	byte			*reference;
+	int				numVariables;
+	int				iterations;
+	int				numScriptFunctions;
+	int				numFunctions;
+	int				numUnsafe;
+	int				numRunaway;
+	int				numMismatches;
+	int				statementsCount;
+	int				threadedCount;
+	int				count;
+	int				i;
+	int				j;
+
+	if ( !program.NumStatements() ) {
+		gameLocal.Printf( "No script loaded.\n" );
+		return;
+	}
+
+	iterations = 100;
+	if ( args.Argc() > 1 ) {
+		iterations = Max( atoi( args.Argv( 1 ) ), 1 );
+	}
+
+	variables = program.GetVariables();
+	numVariables = program.NumVariables();
+	snapshot = new byte[ numVariables ];
+	reference = new byte[ numVariables ];
+	memcpy( snapshot, variables, numVariables );
+
+	thread = new idThread();
+	thread->SetThreadName( "scriptBenchmark" );
+	interpreter = new idInterpreter();
+	interpreter->SetThread( thread );
+
+	numScriptFunctions = 0;
+	numFunctions = 0;
+	numUnsafe = 0;
+	numRunaway = 0;
+	numMismatches = 0;
+	statementsCount = 0;
+	threadedCount = 0;
+
+	for( i = 0; i < program.NumFunctions(); i++ ) {
+		const function_t *func = program.GetFunction( i );
+		if ( func->eventdef || !func->def || ( func->def->initialized == idVarDef::uninitialized ) || ( func->numStatements <= 0 ) ) {
+			continue;
+		}
+		numScriptFunctions++;
+
+		if ( !CanBenchmarkFunction( func ) ) {
+			numUnsafe++;
+			continue;
+		}
+
+		// loops waiting on a stubbed call or event never finish, so leave those out
+		memcpy( variables, snapshot, numVariables );
+		interpreter->BenchmarkFunction( func, false );
+		if ( interpreter->benchmarkRunaway ) {
+			numRunaway++;
+			continue;
+		}
+		numFunctions++;
+
+		memcpy( variables, snapshot, numVariables );
+		count = interpreter->instructionCount;
+		statementsTimer.Start();
+		for( j = 0; j < iterations; j++ ) {
+			interpreter->BenchmarkFunction( func, false );
+		}
+		statementsTimer.Stop();
+		statementsCount += interpreter->instructionCount - count;
+		memcpy( reference, variables, numVariables );
+
+		memcpy( variables, snapshot, numVariables );
+		count = interpreter->instructionCount;
+		threadedTimer.Start();
+		for( j = 0; j < iterations; j++ ) {
+			interpreter->BenchmarkFunction( func, true );
+		}
+		threadedTimer.Stop();
+		threadedCount += interpreter->instructionCount - count;
+
+		if ( memcmp( reference, variables, numVariables ) != 0 ) {
+			gameLocal.Printf( "^1mismatch in '%s'\n", func->Name() );
+			numMismatches++;
+		}
+	}
+
+	memcpy( variables, snapshot, numVariables );
+
+	delete interpreter;
+	delete thread;
+	delete[] reference;
+	delete[] snapshot;
+
+	gameLocal.Printf( "%d of %d script functions, %d iterations\n", numFunctions, numScriptFunctions, iterations );
+	gameLocal.Printf( "skipped %d writing through pointers or using float modulo, %d not returning within %d statements\n", numUnsafe, numRunaway, BENCHMARK_RUNAWAY );
+	gameLocal.Printf( "statements: %9d instructions in %8.2f ms, %7.2f Minstr/s\n", statementsCount, statementsTimer.Milliseconds(), statementsCount / Max( statementsTimer.Milliseconds(), 0.001 ) * 0.001 );
+	gameLocal.Printf( "threaded:   %9d instructions in %8.2f ms, %7.2f Minstr/s\n", threadedCount, threadedTimer.Milliseconds(), threadedCount / Max( threadedTimer.Milliseconds(), 0.001 ) * 0.001 );
+	if ( statementsCount != threadedCount ) {
+		gameLocal.Printf( "^1instruction counts differ\n" );
+		numMismatches++;
+	}
+	gameLocal.Printf( "%d mismatches\n", numMismatches );
+}
+
+/***********************************************************************
+
+  idScriptProfiler
+
+***********************************************************************/
+
+idScriptProfiler scriptProfiler;
+
+typedef struct scriptProfileFunction_s {
+	const function_t	*func;
+	int					calls;
+	int					instructions;
+	double				selfTicks;
+	double				inclusiveTicks;
+} scriptProfileFunction_t;
+
+typedef struct scriptProfileEventTotal_s {
+	const char			*name;
+	int					calls;
+	double				ticks;
+} scriptProfileEventTotal_t;
+
+static const idList<double> *sortInclusiveTicks;
+
+/*
+================
+SortFunctionsBySelfTime
+================
+*/
+static int SortFunctionsBySelfTime( const scriptProfileFunction_t *a, const scriptProfileFunction_t *b ) {
+	if ( a->selfTicks > b->selfTicks ) {
+		return -1;
+	}
+	return ( a->selfTicks < b->selfTicks ) ? 1 : 0;
+}
+
+/*
+================
+SortEventsByTime
+================
+*/
+static int SortEventsByTime( const scriptProfileEventTotal_t *a, const scriptProfileEventTotal_t *b ) {
+	if ( a->ticks > b->ticks ) {
+		return -1;
+	}
+	return ( a->ticks < b->ticks ) ? 1 : 0;
+}
+
+/*
+================
+SortNodesByInclusiveTime
+================
+*/
+static int SortNodesByInclusiveTime( const int *a, const int *b ) {
+	double ta = ( *sortInclusiveTicks )[ *a ];
+	double tb = ( *sortInclusiveTicks )[ *b ];
+	if ( ta > tb ) {
+		return -1;
+	}
+	return ( ta < tb ) ? 1 : 0;
+}
+
+/*
+================
+idScriptProfiler::idScriptProfiler
+================
+*/
+idScriptProfiler::idScriptProfiler() {
+	// nodes are allocated on first use, not during static initialization
+	generation = 0;
+}
+
+/*
+================
+idScriptProfiler::Clear
+================
+*/
+void idScriptProfiler::Clear( void ) {
+	nodes.Clear();
+	nodeHash.Clear();
+	events.Clear();
+	generation++;
+}
+
+/*
+================
+idScriptProfiler::GetNode
+
+Finds or adds the node for calling func from the parent node.  Passing -1 and NULL gives the root.
+================
+*/
+int idScriptProfiler::GetNode( int parent, const function_t *func ) {
+	int i;
+	int key;
+
+	key = nodeHash.GenerateKey( parent, func ? gameLocal.program.GetFunctionIndex( func ) : -1 );
+	for( i = nodeHash.First( key ); i != -1; i = nodeHash.Next( i ) ) {
+		if ( ( nodes[ i ].parent == parent ) && ( nodes[ i ].func == func ) ) {
+			return i;
+		}
+	}
+
+	scriptProfileNode_t &node = nodes.Alloc();
+	node.func = func;
+	node.parent = parent;
+	node.calls = 0;
+	node.instructions = 0;
+	node.selfTicks = 0.0;
+	nodeHash.Add( key, nodes.Num() - 1 );
+
+	return nodes.Num() - 1;
+}
+
+/*
+================
+idScriptProfiler::AddEventTime
+================
+*/
+void idScriptProfiler::AddEventTime( const idEventDef *evdef, double ticks ) {
+	int i;
+	int num;
+
+	num = evdef->GetEventNum();
+	if ( num >= events.Num() ) {
+		i = events.Num();
+		events.SetNum( idEventDef::NumEventCommands() );
+		for( ; i < events.Num(); i++ ) {
+			events[ i ].calls = 0;
+			events[ i ].ticks = 0.0;
+		}
+	}
+
+	events[ num ].calls++;
+	events[ num ].ticks += ticks;
+}
+
+/*
+================
+idScriptProfiler::WriteTree
+================
+*/
+void idScriptProfiler::WriteTree( idFile *file, int node, const idList<double> &inclusive, int depth ) const {
+	int			i;
+	double		toMsec;
+	idList<int>	children;
+
+	toMsec = 1000.0 / idLib::sys->ClockTicksPerSecond();
+
+	if ( nodes[ node ].func ) {
+		file->Printf( "%10.2f %10.2f %8d %12d  %*s%s\n", inclusive[ node ] * toMsec, nodes[ node ].selfTicks * toMsec,
+			nodes[ node ].calls, nodes[ node ].instructions, depth * 2, "", nodes[ node ].func->Name() );
+		depth++;
+	}
+
+	for( i = node + 1; i < nodes.Num(); i++ ) {
+		if ( nodes[ i ].parent == node ) {
+			children.Append( i );
+		}
+	}
+	sortInclusiveTicks = &inclusive;
+	children.Sort( SortNodesByInclusiveTime );
+
+	for( i = 0; i < children.Num(); i++ ) {
+		WriteTree( file, children[ i ], inclusive, depth );
+	}
+}
+
+/*
+================
+idScriptProfiler::WriteReport
+
+Writes the flat per function totals, the inclusive call tree and the event times
+================
+*/
+void idScriptProfiler::WriteReport( const char *filename ) const {
+	int								i;
+	int								j;
+	int								index;
+	double							toMsec;
+	idFile							*file;
+	idList<double>					inclusive;
+	idList<int>						functionIndex;
+	idList<scriptProfileFunction_t>	functions;
+	idList<scriptProfileEventTotal_t> eventTotals;
+
+	if ( !nodes.Num() ) {
+		gameLocal.Printf( "no script profile recorded, set g_scriptProfile 1 first\n" );
+		return;
+	}
+
+	file = fileSystem->OpenFileWrite( filename );
+	if ( !file ) {
+		gameLocal.Warning( "couldn't open '%s'", filename );
+		return;
+	}
+
+	toMsec = 1000.0 / idLib::sys->ClockTicksPerSecond();
+
+	// children are always added after their parent
+	inclusive.SetNum( nodes.Num() );
+	for( i = 0; i < nodes.Num(); i++ ) {
+		inclusive[ i ] = nodes[ i ].selfTicks;
+	}
+	for( i = nodes.Num() - 1; i >= 0; i-- ) {
+		if ( nodes[ i ].parent >= 0 ) {
+			inclusive[ nodes[ i ].parent ] += inclusive[ i ];
+		}
+	}
+
+	// add up the nodes of each function, recursive calls only count once for the inclusive time
+	functionIndex.SetNum( gameLocal.program.NumFunctions() );
+	memset( functionIndex.Ptr(), -1, functionIndex.Num() * sizeof( int ) );
+	for( i = 0; i < nodes.Num(); i++ ) {
+		const scriptProfileNode_t &node = nodes[ i ];
+		if ( !node.func ) {
+			continue;
+		}
+		index = gameLocal.program.GetFunctionIndex( node.func );
+		if ( ( index < 0 ) || ( index >= functionIndex.Num() ) ) {
+			continue;
+		}
+		if ( functionIndex[ index ] < 0 ) {
+			functionIndex[ index ] = functions.Num();
+			scriptProfileFunction_t &total = functions.Alloc();
+			memset( &total, 0, sizeof( total ) );
+			total.func = node.func;
+		}
+		scriptProfileFunction_t &total = functions[ functionIndex[ index ] ];
+		total.calls += node.calls;
+		total.instructions += node.instructions;
+		total.selfTicks += node.selfTicks;
+		for( j = node.parent; j >= 0; j = nodes[ j ].parent ) {
+			if ( nodes[ j ].func == node.func ) {
+				break;
+			}
+		}
+		if ( j < 0 ) {
+			total.inclusiveTicks += inclusive[ i ];
+		}
+	}
+	functions.Sort( SortFunctionsBySelfTime );
+
+	file->Printf( "script profile, %.2f ms in script functions\n\n", inclusive[ 0 ] * toMsec );
+
+	file->Printf( "flat profile:\n\n" );
+	file->Printf( "   self ms    incl ms    calls instructions  function\n" );
+	for( i = 0; i < functions.Num(); i++ ) {
+		file->Printf( "%10.2f %10.2f %8d %12d  %s\n", functions[ i ].selfTicks * toMsec, functions[ i ].inclusiveTicks * toMsec,
+			functions[ i ].calls, functions[ i ].instructions, functions[ i ].func->Name() );
+	}
+
+	file->Printf( "\ncall tree:\n\n" );
+	file->Printf( "   incl ms    self ms    calls instructions  function\n" );
+	WriteTree( file, 0, inclusive, 0 );
+
+	for( i = 0; i < events.Num(); i++ ) {
+		if ( events[ i ].calls ) {
+			scriptProfileEventTotal_t &total = eventTotals.Alloc();
+			total.name = idEventDef::GetEventCommand( i )->GetName();
+			total.calls = events[ i ].calls;
+			total.ticks = events[ i ].ticks;
+		}
+	}
+	eventTotals.Sort( SortEventsByTime );
+
+	file->Printf( "\nevents called from scripts:\n\n" );
+	file->Printf( "        ms    calls  event\n" );
+	for( i = 0; i < eventTotals.Num(); i++ ) {
+		file->Printf( "%10.2f %8d  %s\n", eventTotals[ i ].ticks * toMsec, eventTotals[ i ].calls, eventTotals[ i ].name );
+	}
+
+	fileSystem->CloseFile( file );
+
+	gameLocal.Printf( "wrote script profile to '%s'\n", filename );
+}
+
+/*
+================
+idScriptProfiler::Profile_f
+================
+*/
+void idScriptProfiler::Profile_f( const idCmdArgs &args ) {
+	if ( !idStr::Icmp( args.Argv( 1 ), "clear" ) ) {
+		scriptProfiler.Clear();
+	} else if ( !idStr::Icmp( args.Argv( 1 ), "report" ) ) {
+		scriptProfiler.WriteReport( ( args.Argc() > 2 ) ? args.Argv( 2 ) : "script/profile.txt" );
+	} else {
+		gameLocal.Printf( "usage: scriptProfile <clear|report> [filename]\n" );
+	}
+}
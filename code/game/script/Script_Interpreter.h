@@ -13,6 +13,53 @@ typedef struct prstack_s {
 	int 				stackbase;
 } prstack_t;
 
+/***********************************************************************
+
+idScriptProfiler
+
+Collects the time spent in script functions for g_scriptProfile.  Every call path gets its own
+node, so the report can show both the flat per function totals and the inclusive call tree.
+
+***********************************************************************/
+
+typedef struct scriptProfileNode_s {
+	const function_t	*func;				// NULL for the root
+	int					parent;				// -1 for the root
+	int					calls;
+	int					instructions;
+	double				selfTicks;			// time spent in the function itself and the events it called
+} scriptProfileNode_t;
+
+typedef struct scriptProfileEvent_s {
+	int					calls;
+	double				ticks;
+} scriptProfileEvent_t;
+
+class idScriptProfiler {
+public:
+								idScriptProfiler();
+
+	void						Clear( void );
+	int							GetGeneration( void ) const { return generation; }
+	int							GetNode( int parent, const function_t *func );
+	scriptProfileNode_t			&GetNode( int index ) { return nodes[ index ]; }
+	int							GetParent( int index ) const { return nodes[ index ].parent; }
+	void						AddEventTime( const idEventDef *evdef, double ticks );
+	void						WriteReport( const char *filename ) const;
+
+	static void					Profile_f( const idCmdArgs &args );
+
+private:
+	idList<scriptProfileNode_t>	nodes;
+	idHashIndex					nodeHash;
+	idList<scriptProfileEvent_t> events;	// indexed by event number
+	int							generation;	// changes when the nodes are cleared
+
+	void						WriteTree( idFile *file, int node, const idList<double> &inclusive, int depth ) const;
+};
+
+extern idScriptProfiler			scriptProfiler;
+
 class idInterpreter {
 private:
 	prstack_t			callStack[ MAX_STACK_DEPTH ];
@@ -33,6 +80,17 @@ private:
 
 	idThread			*thread;
 
+	int					instructionCount;		// statements run by this interpreter, for scriptBenchmark
+	bool				benchmarking;			// inside BenchmarkFunction, warnings are not printed
+	bool				benchmarkRunaway;		// the last benchmarked function hit the runaway limit
+
+	bool				interpreting;			// inside ExecuteStatements or ExecuteThreaded called from Execute
+
+	bool				profiling;				// inside Execute with g_scriptProfile set
+	int					profileNode;			// scriptProfiler node of the current call path, or -1
+	int					profileGeneration;
+	double				profileTicks;			// when the time of the current node was last added up
+
 	void		PushVector(const idVec3& vector);
 	void				PopParms( int numParms );
 	void				PushString( const char *string );
@@ -44,16 +102,33 @@ private:
 	void				SetString( idVarDef *def, const char *from );
 	const char			*GetString( idVarDef *def );
 	varEval_t			GetVariable( idVarDef *def );
+	varEval_t			GetThreadedVariable( const varEval_t &operand, int stackOperand );
 	idEntity			*GetEntity( int entnum ) const;
 	idScriptObject		*GetScriptObject( int entnum ) const;
 	void				NextInstruction( int position );
 
 	void				LeaveFunction( idVarDef *returnDef );
+	bool				MarshalEventArgs( const idEventDef *evdef, int start, intptr_t data[ D_EVENT_MAXARGS ] );
 	void				CallEvent( const function_t *func, int argsize );
 	void				CallSysEvent( const function_t *func, int argsize );
 
+	template< bool benchmark >
+	void				ExecuteStatement( statement_t *st );
+	template< bool benchmark >
+	bool				ExecuteStatements( void );
+	template< bool benchmark >
+	bool				ExecuteThreaded( void );
+	bool				ExecuteNative( void );
+	void				CheckNativeSwitch( void );
+	void				BenchmarkCall( int argSize );
+	void				BenchmarkFunction( const function_t *func, bool threaded );
+
+	int					GetProfileNode( void );
+	void				AddProfileTime( void );
+
 public:
 	bool				doneProcessing;
+	bool				nativeSwitch;			// stopped only to switch between ExecuteNative and the interpreter loops
 	bool				threadDying;
 	bool				terminateOnExit;
 	bool				debug;
@@ -95,6 +170,8 @@ public:
 	const function_t	*GetCurrentFunction( void ) const;
 	idThread			*GetThread( void ) const;
 
+	static void			Benchmark_f( const idCmdArgs &args );
+
 };
 
 /*
@@ -207,6 +284,21 @@ ID_INLINE varEval_t idInterpreter::GetVariable( idVarDef *def ) {
 	}
 }
 
+/*
+================
+idInterpreter::GetThreadedVariable
+================
+*/
+ID_INLINE varEval_t idInterpreter::GetThreadedVariable( const varEval_t &operand, int stackOperand ) {
+	if ( stackOperand ) {
+		varEval_t val;
+		val.intPtr = ( int * )&localstack[ localstackBase + operand.stackOffset ];
+		return val;
+	} else {
+		return operand;
+	}
+}
+
 /*
 ================
 idInterpreter::GetEntity
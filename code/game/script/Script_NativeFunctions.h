@@ -0,0 +1,9 @@
+// Native script functions written by scriptWriteNative, see idProgram::WriteNativeFunctions.
+//
+// This checked-in table is empty, so g_scriptNative links nothing until it is replaced.  Run
+// scriptWriteNative with the shipped scripts loaded and copy <fs_savepath>/script/Script_NativeFunctions.h
+// over this file to compile them into the game.
+
+static const scriptNativeFunction_t scriptNativeFunctions[] = {
+	{ NULL, 0, NULL }
+};
@@ -5,6 +5,7 @@
 #pragma hdrstop
 
 #include "../Game_local.h"
+#include "Script_NativeFunctions.h"
 
 //#define _HH_GLOBAL_COUNTER //HUMANHEAD rww
 
@@ -104,6 +105,8 @@ void function_t::Clear( void ) {
 	type			= NULL;
 	firstStatement	= 0;
 	numStatements	= 0;
+	numUnoptimizedStatements = 0;
+	nativeFunc		= NULL;
 	parmTotal		= 0;
 	locals			= 0;
 	filenum			= 0;
@@ -1653,6 +1656,7 @@ void idProgram::SetEntity( const char *name, idEntity *ent ) {
 		if ( !ent ) {
 			*def->value.entityNumberPtr = 0;
 		} else {
+			ent->scriptHandle = true;
 			*def->value.entityNumberPtr = ent->entityNumber + 1;
 		}
 	}
@@ -1670,6 +1674,125 @@ statement_t *idProgram::AllocStatement( void ) {
 	return statements.Alloc();
 }
 
+/*
+================
+idProgram::FreeStatements
+
+Drops the statements from num on, used by the compiler when it shortens the last function.
+================
+*/
+void idProgram::FreeStatements( int num ) {
+	assert( ( num >= 0 ) && ( num <= statements.Num() ) );
+	statements.SetNum( num );
+
+	// the statement before num may have been fused with a freed one
+	if ( threadedCode.Num() >= num ) {
+		threadedCode.SetNum( Max( num - 1, 0 ), false );
+	}
+}
+
+/*
+================
+DecodeOperand
+================
+*/
+static void DecodeOperand( const idVarDef *def, varEval_t &operand, unsigned short &stackOperands, int stackFlag ) {
+	if ( !def ) {
+		operand.highPtr = 0;
+	} else if ( def->initialized == idVarDef::stackVariable ) {
+		operand.highPtr = 0;
+		operand.stackOffset = def->value.stackOffset;
+		stackOperands |= stackFlag;
+	} else {
+		operand = def->value;
+	}
+}
+
+/*
+================
+FuseStatements
+
+Returns the superinstruction that executes both statements, or the opcode of the first one
+================
+*/
+static int FuseStatements( const statement_t &first, const statement_t &second ) {
+	if ( second.op == OP_IFNOT && second.a == first.c ) {
+		switch( first.op ) {
+			case OP_EQ_F:	return OP_EQ_F_IFNOT;
+			case OP_NE_F:	return OP_NE_F_IFNOT;
+			case OP_LT:		return OP_LT_IFNOT;
+			case OP_LE:		return OP_LE_IFNOT;
+			case OP_GT:		return OP_GT_IFNOT;
+			case OP_GE:		return OP_GE_IFNOT;
+		}
+	}
+
+	if ( first.op == OP_ADDRESS && second.b == first.c ) {
+		switch( second.op ) {
+			case OP_STOREP_F:		return OP_ADDRESS_STOREP_F;
+			case OP_STOREP_V:		return OP_ADDRESS_STOREP_V;
+			case OP_STOREP_ENT:
+			case OP_STOREP_FLD:
+			case OP_STOREP_BOOL:
+			case OP_STOREP_OBJ:		return OP_ADDRESS_STOREP_INT;
+		}
+	}
+
+	switch( first.op ) {
+		case OP_INDIRECT_F:
+		case OP_INDIRECT_ENT:
+		case OP_INDIRECT_BOOL:
+		case OP_INDIRECT_OBJ:
+			if ( second.a == first.c ) {
+				switch( second.op ) {
+					case OP_PUSH_F:
+					case OP_PUSH_ENT:
+					case OP_PUSH_OBJ:
+					case OP_PUSH_OBJENT:
+						return OP_INDIRECT_PUSH;
+				}
+			}
+			break;
+	}
+
+	return first.op;
+}
+
+/*
+================
+idProgram::DecodeStatements
+
+Resolves the operands of the statements that aren't in the threaded code yet, so the
+interpreter doesn't have to look at their defs, and fuses common pairs of statements into
+superinstructions.  The second statement of a pair keeps its own entry so that jumps to it
+still work.
+================
+*/
+void idProgram::DecodeStatements( void ) {
+	int					i;
+	int					start;
+	threadedStatement_t	*ts;
+
+	start = threadedCode.Num();
+	threadedCode.SetNum( statements.Num(), false );
+
+	for( i = start; i < statements.Num(); i++ ) {
+		const statement_t &st = statements[ i ];
+
+		ts = &threadedCode[ i ];
+		ts->op = st.op;
+		ts->stackOperands = 0;
+		DecodeOperand( st.a, ts->a, ts->stackOperands, THREADED_STACK_A );
+		DecodeOperand( st.b, ts->b, ts->stackOperands, THREADED_STACK_B );
+		DecodeOperand( st.c, ts->c, ts->stackOperands, THREADED_STACK_C );
+	}
+
+	// the last statement decoded previously had nothing to pair with
+	for( i = Max( start - 1, 0 ); i < statements.Num() - 1; i++ ) {
+		threadedCode[ i ].op = FuseStatements( statements[ i ], statements[ i + 1 ] );
+	}
+}
+
 /*
 ==============
 idProgram::BeginCompilation
@@ -1795,6 +1918,8 @@ void idProgram::FinishCompilation( void ) {
 	for( i = 0; i < numVariables; i++ ) {
 		variableDefaults[ i ] = variables[ i ];
 	}
+
+	LinkNativeFunctions();
 }
 
 /*
@@ -1967,6 +2092,8 @@ idProgram::FreeData
 void idProgram::FreeData( void ) {
 	int i;
 
+	scriptProfiler.Clear();
+
 	// free the defs
 	varDefs.DeleteContents( true );
 	varDefNames.DeleteContents( true );
@@ -1992,6 +2119,7 @@ void idProgram::FreeData( void ) {
 	filename.Clear();
 	fileList.Clear();
 	statements.Clear();
+	threadedCode.Clear();
 	functions.Clear();
 
 	top_functions	= 0;
@@ -2174,6 +2302,9 @@ void idProgram::Restart( void ) {
 
 	idThread::Restart();
 
+	// the profile points at functions that are about to be freed
+	scriptProfiler.Clear();
+
 	//
 	// since there may have been a script loaded by the map or the user may
 	// have typed "script" from the console, free up any types and vardefs that
@@ -2195,6 +2326,7 @@ void idProgram::Restart( void ) {
 	functions.SetNum( top_functions	);
 
 	statements.SetNum( top_statements );
+	threadedCode.SetNum( 0, false );
 	fileList.SetNum( top_files, false );
 	filename.Clear();
 	
@@ -2254,10 +2386,338 @@ idProgram::ReturnEntity
 ================
 */
 void idProgram::ReturnEntity( idEntity *ent ) {
-	if ( ent ) {
+	// entities parked in the entity pool stay out of reach of the scripts
+	if ( ent && !ent->inEntityPool ) {
+		ent->scriptHandle = true;
 		assert(ent->entityNumber + 1 <= MAX_GENTITIES);
 		*returnDef->value.entityNumberPtr = ent->entityNumber + 1;
 	} else {
 		*returnDef->value.entityNumberPtr = 0;
 	}
 }
+
+/***********************************************************************
+
+  Native functions
+
+***********************************************************************/
+
+/*
+================
+NativeCode
+
+Returns the C++ generated for an opcode, with $a, $b and $c standing for the operands, or NULL
+if the statement has to be run by the interpreter.  Jumps are handled by the caller.
+================
+*/
+static const char *NativeCode( int op ) {
+	switch( op ) {
+		case OP_ADD_F:			return "F( $c ) = F( $a ) + F( $b );";
+		case OP_ADD_V:			return "V( $c ) = V( $a ) + V( $b );";
+		case OP_SUB_F:			return "F( $c ) = F( $a ) - F( $b );";
+		case OP_SUB_V:			return "V( $c ) = V( $a ) - V( $b );";
+		case OP_MUL_F:			return "F( $c ) = F( $a ) * F( $b );";
+		case OP_MUL_V:			return "F( $c ) = V( $a ) * V( $b );";
+		case OP_MUL_FV:			return "V( $c ) = F( $a ) * V( $b );";
+		case OP_MUL_VF:			return "V( $c ) = V( $a ) * F( $b );";
+		case OP_BITAND:			return "F( $c ) = static_cast<int>( F( $a ) ) & static_cast<int>( F( $b ) );";
+		case OP_BITOR:			return "F( $c ) = static_cast<int>( F( $a ) ) | static_cast<int>( F( $b ) );";
+		case OP_GE:				return "F( $c ) = ( F( $a ) >= F( $b ) );";
+		case OP_LE:				return "F( $c ) = ( F( $a ) <= F( $b ) );";
+		case OP_GT:				return "F( $c ) = ( F( $a ) > F( $b ) );";
+		case OP_LT:				return "F( $c ) = ( F( $a ) < F( $b ) );";
+		case OP_EQ_F:			return "F( $c ) = ( F( $a ) == F( $b ) );";
+		case OP_NE_F:			return "F( $c ) = ( F( $a ) != F( $b ) );";
+		case OP_EQ_V:			return "F( $c ) = ( V( $a ) == V( $b ) );";
+		case OP_NE_V:			return "F( $c ) = ( V( $a ) != V( $b ) );";
+		case OP_EQ_E:
+		case OP_EQ_EO:
+		case OP_EQ_OE:
+		case OP_EQ_OO:			return "F( $c ) = ( I( $a ) == I( $b ) );";
+		case OP_NE_E:
+		case OP_NE_EO:
+		case OP_NE_OE:
+		case OP_NE_OO:			return "F( $c ) = ( I( $a ) != I( $b ) );";
+		case OP_AND:			return "F( $c ) = ( F( $a ) != 0.0f ) && ( F( $b ) != 0.0f );";
+		case OP_AND_BOOLF:		return "F( $c ) = ( I( $a ) != 0 ) && ( F( $b ) != 0.0f );";
+		case OP_AND_FBOOL:		return "F( $c ) = ( F( $a ) != 0.0f ) && ( I( $b ) != 0 );";
+		case OP_AND_BOOLBOOL:	return "F( $c ) = ( I( $a ) != 0 ) && ( I( $b ) != 0 );";
+		case OP_OR:				return "F( $c ) = ( F( $a ) != 0.0f ) || ( F( $b ) != 0.0f );";
+		case OP_OR_BOOLF:		return "F( $c ) = ( I( $a ) != 0 ) || ( F( $b ) != 0.0f );";
+		case OP_OR_FBOOL:		return "F( $c ) = ( F( $a ) != 0.0f ) || ( I( $b ) != 0 );";
+		case OP_OR_BOOLBOOL:	return "F( $c ) = ( I( $a ) != 0 ) || ( I( $b ) != 0 );";
+		case OP_NOT_BOOL:		return "F( $c ) = ( I( $a ) == 0 );";
+		case OP_NOT_F:			return "F( $c ) = ( F( $a ) == 0.0f );";
+		case OP_NOT_V:			return "F( $c ) = ( V( $a ) == vec3_zero );";
+		case OP_NEG_F:			return "F( $c ) = -F( $a );";
+		case OP_NEG_V:			return "V( $c ) = -V( $a );";
+		case OP_INT_F:			return "F( $c ) = static_cast<int>( F( $a ) );";
+		case OP_COMP_F:			return "F( $c ) = ~static_cast<int>( F( $a ) );";
+		case OP_UADD_F:			return "F( $b ) += F( $a );";
+		case OP_UADD_V:			return "V( $b ) += V( $a );";
+		case OP_USUB_F:			return "F( $b ) -= F( $a );";
+		case OP_USUB_V:			return "V( $b ) -= V( $a );";
+		case OP_UMUL_F:			return "F( $b ) *= F( $a );";
+		case OP_UMUL_V:			return "V( $b ) *= F( $a );";
+		case OP_UOR_F:			return "F( $b ) = static_cast<int>( F( $b ) ) | static_cast<int>( F( $a ) );";
+		case OP_UAND_F:			return "F( $b ) = static_cast<int>( F( $b ) ) & static_cast<int>( F( $a ) );";
+		case OP_UINC_F:			return "F( $a )++;";
+		case OP_UDEC_F:			return "F( $a )--;";
+		case OP_STORE_F:		return "F( $b ) = F( $a );";
+		case OP_STORE_V:		return "V( $b ) = V( $a );";
+		case OP_STORE_ENT:
+		case OP_STORE_BOOL:
+		case OP_STORE_OBJ:
+		case OP_STORE_ENTOBJ:	return "I( $b ) = I( $a );";
+		case OP_STORE_FTOBOOL:	return "I( $b ) = ( F( $a ) != 0.0f ) ? 1 : 0;";
+		case OP_STORE_BOOLTOF:	return "F( $b ) = static_cast<float>( I( $a ) );";
+	}
+	return NULL;
+}
+
+/*
+================
+idProgram::GetNativeOperand
+
+Gets the expression generated code uses to address a local or a global
+================
+*/
+bool idProgram::GetNativeOperand( const idVarDef *def, idStr &operand ) const {
+	if ( def->initialized == idVarDef::stackVariable ) {
+		sprintf( operand, "stack + %d", def->value.stackOffset );
+		return true;
+	}
+	if ( ( def->value.bytePtr >= variables ) && ( def->value.bytePtr < variables + numVariables ) ) {
+		sprintf( operand, "globals + %d", static_cast<int>( def->value.bytePtr - variables ) );
+		return true;
+	}
+	return false;
+}
+
+/*
+================
+idProgram::GetNativeStatement
+
+Gets the generated code of a statement, and the relative statement it jumps to, or -1.
+Returns false if the statement has to be run by the interpreter.
+================
+*/
+bool idProgram::GetNativeStatement( const function_t *func, int index, idStr &code, int &jump ) const {
+	const statement_t	&st = statements[ func->firstStatement + index ];
+	const char			*text;
+	idStr				a;
+	idStr				b;
+	idStr				c;
+
+	jump = -1;
+
+	switch( st.op ) {
+		case OP_IF:
+		case OP_IFNOT:
+			if ( !GetNativeOperand( st.a, a ) ) {
+				return false;
+			}
+			jump = index + st.b->value.jumpOffset;
+			sprintf( code, "if ( I( %s ) %s 0 )", a.c_str(), ( st.op == OP_IF ) ? "!=" : "==" );
+			break;
+
+		case OP_GOTO:
+			jump = index + st.a->value.jumpOffset;
+			code.Empty();
+			break;
+
+		default:
+			text = NativeCode( st.op );
+			if ( !text ) {
+				return false;
+			}
+			if ( ( st.a && !GetNativeOperand( st.a, a ) ) || ( st.b && !GetNativeOperand( st.b, b ) ) || ( st.c && !GetNativeOperand( st.c, c ) ) ) {
+				return false;
+			}
+			code = text;
+			code.Replace( "$a", a );
+			code.Replace( "$b", b );
+			code.Replace( "$c", c );
+			break;
+	}
+
+	if ( ( jump >= 0 ) && ( jump >= func->numStatements ) ) {
+		return false;
+	}
+
+	return true;
+}
+
+/*
+================
+idProgram::NumNativeStatements
+================
+*/
+int idProgram::NumNativeStatements( const function_t *func ) const {
+	int		i;
+	int		jump;
+	int		num;
+	idStr	code;
+
+	num = 0;
+	for( i = 0; i < func->numStatements; i++ ) {
+		if ( GetNativeStatement( func, i, code, jump ) ) {
+			num++;
+		}
+	}
+	return num;
+}
+
+/*
+================
+idProgram::NativeChecksum
+
+Checksum of everything the generated code of a function depends on
+================
+*/
+int idProgram::NativeChecksum( const function_t *func ) const {
+	int			i;
+	int			jump;
+	idStr		code;
+	idList<int>	data;
+
+	data.SetGranularity( 256 );
+	data.Append( func->numStatements );
+	for( i = 0; i < func->numStatements; i++ ) {
+		data.Append( statements[ func->firstStatement + i ].op );
+		if ( GetNativeStatement( func, i, code, jump ) ) {
+			data.Append( jump );
+			data.Append( code.Length() );
+			data.Append( idStr::Hash( code ) );
+		}
+	}
+
+	return MD4_BlockChecksum( data.Ptr(), data.Num() * sizeof( int ) );
+}
+
+/*
+================
+idProgram::WriteNativeFunctions
+
+Translates the script functions to C++ for Script_NativeFunctions.h.  The file is written under
+fs_savepath and has to be copied over game/script/Script_NativeFunctions.h.  The generated functions
+run the statements they can from the given statement on, and return the statement the
+interpreter has to run next, so calls, events and waits still go through the interpreter.
+Backward jumps also return to the interpreter so it keeps counting runaway loops.
+================
+*/
+void idProgram::WriteNativeFunctions( const char *filename ) const {
+	int					i;
+	int					j;
+	int					jump;
+	int					numWritten;
+	const function_t	*func;
+	idFile				*file;
+	idStr				code;
+	idList<bool>		jumpedTo;
+
+	file = fileSystem->OpenFileWrite( filename );
+	if ( !file ) {
+		gameLocal.Warning( "couldn't open '%s'", filename );
+		return;
+	}
+
+	file->Printf( "// Native script functions written by scriptWriteNative, see idProgram::WriteNativeFunctions.\n" );
+	file->Printf( "//\n\n" );
+	file->Printf( "#define F( p )	( *reinterpret_cast<float *>( p ) )\n" );
+	file->Printf( "#define V( p )	( *reinterpret_cast<idVec3 *>( p ) )\n" );
+	file->Printf( "#define I( p )	( *reinterpret_cast<int *>( p ) )\n" );
+
+	numWritten = 0;
+	for( i = 0; i < functions.Num(); i++ ) {
+		func = &functions[ i ];
+
+		// skip the functions that would go straight back to the interpreter
+		if ( func->eventdef || !NumNativeStatements( func ) ) {
+			continue;
+		}
+
+		jumpedTo.SetNum( func->numStatements );
+		memset( jumpedTo.Ptr(), 0, func->numStatements * sizeof( bool ) );
+		for( j = 0; j < func->numStatements; j++ ) {
+			if ( GetNativeStatement( func, j, code, jump ) && ( jump > j ) ) {
+				jumpedTo[ jump ] = true;
+			}
+		}
+
+		file->Printf( "\n/*\n================\n%s\n================\n*/\n", func->Name() );
+		file->Printf( "static int ScriptNative_%d( int statement, byte *stack, byte *globals ) {\n", numWritten );
+		file->Printf( "\tswitch( statement ) {\n" );
+		for( j = 0; j < func->numStatements; j++ ) {
+			file->Printf( jumpedTo[ j ] ? "\tcase %d: s%d:\n" : "\tcase %d:\n", j, j );
+			if ( !GetNativeStatement( func, j, code, jump ) ) {
+				file->Printf( "\t\treturn %d;\n", j );
+			} else if ( jump < 0 ) {
+				file->Printf( "\t\t%s\n", code.c_str() );
+			} else if ( code.Length() ) {
+				file->Printf( ( jump > j ) ? "\t\t%s goto s%d;\n" : "\t\t%s return %d;\n", code.c_str(), jump );
+			} else {
+				file->Printf( ( jump > j ) ? "\t\tgoto s%d;\n" : "\t\treturn %d;\n", jump );
+			}
+		}
+		file->Printf( "\t}\n\treturn statement;\n}\n" );
+		numWritten++;
+	}
+
+	file->Printf( "\n#undef F\n#undef V\n#undef I\n\n" );
+	file->Printf( "static const scriptNativeFunction_t scriptNativeFunctions[] = {\n" );
+	for( i = 0, j = 0; i < functions.Num(); i++ ) {
+		func = &functions[ i ];
+		if ( !func->eventdef && NumNativeStatements( func ) ) {
+			file->Printf( "\t{ \"%s\", %d, ScriptNative_%d },\n", func->Name(), NativeChecksum( func ), j++ );
+		}
+	}
+	file->Printf( "\t{ NULL, 0, NULL }\n};\n" );
+
+	fileSystem->CloseFile( file );
+
+	gameLocal.Printf( "wrote %d native script functions to '%s'\n", numWritten, fileSystem->RelativePathToOSPath( filename, "fs_savepath" ) );
+}
+
+/*
+================
+idProgram::LinkNativeFunctions
+
+Points the functions at their native code from Script_NativeFunctions.h, as long as their
+statements haven't changed since it was written.
+================
+*/
+void idProgram::LinkNativeFunctions( void ) {
+	int			i;
+	int			j;
+	int			numNative;
+	int			numLinked;
+	function_t	*func;
+	idHashIndex	nameHash;
+
+	for( numNative = 0; scriptNativeFunctions[ numNative ].name; numNative++ ) {
+		nameHash.Add( idStr::Hash( scriptNativeFunctions[ numNative ].name ), numNative );
+	}
+
+	numLinked = 0;
+	for( i = 0; i < functions.Num(); i++ ) {
+		func = &functions[ i ];
+		func->nativeFunc = NULL;
+		if ( !numNative || !g_scriptNative.GetBool() || func->eventdef ) {
+			continue;
+		}
+		for( j = nameHash.First( idStr::Hash( func->Name() ) ); j != -1; j = nameHash.Next( j ) ) {
+			if ( !idStr::Cmp( scriptNativeFunctions[ j ].name, func->Name() ) ) {
+				if ( scriptNativeFunctions[ j ].checksum == NativeChecksum( func ) ) {
+					func->nativeFunc = scriptNativeFunctions[ j ].func;
+					numLinked++;
+				}
+				break;
+			}
+		}
+	}
+
+	if ( numNative && g_scriptNative.GetBool() ) {
+		gameLocal.Printf( "linked %d of %d native script functions\n", numLinked, numNative );
+	}
+}
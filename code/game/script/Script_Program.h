@@ -32,6 +32,15 @@ typedef enum {
 	ev_error = -1, ev_void, ev_scriptevent, ev_namespace, ev_string, ev_float, ev_vector, ev_entity, ev_field, ev_function, ev_virtualfunction, ev_pointer, ev_object, ev_jumpoffset, ev_argsize, ev_boolean
 } etype_t;
 
+// runs the statements it can from statement on, and returns the statement the interpreter has to run next
+typedef int (*scriptNativeFunc_t)( int statement, byte *stack, byte *globals );
+
+typedef struct scriptNativeFunction_s {
+	const char			*name;
+	int					checksum;
+	scriptNativeFunc_t	func;
+} scriptNativeFunction_t;
+
 class function_t {
 public:
 						function_t();
@@ -49,10 +58,12 @@ public:
 	const idTypeDef		*type;
 	int 				firstStatement;
 	int 				numStatements;
+	int					numUnoptimizedStatements;	// as emitted, before idCompiler::OptimizeFunction
 	int 				parmTotal;
 	int 				locals; 			// total ints of parms + locals
 	int					filenum; 			// source file defined in
 	idList<int>			parmSize;
+	scriptNativeFunc_t	nativeFunc;			// set by idProgram::LinkNativeFunctions
 };
 
 typedef union eval_s {
@@ -465,6 +476,20 @@ typedef struct statement_s {
 	unsigned short	file;
 } statement_t;
 
+// stackOperands flags
+#define THREADED_STACK_A		BIT( 0 )
+#define THREADED_STACK_B		BIT( 1 )
+#define THREADED_STACK_C		BIT( 2 )
+
+// statement with its operands resolved ahead of time for idInterpreter::ExecuteThreaded
+typedef struct threadedStatement_s {
+	unsigned short	op;					// opcode or superinstruction
+	unsigned short	stackOperands;		// operands holding a stack offset instead of an address
+	varEval_t		a;
+	varEval_t		b;
+	varEval_t		c;
+} threadedStatement_t;
+
 /***********************************************************************
 
 idProgram
@@ -487,6 +512,7 @@ private:
 	idStaticList<byte,MAX_GLOBALS>				variableDefaults;
 	idStaticList<function_t,MAX_FUNCS>			functions;
 	idStaticList<statement_t,MAX_STATEMENTS>	statements;
+	idList<threadedStatement_t>					threadedCode;
 	idList<idTypeDef *>							types;
 	idList<idVarDefName *>						varDefNames;
 	idHashIndex									varDefNameHash;
@@ -501,6 +527,11 @@ private:
 	int											top_files;
 
 	void										CompileStats( void );
+	void										DecodeStatements( void );
+	bool										GetNativeOperand( const idVarDef *def, idStr &operand ) const;
+	bool										GetNativeStatement( const function_t *func, int index, idStr &code, int &jump ) const;
+	int											NumNativeStatements( const function_t *func ) const;
+	void										LinkNativeFunctions( void );
 
 public:
 	idVarDef									*returnDef;
@@ -524,6 +555,8 @@ public:
 	void										FinishCompilation( void );
 	void										DisassembleStatement( idFile *file, int instructionPointer ) const;
 	void										Disassemble( void ) const;
+	int											NativeChecksum( const function_t *func ) const;
+	void										WriteNativeFunctions( const char *filename ) const;
 	void										FreeData( void );
 
 	const char									*GetFilename( int num );
@@ -552,8 +585,13 @@ public:
 	void										SetEntity( const char *name, idEntity *ent );
 
 	statement_t									*AllocStatement( void );
+	void										FreeStatements( int num );
 	statement_t									&GetStatement( int index );
 	int											NumStatements( void ) { return statements.Num(); }
+	const threadedStatement_t					&GetThreadedStatement( int index );
+	int											NumFunctions( void ) const { return functions.Num(); }
+	byte										*GetVariables( void ) { return variables; }
+	int											NumVariables( void ) const { return numVariables; }
 
 	int 										GetReturnedInteger( void );
 
@@ -583,6 +621,18 @@ ID_INLINE statement_t &idProgram::GetStatement( int index ) {
 	return statements[ index ];
 }
 
+/*
+================
+idProgram::GetThreadedStatement
+================
+*/
+ID_INLINE const threadedStatement_t &idProgram::GetThreadedStatement( int index ) {
+	if ( index >= threadedCode.Num() ) {
+		DecodeStatements();
+	}
+	return threadedCode[ index ];
+}
+
 /*
 ================
 idProgram::GetFunction
@@ -958,6 +958,7 @@ idThread::Pause
 void idThread::Pause( void ) {
 	ClearWaitFor();
 	interpreter.doneProcessing = true;
+	interpreter.nativeSwitch = false;
 }
 
 /*
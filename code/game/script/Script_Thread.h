@@ -244,7 +244,7 @@ public:
 	static void					KillThread( int num );
 	bool						Execute( void );
 	void						ManualControl( void ) { manualControl = true; CancelEvents( &EV_Thread_Execute ); };
-	void						DoneProcessing( void ) { interpreter.doneProcessing = true; };
+	void						DoneProcessing( void ) { interpreter.doneProcessing = true; interpreter.nativeSwitch = false; };
 	void						ContinueProcessing( void ) { interpreter.doneProcessing = false; };
 	bool						ThreadDying( void ) { return interpreter.threadDying; };
 	void						EndThread( void ) { interpreter.threadDying = true; };
@@ -73,6 +73,9 @@ void idLib::ShutDown( void ) {
 	// shut down the string memory allocator
 	idStr::ShutdownMemory();
 
+	// free the systems captured for testLCP
+	idLCP::Shutdown();
+
 	// shut down the SIMD engine
 	idSIMD::Shutdown();
 
@@ -5,14 +5,176 @@
 #pragma hdrstop
 
 static idCVar lcp_showFailures( "lcp_showFailures", "0", CVAR_SYSTEM | CVAR_BOOL, "show LCP solver failures" );
+static idCVar lcp_blockedFactor( "lcp_blockedFactor", "1", CVAR_SYSTEM | CVAR_BOOL, "use a cache blocked LDLt factorization for large symmetric LCP systems" );
+static idCVar lcp_fallbackIterations( "lcp_fallbackIterations", "0", CVAR_SYSTEM | CVAR_INTEGER, "number of projected Gauss-Seidel iterations used to recover the forces when the pivoting LCP solver fails, 0 leaves the forces it could not solve for at zero", 0, 256 );
+static idCVar lcp_captureSystems( "lcp_captureSystems", "0", CVAR_SYSTEM | CVAR_INTEGER, "number of LCP systems to capture for testLCP, 0 frees the captured systems", 0, 1024 );
 
 const float LCP_BOUND_EPSILON			= 1e-5f;
 const float LCP_ACCEL_EPSILON			= 1e-5f;
 const float LCP_DELTA_ACCEL_EPSILON		= 1e-9f;
 const float LCP_DELTA_FORCE_EPSILON		= 1e-9f;
+const float LCP_PGS_EPSILON				= 1e-6f;
+
+const int LCP_BLOCK_SIZE				= 16;		// number of columns factored per panel
+const int LCP_BLOCK_FACTOR_MIN			= 32;		// smallest system factored with the blocked factorization
 
 #define IGNORE_UNSATISFIABLE_VARIABLES
 
+/*
+============
+LCP_LDLTFactorBlocked
+
+  Left looking LDLt factorization processed in panels of LCP_BLOCK_SIZE columns.
+  The updates from all previous panels are applied with SIMD dot products over
+  contiguous rows so each row of L only streams through the cache once per panel.
+  The result has the same layout as idSIMDProcessor::MatX_LDLTFactor.
+============
+*/
+static bool LCP_LDLTFactorBlocked( idMatX &mat, idVecX &invDiag, const int n ) {
+	int c0, c1, i, j, k, stride;
+	float *diag, *v, *w, *li, *lj, dot;
+	double sum, d;
+
+	diag = (float *) _alloca16( n * sizeof( float ) );
+	v = (float *) _alloca16( n * sizeof( float ) );
+	stride = ( n + 3 ) & ~3;
+	w = (float *) _alloca16( LCP_BLOCK_SIZE * stride * sizeof( float ) );
+
+	for ( c0 = 0; c0 < n; c0 = c1 ) {
+		c1 = Min( c0 + LCP_BLOCK_SIZE, n );
+
+		if ( c0 > 0 ) {
+			// rows of the panel scaled with the diagonal of the previous panels
+			for ( i = c0; i < c1; i++ ) {
+				SIMDProcessor->Mul( w + ( i - c0 ) * stride, mat[i], diag, c0 );
+			}
+
+			// apply the updates from the previous panels to the columns of this panel
+			for ( j = c0; j < n; j++ ) {
+				lj = mat[j];
+				for ( i = c0; i < c1 && i <= j; i++ ) {
+					SIMDProcessor->Dot( dot, lj, w + ( i - c0 ) * stride, c0 );
+					lj[i] -= dot;
+				}
+			}
+		}
+
+		// factor the panel
+		for ( i = c0; i < c1; i++ ) {
+			li = mat[i];
+
+			sum = li[i];
+			for ( k = c0; k < i; k++ ) {
+				v[k] = diag[k] * li[k];
+				sum -= v[k] * li[k];
+			}
+
+			if ( sum == 0.0f ) {
+				return false;
+			}
+
+			li[i] = sum;
+			diag[i] = sum;
+			invDiag[i] = d = 1.0f / sum;
+
+			for ( j = i + 1; j < n; j++ ) {
+				lj = mat[j];
+				sum = lj[i];
+				for ( k = c0; k < i; k++ ) {
+					sum -= v[k] * lj[k];
+				}
+				lj[i] = sum * d;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+============
+LCP_ProjectedGaussSeidel
+
+  Improves the forces in x with projected Gauss-Seidel iterations. The bounds of
+  variables with boxIndex[i] >= 0 are scaled with x[boxIndex[i]] as the iterations
+  progress. Returns the largest change of a force during the last iteration.
+============
+*/
+static float LCP_ProjectedGaussSeidel( float **rows, float *x, const float *b, const float *lo, const float *hi, const int *boxIndex, const int n, const int maxIterations ) {
+	int i, iter;
+	float dot, l, h, s, nx, delta, maxDelta;
+
+	maxDelta = 0.0f;
+	for ( iter = 0; iter < maxIterations; iter++ ) {
+		maxDelta = 0.0f;
+		for ( i = 0; i < n; i++ ) {
+			if ( rows[i][i] <= 0.0f ) {
+				x[i] = 0.0f;
+				continue;
+			}
+			SIMDProcessor->Dot( dot, rows[i], x, n );
+			nx = x[i] + ( b[i] - dot ) / rows[i][i];
+
+			l = lo[i];
+			h = hi[i];
+			if ( boxIndex && boxIndex[i] >= 0 ) {
+				s = x[boxIndex[i]];
+				if ( l != -idMath::INFINITY ) {
+					l = - idMath::Fabs( l * s );
+				}
+				if ( h != idMath::INFINITY ) {
+					h = idMath::Fabs( h * s );
+				}
+			}
+			if ( nx < l ) {
+				nx = l;
+			} else if ( nx > h ) {
+				nx = h;
+			}
+
+			delta = idMath::Fabs( nx - x[i] );
+			if ( delta > maxDelta ) {
+				maxDelta = delta;
+			}
+			x[i] = nx;
+		}
+		if ( maxDelta < LCP_PGS_EPSILON ) {
+			break;
+		}
+	}
+	return maxDelta;
+}
+
+/*
+============
+LCP_RecoverForces
+
+  Used when the pivoting solvers fail. Runs a few projected Gauss-Seidel
+  iterations over the permuted system instead of leaving the forces of
+  the remaining variables at zero.
+============
+*/
+static void LCP_RecoverForces( float **rowPtrs, idVecX &f, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex, const int *permuted, bool boxBoundsSet ) {
+	int i, n, *box, *invPermuted;
+
+	n = f.GetSize();
+
+	box = NULL;
+	if ( boxIndex && !boxBoundsSet ) {
+		// the box index refers to the unpermuted variables
+		invPermuted = (int *) _alloca16( n * sizeof( int ) );
+		for ( i = 0; i < n; i++ ) {
+			invPermuted[permuted[i]] = i;
+		}
+		box = (int *) _alloca16( n * sizeof( int ) );
+		for ( i = 0; i < n; i++ ) {
+			box[i] = ( boxIndex[i] >= 0 ) ? invPermuted[boxIndex[i]] : -1;
+		}
+	}
+
+	LCP_ProjectedGaussSeidel( rowPtrs, f.ToFloatPtr(), b.ToFloatPtr(), lo.ToFloatPtr(), hi.ToFloatPtr(), box, n, lcp_fallbackIterations.GetInteger() );
+}
+
 //===============================================================
 //                                                        M
 //  idLCP_Square                                         MrE
@@ -257,7 +419,7 @@ void idLCP_Square::RemoveClamped( int r ) {
 		diag += p0 * p1;
 
 		if ( diag == 0.0f ) {
-			idLib::common->Printf( "idLCP_Square::RemoveClamped: updating factorization failed\n" );
+			Failure( "idLCP_Square::RemoveClamped: updating factorization failed\n" );
 			return;
 		}
 
@@ -268,7 +430,7 @@ void idLCP_Square::RemoveClamped( int r ) {
 		diag += q0 * q1;
 
 		if ( diag == 0.0f ) {
-			idLib::common->Printf( "idLCP_Square::RemoveClamped: updating factorization failed\n" );
+			Failure( "idLCP_Square::RemoveClamped: updating factorization failed\n" );
 			return;
 		}
 
@@ -565,7 +727,7 @@ bool idLCP_Square::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, con
 
 		// factor and solve for unbounded variables
 		if ( !FactorClamped() ) {
-			idLib::common->Printf( "idLCP_Square::Solve: unbounded factorization failed\n" );
+			Failure( "idLCP_Square::Solve: unbounded factorization failed\n" );
 			return false;
 		}
 		SolveClamped( f, b.ToFloatPtr() );
@@ -709,7 +871,7 @@ bool idLCP_Square::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, con
 #ifdef IGNORE_UNSATISFIABLE_VARIABLES
 	if ( numIgnored ) {
 		if ( lcp_showFailures.GetBool() ) {
-			idLib::common->Printf( "idLCP_Symmetric::Solve: %d of %d bounded variables ignored\n", numIgnored, m.GetNumRows() - numUnbounded );
+			Failure( "idLCP_Symmetric::Solve: %d of %d bounded variables ignored\n", numIgnored, m.GetNumRows() - numUnbounded );
 		}
 	}
 #endif
@@ -717,11 +879,14 @@ bool idLCP_Square::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, con
 	// if failed clear remaining forces
 	if ( failed ) {
 		if ( lcp_showFailures.GetBool() ) {
-			idLib::common->Printf( "idLCP_Square::Solve: %s (%d of %d bounded variables ignored)\n", failed, m.GetNumRows() - i, m.GetNumRows() - numUnbounded );
+			Failure( "idLCP_Square::Solve: %s (%d of %d bounded variables ignored)\n", failed, m.GetNumRows() - i, m.GetNumRows() - numUnbounded );
 		}
 		for ( j = i; j < m.GetNumRows(); j++ ) {
 			f[j] = 0.0f;
 		}
+		if ( lcp_fallbackIterations.GetInteger() > 0 ) {
+			LCP_RecoverForces( rowPtrs, f, b, lo, hi, boxIndex, permuted, i >= boxStartIndex );
+		}
 	}
 
 #if defined(_DEBUG) && 0
@@ -824,6 +989,9 @@ bool idLCP_Symmetric::FactorClamped( void ) {
 	for ( int i = 0; i < numClamped; i++ ) {
 		memcpy( clamped[i], rowPtrs[i], numClamped * sizeof( float ) );
 	}
+	if ( numClamped >= LCP_BLOCK_FACTOR_MIN && lcp_blockedFactor.GetBool() ) {
+		return LCP_LDLTFactorBlocked( clamped, diagonal, numClamped );
+	}
 	return SIMDProcessor->MatX_LDLTFactor( clamped, diagonal, numClamped );
 }
 
@@ -913,7 +1081,7 @@ void idLCP_Symmetric::AddClamped( int r, bool useSolveCache ) {
 	d = rowPtrs[numClamped][numClamped] - dot;
 
 	if ( d == 0.0f ) {
-		idLib::common->Printf( "idLCP_Symmetric::AddClamped: updating factorization failed\n" );
+		Failure( "idLCP_Symmetric::AddClamped: updating factorization failed\n" );
 		numClamped++;
 		return;
 	}
@@ -958,7 +1126,7 @@ void idLCP_Symmetric::RemoveClamped( int r ) {
 		if ( numClamped == 1 ) {
 			diag = rowPtrs[0][0];
 			if ( diag == 0.0f ) {
-				idLib::common->Printf( "idLCP_Symmetric::RemoveClamped: updating factorization failed\n" );
+				Failure( "idLCP_Symmetric::RemoveClamped: updating factorization failed\n" );
 				return;
 			}
 			clamped[0][0] = diag;
@@ -990,7 +1158,7 @@ void idLCP_Symmetric::RemoveClamped( int r ) {
 			SIMDProcessor->Dot( dot, clamped[r], v, r );
 			diag = rowPtrs[r][r] - dot;
 			if ( diag == 0.0f ) {
-				idLib::common->Printf( "idLCP_Symmetric::RemoveClamped: updating factorization failed\n" );
+				Failure( "idLCP_Symmetric::RemoveClamped: updating factorization failed\n" );
 				return;
 			}
 			clamped[r][r] = diag;
@@ -1040,7 +1208,7 @@ void idLCP_Symmetric::RemoveClamped( int r ) {
 		newDiag = diag + alpha1 * p1 * p1;
 
 		if ( newDiag == 0.0f ) {
-			idLib::common->Printf( "idLCP_Symmetric::RemoveClamped: updating factorization failed\n" );
+			Failure( "idLCP_Symmetric::RemoveClamped: updating factorization failed\n" );
 			return;
 		}
 
@@ -1053,7 +1221,7 @@ void idLCP_Symmetric::RemoveClamped( int r ) {
 		newDiag = diag + alpha2 * p2 * p2;
 
 		if ( newDiag == 0.0f ) {
-			idLib::common->Printf( "idLCP_Symmetric::RemoveClamped: updating factorization failed\n" );
+			Failure( "idLCP_Symmetric::RemoveClamped: updating factorization failed\n" );
 			return;
 		}
 
@@ -1357,7 +1525,7 @@ bool idLCP_Symmetric::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b,
 
 		// factor and solve for unbounded variables
 		if ( !FactorClamped() ) {
-			idLib::common->Printf( "idLCP_Symmetric::Solve: unbounded factorization failed\n" );
+			Failure( "idLCP_Symmetric::Solve: unbounded factorization failed\n" );
 			return false;
 		}
 		SolveClamped( f, b.ToFloatPtr() );
@@ -1503,7 +1671,7 @@ bool idLCP_Symmetric::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b,
 #ifdef IGNORE_UNSATISFIABLE_VARIABLES
 	if ( numIgnored ) {
 		if ( lcp_showFailures.GetBool() ) {
-			idLib::common->Printf( "idLCP_Symmetric::Solve: %d of %d bounded variables ignored\n", numIgnored, m.GetNumRows() - numUnbounded );
+			Failure( "idLCP_Symmetric::Solve: %d of %d bounded variables ignored\n", numIgnored, m.GetNumRows() - numUnbounded );
 		}
 	}
 #endif
@@ -1511,11 +1679,14 @@ bool idLCP_Symmetric::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b,
 	// if failed clear remaining forces
 	if ( failed ) {
 		if ( lcp_showFailures.GetBool() ) {
-			idLib::common->Printf( "idLCP_Symmetric::Solve: %s (%d of %d bounded variables ignored)\n", failed, m.GetNumRows() - i, m.GetNumRows() - numUnbounded );
+			Failure( "idLCP_Symmetric::Solve: %s (%d of %d bounded variables ignored)\n", failed, m.GetNumRows() - i, m.GetNumRows() - numUnbounded );
 		}
 		for ( j = i; j < m.GetNumRows(); j++ ) {
 			f[j] = 0.0f;
 		}
+		if ( lcp_fallbackIterations.GetInteger() > 0 ) {
+			LCP_RecoverForces( rowPtrs, f, b, lo, hi, boxIndex, permuted, i >= boxStartIndex );
+		}
 	}
 
 #if defined(_DEBUG) && 0
@@ -1564,6 +1735,52 @@ bool idLCP_Symmetric::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b,
 }
 
 
+//===============================================================
+//
+//	idLCP_PGS
+//
+//===============================================================
+
+class idLCP_PGS : public idLCP {
+public:
+	virtual bool	Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, const idVecX &o_lo, const idVecX &o_hi, const int *o_boxIndex );
+};
+
+/*
+============
+idLCP_PGS::Solve
+
+  Approximate solution with at most maxIterations projected Gauss-Seidel iterations.
+============
+*/
+bool idLCP_PGS::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, const idVecX &o_lo, const idVecX &o_hi, const int *o_boxIndex ) {
+	int i, n;
+	float **rowPtrs, maxDelta;
+
+	n = o_m.GetNumRows();
+
+	assert( ((n+3)&~3) == o_m.GetNumColumns() || n == o_m.GetNumColumns() );
+	assert( o_x.GetSize() == n );
+	assert( o_b.GetSize() == n );
+	assert( o_lo.GetSize() == n );
+	assert( o_hi.GetSize() == n );
+
+	rowPtrs = (float **) _alloca16( n * sizeof( float * ) );
+	for ( i = 0; i < n; i++ ) {
+		rowPtrs[i] = const_cast<float *>( o_m[i] );
+	}
+
+	o_x.Zero();
+	maxDelta = LCP_ProjectedGaussSeidel( rowPtrs, o_x.ToFloatPtr(), o_b.ToFloatPtr(), o_lo.ToFloatPtr(), o_hi.ToFloatPtr(), o_boxIndex, n, maxIterations );
+
+	if ( maxDelta >= LCP_PGS_EPSILON && lcp_showFailures.GetBool() ) {
+		Failure( "idLCP_PGS::Solve: no convergence after %d iterations (delta %1.6f)\n", maxIterations, maxDelta );
+	}
+
+	return true;
+}
+
+
 //===============================================================
 //
 //	idLCP
@@ -1592,6 +1809,29 @@ idLCP *idLCP::AllocSymmetric( void ) {
 	return lcp;
 }
 
+/*
+============
+idLCP::AllocPGS
+============
+*/
+idLCP *idLCP::AllocPGS( void ) {
+	idLCP *lcp = new idLCP_PGS;
+	lcp->SetMaxIterations( 32 );
+	return lcp;
+}
+
+/*
+============
+idLCP::idLCP
+============
+*/
+idLCP::idLCP( void ) {
+	maxIterations = 0;
+	deferFailures = false;
+	numDeferredFailures = 0;
+	deferredFailure[0] = '\0';
+}
+
 /*
 ============
 idLCP::~idLCP
@@ -1617,3 +1857,279 @@ idLCP::GetMaxIterations
 int idLCP::GetMaxIterations( void ) {
 	return maxIterations;
 }
+
+/*
+============
+idLCP::DeferFailures
+============
+*/
+void idLCP::DeferFailures( bool defer ) {
+	deferFailures = defer;
+}
+
+/*
+============
+idLCP::ReportFailures
+============
+*/
+void idLCP::ReportFailures( void ) {
+	if ( !numDeferredFailures ) {
+		return;
+	}
+	idLib::common->Printf( "%s", deferredFailure );
+	if ( numDeferredFailures > 1 ) {
+		idLib::common->Printf( "%d more LCP failures\n", numDeferredFailures - 1 );
+	}
+	numDeferredFailures = 0;
+	deferredFailure[0] = '\0';
+}
+
+/*
+============
+idLCP::Failure
+============
+*/
+void idLCP::Failure( const char *fmt, ... ) {
+	va_list argptr;
+
+	if ( deferFailures ) {
+		if ( numDeferredFailures++ ) {
+			return;
+		}
+		va_start( argptr, fmt );
+		idStr::vsnPrintf( deferredFailure, sizeof( deferredFailure ), fmt, argptr );
+		va_end( argptr );
+		return;
+	}
+
+	va_start( argptr, fmt );
+	idLib::common->VPrintf( fmt, argptr );
+	va_end( argptr );
+}
+
+//===============================================================
+//
+//	LCP test
+//
+//===============================================================
+
+typedef struct lcpSystem_s {
+	idMatX			m;
+	idVecX			b;
+	idVecX			lo;
+	idVecX			hi;
+	idList<int>		boxIndex;
+} lcpSystem_t;
+
+static idList<lcpSystem_t *> lcpCapturedSystems;
+
+/*
+============
+idLCP::CaptureSystem
+============
+*/
+void idLCP::CaptureSystem( const idMatX &m, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex ) {
+	if ( lcpCapturedSystems.Num() >= lcp_captureSystems.GetInteger() ) {
+		// free the systems once capturing is turned off
+		if ( !lcp_captureSystems.GetInteger() && lcpCapturedSystems.Num() ) {
+			lcpCapturedSystems.DeleteContents( true );
+		}
+		return;
+	}
+
+	lcpSystem_t *sys = new lcpSystem_t;
+	sys->m = m;
+	sys->b = b;
+	sys->lo = lo;
+	sys->hi = hi;
+	if ( boxIndex ) {
+		sys->boxIndex.SetNum( m.GetNumRows() );
+		memcpy( sys->boxIndex.Ptr(), boxIndex, m.GetNumRows() * sizeof( int ) );
+	}
+	lcpCapturedSystems.Append( sys );
+
+	if ( lcpCapturedSystems.Num() == lcp_captureSystems.GetInteger() ) {
+		idLib::common->Printf( "captured %d LCP systems\n", lcpCapturedSystems.Num() );
+	}
+}
+
+/*
+============
+idLCP::Shutdown
+============
+*/
+void idLCP::Shutdown( void ) {
+	lcpCapturedSystems.DeleteContents( true );
+}
+
+/*
+============
+LCP_SolutionError
+
+  Returns the largest violation of the complementarity conditions.
+============
+*/
+static float LCP_SolutionError( const lcpSystem_t *sys, const idVecX &x ) {
+	int i, j, n;
+	float a, l, h, s, error, maxError;
+
+	n = sys->m.GetNumRows();
+	maxError = 0.0f;
+
+	for ( i = 0; i < n; i++ ) {
+		a = -sys->b[i];
+		for ( j = 0; j < n; j++ ) {
+			a += sys->m[i][j] * x[j];
+		}
+
+		l = sys->lo[i];
+		h = sys->hi[i];
+		if ( sys->boxIndex.Num() && sys->boxIndex[i] >= 0 ) {
+			s = x[sys->boxIndex[i]];
+			if ( l != -idMath::INFINITY ) {
+				l = - idMath::Fabs( l * s );
+			}
+			if ( h != idMath::INFINITY ) {
+				h = idMath::Fabs( h * s );
+			}
+		}
+
+		if ( x[i] < l - LCP_BOUND_EPSILON ) {
+			error = l - x[i];
+		} else if ( x[i] > h + LCP_BOUND_EPSILON ) {
+			error = x[i] - h;
+		} else if ( x[i] <= l + LCP_BOUND_EPSILON ) {
+			error = ( a < 0.0f ) ? -a : 0.0f;
+		} else if ( x[i] >= h - LCP_BOUND_EPSILON ) {
+			error = ( a > 0.0f ) ? a : 0.0f;
+		} else {
+			error = idMath::Fabs( a );
+		}
+		if ( error > maxError ) {
+			maxError = error;
+		}
+	}
+	return maxError;
+}
+
+/*
+============
+LCP_TestSolver
+============
+*/
+static void LCP_TestSolver( const char *name, idLCP *lcp ) {
+	int i;
+	float error, maxError, totalError;
+	idTimer timer;
+	idVecX x;
+
+	maxError = totalError = 0.0f;
+	for ( i = 0; i < lcpCapturedSystems.Num(); i++ ) {
+		const lcpSystem_t *sys = lcpCapturedSystems[i];
+
+		x.SetSize( sys->m.GetNumRows() );
+		timer.Start();
+		lcp->Solve( sys->m, x, sys->b, sys->lo, sys->hi, sys->boxIndex.Num() ? sys->boxIndex.Ptr() : NULL );
+		timer.Stop();
+
+		error = LCP_SolutionError( sys, x );
+		totalError += error;
+		if ( error > maxError ) {
+			maxError = error;
+		}
+	}
+
+	idLib::common->Printf( "%-24s %8.3f ms, max error %1.6f, avg error %1.6f\n", name, timer.Milliseconds(), maxError, totalError / lcpCapturedSystems.Num() );
+}
+
+/*
+============
+idLCP::Test_f
+============
+*/
+void idLCP::Test_f( const idCmdArgs &args ) {
+	int i, j, n, maxSize, numFailed;
+	float diff, maxDiff;
+	idTimer timerGeneric, timerBlocked;
+	idLCP *lcp;
+
+	if ( args.Argc() > 1 && !idStr::Icmp( args.Argv( 1 ), "clear" ) ) {
+		lcpCapturedSystems.DeleteContents( true );
+		return;
+	}
+
+	if ( !lcpCapturedSystems.Num() ) {
+		idLib::common->Printf( "no LCP systems captured, set lcp_captureSystems to capture systems\n" );
+		return;
+	}
+
+	maxSize = 0;
+	for ( i = 0; i < lcpCapturedSystems.Num(); i++ ) {
+		maxSize = Max( maxSize, lcpCapturedSystems[i]->m.GetNumRows() );
+	}
+	idLib::common->Printf( "%d systems, largest %dx%d\n", lcpCapturedSystems.Num(), maxSize, maxSize );
+
+	// factorization of the complete matrices
+	maxDiff = 0.0f;
+	numFailed = 0;
+	for ( i = 0; i < lcpCapturedSystems.Num(); i++ ) {
+		const lcpSystem_t *sys = lcpCapturedSystems[i];
+		idMatX m1, m2;
+		idVecX d1, d2;
+
+		n = sys->m.GetNumRows();
+		m1 = sys->m;
+		m2 = sys->m;
+		d1.SetSize( n );
+		d2.SetSize( n );
+
+		timerGeneric.Start();
+		bool ok1 = SIMDProcessor->MatX_LDLTFactor( m1, d1, n );
+		timerGeneric.Stop();
+
+		timerBlocked.Start();
+		bool ok2 = LCP_LDLTFactorBlocked( m2, d2, n );
+		timerBlocked.Stop();
+
+		if ( !ok1 || !ok2 ) {
+			numFailed++;
+			continue;
+		}
+		for ( j = 0; j < n; j++ ) {
+			for ( int k = 0; k <= j; k++ ) {
+				diff = idMath::Fabs( m1[j][k] - m2[j][k] );
+				if ( diff > maxDiff ) {
+					maxDiff = diff;
+				}
+			}
+		}
+	}
+	idLib::common->Printf( "%-24s %8.3f ms\n", "LDLt factor", timerGeneric.Milliseconds() );
+	idLib::common->Printf( "%-24s %8.3f ms, max difference %1.6f, %d not factored\n", "LDLt factor blocked", timerBlocked.Milliseconds(), maxDiff, numFailed );
+
+	// complete solvers
+	bool blocked = lcp_blockedFactor.GetBool();
+	int fallback = lcp_fallbackIterations.GetInteger();
+	lcp_fallbackIterations.SetInteger( 0 );
+
+	lcp = AllocSymmetric();
+	lcp_blockedFactor.SetBool( false );
+	LCP_TestSolver( "symmetric", lcp );
+	lcp_blockedFactor.SetBool( true );
+	LCP_TestSolver( "symmetric blocked", lcp );
+	delete lcp;
+
+	lcp = AllocSquare();
+	LCP_TestSolver( "square", lcp );
+	delete lcp;
+
+	lcp = AllocPGS();
+	for ( i = 8; i <= 64; i *= 2 ) {
+		lcp->SetMaxIterations( i );
+		LCP_TestSolver( va( "PGS %d iterations", i ), lcp );
+	}
+	delete lcp;
+
+	lcp_blockedFactor.SetBool( blocked );
+	lcp_fallbackIterations.SetInteger( fallback );
+}
@@ -38,15 +38,32 @@ class idLCP {
 public:
 	static idLCP *	AllocSquare( void );		// A must be a square matrix
 	static idLCP *	AllocSymmetric( void );		// A must be a symmetric matrix
+	static idLCP *	AllocPGS( void );			// approximate solver, max iterations is the iteration budget
 
+					idLCP( void );
 	virtual			~idLCP( void );
 
 	virtual bool	Solve( const idMatX &A, idVecX &x, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex = NULL ) = 0;
 	virtual void	SetMaxIterations( int max );
 	virtual int		GetMaxIterations( void );
 
+					// while deferred failures are kept instead of printed so the solver can run on a job thread
+	void			DeferFailures( bool defer );
+					// prints the first failure kept while deferred
+	void			ReportFailures( void );
+
+					// keeps a copy of the system for testLCP while lcp_captureSystems allows, not thread safe
+	static void		CaptureSystem( const idMatX &A, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex = NULL );
+	static void		Test_f( const class idCmdArgs &args );
+	static void		Shutdown( void );			// frees the captured systems
+
 protected:
 	int				maxIterations;
+	bool			deferFailures;
+	int				numDeferredFailures;
+	char			deferredFailure[128];
+
+	void			Failure( const char *fmt, ... ) id_attribute((format(printf,2,3)));
 };
 
 #endif /* !__MATH_LCP_H__ */
@@ -2320,6 +2320,55 @@ void TestBlendJoints(void) {
 	PrintClocks(va("   simd->BlendJoints() %s", result), COUNT, bestClocksSIMD, bestClocksGeneric);
 }
 
+/*
+============
+TestDecodeAnimComponents
+============
+*/
+void TestDecodeAnimComponents(void) {
+	int i;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16(short src[COUNT]);
+	ALIGN16(float bias[COUNT]);
+	ALIGN16(float scale[COUNT]);
+	ALIGN16(float dst1[COUNT]);
+	ALIGN16(float dst2[COUNT]);
+	const char* result;
+
+	idRandom srnd(RANDOM_SEED);
+
+	for (i = 0; i < COUNT; i++) {
+		src[i] = (short)(srnd.CRandomFloat() * 32767.0f);
+		bias[i] = srnd.CRandomFloat() * 100.0f;
+		scale[i] = srnd.RandomFloat() * 0.01f;
+	}
+
+	bestClocksGeneric = 0;
+	for (i = 0; i < NUMTESTS; i++) {
+		StartRecordTime(start);
+		p_generic->DecodeAnimComponents(dst1, src, bias, scale, COUNT);
+		StopRecordTime(end);
+		GetBest(start, end, bestClocksGeneric);
+	}
+	PrintClocks("generic->DecodeAnimComponents()", COUNT, bestClocksGeneric);
+
+	bestClocksSIMD = 0;
+	for (i = 0; i < NUMTESTS; i++) {
+		StartRecordTime(start);
+		p_simd->DecodeAnimComponents(dst2, src, bias, scale, COUNT);
+		StopRecordTime(end);
+		GetBest(start, end, bestClocksSIMD);
+	}
+
+	for (i = 0; i < COUNT; i++) {
+		if (idMath::Fabs(dst1[i] - dst2[i]) > 1e-4f) {
+			break;
+		}
+	}
+	result = (i >= COUNT) ? "ok" : S_COLOR_RED"X";
+	PrintClocks(va("   simd->DecodeAnimComponents() %s", result), COUNT, bestClocksSIMD, bestClocksGeneric);
+}
+
 /*
 ============
 TestConvertJointQuatsToJointMats
@@ -4108,6 +4157,7 @@ void idSIMD::Test_f(const idCmdArgs& args) {
 	idLib::common->Printf("====================================\n");
 
 	TestBlendJoints();
+	TestDecodeAnimComponents();
 	TestConvertJointQuatsToJointMats();
 	TestConvertJointMatsToJointQuats();
 	TestTransformJoints();
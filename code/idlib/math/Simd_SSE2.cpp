@@ -1007,6 +1007,48 @@ void VPCALL idSIMD_SSE2::TransformJoints( idJointMat *jointMats, const int *pare
 }
 //HUMANHEAD END
 
+/*
+============
+idSIMD_SSE2::DecodeAnimComponents
+
+  dst[i] = bias[i] + scale[i] * src[i];
+============
+*/
+void VPCALL idSIMD_SSE2::DecodeAnimComponents( float *dst, const short *src, const float *bias, const float *scale, const int count ) {
+	int count4 = count & ~3;
+	int i;
+
+	__asm {
+		mov			eax, count4
+		test		eax, eax
+		jz			done4
+		mov			esi, src
+		mov			edi, dst
+		mov			ecx, bias
+		mov			edx, scale
+		xor			eax, eax
+
+	loop4:
+		movq		xmm0, qword ptr [esi+eax*2]				// xmm0 = s0, s1, s2, s3
+		movups		xmm1, [edx+eax*4]
+		movups		xmm2, [ecx+eax*4]
+		punpcklwd	xmm0, xmm0
+		psrad		xmm0, 16								// sign extend the shorts to dwords
+		cvtdq2ps	xmm0, xmm0
+		mulps		xmm0, xmm1
+		addps		xmm0, xmm2
+		movups		[edi+eax*4], xmm0
+		add			eax, 4
+		cmp			eax, count4
+		jl			loop4
+	done4:
+	}
+
+	for ( i = count4; i < count; i++ ) {
+		dst[i] = bias[i] + scale[i] * (float) src[i];
+	}
+}
+
 #if NEW_MESH_TRANSFORM
 
 #define SHUFFLE_PS( x, y, z, w )	(( (x) & 3 ) << 6 | ( (y) & 3 ) << 4 | ( (z) & 3 ) << 2 | ( (w) & 3 ))
@@ -27,6 +27,8 @@ public:
 	virtual void VPCALL TransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint );
 	//HUMANHEAD END
 
+	virtual void VPCALL DecodeAnimComponents( float *dst, const short *src, const float *bias, const float *scale, const int count );
+
 #if NEW_MESH_TRANSFORM
 	virtual void VPCALL MultiplyJoints( idJointMat *result, const idJointMat *joints1, const idJointMat *joints2, const int numJoints );
 	virtual void VPCALL TransformVertsNew( idDrawVert *verts, const int numVerts, idBounds &bounds, const idJointMat *joints, const idVec4 *base, const jointWeight_t *weights, const int numWeights );
@@ -2239,6 +2239,21 @@ void VPCALL idSIMD_Generic::BlendJoints( idJointQuat *joints, const idJointQuat
 	}
 }
 
+/*
+============
+idSIMD_Generic::DecodeAnimComponents
+
+  dst[i] = bias[i] + scale[i] * src[i];
+============
+*/
+void VPCALL idSIMD_Generic::DecodeAnimComponents( float *dst, const short *src, const float *bias, const float *scale, const int count ) {
+	int i;
+
+	for ( i = 0; i < count; i++ ) {
+		dst[i] = bias[i] + scale[i] * (float) src[i];
+	}
+}
+
 /*
 ============
 idSIMD_Generic::ConvertJointQuatsToJointMats
@@ -39,6 +39,7 @@ idCVar idRenderModelStatic::r_mergeModelSurfaces( "r_mergeModelSurfaces", "1", C
 idCVar idRenderModelStatic::r_slopVertex( "r_slopVertex", "0.01", CVAR_RENDERER, "merge xyz coordinates this far apart" );
 idCVar idRenderModelStatic::r_slopTexCoord( "r_slopTexCoord", "0.001", CVAR_RENDERER, "merge texture coordinates this far apart" );
 idCVar idRenderModelStatic::r_slopNormal( "r_slopNormal", "0.02", CVAR_RENDERER, "merge normals that dot less than this" );
+idCVar idRenderModelStatic::r_binaryModels( "r_binaryModels", "1", CVAR_BOOL|CVAR_RENDERER, "read and write binary caches of processed ase, lwo, ma and md5mesh models" );
 
 /*
 ================
@@ -56,6 +57,9 @@ idRenderModelStatic::idRenderModelStatic() {
 	defaulted = false;
 	purged = false;
 	fastLoad = false;
+	deferSurfaceCleanup = false;
+	surfaceCleanupPending = false;
+	deferredBinaryTimeStamp = FILE_NOT_FOUND_TIMESTAMP;
 	reloadable = true;
 	levelLoadReferenced = false;
 	timeStamp = 0;
@@ -276,7 +280,9 @@ idRenderModelStatic::InitFromFile
 */
 void idRenderModelStatic::InitFromFile( const char *fileName ) {
 	bool loaded;
+	bool binaryCache;
 	idStr extension;
+	ID_TIME_T sourceTimeStamp;
 
 	InitEmpty( fileName );
 
@@ -284,6 +290,21 @@ void idRenderModelStatic::InitFromFile( const char *fileName ) {
 
 	name.ExtractFileExtension( extension );
 
+	// renderBump loads don't do the processing the binary cache stores
+	binaryCache = false;
+	sourceTimeStamp = FILE_NOT_FOUND_TIMESTAMP;
+	if ( !fastLoad && r_binaryModels.GetBool() ) {
+		if ( extension.Icmp( "ase" ) == 0 || extension.Icmp( "lwo" ) == 0 || extension.Icmp( "ma" ) == 0 ) {
+			fileSystem->ReadFile( name, NULL, &sourceTimeStamp );
+			binaryCache = ( sourceTimeStamp != FILE_NOT_FOUND_TIMESTAMP );
+		}
+	}
+
+	if ( binaryCache && LoadBinaryModel( sourceTimeStamp ) ) {
+		reloadable = true;
+		return;
+	}
+
 	if ( extension.Icmp( "ase" ) == 0 ) {
 		loaded		= LoadASE( name );
 		reloadable	= true;
@@ -312,6 +333,16 @@ void idRenderModelStatic::InitFromFile( const char *fileName ) {
 
 	// create the bounds for culling and dynamic surface creation
 	FinishSurfaces();
+
+	if ( surfaceCleanupPending ) {
+		// the binary cache is written once the surfaces are clean
+		deferredBinaryTimeStamp = binaryCache ? sourceTimeStamp : FILE_NOT_FOUND_TIMESTAMP;
+		return;
+	}
+
+	if ( binaryCache ) {
+		WriteBinaryModel( sourceTimeStamp );
+	}
 }
 
 /*
@@ -552,6 +583,21 @@ int idRenderModelStatic::NearestJoint( int surfaceNum, int a, int b, int c ) con
 //=====================================================================
 
 
+/*
+================
+R_AddModelSurfaceArea
+================
+*/
+static void R_AddModelSurfaceArea( const modelSurface_t *surf ) {
+	const srfTriangles_t	*tri = surf->geometry;
+
+	for ( int j = 0 ; j < tri->numIndexes ; j += 3 ) {
+		float	area = idWinding::TriangleArea( tri->verts[tri->indexes[j]].xyz,
+			 tri->verts[tri->indexes[j+1]].xyz,  tri->verts[tri->indexes[j+2]].xyz );
+		const_cast<idMaterial *>(surf->shader)->AddToSurfaceArea( area );
+	}
+}
+
 /*
 ================
 idRenderModelStatic::FinishSurfaces
@@ -579,7 +625,6 @@ Extends the bounds of deformed surfaces so they don't cull incorrectly at screen
 */
 void idRenderModelStatic::FinishSurfaces() {
 	int			i;
-	int			totalVerts, totalIndexes;
 
 	purged = false;
 
@@ -603,10 +648,6 @@ void idRenderModelStatic::FinishSurfaces() {
 		return;
 	}
 
-	// cleanup all the final surfaces, but don't create sil edges
-	totalVerts = 0;
-	totalIndexes = 0;
-
 	// decide if we are going to merge all the surfaces into one shadower
 	int	numOriginalSurfaces = surfaces.Num();
 
@@ -648,27 +689,72 @@ void idRenderModelStatic::FinishSurfaces() {
 		}
 	}
 
+	// the level loading threads clean the surfaces and call FinishDeferredSurfaces
+	if ( deferSurfaceCleanup ) {
+		for ( i = 0 ; i < surfaces.Num() ; i++ ) {
+			// errors can only be thrown from the main thread
+			R_RangeCheckIndexes( surfaces[i].geometry );
+		}
+		surfaceCleanupPending = true;
+		return;
+	}
+
 	// clean the surfaces
 	for ( i = 0 ; i < surfaces.Num() ; i++ ) {
-		const modelSurface_t	*surf = &surfaces[i];
+		CleanupSurface( i, NULL );
+	}
 
-		R_CleanupTriangles( surf->geometry, surf->geometry->generateNormals, true, surf->shader->UseUnsmoothedTangents() );
-		if ( surf->shader->SurfaceCastsShadow() ) {
-			totalVerts += surf->geometry->numVerts;
-			totalIndexes += surf->geometry->numIndexes;
-		}
+	FinishCleanSurfaces();
+}
+
+/*
+================
+idRenderModelStatic::CleanupSurface
+
+Safe to call from any thread for different surfaces, as long as the tri surf data
+is threaded and every thread passes its own silEdgeWork_t.
+================
+*/
+void idRenderModelStatic::CleanupSurface( int surfaceNum, struct silEdgeWork_s *work ) {
+	const modelSurface_t	*surf = &surfaces[surfaceNum];
+
+	R_CleanupTriangles( surf->geometry, surf->geometry->generateNormals, true, surf->shader->UseUnsmoothedTangents(), work );
+}
+
+/*
+================
+idRenderModelStatic::FinishDeferredSurfaces
+
+Completes a load that had its surface cleanup deferred, on the main thread.
+================
+*/
+void idRenderModelStatic::FinishDeferredSurfaces() {
+	if ( !surfaceCleanupPending ) {
+		return;
 	}
+	surfaceCleanupPending = false;
+
+	FinishCleanSurfaces();
+
+	if ( deferredBinaryTimeStamp != FILE_NOT_FOUND_TIMESTAMP ) {
+		WriteBinaryModel( deferredBinaryTimeStamp );
+		deferredBinaryTimeStamp = FILE_NOT_FOUND_TIMESTAMP;
+	}
+}
+
+/*
+================
+idRenderModelStatic::FinishCleanSurfaces
+
+the part of FinishSurfaces after R_CleanupTriangles
+================
+*/
+void idRenderModelStatic::FinishCleanSurfaces() {
+	int			i;
 
 	// add up the total surface area for development information
 	for ( i = 0 ; i < surfaces.Num() ; i++ ) {
-		const modelSurface_t	*surf = &surfaces[i];
-		srfTriangles_t	*tri = surf->geometry;
-
-		for ( int j = 0 ; j < tri->numIndexes ; j += 3 ) {
-			float	area = idWinding::TriangleArea( tri->verts[tri->indexes[j]].xyz,
-				 tri->verts[tri->indexes[j+1]].xyz,  tri->verts[tri->indexes[j+2]].xyz );
-			const_cast<idMaterial *>(surf->shader)->AddToSurfaceArea( area );
-		}
+		R_AddModelSurfaceArea( &surfaces[i] );
 	}
 
 	// calculate the bounds
@@ -2326,3 +2412,256 @@ bool idRenderModelStatic::FindSurfaceWithId( int id, int &surfaceNum ) {
 	}
 	return false;
 }
+
+/*
+===============================================================================
+
+	Binary model cache
+
+	Loading an ase, lwo or ma model converts it to model surfaces and runs
+	R_CleanupTriangles on them, md5 meshes build their deform info. The
+	result of that processing is written to a platform specific binary file
+	next to the source model (models/foo.lwo -> models/foo.blwo), which is
+	read back without any parsing on the next load.
+
+	The cache is only used when the struct sizes, the cvars that affect the
+	processing and the time stamp of the source file all match. Each surface
+	also stores the material flags that change the processing, so editing a
+	material to be two sided or use unsmoothed tangents rebuilds the cache.
+
+===============================================================================
+*/
+
+#define BINARYMODEL_ID				( ( 'L' << 24 ) | ( 'D' << 16 ) | ( 'M' << 8 ) | 'B' )
+#define BINARYMODEL_VERSION			1
+
+#define BINARYMODEL_BACKSIDES		BIT( 0 )
+#define BINARYMODEL_UNSMOOTHED		BIT( 1 )
+
+typedef struct binaryModelHeader_s {
+	int						id;
+	int						version;
+	int						modelType;
+	ID_TIME_T				sourceTimeStamp;	// time stamp of the source model the cache was created from
+	int						drawVertSize;
+	int						indexSize;
+	int						silEdgeSize;
+	int						dominantTriSize;
+	int						jointQuatSize;
+	int						mergeSurfaces;
+	float					slopVertex;
+	float					slopTexCoord;
+	float					slopNormal;
+} binaryModelHeader_t;
+
+/*
+================
+R_SetupBinaryModelHeader
+================
+*/
+static void R_SetupBinaryModelHeader( binaryModelHeader_t *header, int modelType, ID_TIME_T sourceTimeStamp ) {
+	memset( header, 0, sizeof( *header ) );
+	header->id = BINARYMODEL_ID;
+	header->version = BINARYMODEL_VERSION;
+	header->modelType = modelType;
+	header->sourceTimeStamp = sourceTimeStamp;
+	header->drawVertSize = sizeof( idDrawVert );
+	header->indexSize = sizeof( glIndex_t );
+	header->silEdgeSize = sizeof( silEdge_t );
+	header->dominantTriSize = sizeof( dominantTri_t );
+	header->jointQuatSize = sizeof( idJointQuat );
+	header->mergeSurfaces = cvarSystem->GetCVarBool( "r_mergeModelSurfaces" );
+	header->slopVertex = cvarSystem->GetCVarFloat( "r_slopVertex" );
+	header->slopTexCoord = cvarSystem->GetCVarFloat( "r_slopTexCoord" );
+	header->slopNormal = cvarSystem->GetCVarFloat( "r_slopNormal" );
+}
+
+/*
+================
+R_BinaryModelFileName
+================
+*/
+static void R_BinaryModelFileName( const char *fileName, idStr &binaryName ) {
+	idStr extension;
+
+	binaryName = fileName;
+	binaryName.ExtractFileExtension( extension );
+	binaryName.SetFileExtension( va( "b%s", extension.c_str() ) );
+}
+
+/*
+================
+R_BinaryModelMaterialFlags
+================
+*/
+static int R_BinaryModelMaterialFlags( const idMaterial *shader ) {
+	int flags = 0;
+
+	if ( shader->ShouldCreateBackSides() ) {
+		flags |= BINARYMODEL_BACKSIDES;
+	}
+	if ( shader->UseUnsmoothedTangents() ) {
+		flags |= BINARYMODEL_UNSMOOTHED;
+	}
+	return flags;
+}
+
+/*
+================
+idRenderModelStatic::OpenBinaryModel
+
+Returns the binary cache positioned after its header, or NULL if there is no valid cache.
+================
+*/
+idFile *idRenderModelStatic::OpenBinaryModel( int modelType, ID_TIME_T sourceTimeStamp ) const {
+	idStr binaryName;
+	idFile *file;
+	binaryModelHeader_t header, expected;
+
+	if ( !r_binaryModels.GetBool() || sourceTimeStamp == FILE_NOT_FOUND_TIMESTAMP ) {
+		return NULL;
+	}
+
+	R_BinaryModelFileName( name, binaryName );
+	file = fileSystem->OpenFileRead( binaryName );
+	if ( !file ) {
+		return NULL;
+	}
+
+	R_SetupBinaryModelHeader( &expected, modelType, sourceTimeStamp );
+	if ( file->Read( &header, sizeof( header ) ) != sizeof( header ) || memcmp( &header, &expected, sizeof( header ) ) != 0 ) {
+		fileSystem->CloseFile( file );
+		return NULL;
+	}
+
+	return file;
+}
+
+/*
+================
+idRenderModelStatic::CreateBinaryModel
+================
+*/
+idFile *idRenderModelStatic::CreateBinaryModel( int modelType, ID_TIME_T sourceTimeStamp ) const {
+	idStr binaryName;
+	idFile *file;
+	binaryModelHeader_t header;
+
+	if ( !r_binaryModels.GetBool() || sourceTimeStamp == FILE_NOT_FOUND_TIMESTAMP ) {
+		return NULL;
+	}
+
+	R_BinaryModelFileName( name, binaryName );
+	file = fileSystem->OpenFileWrite( binaryName );
+	if ( !file ) {
+		common->Warning( "idRenderModelStatic::CreateBinaryModel: couldn't open %s", binaryName.c_str() );
+		return NULL;
+	}
+
+	R_SetupBinaryModelHeader( &header, modelType, sourceTimeStamp );
+	file->Write( &header, sizeof( header ) );
+
+	return file;
+}
+
+/*
+================
+idRenderModelStatic::WriteBinaryModel
+
+Writes the surfaces after FinishSurfaces.
+================
+*/
+void idRenderModelStatic::WriteBinaryModel( ID_TIME_T sourceTimeStamp ) const {
+	idFile *file;
+	int i;
+
+	if ( defaulted ) {
+		return;
+	}
+
+	file = CreateBinaryModel( DM_STATIC, sourceTimeStamp );
+	if ( !file ) {
+		return;
+	}
+
+	file->Write( &bounds, sizeof( bounds ) );
+	file->WriteInt( surfaces.Num() );
+	for ( i = 0; i < surfaces.Num(); i++ ) {
+		const modelSurface_t *surf = &surfaces[i];
+
+		file->WriteInt( surf->id );
+		file->WriteString( surf->shader->GetName() );
+		file->WriteInt( R_BinaryModelMaterialFlags( surf->shader ) );
+		R_WriteStaticTriSurfBinary( file, surf->geometry );
+	}
+
+	fileSystem->CloseFile( file );
+}
+
+/*
+================
+idRenderModelStatic::LoadBinaryModel
+
+Replaces the LoadASE / LoadLWO / LoadMA and FinishSurfaces steps of InitFromFile.
+================
+*/
+bool idRenderModelStatic::LoadBinaryModel( ID_TIME_T sourceTimeStamp ) {
+	idFile *file;
+	idStr shaderName;
+	int i, numSurfaces, flags;
+	modelSurface_t surf;
+	bool ok;
+
+	file = OpenBinaryModel( DM_STATIC, sourceTimeStamp );
+	if ( !file ) {
+		return false;
+	}
+
+	ok = ( file->Read( &bounds, sizeof( bounds ) ) == sizeof( bounds ) );
+	ok = ok && file->ReadInt( numSurfaces ) > 0 && numSurfaces >= 0;
+
+	for ( i = 0; ok && i < numSurfaces; i++ ) {
+		ok = file->ReadInt( surf.id ) > 0;
+		ok = ok && file->ReadString( shaderName ) > 0;
+		ok = ok && file->ReadInt( flags ) > 0;
+		if ( !ok ) {
+			break;
+		}
+
+		surf.shader = declManager->FindMaterial( shaderName );
+		if ( R_BinaryModelMaterialFlags( surf.shader ) != flags ) {
+			// the material changed in a way that affects the processing
+			ok = false;
+			break;
+		}
+
+		surf.geometry = R_ReadStaticTriSurfBinary( file );
+		if ( !surf.geometry ) {
+			ok = false;
+			break;
+		}
+
+		AddSurface( surf );
+	}
+
+	fileSystem->CloseFile( file );
+
+	if ( !ok ) {
+		for ( i = 0; i < surfaces.Num(); i++ ) {
+			R_FreeStaticTriSurf( surfaces[i].geometry );
+		}
+		surfaces.Clear();
+		bounds.Zero();
+		return false;
+	}
+
+	// add up the total surface area for development information
+	for ( i = 0; i < surfaces.Num(); i++ ) {
+		R_AddModelSurfaceArea( &surfaces[i] );
+	}
+
+	timeStamp = sourceTimeStamp;
+	purged = false;
+
+	return true;
+}
@@ -65,6 +65,7 @@ private:
 	bool					insideLevelLoad;		// don't actually load now
 
 	idRenderModel *			GetModel( const char *modelName, bool createIfNotFound );
+	void					LoadModels( const idList<idRenderModel *> &loadList );
 
 	static void				PrintModel_f( const idCmdArgs &args );
 	static void				ListModels_f( const idCmdArgs &args );
@@ -76,6 +77,28 @@ private:
 idRenderModelManagerLocal	localModelManager;
 idRenderModelManager *		renderModelManager = &localModelManager;
 
+const int MAX_MODEL_LOAD_THREADS	= 4;
+
+idCVar r_modelLoadThreads( "r_modelLoadThreads", "2", CVAR_RENDERER | CVAR_INTEGER, "number of extra threads cleaning up model surfaces during level loads, 0 = load serially", 0, MAX_MODEL_LOAD_THREADS );
+
+typedef struct modelCleanupJob_s {
+	idRenderModelStatic *		model;
+	int							surfaceNum;
+	int							numIndexes;
+} modelCleanupJob_t;
+
+typedef struct modelCleanupJobs_s {
+	idList<modelCleanupJob_t>	jobs;
+	int							nextJob;			// protected by CRITICAL_SECTION_THREE
+} modelCleanupJobs_t;
+
+typedef struct modelLoadThread_s {
+	xthreadInfo					threadInfo;
+	modelCleanupJobs_t *		cleanup;
+	silEdgeWork_t *				silEdgeWork;
+	staticAllocCounts_t			allocCounts;
+} modelLoadThread_t;
+
 /*
 ==============
 idRenderModelManagerLocal::idRenderModelManagerLocal
@@ -338,6 +361,156 @@ idRenderModel *idRenderModelManagerLocal::GetModel( const char *modelName, bool
 	return model;
 }
 
+/*
+=================
+R_SortModelCleanupJobs
+
+largest surfaces first so the threads finish at about the same time
+=================
+*/
+static int R_SortModelCleanupJobs( const modelCleanupJob_t *a, const modelCleanupJob_t *b ) {
+	return b->numIndexes - a->numIndexes;
+}
+
+/*
+=================
+R_RunModelCleanupJobs
+=================
+*/
+static void R_RunModelCleanupJobs( modelCleanupJobs_t *cleanup, silEdgeWork_t *silEdgeWork ) {
+	int jobNum;
+
+	while( 1 ) {
+		Sys_EnterCriticalSection( CRITICAL_SECTION_THREE );
+		jobNum = cleanup->nextJob++;
+		Sys_LeaveCriticalSection( CRITICAL_SECTION_THREE );
+
+		if ( jobNum >= cleanup->jobs.Num() ) {
+			break;
+		}
+
+		const modelCleanupJob_t &job = cleanup->jobs[jobNum];
+		job.model->CleanupSurface( job.surfaceNum, silEdgeWork );
+	}
+}
+
+/*
+=================
+R_ModelCleanupThread
+=================
+*/
+static unsigned int R_ModelCleanupThread( void *parms ) {
+	modelLoadThread_t *thread = (modelLoadThread_t *)parms;
+
+	R_SetThreadStaticAllocCounts( &thread->allocCounts );
+	R_RunModelCleanupJobs( thread->cleanup, thread->silEdgeWork );
+
+	return 0;
+}
+
+/*
+=================
+idRenderModelManagerLocal::LoadModels
+
+Loads the models in list order. The source files are parsed on the main thread,
+because the file and decl systems are not thread safe. The R_CleanupTriangles work
+of all the static model surfaces is then shared between the main thread and
+r_modelLoadThreads worker threads. Bounds, surface area and binary caches are
+finished on the main thread, in list order again, so the loaded models never
+depend on the thread timing.
+=================
+*/
+void idRenderModelManagerLocal::LoadModels( const idList<idRenderModel *> &loadList ) {
+	int i, j;
+	int numThreads;
+	modelCleanupJobs_t cleanup;
+	idList<idRenderModelStatic *> pending;
+
+	numThreads = r_modelLoadThreads.GetInteger();
+
+	if ( numThreads <= 0 || loadList.Num() < 2 ) {
+		for ( i = 0; i < loadList.Num(); i++ ) {
+			loadList[i]->LoadModel();
+
+			if ( ( ( i + 1 ) & 15 ) == 0 ) {
+				session->PacifierUpdate();
+			}
+		}
+		return;
+	}
+
+	cleanup.nextJob = 0;
+
+	// parse the models and queue their surfaces
+	for ( i = 0; i < loadList.Num(); i++ ) {
+		idRenderModel *model = loadList[i];
+		idRenderModelStatic *staticModel = dynamic_cast<idRenderModelStatic *>( model );
+
+		if ( staticModel ) {
+			staticModel->SetDeferSurfaceCleanup( true );
+		}
+
+		model->LoadModel();
+
+		if ( staticModel ) {
+			staticModel->SetDeferSurfaceCleanup( false );
+
+			if ( staticModel->IsSurfaceCleanupPending() ) {
+				pending.Append( staticModel );
+
+				for ( j = 0; j < staticModel->NumSurfaces(); j++ ) {
+					modelCleanupJob_t &job = cleanup.jobs.Alloc();
+					job.model = staticModel;
+					job.surfaceNum = j;
+					job.numIndexes = staticModel->Surface( j )->geometry->numIndexes;
+				}
+			}
+		}
+
+		if ( ( ( i + 1 ) & 15 ) == 0 ) {
+			session->PacifierUpdate();
+		}
+	}
+
+	// clean up the surfaces on all threads
+	if ( cleanup.jobs.Num() ) {
+		modelLoadThread_t	threads[MAX_MODEL_LOAD_THREADS];
+		xthreadInfo *		threadList[MAX_THREADS];
+		int					threadCount = 0;
+
+		cleanup.jobs.Sort( R_SortModelCleanupJobs );
+
+		numThreads = Min( numThreads, Min( MAX_MODEL_LOAD_THREADS, cleanup.jobs.Num() - 1 ) );
+
+		R_BeginThreadedTriSurfData();
+
+		for ( i = 0; i < numThreads; i++ ) {
+			threads[i].cleanup = &cleanup;
+			threads[i].silEdgeWork = R_AllocSilEdgeWork();
+			memset( &threads[i].allocCounts, 0, sizeof( threads[i].allocCounts ) );
+			Sys_CreateThread( (xthread_t)R_ModelCleanupThread, &threads[i], THREAD_NORMAL, threads[i].threadInfo, "modelLoad", threadList, &threadCount );
+		}
+
+		// the main thread uses the default sil edge scratch space
+		R_RunModelCleanupJobs( &cleanup, NULL );
+
+		// Sys_DestroyThread joins, the cleanup jobs have no cancelation points
+		// so posix threads still run their last job to completion
+		for ( i = 0; i < numThreads; i++ ) {
+			Sys_DestroyThread( threads[i].threadInfo );
+			R_AddStaticAllocCounts( threads[i].allocCounts );
+			R_FreeSilEdgeWork( threads[i].silEdgeWork );
+		}
+
+		R_EndThreadedTriSurfData();
+	}
+
+	// finish the models in list order
+	for ( i = 0; i < pending.Num(); i++ ) {
+		pending[i]->FinishDeferredSurfaces();
+	}
+}
+
 /*
 =================
 idRenderModelManagerLocal::AllocModel
@@ -439,6 +612,8 @@ void idRenderModelManagerLocal::ReloadModels( bool forceAll ) {
 
 	R_FreeDerivedData();
 
+	idList<idRenderModel *> loadList;
+
 	// skip the default model at index 0
 	for ( int i = 1 ; i < models.Num() ; i++ ) {
 		idRenderModel	*model = models[i];
@@ -460,9 +635,11 @@ void idRenderModelManagerLocal::ReloadModels( bool forceAll ) {
 
 		common->DPrintf( "reloading %s.\n", model->Name() );
 
-		model->LoadModel();
+		loadList.Append( model );
 	}
 
+	LoadModels( loadList );
+
 	// we must force the world to regenerate, because models may
 	// have changed size, making their references invalid
 	R_ReCreateWorldReferences();
@@ -544,20 +721,19 @@ void idRenderModelManagerLocal::EndLevelLoad() {
 	R_PurgeTriSurfData( frameData );
 
 	// load any new ones
+	idList<idRenderModel *> loadList;
+
 	for ( int i = 0 ; i < models.Num() ; i++ ) {
 		idRenderModel *model = models[i];
 
 		if ( model->IsLevelLoadReferenced() && !model->IsLoaded() && model->IsReloadable() ) {
-
-			loadCount++;
-			model->LoadModel();
-
-			if ( ( loadCount & 15 ) == 0 ) {
-				session->PacifierUpdate();
-			}
+			loadList.Append( model );
 		}
 	}
 
+	loadCount = loadList.Num();
+	LoadModels( loadList );
+
 	// _D3XP added this
 	int	end = Sys_Milliseconds();
 	common->Printf( "%5i models purged from previous level, ", purgeCount );
@@ -102,6 +102,12 @@ public:
 	void						DeleteSurfacesWithNegativeId( void );
 	bool						FindSurfaceWithId( int id, int &surfaceNum );
 
+	// threaded level loading, see idRenderModelManagerLocal::LoadModels
+	void						SetDeferSurfaceCleanup( bool defer ) { deferSurfaceCleanup = defer; }
+	bool						IsSurfaceCleanupPending() const { return surfaceCleanupPending; }
+	void						CleanupSurface( int surfaceNum, struct silEdgeWork_s *work );
+	void						FinishDeferredSurfaces();
+
 public:
 	idList<modelSurface_t>		surfaces;
 	idBounds					bounds;
@@ -119,12 +125,24 @@ protected:
 	bool						fastLoad;				// don't generate tangents and shadow data
 	bool						reloadable;				// if not, reloadModels won't check timestamp
 	bool						levelLoadReferenced;	// for determining if it needs to be freed
+	bool						deferSurfaceCleanup;	// leave R_CleanupTriangles to the level loading threads
+	bool						surfaceCleanupPending;	// FinishDeferredSurfaces still needs to be called
+	ID_TIME_T					deferredBinaryTimeStamp;	// binary cache to write in FinishDeferredSurfaces
 	ID_TIME_T						timeStamp;
 
 	static idCVar				r_mergeModelSurfaces;	// combine model surfaces with the same material
 	static idCVar				r_slopVertex;			// merge xyz coordinates this far apart
 	static idCVar				r_slopTexCoord;			// merge texture coordinates this far apart
 	static idCVar				r_slopNormal;			// merge normals that dot less than this
+	static idCVar				r_binaryModels;			// read and write binary caches of processed models
+
+	// binary model cache
+	idFile *					OpenBinaryModel( int modelType, ID_TIME_T sourceTimeStamp ) const;
+	idFile *					CreateBinaryModel( int modelType, ID_TIME_T sourceTimeStamp ) const;
+	bool						LoadBinaryModel( ID_TIME_T sourceTimeStamp );
+	void						WriteBinaryModel( ID_TIME_T sourceTimeStamp ) const;
+
+	void						FinishCleanSurfaces();
 };
 
 /*
@@ -162,6 +180,9 @@ private:
 
 	void						TransformVerts( idDrawVert *verts, const idJointMat *joints );
 	void						TransformScaledVerts( idDrawVert *verts, const idJointMat *joints, float scale );
+
+	void						WriteBinary( idFile *f ) const;
+	bool						ReadBinary( idFile *f );
 };
 
 class idRenderModelMD5 : public idRenderModelStatic {
@@ -192,6 +213,9 @@ private:
 	void						GetFrameBounds( const renderEntity_t *ent, idBounds &bounds ) const;
 	void						DrawJoints( const renderEntity_t *ent, const struct viewDef_s *view ) const;
 	void						ParseJoint( idLexer &parser, idMD5Joint *joint, idJointQuat *defaultPose );
+
+	bool						LoadBinaryMD5( ID_TIME_T sourceTimeStamp );
+	void						WriteBinaryMD5( ID_TIME_T sourceTimeStamp ) const;
 };
 
 /*
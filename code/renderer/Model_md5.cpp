@@ -245,6 +245,85 @@ void idMD5Mesh::ParseMesh( idLexer &parser, int numJoints, const idJointMat *joi
 	deformInfo = R_BuildDeformInfo( texCoords.Num(), verts, tris.Num(), tris.Ptr(), shader->UseUnsmoothedTangents() );
 }
 
+/*
+====================
+idMD5Mesh::WriteBinary
+====================
+*/
+void idMD5Mesh::WriteBinary( idFile *f ) const {
+	f->WriteString( shader->GetName() );
+	f->WriteBool( shader->UseUnsmoothedTangents() );
+	f->WriteInt( texCoords.Num() );
+	f->Write( texCoords.Ptr(), texCoords.Num() * sizeof( texCoords[0] ) );
+	f->WriteInt( numWeights );
+	f->Write( scaledWeights, numWeights * sizeof( scaledWeights[0] ) );
+	f->Write( weightIndex, numWeights * 2 * sizeof( weightIndex[0] ) );
+	f->WriteInt( numTris );
+	R_WriteDeformInfoBinary( f, deformInfo );
+}
+
+/*
+====================
+idMD5Mesh::ReadBinary
+
+returns false if the file is truncated or the material no longer matches the cached deform info
+====================
+*/
+bool idMD5Mesh::ReadBinary( idFile *f ) {
+	idStr	shaderName;
+	bool	unsmoothedTangents;
+	int		i, count;
+
+	if ( f->ReadString( shaderName ) <= 0 || f->ReadBool( unsmoothedTangents ) <= 0 ) {
+		return false;
+	}
+
+	shader = declManager->FindMaterial( shaderName );
+	if ( shader->UseUnsmoothedTangents() != unsmoothedTangents ) {
+		return false;
+	}
+
+	if ( f->ReadInt( count ) <= 0 || count < 0 ) {
+		return false;
+	}
+	texCoords.SetNum( count );
+	if ( f->Read( texCoords.Ptr(), count * sizeof( texCoords[0] ) ) != count * (int)sizeof( texCoords[0] ) ) {
+		return false;
+	}
+
+	if ( f->ReadInt( numWeights ) <= 0 || numWeights < 0 ) {
+		numWeights = 0;
+		return false;
+	}
+	scaledWeights = (idVec4 *) Mem_Alloc16( numWeights * sizeof( scaledWeights[0] ) );
+	weightIndex = (int *) Mem_Alloc16( numWeights * 2 * sizeof( weightIndex[0] ) );
+	if ( f->Read( scaledWeights, numWeights * sizeof( scaledWeights[0] ) ) != numWeights * (int)sizeof( scaledWeights[0] ) ) {
+		return false;
+	}
+	if ( f->Read( weightIndex, numWeights * 2 * sizeof( weightIndex[0] ) ) != numWeights * 2 * (int)sizeof( weightIndex[0] ) ) {
+		return false;
+	}
+
+	if ( f->ReadInt( numTris ) <= 0 ) {
+		return false;
+	}
+
+	deformInfo = R_ReadDeformInfoBinary( f );
+	if ( !deformInfo ) {
+		return false;
+	}
+
+	// update counters
+	c_numVerts += texCoords.Num();
+	c_numWeights += numWeights;
+	c_numWeightJoints++;
+	for ( i = 0; i < numWeights; i++ ) {
+		c_numWeightJoints += weightIndex[i*2+1];
+	}
+
+	return true;
+}
+
 /*
 ====================
 idMD5Mesh::TransformVerts
@@ -504,6 +583,14 @@ void idRenderModelMD5::LoadModel() {
 	}
 	purged = false;
 
+	// set the timestamp for reloadmodels
+	fileSystem->ReadFile( name, NULL, &timeStamp );
+
+	// try the binary cache first
+	if ( LoadBinaryMD5( timeStamp ) ) {
+		return;
+	}
+
 	if ( !parser.LoadFile( name ) ) {
 		MakeDefaultModel();
 		return;
@@ -569,8 +656,93 @@ void idRenderModelMD5::LoadModel() {
 	//
 	CalculateBounds( poseMat3 );
 
-	// set the timestamp for reloadmodels
-	fileSystem->ReadFile( name, NULL, &timeStamp );
+	// create the binary cache so the next load does not need to parse the mesh
+	WriteBinaryMD5( timeStamp );
+}
+
+/*
+====================
+idRenderModelMD5::WriteBinaryMD5
+
+the bind pose data and deform info of every mesh
+====================
+*/
+void idRenderModelMD5::WriteBinaryMD5( ID_TIME_T sourceTimeStamp ) const {
+	idFile	*file;
+	int		i;
+
+	file = CreateBinaryModel( DM_CACHED, sourceTimeStamp );
+	if ( !file ) {
+		return;
+	}
+
+	file->Write( &bounds, sizeof( bounds ) );
+
+	file->WriteInt( joints.Num() );
+	for( i = 0; i < joints.Num(); i++ ) {
+		file->WriteString( joints[ i ].name );
+		file->WriteInt( joints[ i ].parent ? joints[ i ].parent - joints.Ptr() : -1 );
+	}
+	file->Write( defaultPose.Ptr(), defaultPose.Num() * sizeof( defaultPose[0] ) );
+
+	file->WriteInt( meshes.Num() );
+	for( i = 0; i < meshes.Num(); i++ ) {
+		meshes[ i ].WriteBinary( file );
+	}
+
+	fileSystem->CloseFile( file );
+}
+
+/*
+====================
+idRenderModelMD5::LoadBinaryMD5
+====================
+*/
+bool idRenderModelMD5::LoadBinaryMD5( ID_TIME_T sourceTimeStamp ) {
+	idFile	*file;
+	int		i, num, parentNum;
+	bool	ok;
+
+	file = OpenBinaryModel( DM_CACHED, sourceTimeStamp );
+	if ( !file ) {
+		return false;
+	}
+
+	ok = ( file->Read( &bounds, sizeof( bounds ) ) == sizeof( bounds ) );
+	ok = ok && file->ReadInt( num ) > 0 && num >= 0;
+	if ( ok ) {
+		joints.SetGranularity( 1 );
+		joints.SetNum( num );
+		defaultPose.SetGranularity( 1 );
+		defaultPose.SetNum( num );
+		for( i = 0; ok && i < joints.Num(); i++ ) {
+			ok = file->ReadString( joints[ i ].name ) > 0;
+			ok = ok && file->ReadInt( parentNum ) > 0 && parentNum < i;
+			joints[ i ].parent = ( parentNum < 0 ) ? NULL : &joints[ parentNum ];
+		}
+		ok = ok && file->Read( defaultPose.Ptr(), num * sizeof( defaultPose[0] ) ) == num * (int)sizeof( defaultPose[0] );
+	}
+
+	ok = ok && file->ReadInt( num ) > 0 && num >= 0;
+	if ( ok ) {
+		meshes.SetGranularity( 1 );
+		meshes.SetNum( num );
+		for( i = 0; ok && i < meshes.Num(); i++ ) {
+			ok = meshes[ i ].ReadBinary( file );
+		}
+	}
+
+	fileSystem->CloseFile( file );
+
+	if ( !ok ) {
+		joints.Clear();
+		defaultPose.Clear();
+		meshes.Clear();
+		bounds.Clear();
+		return false;
+	}
+
+	return true;
 }
 
 /*
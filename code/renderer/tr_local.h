@@ -1479,6 +1479,15 @@ void				R_ShutdownTriSurfData( void );
 void				R_PurgeTriSurfData( frameData_t *frame );
 void				R_ShowTriSurfMemory_f( const idCmdArgs &args );
 
+// models can be cleaned up on multiple threads during level loads, each
+// thread other than the main thread passes its own silEdgeWork_t
+typedef struct silEdgeWork_s silEdgeWork_t;
+
+void				R_BeginThreadedTriSurfData( void );
+void				R_EndThreadedTriSurfData( void );
+silEdgeWork_t *		R_AllocSilEdgeWork( void );
+void				R_FreeSilEdgeWork( silEdgeWork_t *work );
+
 srfTriangles_t *	R_AllocStaticTriSurf( void );
 srfTriangles_t *	R_CopyStaticTriSurf( const srfTriangles_t *tri );
 void				R_AllocStaticTriSurfVerts( srfTriangles_t *tri, int numVerts );
@@ -1500,12 +1509,13 @@ int					R_TriSurfMemory( const srfTriangles_t *tri );
 void				R_BoundTriSurf( srfTriangles_t *tri );
 void				R_RemoveDuplicatedTriangles( srfTriangles_t *tri );
 void				R_CreateSilIndexes( srfTriangles_t *tri );
-void				R_RemoveDegenerateTriangles( srfTriangles_t *tri );
+void				R_RemoveDegenerateTriangles( srfTriangles_t *tri, int *numRemoved = NULL );
 void				R_RemoveUnusedVerts( srfTriangles_t *tri );
 void				R_RangeCheckIndexes( const srfTriangles_t *tri );
 void				R_CreateVertexNormals( srfTriangles_t *tri );	// also called by dmap
 void				R_DeriveFacePlanes( srfTriangles_t *tri );		// also called by renderbump
-void				R_CleanupTriangles( srfTriangles_t *tri, bool createNormals, bool identifySilEdges, bool useUnsmoothedTangents );
+void				R_CleanupTriangles( srfTriangles_t *tri, bool createNormals, bool identifySilEdges, bool useUnsmoothedTangents, silEdgeWork_t *work = NULL );
+void				R_IdentifySilEdges( srfTriangles_t *tri, bool omitCoplanarEdges, silEdgeWork_t *work = NULL );
 void				R_ReverseTriangles( srfTriangles_t *tri );
 
 // Only deals with vertexes and indexes, not silhouettes, planes, etc.
@@ -1549,6 +1559,12 @@ deformInfo_t *		R_BuildDeformInfo( int numVerts, const idDrawVert *verts, int nu
 void				R_FreeDeformInfo( deformInfo_t *deformInfo );
 int					R_DeformInfoMemoryUsed( deformInfo_t *deformInfo );
 
+// binary model caches, see idRenderModelStatic::LoadBinaryModel
+void				R_WriteStaticTriSurfBinary( idFile *f, const srfTriangles_t *tri );
+srfTriangles_t *	R_ReadStaticTriSurfBinary( idFile *f );
+void				R_WriteDeformInfoBinary( idFile *f, const deformInfo_t *deform );
+deformInfo_t *		R_ReadDeformInfoBinary( idFile *f );
+
 /*
 ============================================================
 
@@ -1580,6 +1596,17 @@ void *R_StaticAlloc( int bytes );		// just malloc with error checking
 void *R_ClearedStaticAlloc( int bytes );	// with memset
 void R_StaticFree( void *data );
 
+// threads other than the main thread count their static allocations
+// privately, the main thread adds them to tr after joining the thread
+typedef struct {
+	int		c_alloc;
+	int		c_free;
+	int		bytes;
+} staticAllocCounts_t;
+
+void R_SetThreadStaticAllocCounts( staticAllocCounts_t *counts );
+void R_AddStaticAllocCounts( const staticAllocCounts_t &counts );
+
 
 /*
 =============================================================
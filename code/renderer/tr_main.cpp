@@ -293,6 +293,39 @@ int R_CountFrameData( void ) {
 	return count;
 }
 
+#ifdef _WIN32
+#define R_THREAD_LOCAL	__declspec( thread )
+#else
+#define R_THREAD_LOCAL	__thread
+#endif
+
+static R_THREAD_LOCAL staticAllocCounts_t *threadStaticAllocCounts;
+
+/*
+=================
+R_SetThreadStaticAllocCounts
+
+Called at the start of a worker thread so its allocations don't touch the
+counters in tr, NULL goes back to counting in tr.
+=================
+*/
+void R_SetThreadStaticAllocCounts( staticAllocCounts_t *counts ) {
+	threadStaticAllocCounts = counts;
+}
+
+/*
+=================
+R_AddStaticAllocCounts
+
+Only call from the main thread once the worker thread is done.
+=================
+*/
+void R_AddStaticAllocCounts( const staticAllocCounts_t &counts ) {
+	tr.pc.c_alloc += counts.c_alloc;
+	tr.pc.c_free += counts.c_free;
+	tr.staticAllocCount += counts.bytes;
+}
+
 /*
 =================
 R_StaticAlloc
@@ -301,9 +334,13 @@ R_StaticAlloc
 void *R_StaticAlloc( int bytes ) {
 	void	*buf;
 
-	tr.pc.c_alloc++;
-
-	tr.staticAllocCount += bytes;
+	if ( threadStaticAllocCounts ) {
+		threadStaticAllocCounts->c_alloc++;
+		threadStaticAllocCounts->bytes += bytes;
+	} else {
+		tr.pc.c_alloc++;
+		tr.staticAllocCount += bytes;
+	}
 
     buf = Mem_Alloc( bytes );
 
@@ -333,7 +370,11 @@ R_StaticFree
 =================
 */
 void R_StaticFree( void *data ) {
-	tr.pc.c_free++;
+	if ( threadStaticAllocCounts ) {
+		threadStaticAllocCounts->c_free++;
+	} else {
+		tr.pc.c_free++;
+	}
     Mem_Free( data );
 }
 
@@ -119,33 +119,77 @@ is highly uneven.
 const int MAX_SIL_EDGES			= 0x10000;
 const int SILEDGE_HASH_SIZE		= 1024;
 
-static int			numSilEdges;
-static silEdge_t *	silEdges;
-static idHashIndex	silEdgeHash( SILEDGE_HASH_SIZE, MAX_SIL_EDGES );
-static int			numPlanes;
+// scratch space for R_IdentifySilEdges, every thread that cleans up triangles needs its own
+struct silEdgeWork_s {
+					silEdgeWork_s() : silEdgeHash( SILEDGE_HASH_SIZE, MAX_SIL_EDGES ) {}
+
+	int				numSilEdges;
+	silEdge_t *		silEdges;
+	idHashIndex		silEdgeHash;
+	int				numPlanes;
+	int				c_duplicatedEdges;
+	int				c_tripledEdges;
+	int				c_coplanarSilEdges;
+	int				c_totalSilEdges;
+	int				c_degenerateTriangles;
+};
+
+static silEdgeWork_t	silEdgeWork;		// used by the main thread
 
-static idBlockAlloc<srfTriangles_t, 1<<8>				srfTrianglesAllocator;
+/*
+===============================================================================
+
+	The allocators are only locked while models are being cleaned up
+	on multiple threads, see R_BeginThreadedTriSurfData.
+
+===============================================================================
+*/
+
+static bool			triSurfDataThreaded = false;
+
+ID_INLINE void R_LockTriSurfData( void ) {
+	if ( triSurfDataThreaded ) {
+		Sys_EnterCriticalSection( CRITICAL_SECTION_TWO );
+	}
+}
+
+ID_INLINE void R_UnlockTriSurfData( void ) {
+	if ( triSurfDataThreaded ) {
+		Sys_LeaveCriticalSection( CRITICAL_SECTION_TWO );
+	}
+}
+
+template< class type, class allocator >
+class idTriSurfDataAlloc : public allocator {
+public:
+	type *			Alloc( void ) { R_LockTriSurfData(); type *ptr = allocator::Alloc(); R_UnlockTriSurfData(); return ptr; }
+	type *			Alloc( const int num ) { R_LockTriSurfData(); type *ptr = allocator::Alloc( num ); R_UnlockTriSurfData(); return ptr; }
+	type *			Resize( type *ptr, const int num ) { R_LockTriSurfData(); ptr = allocator::Resize( ptr, num ); R_UnlockTriSurfData(); return ptr; }
+	void			Free( type *ptr ) { R_LockTriSurfData(); allocator::Free( ptr ); R_UnlockTriSurfData(); }
+};
+
+static idTriSurfDataAlloc<srfTriangles_t, idBlockAlloc<srfTriangles_t, 1<<8> >						srfTrianglesAllocator;
 
 #ifdef USE_TRI_DATA_ALLOCATOR
-static idDynamicBlockAlloc<idDrawVert, 1<<20, 1<<10>	triVertexAllocator;
-static idDynamicBlockAlloc<glIndex_t, 1<<18, 1<<10>		triIndexAllocator;
-static idDynamicBlockAlloc<shadowCache_t, 1<<18, 1<<10>	triShadowVertexAllocator;
-static idDynamicBlockAlloc<idPlane, 1<<17, 1<<10>		triPlaneAllocator;
-static idDynamicBlockAlloc<glIndex_t, 1<<17, 1<<10>		triSilIndexAllocator;
-static idDynamicBlockAlloc<silEdge_t, 1<<17, 1<<10>		triSilEdgeAllocator;
-static idDynamicBlockAlloc<dominantTri_t, 1<<16, 1<<10>	triDominantTrisAllocator;
-static idDynamicBlockAlloc<int, 1<<16, 1<<10>			triMirroredVertAllocator;
-static idDynamicBlockAlloc<int, 1<<16, 1<<10>			triDupVertAllocator;
+static idTriSurfDataAlloc<idDrawVert, idDynamicBlockAlloc<idDrawVert, 1<<20, 1<<10> >			triVertexAllocator;
+static idTriSurfDataAlloc<glIndex_t, idDynamicBlockAlloc<glIndex_t, 1<<18, 1<<10> >				triIndexAllocator;
+static idTriSurfDataAlloc<shadowCache_t, idDynamicBlockAlloc<shadowCache_t, 1<<18, 1<<10> >		triShadowVertexAllocator;
+static idTriSurfDataAlloc<idPlane, idDynamicBlockAlloc<idPlane, 1<<17, 1<<10> >					triPlaneAllocator;
+static idTriSurfDataAlloc<glIndex_t, idDynamicBlockAlloc<glIndex_t, 1<<17, 1<<10> >				triSilIndexAllocator;
+static idTriSurfDataAlloc<silEdge_t, idDynamicBlockAlloc<silEdge_t, 1<<17, 1<<10> >				triSilEdgeAllocator;
+static idTriSurfDataAlloc<dominantTri_t, idDynamicBlockAlloc<dominantTri_t, 1<<16, 1<<10> >		triDominantTrisAllocator;
+static idTriSurfDataAlloc<int, idDynamicBlockAlloc<int, 1<<16, 1<<10> >							triMirroredVertAllocator;
+static idTriSurfDataAlloc<int, idDynamicBlockAlloc<int, 1<<16, 1<<10> >							triDupVertAllocator;
 #else
-static idDynamicAlloc<idDrawVert, 1<<20, 1<<10>			triVertexAllocator;
-static idDynamicAlloc<glIndex_t, 1<<18, 1<<10>			triIndexAllocator;
-static idDynamicAlloc<shadowCache_t, 1<<18, 1<<10>		triShadowVertexAllocator;
-static idDynamicAlloc<idPlane, 1<<17, 1<<10>			triPlaneAllocator;
-static idDynamicAlloc<glIndex_t, 1<<17, 1<<10>			triSilIndexAllocator;
-static idDynamicAlloc<silEdge_t, 1<<17, 1<<10>			triSilEdgeAllocator;
-static idDynamicAlloc<dominantTri_t, 1<<16, 1<<10>		triDominantTrisAllocator;
-static idDynamicAlloc<int, 1<<16, 1<<10>				triMirroredVertAllocator;
-static idDynamicAlloc<int, 1<<16, 1<<10>				triDupVertAllocator;
+static idTriSurfDataAlloc<idDrawVert, idDynamicAlloc<idDrawVert, 1<<20, 1<<10> >				triVertexAllocator;
+static idTriSurfDataAlloc<glIndex_t, idDynamicAlloc<glIndex_t, 1<<18, 1<<10> >					triIndexAllocator;
+static idTriSurfDataAlloc<shadowCache_t, idDynamicAlloc<shadowCache_t, 1<<18, 1<<10> >			triShadowVertexAllocator;
+static idTriSurfDataAlloc<idPlane, idDynamicAlloc<idPlane, 1<<17, 1<<10> >						triPlaneAllocator;
+static idTriSurfDataAlloc<glIndex_t, idDynamicAlloc<glIndex_t, 1<<17, 1<<10> >					triSilIndexAllocator;
+static idTriSurfDataAlloc<silEdge_t, idDynamicAlloc<silEdge_t, 1<<17, 1<<10> >					triSilEdgeAllocator;
+static idTriSurfDataAlloc<dominantTri_t, idDynamicAlloc<dominantTri_t, 1<<16, 1<<10> >			triDominantTrisAllocator;
+static idTriSurfDataAlloc<int, idDynamicAlloc<int, 1<<16, 1<<10> >								triMirroredVertAllocator;
+static idTriSurfDataAlloc<int, idDynamicAlloc<int, 1<<16, 1<<10> >								triDupVertAllocator;
 #endif
 
 
@@ -155,7 +199,7 @@ R_InitTriSurfData
 ===============
 */
 void R_InitTriSurfData( void ) {
-	silEdges = (silEdge_t *)R_StaticAlloc( MAX_SIL_EDGES * sizeof( silEdges[0] ) );
+	silEdgeWork.silEdges = (silEdge_t *)R_StaticAlloc( MAX_SIL_EDGES * sizeof( silEdgeWork.silEdges[0] ) );
 
 	// initialize allocators for triangle surfaces
 	triVertexAllocator.Init();
@@ -186,8 +230,9 @@ R_ShutdownTriSurfData
 ===============
 */
 void R_ShutdownTriSurfData( void ) {
-	R_StaticFree( silEdges );
-	silEdgeHash.Free();
+	R_StaticFree( silEdgeWork.silEdges );
+	silEdgeWork.silEdges = NULL;
+	silEdgeWork.silEdgeHash.Free();
 	srfTrianglesAllocator.Shutdown();
 	triVertexAllocator.Shutdown();
 	triIndexAllocator.Shutdown();
@@ -221,6 +266,64 @@ void R_PurgeTriSurfData( frameData_t *frame ) {
 	triDupVertAllocator.FreeEmptyBaseBlocks();
 }
 
+/*
+===============
+R_BeginThreadedTriSurfData
+
+Called on the main thread before any other thread allocates or frees triangle surface data.
+===============
+*/
+void R_BeginThreadedTriSurfData( void ) {
+	triSurfDataThreaded = true;
+}
+
+/*
+===============
+R_EndThreadedTriSurfData
+
+Called on the main thread after all other threads are done with triangle surface data.
+===============
+*/
+void R_EndThreadedTriSurfData( void ) {
+	triSurfDataThreaded = false;
+}
+
+/*
+===============
+R_AllocSilEdgeWork
+
+Scratch space for R_CleanupTriangles on threads other than the main thread.
+===============
+*/
+silEdgeWork_t *R_AllocSilEdgeWork( void ) {
+	silEdgeWork_t *work = new silEdgeWork_t;
+
+	work->silEdges = (silEdge_t *)R_StaticAlloc( MAX_SIL_EDGES * sizeof( work->silEdges[0] ) );
+	work->numSilEdges = 0;
+	work->numPlanes = 0;
+	work->c_duplicatedEdges = 0;
+	work->c_tripledEdges = 0;
+	work->c_coplanarSilEdges = 0;
+	work->c_totalSilEdges = 0;
+	work->c_degenerateTriangles = 0;
+	return work;
+}
+
+/*
+===============
+R_FreeSilEdgeWork
+===============
+*/
+void R_FreeSilEdgeWork( silEdgeWork_t *work ) {
+	silEdgeWork.c_coplanarSilEdges += work->c_coplanarSilEdges;
+	silEdgeWork.c_totalSilEdges += work->c_totalSilEdges;
+	if ( work->c_degenerateTriangles ) {
+		common->Printf( "removed %i degenerate triangles\n", work->c_degenerateTriangles );
+	}
+	R_StaticFree( work->silEdges );
+	delete work;
+}
+
 /*
 ===============
 R_ShowTriMemory_f
@@ -922,26 +1025,25 @@ void R_CreateVertexNormals( srfTriangles_t *tri ) {
 R_DefineEdge
 ===============
 */
-static int c_duplicatedEdges, c_tripledEdges;
-
-static void R_DefineEdge( int v1, int v2, int planeNum ) {
+static void R_DefineEdge( silEdgeWork_t *work, int v1, int v2, int planeNum ) {
 	int		i, hashKey;
+	silEdge_t *silEdges = work->silEdges;
 
 	// check for degenerate edge
 	if ( v1 == v2 ) {
 		return;
 	}
-	hashKey = silEdgeHash.GenerateKey( v1, v2 );
+	hashKey = work->silEdgeHash.GenerateKey( v1, v2 );
 	// search for a matching other side
-	for ( i = silEdgeHash.First( hashKey ); i >= 0 && i < MAX_SIL_EDGES; i = silEdgeHash.Next( i ) ) {
+	for ( i = work->silEdgeHash.First( hashKey ); i >= 0 && i < MAX_SIL_EDGES; i = work->silEdgeHash.Next( i ) ) {
 		if ( silEdges[i].v1 == v1 && silEdges[i].v2 == v2 ) {
-			c_duplicatedEdges++;
+			work->c_duplicatedEdges++;
 			// allow it to still create a new edge
 			continue;
 		}
 		if ( silEdges[i].v2 == v1 && silEdges[i].v1 == v2 ) {
-			if ( silEdges[i].p2 != numPlanes )  {
-				c_tripledEdges++;
+			if ( silEdges[i].p2 != work->numPlanes )  {
+				work->c_tripledEdges++;
 				// allow it to still create a new edge
 				continue;
 			}
@@ -953,19 +1055,21 @@ static void R_DefineEdge( int v1, int v2, int planeNum ) {
 	}
 
 	// define the new edge
-	if ( numSilEdges == MAX_SIL_EDGES ) {
-		common->DWarning( "MAX_SIL_EDGES" );
+	if ( work->numSilEdges == MAX_SIL_EDGES ) {
+		if ( work == &silEdgeWork ) {
+			common->DWarning( "MAX_SIL_EDGES" );
+		}
 		return;
 	}
 	
-	silEdgeHash.Add( hashKey, numSilEdges );
+	work->silEdgeHash.Add( hashKey, work->numSilEdges );
 
-	silEdges[numSilEdges].p1 = planeNum;
-	silEdges[numSilEdges].p2 = numPlanes;
-	silEdges[numSilEdges].v1 = v1;
-	silEdges[numSilEdges].v2 = v2;
+	silEdges[work->numSilEdges].p1 = planeNum;
+	silEdges[work->numSilEdges].p2 = work->numPlanes;
+	silEdges[work->numSilEdges].v1 = v1;
+	silEdges[work->numSilEdges].v2 = v2;
 
-	numSilEdges++;
+	work->numSilEdges++;
 }
 
 /*
@@ -995,26 +1099,33 @@ R_IdentifySilEdges
 
 If the surface will not deform, coplanar edges (polygon interiors)
 can never create silhouette plains, and can be omited
+
+Threads other than the main thread must pass their own scratch space.
 =================
 */
-int	c_coplanarSilEdges;
-int	c_totalSilEdges;
-
-void R_IdentifySilEdges( srfTriangles_t *tri, bool omitCoplanarEdges ) {
+void R_IdentifySilEdges( srfTriangles_t *tri, bool omitCoplanarEdges, silEdgeWork_t *work ) {
 	int		i;
 	int		numTris;
 	int		shared, single;
 
 	omitCoplanarEdges = false;	// optimization doesn't work for some reason
 
+	if ( work == NULL ) {
+		work = &silEdgeWork;
+	}
+
 	numTris = tri->numIndexes / 3;
 
+	silEdge_t *	silEdges = work->silEdges;
+	int &		numSilEdges = work->numSilEdges;
+	const int	numPlanes = numTris;
+
 	numSilEdges = 0;
-	silEdgeHash.Clear();
-	numPlanes = numTris;
+	work->silEdgeHash.Clear();
+	work->numPlanes = numPlanes;
 
-	c_duplicatedEdges = 0;
-	c_tripledEdges = 0;
+	work->c_duplicatedEdges = 0;
+	work->c_tripledEdges = 0;
 
 	for ( i = 0 ; i < numTris ; i++ ) {
 		int		i1, i2, i3;
@@ -1024,13 +1135,14 @@ void R_IdentifySilEdges( srfTriangles_t *tri, bool omitCoplanarEdges ) {
 		i3 = tri->silIndexes[ i*3 + 2 ];
 
 		// create the edges
-		R_DefineEdge( i1, i2, i );
-		R_DefineEdge( i2, i3, i );
-		R_DefineEdge( i3, i1, i );
+		R_DefineEdge( work, i1, i2, i );
+		R_DefineEdge( work, i2, i3, i );
+		R_DefineEdge( work, i3, i1, i );
 	}
 
-	if ( c_duplicatedEdges || c_tripledEdges ) {
-		common->DWarning( "%i duplicated edge directions, %i tripled edges", c_duplicatedEdges, c_tripledEdges );
+	// the console can only be printed to from the main thread
+	if ( ( work->c_duplicatedEdges || work->c_tripledEdges ) && work == &silEdgeWork ) {
+		common->DWarning( "%i duplicated edge directions, %i tripled edges", work->c_duplicatedEdges, work->c_tripledEdges );
 	}
 
 	// if we know that the vertexes aren't going
@@ -1081,12 +1193,12 @@ void R_IdentifySilEdges( srfTriangles_t *tri, bool omitCoplanarEdges ) {
 			}
 		}
 		if ( c_coplanarCulled ) {
-			c_coplanarSilEdges += c_coplanarCulled;
+			work->c_coplanarSilEdges += c_coplanarCulled;
 //			common->Printf( "%i of %i sil edges coplanar culled\n", c_coplanarCulled,
 //				c_coplanarCulled + numSilEdges );
 		}
 	}
-	c_totalSilEdges += numSilEdges;
+	work->c_totalSilEdges += numSilEdges;
 
 	// sort the sil edges based on plane number
 	qsort( silEdges, numSilEdges, sizeof( silEdges[0] ), SilEdgeSort );
@@ -1879,7 +1991,7 @@ R_RemoveDegenerateTriangles
 silIndexes must have already been calculated
 =================
 */
-void R_RemoveDegenerateTriangles( srfTriangles_t *tri ) {
+void R_RemoveDegenerateTriangles( srfTriangles_t *tri, int *numRemoved ) {
 	int		c_removed;
 	int		i;
 	int		a, b, c;
@@ -1903,7 +2015,9 @@ void R_RemoveDegenerateTriangles( srfTriangles_t *tri ) {
 
 	// this doesn't free the memory used by the unused verts
 
-	if ( c_removed ) {
+	if ( numRemoved ) {
+		*numRemoved += c_removed;
+	} else if ( c_removed ) {
 		common->Printf( "removed %i degenerate triangles\n", c_removed );
 	}
 }
@@ -2093,21 +2207,22 @@ R_CleanupTriangles
 FIXME: allow createFlat and createSmooth normals, as well as explicit
 =================
 */
-void R_CleanupTriangles( srfTriangles_t *tri, bool createNormals, bool identifySilEdges, bool useUnsmoothedTangents ) {
+void R_CleanupTriangles( srfTriangles_t *tri, bool createNormals, bool identifySilEdges, bool useUnsmoothedTangents, silEdgeWork_t *work ) {
 	R_RangeCheckIndexes( tri );
 
 	R_CreateSilIndexes( tri );
 
 //	R_RemoveDuplicatedTriangles( tri );	// this may remove valid overlapped transparent triangles
 
-	R_RemoveDegenerateTriangles( tri );
+	// worker threads can't print, they total the count for R_FreeSilEdgeWork
+	R_RemoveDegenerateTriangles( tri, ( work != NULL && work != &silEdgeWork ) ? &work->c_degenerateTriangles : NULL );
 
 	R_TestDegenerateTextureSpace( tri );
 
 //	R_RemoveUnusedVerts( tri );
 
 	if ( identifySilEdges ) {
-		R_IdentifySilEdges( tri, true );	// assume it is non-deformable, and omit coplanar edges
+		R_IdentifySilEdges( tri, true, work );	// assume it is non-deformable, and omit coplanar edges
 	}
 
 	// bust vertexes that share a mirrored edge into separate vertexes
@@ -2272,3 +2387,256 @@ int R_DeformInfoMemoryUsed( deformInfo_t *deformInfo ) {
 	return total;
 }
 
+
+/*
+===================================================================================
+
+BINARY MODEL CACHE
+
+	The fully processed surfaces are written as raw arrays, so the binary
+	model caches are platform specific and only valid for the struct sizes
+	they were written with.
+
+===================================================================================
+*/
+
+#define TRI_BINARY_SILINDEXES		BIT( 0 )
+#define TRI_BINARY_MIRROREDVERTS	BIT( 1 )
+#define TRI_BINARY_DUPVERTS			BIT( 2 )
+#define TRI_BINARY_SILEDGES			BIT( 3 )
+#define TRI_BINARY_FACEPLANES		BIT( 4 )
+#define TRI_BINARY_DOMINANTTRIS		BIT( 5 )
+
+/*
+===================
+R_ReadTriData
+===================
+*/
+static bool R_ReadTriData( idFile *f, void *data, int size ) {
+	return ( f->Read( data, size ) == size );
+}
+
+/*
+===================
+R_WriteStaticTriSurfBinary
+
+Writes a surface that has been through R_CleanupTriangles.
+Shadow data and vertex caches are not written, they are created on demand.
+===================
+*/
+void R_WriteStaticTriSurfBinary( idFile *f, const srfTriangles_t *tri ) {
+	int flags;
+
+	flags = 0;
+	flags |= ( tri->silIndexes != NULL ) ? TRI_BINARY_SILINDEXES : 0;
+	flags |= ( tri->mirroredVerts != NULL ) ? TRI_BINARY_MIRROREDVERTS : 0;
+	flags |= ( tri->dupVerts != NULL ) ? TRI_BINARY_DUPVERTS : 0;
+	flags |= ( tri->silEdges != NULL ) ? TRI_BINARY_SILEDGES : 0;
+	flags |= ( tri->facePlanes != NULL ) ? TRI_BINARY_FACEPLANES : 0;
+	flags |= ( tri->dominantTris != NULL ) ? TRI_BINARY_DOMINANTTRIS : 0;
+
+	f->Write( &tri->bounds, sizeof( tri->bounds ) );
+	f->WriteBool( tri->generateNormals );
+	f->WriteBool( tri->tangentsCalculated );
+	f->WriteBool( tri->facePlanesCalculated );
+	f->WriteBool( tri->perfectHull );
+	f->WriteInt( flags );
+	f->WriteInt( tri->numVerts );
+	f->WriteInt( tri->numIndexes );
+	f->WriteInt( tri->numMirroredVerts );
+	f->WriteInt( tri->numDupVerts );
+	f->WriteInt( tri->numSilEdges );
+
+	f->Write( tri->verts, tri->numVerts * sizeof( tri->verts[0] ) );
+	f->Write( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ) );
+	if ( flags & TRI_BINARY_SILINDEXES ) {
+		f->Write( tri->silIndexes, tri->numIndexes * sizeof( tri->silIndexes[0] ) );
+	}
+	if ( flags & TRI_BINARY_MIRROREDVERTS ) {
+		f->Write( tri->mirroredVerts, tri->numMirroredVerts * sizeof( tri->mirroredVerts[0] ) );
+	}
+	if ( flags & TRI_BINARY_DUPVERTS ) {
+		f->Write( tri->dupVerts, tri->numDupVerts * 2 * sizeof( tri->dupVerts[0] ) );
+	}
+	if ( flags & TRI_BINARY_SILEDGES ) {
+		f->Write( tri->silEdges, tri->numSilEdges * sizeof( tri->silEdges[0] ) );
+	}
+	if ( flags & TRI_BINARY_FACEPLANES ) {
+		f->Write( tri->facePlanes, tri->numIndexes / 3 * sizeof( tri->facePlanes[0] ) );
+	}
+	if ( flags & TRI_BINARY_DOMINANTTRIS ) {
+		f->Write( tri->dominantTris, tri->numVerts * sizeof( tri->dominantTris[0] ) );
+	}
+}
+
+/*
+===================
+R_ReadStaticTriSurfBinary
+
+Every array is read straight into its final allocation.
+Returns NULL if the file is truncated.
+===================
+*/
+srfTriangles_t *R_ReadStaticTriSurfBinary( idFile *f ) {
+	srfTriangles_t *tri;
+	int flags;
+	bool ok;
+
+	tri = R_AllocStaticTriSurf();
+
+	ok = R_ReadTriData( f, &tri->bounds, sizeof( tri->bounds ) );
+	ok = ok && f->ReadBool( tri->generateNormals ) > 0;
+	ok = ok && f->ReadBool( tri->tangentsCalculated ) > 0;
+	ok = ok && f->ReadBool( tri->facePlanesCalculated ) > 0;
+	ok = ok && f->ReadBool( tri->perfectHull ) > 0;
+	ok = ok && f->ReadInt( flags ) > 0;
+	ok = ok && f->ReadInt( tri->numVerts ) > 0;
+	ok = ok && f->ReadInt( tri->numIndexes ) > 0;
+	ok = ok && f->ReadInt( tri->numMirroredVerts ) > 0;
+	ok = ok && f->ReadInt( tri->numDupVerts ) > 0;
+	ok = ok && f->ReadInt( tri->numSilEdges ) > 0;
+
+	if ( !ok || tri->numVerts < 0 || tri->numIndexes < 0 || tri->numMirroredVerts < 0 || tri->numDupVerts < 0 || tri->numSilEdges < 0 ) {
+		R_ReallyFreeStaticTriSurf( tri );
+		return NULL;
+	}
+
+	R_AllocStaticTriSurfVerts( tri, tri->numVerts );
+	ok = R_ReadTriData( f, tri->verts, tri->numVerts * sizeof( tri->verts[0] ) );
+
+	R_AllocStaticTriSurfIndexes( tri, tri->numIndexes );
+	ok = ok && R_ReadTriData( f, tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ) );
+
+	if ( flags & TRI_BINARY_SILINDEXES ) {
+		tri->silIndexes = triSilIndexAllocator.Alloc( tri->numIndexes );
+		ok = ok && R_ReadTriData( f, tri->silIndexes, tri->numIndexes * sizeof( tri->silIndexes[0] ) );
+	}
+	if ( flags & TRI_BINARY_MIRROREDVERTS ) {
+		tri->mirroredVerts = triMirroredVertAllocator.Alloc( tri->numMirroredVerts );
+		ok = ok && R_ReadTriData( f, tri->mirroredVerts, tri->numMirroredVerts * sizeof( tri->mirroredVerts[0] ) );
+	}
+	if ( flags & TRI_BINARY_DUPVERTS ) {
+		tri->dupVerts = triDupVertAllocator.Alloc( tri->numDupVerts * 2 );
+		ok = ok && R_ReadTriData( f, tri->dupVerts, tri->numDupVerts * 2 * sizeof( tri->dupVerts[0] ) );
+	}
+	if ( flags & TRI_BINARY_SILEDGES ) {
+		tri->silEdges = triSilEdgeAllocator.Alloc( tri->numSilEdges );
+		ok = ok && R_ReadTriData( f, tri->silEdges, tri->numSilEdges * sizeof( tri->silEdges[0] ) );
+	}
+	if ( flags & TRI_BINARY_FACEPLANES ) {
+		R_AllocStaticTriSurfPlanes( tri, tri->numIndexes );
+		ok = ok && R_ReadTriData( f, tri->facePlanes, tri->numIndexes / 3 * sizeof( tri->facePlanes[0] ) );
+	}
+	if ( flags & TRI_BINARY_DOMINANTTRIS ) {
+		tri->dominantTris = triDominantTrisAllocator.Alloc( tri->numVerts );
+		ok = ok && R_ReadTriData( f, tri->dominantTris, tri->numVerts * sizeof( tri->dominantTris[0] ) );
+	}
+
+	if ( !ok ) {
+		R_ReallyFreeStaticTriSurf( tri );
+		return NULL;
+	}
+
+	return tri;
+}
+
+/*
+===================
+R_WriteDeformInfoBinary
+===================
+*/
+void R_WriteDeformInfoBinary( idFile *f, const deformInfo_t *deform ) {
+	int flags;
+
+	flags = 0;
+	flags |= ( deform->silIndexes != NULL ) ? TRI_BINARY_SILINDEXES : 0;
+	flags |= ( deform->mirroredVerts != NULL ) ? TRI_BINARY_MIRROREDVERTS : 0;
+	flags |= ( deform->dupVerts != NULL ) ? TRI_BINARY_DUPVERTS : 0;
+	flags |= ( deform->silEdges != NULL ) ? TRI_BINARY_SILEDGES : 0;
+	flags |= ( deform->dominantTris != NULL ) ? TRI_BINARY_DOMINANTTRIS : 0;
+
+	f->WriteInt( flags );
+	f->WriteInt( deform->numSourceVerts );
+	f->WriteInt( deform->numOutputVerts );
+	f->WriteInt( deform->numIndexes );
+	f->WriteInt( deform->numMirroredVerts );
+	f->WriteInt( deform->numDupVerts );
+	f->WriteInt( deform->numSilEdges );
+
+	f->Write( deform->indexes, deform->numIndexes * sizeof( deform->indexes[0] ) );
+	if ( flags & TRI_BINARY_SILINDEXES ) {
+		f->Write( deform->silIndexes, deform->numIndexes * sizeof( deform->silIndexes[0] ) );
+	}
+	if ( flags & TRI_BINARY_MIRROREDVERTS ) {
+		f->Write( deform->mirroredVerts, deform->numMirroredVerts * sizeof( deform->mirroredVerts[0] ) );
+	}
+	if ( flags & TRI_BINARY_DUPVERTS ) {
+		f->Write( deform->dupVerts, deform->numDupVerts * 2 * sizeof( deform->dupVerts[0] ) );
+	}
+	if ( flags & TRI_BINARY_SILEDGES ) {
+		f->Write( deform->silEdges, deform->numSilEdges * sizeof( deform->silEdges[0] ) );
+	}
+	if ( flags & TRI_BINARY_DOMINANTTRIS ) {
+		// R_BuildDominantTris allocates one per output vertex
+		f->Write( deform->dominantTris, deform->numOutputVerts * sizeof( deform->dominantTris[0] ) );
+	}
+}
+
+/*
+===================
+R_ReadDeformInfoBinary
+
+Returns NULL if the file is truncated.
+===================
+*/
+deformInfo_t *R_ReadDeformInfoBinary( idFile *f ) {
+	deformInfo_t *deform;
+	int flags;
+	bool ok;
+
+	deform = (deformInfo_t *)R_ClearedStaticAlloc( sizeof( *deform ) );
+
+	ok = f->ReadInt( flags ) > 0;
+	ok = ok && f->ReadInt( deform->numSourceVerts ) > 0;
+	ok = ok && f->ReadInt( deform->numOutputVerts ) > 0;
+	ok = ok && f->ReadInt( deform->numIndexes ) > 0;
+	ok = ok && f->ReadInt( deform->numMirroredVerts ) > 0;
+	ok = ok && f->ReadInt( deform->numDupVerts ) > 0;
+	ok = ok && f->ReadInt( deform->numSilEdges ) > 0;
+
+	if ( !ok || deform->numOutputVerts < 0 || deform->numIndexes < 0 || deform->numMirroredVerts < 0 || deform->numDupVerts < 0 || deform->numSilEdges < 0 ) {
+		R_FreeDeformInfo( deform );
+		return NULL;
+	}
+
+	deform->indexes = triIndexAllocator.Alloc( deform->numIndexes );
+	ok = R_ReadTriData( f, deform->indexes, deform->numIndexes * sizeof( deform->indexes[0] ) );
+
+	if ( flags & TRI_BINARY_SILINDEXES ) {
+		deform->silIndexes = triSilIndexAllocator.Alloc( deform->numIndexes );
+		ok = ok && R_ReadTriData( f, deform->silIndexes, deform->numIndexes * sizeof( deform->silIndexes[0] ) );
+	}
+	if ( flags & TRI_BINARY_MIRROREDVERTS ) {
+		deform->mirroredVerts = triMirroredVertAllocator.Alloc( deform->numMirroredVerts );
+		ok = ok && R_ReadTriData( f, deform->mirroredVerts, deform->numMirroredVerts * sizeof( deform->mirroredVerts[0] ) );
+	}
+	if ( flags & TRI_BINARY_DUPVERTS ) {
+		deform->dupVerts = triDupVertAllocator.Alloc( deform->numDupVerts * 2 );
+		ok = ok && R_ReadTriData( f, deform->dupVerts, deform->numDupVerts * 2 * sizeof( deform->dupVerts[0] ) );
+	}
+	if ( flags & TRI_BINARY_SILEDGES ) {
+		deform->silEdges = triSilEdgeAllocator.Alloc( deform->numSilEdges );
+		ok = ok && R_ReadTriData( f, deform->silEdges, deform->numSilEdges * sizeof( deform->silEdges[0] ) );
+	}
+	if ( flags & TRI_BINARY_DOMINANTTRIS ) {
+		deform->dominantTris = triDominantTrisAllocator.Alloc( deform->numOutputVerts );
+		ok = ok && R_ReadTriData( f, deform->dominantTris, deform->numOutputVerts * sizeof( deform->dominantTris[0] ) );
+	}
+
+	if ( !ok ) {
+		R_FreeDeformInfo( deform );
+		return NULL;
+	}
+
+	return deform;
+}
@@ -142,6 +142,44 @@ void Sys_TriggerEvent( int index ) {
 	Sys_LeaveCriticalSection( MAX_LOCAL_CRITICAL_SECTIONS - 1 );
 }
 
+/*
+======================================================
+job signals
+counting semaphores built from a condition and a counter, they share the event lock
+======================================================
+*/
+
+static pthread_cond_t	jobSignalCond[ MAX_JOB_SIGNALS ];
+static int				jobSignalCount[ MAX_JOB_SIGNALS ];
+
+/*
+==================
+Sys_WaitForJobSignal
+==================
+*/
+void Sys_WaitForJobSignal( int index ) {
+	assert( index >= 0 && index < MAX_JOB_SIGNALS );
+	Sys_EnterCriticalSection( MAX_LOCAL_CRITICAL_SECTIONS - 1 );
+	while ( jobSignalCount[ index ] == 0 ) {
+		pthread_cond_wait( &jobSignalCond[ index ], &global_lock[ MAX_LOCAL_CRITICAL_SECTIONS - 1 ] );
+	}
+	jobSignalCount[ index ]--;
+	Sys_LeaveCriticalSection( MAX_LOCAL_CRITICAL_SECTIONS - 1 );
+}
+
+/*
+==================
+Sys_RaiseJobSignal
+==================
+*/
+void Sys_RaiseJobSignal( int index, int count ) {
+	assert( index >= 0 && index < MAX_JOB_SIGNALS );
+	Sys_EnterCriticalSection( MAX_LOCAL_CRITICAL_SECTIONS - 1 );
+	jobSignalCount[ index ] += count;
+	pthread_cond_broadcast( &jobSignalCond[ index ] );
+	Sys_LeaveCriticalSection( MAX_LOCAL_CRITICAL_SECTIONS - 1 );
+}
+
 /*
 ======================================================
 thread create and destroy
@@ -284,6 +322,12 @@ void Posix_InitPThreads( ) {
 		waiting[i] = false;
 	}
 
+	// init job signals
+	for ( i = 0; i < MAX_JOB_SIGNALS; i++ ) {
+		pthread_cond_init( &jobSignalCond[ i ], NULL );
+		jobSignalCount[ i ] = 0;
+	}
+
 	// init threads table
 	for ( i = 0; i < MAX_THREADS; i++ ) {
 		g_threads[ i ] = NULL;
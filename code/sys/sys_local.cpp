@@ -156,6 +156,127 @@ void idSysLocal::FPU_EnableExceptions( int exceptions ) {
 	Sys_FPU_EnableExceptions( exceptions );
 }
 
+/*
+==============================================================
+
+	jobs
+
+	Jobs are shared between the calling thread and worker threads that
+	are started the first time they are needed and then wait for the
+	next job list. Jobs must not use anything that isn't thread safe,
+	the caller only gets control back when all jobs are done.
+
+==============================================================
+*/
+
+typedef struct sysJobList_s {
+	sysJob_t				job;
+	void **					jobData;
+	int						numJobs;
+	int						numThreads;			// number of job threads working on the list
+	int						nextJob;			// protected by CRITICAL_SECTION_THREE
+	int						numThreadsDone;		// protected by CRITICAL_SECTION_THREE
+} sysJobList_t;
+
+static xthreadInfo			jobThreads[MAX_JOB_THREADS];
+static int					numJobThreads = 0;
+static sysJobList_t *		currentJobList = NULL;	// protected by CRITICAL_SECTION_THREE
+
+/*
+=================
+Sys_RunJobList
+=================
+*/
+static void Sys_RunJobList( sysJobList_t *list ) {
+	int jobNum;
+
+	while( 1 ) {
+		Sys_EnterCriticalSection( CRITICAL_SECTION_THREE );
+		jobNum = list->nextJob++;
+		Sys_LeaveCriticalSection( CRITICAL_SECTION_THREE );
+
+		if ( jobNum >= list->numJobs ) {
+			break;
+		}
+
+		list->job( list->jobData[jobNum] );
+	}
+}
+
+/*
+=================
+Sys_JobThread
+=================
+*/
+static unsigned int Sys_JobThread( void *parms ) {
+	sysJobList_t *list;
+	bool last;
+	cpuid_t cpuid = Sys_GetProcessorId();
+
+	// use the same denormal handling as the main thread so results don't depend on the thread running a job
+	Sys_FPU_SetFTZ( ( cpuid & CPUID_FTZ ) != 0 );
+	Sys_FPU_SetDAZ( ( cpuid & CPUID_DAZ ) != 0 );
+
+	while( 1 ) {
+		Sys_WaitForJobSignal( JOB_SIGNAL_START );
+
+		Sys_EnterCriticalSection( CRITICAL_SECTION_THREE );
+		list = currentJobList;
+		Sys_LeaveCriticalSection( CRITICAL_SECTION_THREE );
+
+		Sys_RunJobList( list );
+
+		Sys_EnterCriticalSection( CRITICAL_SECTION_THREE );
+		last = ( ++list->numThreadsDone == list->numThreads );
+		Sys_LeaveCriticalSection( CRITICAL_SECTION_THREE );
+
+		if ( last ) {
+			Sys_RaiseJobSignal( JOB_SIGNAL_DONE );
+		}
+	}
+
+	return 0;
+}
+
+/*
+=================
+idSysLocal::RunJobs
+=================
+*/
+void idSysLocal::RunJobs( sysJob_t job, void **jobData, int numJobs, int numThreads ) {
+	sysJobList_t	list;
+
+	numThreads = Max( 0, Min( numThreads, Min( MAX_JOB_THREADS, numJobs - 1 ) ) );
+
+	// the job threads are created once and wait for a job list afterwards
+	while( numJobThreads < numThreads ) {
+		Sys_CreateThread( (xthread_t)Sys_JobThread, NULL, THREAD_NORMAL, jobThreads[numJobThreads], "job", g_threads, &g_thread_count );
+		numJobThreads++;
+	}
+
+	list.job = job;
+	list.jobData = jobData;
+	list.numJobs = numJobs;
+	list.numThreads = numThreads;
+	list.nextJob = 0;
+	list.numThreadsDone = 0;
+
+	if ( numThreads > 0 ) {
+		Sys_EnterCriticalSection( CRITICAL_SECTION_THREE );
+		currentJobList = &list;
+		Sys_LeaveCriticalSection( CRITICAL_SECTION_THREE );
+
+		Sys_RaiseJobSignal( JOB_SIGNAL_START, numThreads );
+	}
+
+	Sys_RunJobList( &list );
+
+	// sleep until the last job thread is done with the list
+	if ( numThreads > 0 ) {
+		Sys_WaitForJobSignal( JOB_SIGNAL_DONE );
+	}
+}
+
 /*
 =================
 Sys_TimeStampToStr
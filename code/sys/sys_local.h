@@ -71,6 +71,8 @@ public:
 
 	virtual void			OpenURL( const char *url, bool quit );
 	virtual void			StartProcess(const char* exeName, bool quit) { };
+
+	virtual void			RunJobs( sysJob_t job, void **jobData, int numJobs, int numThreads );
 };
 
 #endif /* !__SYS_LOCAL__ */
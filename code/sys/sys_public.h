@@ -526,6 +526,22 @@ enum {
 void				Sys_WaitForEvent( int index = TRIGGER_EVENT_ZERO );
 void				Sys_TriggerEvent( int index = TRIGGER_EVENT_ZERO );
 
+// counting signals used by idSys::RunJobs, unlike the trigger events any number of threads can wait on them
+const int MAX_JOB_SIGNALS			= 2;
+
+enum {
+	JOB_SIGNAL_START = 0,			// raised once for every job thread that should work on the current job list
+	JOB_SIGNAL_DONE					// raised by the last job thread done with the current job list
+};
+
+void				Sys_WaitForJobSignal( int index );
+void				Sys_RaiseJobSignal( int index, int count = 1 );
+
+// jobs run by idSys::RunJobs
+typedef void (*sysJob_t)( void *data );
+
+const int MAX_JOB_THREADS			= 4;
+
 /*
 ==============================================================
 
@@ -568,6 +584,10 @@ public:
 
 	virtual void			OpenURL( const char *url, bool quit ) = 0;
 	virtual void			StartProcess( const char *exePath, bool quit ) = 0;
+
+							// runs job( jobData[i] ) for all jobs on the calling thread and up to numThreads
+							// extra threads, returns when all jobs are done
+	virtual void			RunJobs( sysJob_t job, void **jobData, int numJobs, int numThreads ) = 0;
 };
 
 extern idSys *				sys;
@@ -151,6 +151,7 @@ typedef struct {
 
 	CRITICAL_SECTION criticalSections[MAX_CRITICAL_SECTIONS];
 	HANDLE			backgroundDownloadSemaphore;
+	HANDLE			jobSemaphores[MAX_JOB_SIGNALS];
 
 	HINSTANCE		hInstDI;			// direct input
 
@@ -200,6 +200,26 @@ void Sys_TriggerEvent( int index ) {
 	SetEvent( win32.backgroundDownloadSemaphore );
 }
 
+/*
+==================
+Sys_WaitForJobSignal
+==================
+*/
+void Sys_WaitForJobSignal( int index ) {
+	assert( index >= 0 && index < MAX_JOB_SIGNALS );
+	WaitForSingleObject( win32.jobSemaphores[index], INFINITE );
+}
+
+/*
+==================
+Sys_RaiseJobSignal
+==================
+*/
+void Sys_RaiseJobSignal( int index, int count ) {
+	assert( index >= 0 && index < MAX_JOB_SIGNALS );
+	ReleaseSemaphore( win32.jobSemaphores[index], count, NULL );
+}
+
 
 #ifdef DEBUG
 
@@ -1334,6 +1354,10 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 		InitializeCriticalSection(&win32.criticalSections[i]);
 	}
 
+	for (int i = 0; i < MAX_JOB_SIGNALS; i++) {
+		win32.jobSemaphores[i] = CreateSemaphore(NULL, 0, MAX_JOB_THREADS, NULL);
+	}
+
 	// get the initial time base
 	Sys_Milliseconds();
 
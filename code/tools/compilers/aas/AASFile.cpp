@@ -495,6 +495,76 @@ bool idAASSettings::WriteToFile( idFile *fp ) const {
 	return true;
 }
 
+/*
+============
+AASSettings_WriteBinary
+============
+*/
+static void AASSettings_WriteBinary( idFile *fp, const idAASSettings &settings ) {
+	int i;
+
+	fp->WriteInt( settings.numBoundingBoxes );
+	for ( i = 0; i < settings.numBoundingBoxes; i++ ) {
+		fp->WriteVec3( settings.boundingBoxes[i][0] );
+		fp->WriteVec3( settings.boundingBoxes[i][1] );
+	}
+	fp->WriteBool( settings.usePatches );
+	fp->WriteBool( settings.writeBrushMap );
+	fp->WriteBool( settings.playerFlood );
+	fp->WriteBool( settings.noOptimize );
+	fp->WriteBool( settings.allowSwimReachabilities );
+	fp->WriteBool( settings.allowFlyReachabilities );
+	fp->WriteString( settings.fileExtension );
+	fp->WriteVec3( settings.gravity );
+	fp->WriteFloat( settings.maxStepHeight );
+	fp->WriteFloat( settings.maxBarrierHeight );
+	fp->WriteFloat( settings.maxWaterJumpHeight );
+	fp->WriteFloat( settings.maxFallHeight );
+	fp->WriteFloat( settings.minFloorCos );
+	fp->WriteInt( settings.tt_barrierJump );
+	fp->WriteInt( settings.tt_startCrouching );
+	fp->WriteInt( settings.tt_waterJump );
+	fp->WriteInt( settings.tt_startWalkOffLedge );
+}
+
+/*
+============
+AASSettings_ReadBinary
+============
+*/
+static bool AASSettings_ReadBinary( idFile *fp, idAASSettings &settings ) {
+	int i;
+
+	fp->ReadInt( settings.numBoundingBoxes );
+	if ( settings.numBoundingBoxes <= 0 || settings.numBoundingBoxes > MAX_AAS_BOUNDING_BOXES ) {
+		return false;
+	}
+	for ( i = 0; i < settings.numBoundingBoxes; i++ ) {
+		fp->ReadVec3( settings.boundingBoxes[i][0] );
+		fp->ReadVec3( settings.boundingBoxes[i][1] );
+	}
+	fp->ReadBool( settings.usePatches );
+	fp->ReadBool( settings.writeBrushMap );
+	fp->ReadBool( settings.playerFlood );
+	fp->ReadBool( settings.noOptimize );
+	fp->ReadBool( settings.allowSwimReachabilities );
+	fp->ReadBool( settings.allowFlyReachabilities );
+	fp->ReadString( settings.fileExtension );
+	fp->ReadVec3( settings.gravity );
+	settings.gravityDir = settings.gravity;
+	settings.gravityValue = settings.gravityDir.Normalize();
+	settings.invGravityDir = -settings.gravityDir;
+	fp->ReadFloat( settings.maxStepHeight );
+	fp->ReadFloat( settings.maxBarrierHeight );
+	fp->ReadFloat( settings.maxWaterJumpHeight );
+	fp->ReadFloat( settings.maxFallHeight );
+	fp->ReadFloat( settings.minFloorCos );
+	fp->ReadInt( settings.tt_barrierJump );
+	fp->ReadInt( settings.tt_startCrouching );
+	fp->ReadInt( settings.tt_waterJump );
+	return ( fp->ReadInt( settings.tt_startWalkOffLedge ) == sizeof( int ) );
+}
+
 /*
 ============
 idAASSettings::ValidForBounds
@@ -570,6 +640,8 @@ idAASFileLocal::idAASFileLocal
 ================
 */
 idAASFileLocal::idAASFileLocal( void ) {
+	reachabilityBlock = NULL;
+	numBlockReachabilities = 0;
 	planeList.SetGranularity( AAS_PLANE_GRANULARITY );
 	vertices.SetGranularity( AAS_VERTEX_GRANULARITY );
 	edges.SetGranularity( AAS_EDGE_GRANULARITY );
@@ -595,9 +667,24 @@ idAASFileLocal::~idAASFileLocal( void ) {
 	for ( i = 0; i < areas.Num(); i++ ) {
 		for ( reach = areas[i].reach; reach; reach = next ) {
 			next = reach->next;
-			delete reach;
+			FreeReachability( reach );
 		}
 	}
+	delete[] reachabilityBlock;
+}
+
+/*
+================
+idAASFileLocal::FreeReachability
+
+  Reachabilities loaded from a binary file live in one contiguous block.
+================
+*/
+void idAASFileLocal::FreeReachability( idReachability *reach ) {
+	if ( reach >= reachabilityBlock && reach < reachabilityBlock + numBlockReachabilities ) {
+		return;
+	}
+	delete reach;
 }
 
 /*
@@ -1108,6 +1195,12 @@ bool idAASFileLocal::Load( const idStr &fileName, unsigned int mapFileCRC ) {
 	common->Printf( "[Load AAS]\n" );
 	common->Printf( "loading %s\n", name.c_str() );
 
+	// try the binary cache first
+	if ( LoadBinary( fileName, mapFileCRC ) ) {
+		common->Printf( "done.\n" );
+		return true;
+	}
+
 	if ( !src.LoadFile( name ) ) {
 		return false;
 	}
@@ -1191,6 +1284,9 @@ bool idAASFileLocal::Load( const idStr &fileName, unsigned int mapFileCRC ) {
 		src.Error( "idAASFileLocal::Load: tree depth = %d", depth );
 	}
 
+	// create the binary cache so the next load does not need to parse the text file
+	WriteBinary( fileName, c );
+
 	common->Printf( "done.\n" );
 
 	return true;
@@ -1284,11 +1380,14 @@ void idAASFileLocal::DeleteReachabilities( void ) {
 	for ( i = 0; i < areas.Num(); i++ ) {
 		for ( reach = areas[i].reach; reach; reach = nextReach ) {
 			nextReach = reach->next;
-			delete reach;
+			FreeReachability( reach );
 		}
 		areas[i].reach = NULL;
 		areas[i].rev_reach = NULL;
 	}
+	delete[] reachabilityBlock;
+	reachabilityBlock = NULL;
+	numBlockReachabilities = 0;
 }
 
 /*
@@ -1312,3 +1411,313 @@ void idAASFileLocal::DeleteClusters( void ) {
 	memset( &cluster, 0, sizeof( portal ) );
 	clusters.Append( cluster );
 }
+
+
+/*
+===============================================================================
+
+	Binary AAS file
+
+	A platform specific cache of a loaded text AAS file. All lists are read
+	straight into their arrays and the reachabilities are stored in a single
+	contiguous block with the area and reachability links stored as indices
+	that are fixed up after reading.
+
+===============================================================================
+*/
+
+#define AAS_BINARYFILEID		( ( 'S' << 24 ) | ( 'A' << 16 ) | ( 'A' << 8 ) | 'B' )
+#define AAS_BINARYFILEVERSION	1
+
+idCVar aas_binaryFiles( "aas_binaryFiles", "1", CVAR_SYSTEM | CVAR_BOOL, "read and write binary AAS file caches" );
+
+typedef struct aasBinaryHeader_s {
+	int							id;
+	int							version;
+	unsigned int				mapFileCRC;
+	ID_TIME_T					sourceTimeStamp;	// time stamp of the text AAS file the cache was created from
+	int							pointerSize;
+	int							areaSize;
+	int							reachabilitySize;
+} aasBinaryHeader_t;
+
+/*
+================
+AAS_BinaryFileName
+================
+*/
+static idStr AAS_BinaryFileName( const idStr &fileName ) {
+	idStr name, extension;
+
+	fileName.ExtractFileExtension( extension );
+	name = fileName;
+	name.SetFileExtension( "b" + extension );
+	return name;
+}
+
+/*
+================
+AAS_SetupBinaryHeader
+================
+*/
+static void AAS_SetupBinaryHeader( aasBinaryHeader_t *header, unsigned int mapFileCRC, ID_TIME_T sourceTimeStamp ) {
+	memset( header, 0, sizeof( *header ) );
+	header->id = AAS_BINARYFILEID;
+	header->version = AAS_BINARYFILEVERSION;
+	header->mapFileCRC = mapFileCRC;
+	header->sourceTimeStamp = sourceTimeStamp;
+	header->pointerSize = sizeof( void * );
+	header->areaSize = sizeof( aasArea_t );
+	header->reachabilitySize = sizeof( idReachability );
+}
+
+/*
+================
+AAS_WriteBinaryList
+================
+*/
+template< class type >
+static void AAS_WriteBinaryList( idFile *fp, const idList<type> &list ) {
+	fp->WriteInt( list.Num() );
+	fp->Write( list.Ptr(), list.Num() * sizeof( type ) );
+}
+
+/*
+================
+AAS_ReadBinaryList
+================
+*/
+template< class type >
+static bool AAS_ReadBinaryList( idFile *fp, idList<type> &list ) {
+	int num;
+
+	if ( fp->ReadInt( num ) != sizeof( num ) || num < 0 ) {
+		return false;
+	}
+	list.SetNum( num );
+	return ( fp->Read( list.Ptr(), num * sizeof( type ) ) == num * (int)sizeof( type ) );
+}
+
+/*
+================
+idAASFileLocal::WriteBinary
+================
+*/
+bool idAASFileLocal::WriteBinary( const idStr &fileName, unsigned int mapFileCRC ) {
+	int i, numReach;
+	idFile *fp;
+	idStr binaryName;
+	ID_TIME_T sourceTimeStamp;
+	aasBinaryHeader_t header;
+	idList<aasArea_t> binaryAreas;
+	idList<idReachability *> reachList;
+	idHashIndex reachHash;
+	idReachability *reach, binaryReach;
+
+	if ( !aas_binaryFiles.GetBool() ) {
+		return false;
+	}
+
+	fileSystem->ReadFile( fileName, NULL, &sourceTimeStamp );
+
+	binaryName = AAS_BinaryFileName( fileName );
+	fp = fileSystem->OpenFileWrite( binaryName );
+	if ( !fp ) {
+		common->Warning( "Error opening %s", binaryName.c_str() );
+		return false;
+	}
+
+	AAS_SetupBinaryHeader( &header, mapFileCRC, sourceTimeStamp );
+	fp->Write( &header, sizeof( header ) );
+
+	AASSettings_WriteBinary( fp, settings );
+
+	AAS_WriteBinaryList( fp, planeList );
+	AAS_WriteBinaryList( fp, vertices );
+	AAS_WriteBinaryList( fp, edges );
+	AAS_WriteBinaryList( fp, edgeIndex );
+	AAS_WriteBinaryList( fp, faces );
+	AAS_WriteBinaryList( fp, faceIndex );
+	AAS_WriteBinaryList( fp, nodes );
+	AAS_WriteBinaryList( fp, portals );
+	AAS_WriteBinaryList( fp, portalIndex );
+	AAS_WriteBinaryList( fp, clusters );
+
+	// number all reachabilities in area order
+	reachList.SetGranularity( 1024 );
+	reachHash.Clear( 4096, 4096 );
+	for ( i = 0; i < areas.Num(); i++ ) {
+		for ( reach = areas[i].reach; reach; reach = reach->next ) {
+			reachHash.Add( (int) ( (intptr_t) reach >> 4 ), reachList.Append( reach ) );
+		}
+	}
+
+	#define REACH_TO_INDEX( r )		( (idReachability *) (intptr_t) ( ReachIndex( r, reachList, reachHash ) + 1 ) )
+
+	// areas with the reachability pointers replaced by indices
+	binaryAreas = areas;
+	for ( i = 0; i < binaryAreas.Num(); i++ ) {
+		binaryAreas[i].reach = REACH_TO_INDEX( areas[i].reach );
+		binaryAreas[i].rev_reach = REACH_TO_INDEX( areas[i].rev_reach );
+	}
+	AAS_WriteBinaryList( fp, binaryAreas );
+
+	numReach = reachList.Num();
+	fp->WriteInt( numReach );
+	for ( i = 0; i < numReach; i++ ) {
+		memcpy( &binaryReach, reachList[i], sizeof( binaryReach ) );
+		binaryReach.next = REACH_TO_INDEX( reachList[i]->next );
+		binaryReach.rev_next = REACH_TO_INDEX( reachList[i]->rev_next );
+		binaryReach.areaTravelTimes = NULL;
+		fp->Write( &binaryReach, sizeof( binaryReach ) );
+	}
+
+	#undef REACH_TO_INDEX
+
+	// dictionaries of special reachabilities
+	for ( i = 0; i < numReach; i++ ) {
+		if ( reachList[i]->travelType == TFL_SPECIAL ) {
+			static_cast<idReachability_Special *>( reachList[i] )->dict.WriteToFileHandle( fp );
+		}
+	}
+
+	fileSystem->CloseFile( fp );
+
+	return true;
+}
+
+/*
+================
+idAASFileLocal::ReachIndex
+================
+*/
+int idAASFileLocal::ReachIndex( const idReachability *reach, const idList<idReachability *> &reachList, const idHashIndex &reachHash ) {
+	int i;
+
+	if ( !reach ) {
+		return -1;
+	}
+	for ( i = reachHash.First( (int) ( (intptr_t) reach >> 4 ) ); i != -1; i = reachHash.Next( i ) ) {
+		if ( reachList[i] == reach ) {
+			return i;
+		}
+	}
+	assert( 0 );
+	return -1;
+}
+
+/*
+================
+idAASFileLocal::LoadBinary
+================
+*/
+bool idAASFileLocal::LoadBinary( const idStr &fileName, unsigned int mapFileCRC ) {
+	int i, numReach;
+	idFile *fp;
+	idStr binaryName;
+	ID_TIME_T sourceTimeStamp;
+	aasBinaryHeader_t header, expected;
+	idList<idReachability *> reachList;
+	idReachability *reach;
+	idReachability_Special *special;
+	bool ok;
+
+	if ( !aas_binaryFiles.GetBool() ) {
+		return false;
+	}
+
+	binaryName = AAS_BinaryFileName( fileName );
+	fp = fileSystem->OpenFileRead( binaryName );
+	if ( !fp ) {
+		return false;
+	}
+
+	fileSystem->ReadFile( fileName, NULL, &sourceTimeStamp );
+
+	if ( fp->Read( &header, sizeof( header ) ) != sizeof( header ) ) {
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	AAS_SetupBinaryHeader( &expected, header.mapFileCRC, sourceTimeStamp );
+	if ( memcmp( &header, &expected, sizeof( header ) ) != 0 || ( mapFileCRC && header.mapFileCRC != mapFileCRC ) ) {
+		common->DPrintf( "%s is out of date\n", binaryName.c_str() );
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	Clear();
+
+	ok = AASSettings_ReadBinary( fp, settings );
+	ok = ok && AAS_ReadBinaryList( fp, planeList );
+	ok = ok && AAS_ReadBinaryList( fp, vertices );
+	ok = ok && AAS_ReadBinaryList( fp, edges );
+	ok = ok && AAS_ReadBinaryList( fp, edgeIndex );
+	ok = ok && AAS_ReadBinaryList( fp, faces );
+	ok = ok && AAS_ReadBinaryList( fp, faceIndex );
+	ok = ok && AAS_ReadBinaryList( fp, nodes );
+	ok = ok && AAS_ReadBinaryList( fp, portals );
+	ok = ok && AAS_ReadBinaryList( fp, portalIndex );
+	ok = ok && AAS_ReadBinaryList( fp, clusters );
+	ok = ok && AAS_ReadBinaryList( fp, areas );
+	ok = ok && ( fp->ReadInt( numReach ) == sizeof( numReach ) ) && numReach >= 0;
+
+	if ( ok ) {
+		// all reachabilities are read into one block
+		reachabilityBlock = new idReachability[numReach];
+		numBlockReachabilities = numReach;
+		ok = ( fp->Read( reachabilityBlock, numReach * sizeof( idReachability ) ) == numReach * (int)sizeof( idReachability ) );
+	}
+
+	if ( !ok ) {
+		common->Warning( "%s is corrupt", binaryName.c_str() );
+		delete[] reachabilityBlock;
+		reachabilityBlock = NULL;
+		numBlockReachabilities = 0;
+		Clear();
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	// special reachabilities carry a dictionary and are allocated separately
+	reachList.SetNum( numReach );
+	for ( i = 0; i < numReach; i++ ) {
+		reach = &reachabilityBlock[i];
+		if ( reach->travelType == TFL_SPECIAL ) {
+			special = new idReachability_Special();
+			special->CopyBase( *reach );
+			special->fromAreaNum = reach->fromAreaNum;
+			special->number = reach->number;
+			special->disableCount = reach->disableCount;
+			special->next = reach->next;
+			special->rev_next = reach->rev_next;
+			special->areaTravelTimes = NULL;
+			special->dict.ReadFromFileHandle( fp );
+			reach = special;
+		}
+		reachList[i] = reach;
+	}
+
+	fileSystem->CloseFile( fp );
+
+	#define INDEX_TO_REACH( r )		( (r) ? reachList[ (intptr_t) (r) - 1 ] : NULL )
+
+	// fix up the reachability links
+	for ( i = 0; i < numReach; i++ ) {
+		reach = reachList[i];
+		reach->next = INDEX_TO_REACH( reach->next );
+		reach->rev_next = INDEX_TO_REACH( reach->rev_next );
+		reach->areaTravelTimes = NULL;
+	}
+	for ( i = 0; i < areas.Num(); i++ ) {
+		areas[i].reach = INDEX_TO_REACH( areas[i].reach );
+		areas[i].rev_reach = INDEX_TO_REACH( areas[i].rev_reach );
+	}
+
+	#undef INDEX_TO_REACH
+
+	name = fileName;
+	crc = mapFileCRC;
+
+	return true;
+}
@@ -64,6 +64,8 @@ public:
 public:
 	bool						Load( const idStr &fileName, unsigned int mapFileCRC );
 	bool						Write( const idStr &fileName, unsigned int mapFileCRC );
+	bool						LoadBinary( const idStr &fileName, unsigned int mapFileCRC );
+	bool						WriteBinary( const idStr &fileName, unsigned int mapFileCRC );
 
 	int							MemorySize( void ) const;
 	void						ReportRoutingEfficiency( void ) const;
@@ -94,6 +96,12 @@ private:
 	int							AreaContentsTravelFlags( int areaNum ) const;
 	idVec3						AreaReachableGoal( int areaNum ) const;
 	int							NumReachabilities( void ) const;
+	void						FreeReachability( idReachability *reach );
+	static int					ReachIndex( const idReachability *reach, const idList<idReachability *> &reachList, const idHashIndex &reachHash );
+
+private:
+	idReachability *			reachabilityBlock;		// contiguous reachabilities loaded from a binary file
+	int							numBlockReachabilities;
 };
 
 #endif /* !__AASFILELOCAL_H__ */